@@ -248,6 +248,11 @@ public:
         sharedData->cycles++;
     }
 
+    /** Add cycles that passed while the clock was not ticking */
+    void addCycles(uint64_t cycles) {
+        sharedData->cycles += cycles;
+    }
+
     uint64_t getCycles() const {
         return sharedData->cycles;
     }
@@ -15,6 +15,7 @@
 
 #include <sst_config.h>
 #include "arielcore.h"
+#include "arielcpu.h"
 #include "tb_header.h"
 #include <iostream>
 #include <exception>
@@ -59,7 +60,7 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
+    coreQ.reserve(maxQLength);
     pendingTransactions = new std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>();
     pending_transaction_count = 0;
 
@@ -126,6 +127,13 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     }
 
     currentCycles = 0;
+    recorder = nullptr;
+    frontend = nullptr;
+
+    cpu = nullptr;
+    sleeping = false;
+    sleepActive = false;
+    sleepCycle = NotSleeping;
 }
 
 ArielCore::~ArielCore() {
@@ -260,6 +268,7 @@ void ArielCore::commitFlushEvent(const uint64_t address,
 
 void ArielCore::handleEvent(StandardMem::Request* event) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " handling a memory event.\n", coreID));
+    wakeup();
     StandardMem::Request::id_t mev_id = event->getID();
     auto find_entry = pendingTransactions->find(mev_id);
 
@@ -363,9 +372,7 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                         output->verbose(CALL_INFO, 16, 0, "\n");
                     }
 
-                    ArielWriteEvent* awe;
-                    awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                    handleWriteRequest(awe);
+                    handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                     setCurrentAddress(getCurrentAddress() + current_transfer);
                     setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                 }
@@ -462,17 +469,15 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                 // Still data left to read
                 pendingGpuTransactions->erase(pendingGpuTransactions->find(mev_id));
                 pending_transaction_count--;
-                ArielReadEvent *are;
                 while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
                     if(getRemainingTransfer() <= 64) {
-                        are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                        handleReadRequest(getCurrentAddress(), getRemainingTransfer());
                         setRemainingTransfer(0);
                     }else {
-                        are = new ArielReadEvent(getCurrentAddress(), 64);
+                        handleReadRequest(getCurrentAddress(), 64);
                         setRemainingTransfer(getRemainingTransfer()-64);
                         setCurrentAddress(getCurrentAddress() + 64);
                     }
-                    handleReadRequest(are);
                 }
             }
         }
@@ -532,6 +537,7 @@ void ArielCore::StdMemHandler::handle(StandardMem::WriteResp* resp) {
 bool ArielCore::handleInterrupt(ArielMemoryManager::InterruptAction action) {
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " received an interrupt.\n", coreID));
+    wakeup();
 
     switch (action) {
         case ArielMemoryManager::InterruptAction::STALL:
@@ -579,7 +585,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
     uint64_t addr_offset;
     uint64_t current_transfer;
     current_transfer = (getRemainingTransfer() > 64) ? 64 : getRemainingTransfer();
-    phy_addr = memmgr->translateAddress(getCurrentAddress());
+    phy_addr = memmgr->translateAddressForCore(getCurrentAddress(), coreID);
     addr_offset = phy_addr % ((uint64_t) cacheLineSize);
     if((addr_offset + current_transfer <= cacheLineSize)){
         physicalAddresses.push_back(phy_addr);
@@ -589,7 +595,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
         uint64_t rightAddr = (getCurrentAddress() + ((uint64_t) cacheLineSize)) - addr_offset;
         uint64_t rightSize = current_transfer - leftSize;
         uint64_t physLeftAddr = phy_addr;
-        uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        uint64_t physRightAddr = memmgr->translateAddressForCore(rightAddr, coreID);
         physicalAddresses.push_back(physLeftAddr);
     }
 }
@@ -658,79 +664,85 @@ void ArielCore::unfence()
 }
 
 
-void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
-    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, aSPE->getPool()));
-    memmgr->setDefaultPool(aSPE->getPool());
+void ArielCore::handleSwitchPoolEvent(uint32_t pool) {
+    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " set default memory pool to: %" PRIu32 "\n", coreID, pool));
+    memmgr->setDefaultPool(pool);
 }
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
-    ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    coreQ.push(SWITCH_POOL).length = newPool;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    coreQ.push(NOOP);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    ArielEventRecord& ev = coreQ.push(READ_ADDRESS);
+    ev.addr = address;
+    ev.length = length;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    ArielEventRecord& ev = coreQ.push(MALLOC);
+    ev.addr = vAddr;
+    ev.allocLength = length;
+    ev.length = level;
+    ev.instPtr = instPtr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
-    ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    ArielEventRecord& ev = coreQ.push(MMAP);
+    ev.fileID = fileID;
+    ev.addr = vAddr;
+    ev.allocLength = length;
+    ev.length = level;
+    ev.instPtr = instPtr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
 }
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
-    ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    coreQ.push(FREE).addr = vAddr;
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    ArielEventRecord& ev = coreQ.push(WRITE_ADDRESS);
+    ev.addr = address;
+    ev.length = length;
+    if( writePayloads ) {
+        memcpy(ev.payload, payload, std::min(length, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE));
+    }
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
-    ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    coreQ.push(FLUSH).addr = vAddr;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
-    ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    coreQ.push(FENCE);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
-    ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    coreQ.push(CORE_EXIT);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -751,7 +763,7 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
     Ev->set_rtl_inp_size(inp_size);
     Ev->set_rtl_ctrl_size(ctrl_size);
     Ev->set_updated_rtl_params_size(updated_rtl_params_size);
-    coreQ->push(Ev);
+    coreQ.push(RTL).ext = Ev;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a RTL event.\n"));
 }
@@ -759,7 +771,7 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
     ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    coreQ.push(GPU).ext = gEv;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
@@ -837,12 +849,17 @@ bool ArielCore::hasDrainCompleted() const {
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
-    while(coreQ->size() < maxQLength) {
+    while(coreQ.size() < maxQLength) {
         ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Attempting to fill events for core: %" PRIu32 " current queue size=%" PRIu32 ", max length=%" PRIu32 "\n",
-                            coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
+                            coreID, (uint32_t) coreQ.size(), (uint32_t) maxQLength));
 
         ArielCommand ac;
-        const bool avail = tunnel->readMessageNB(coreID, &ac);
+        bool avail = tunnel->readMessageNB(coreID, &ac);
+
+        if ( !avail && frontend ) {
+                frontend->refill(coreID);
+                avail = tunnel->readMessageNB(coreID, &ac);
+        }
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
@@ -851,6 +868,10 @@ bool ArielCore::refillQueue() {
 
         ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel reads data on core: %" PRIu32 "\n", coreID));
 
+        if(recorder) {
+            recordCommand(ac);
+        }
+
         // There is data on the pipe
         switch(ac.command) {
             case ARIEL_OUTPUT_STATS:
@@ -885,6 +906,9 @@ bool ArielCore::refillQueue() {
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
+                        if(recorder) {
+                            recordCommand(ac);
+                        }
 
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
@@ -962,17 +986,22 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
-void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
-    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
+void ArielCore::recordCommand(const ArielCommand& ac) {
+    if(!recorder->record(coreID, ac)) {
+        output->fatal(CALL_INFO, -1, "Error: core %" PRIu32 " cannot record command (%d), RTL and CUDA commands cannot be replayed.\n", coreID, (int)(ac.command));
+    }
+}
 
-    memmgr->freeMalloc(rFE->getVirtualAddress());
+void ArielCore::handleFreeEvent(uint64_t vAddr) {
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, vAddr));
+
+    memmgr->freeMalloc(vAddr);
 }
 
-void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
+void ArielCore::handleReadRequest(uint64_t readAddress, uint32_t length) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a read event...\n", coreID));
 
-    const uint64_t readAddress = rEv->getAddress();
-    const uint64_t readLength  = std::min((uint64_t) rEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t readLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     /* No longer neccessary due to trimming above
      * if(readLength > cacheLineSize) {
@@ -985,7 +1014,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     // There is a chance that the non-alignment causes an undetected bug if an access spans multiple malloc regions that are contiguous in VA space but non-contiguous in PA space.
     // However, a single access spanning multiple malloc'd regions shouldn't happen...
     // Addresses mapped via first touch are always line/page aligned
-    const uint64_t physAddr = memmgr->translateAddress(readAddress);
+    const uint64_t physAddr = memmgr->translateAddressForCore(readAddress, coreID);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     if((addr_offset + readLength) <= cacheLineSize) {
@@ -1010,7 +1039,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
         const uint64_t rightSize = readLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateAddressForCore(rightAddr, coreID);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address read, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1042,11 +1071,10 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     statReadRequestSizes->addData(readLength);
 }
 
-void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
+void ArielCore::handleWriteRequest(uint64_t writeAddress, uint32_t length, const uint8_t* payload) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a write event...\n", coreID));
 
-    const uint64_t writeAddress = wEv->getAddress();
-    const uint64_t writeLength  = std::min((uint64_t) wEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t writeLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     // No longer neccessary due to trimming above
 /*    if(writeLength > cacheLineSize) {
@@ -1056,7 +1084,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
     }*/
 
     // See note in handleReadRequest() on alignment issues
-    const uint64_t physAddr = memmgr->translateAddress(writeAddress);
+    const uint64_t physAddr = memmgr->translateAddressForCore(writeAddress, coreID);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     // We do not need to perform a split operation
@@ -1076,8 +1104,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
                             coreID, writeAddress, writeLength, physAddr));
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payload);
         } else {
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
         }
@@ -1093,7 +1120,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         const uint64_t rightSize = writeLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateAddressForCore(rightAddr, coreID);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address write, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1116,9 +1143,8 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         }
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payload);
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payload[leftSize]);
         } else {
             commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL);
             commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL);
@@ -1132,27 +1158,25 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
 
 
 
-void ArielCore::handleMmapEvent(ArielMmapEvent* aEv) {
-    memmgr->allocateMMAP(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(),
-            aEv->getInstructionPointer(), aEv->getFileID(), coreID);
+void ArielCore::handleMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
+    memmgr->allocateMMAP(length, level, vAddr, instPtr, fileID, coreID);
 }
 
-void ArielCore::handleAllocationEvent(ArielAllocateEvent* aEv) {
+void ArielCore::handleAllocationEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     output->verbose(CALL_INFO, 2, 0, "Handling a memory allocation event, vAddr=%" PRIu64 ", length=%" PRIu64 ", at level=%" PRIu32 " with malloc ID=%" PRIu64 "\n",
-                aEv->getVirtualAddress(), aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getInstructionPointer());
+                vAddr, length, level, instPtr);
 
-    memmgr->allocateMalloc(aEv->getAllocationLength(), aEv->getAllocationLevel(), aEv->getVirtualAddress(), aEv->getInstructionPointer(), coreID);
+    memmgr->allocateMalloc(length, level, vAddr, instPtr, coreID);
 }
 
-void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
-    const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
-    const uint64_t readLength = (uint64_t) flEv->getLength();
+void ArielCore::handleFlushEvent(uint64_t virtualAddress) {
+    const uint64_t readLength = cacheLineSize;
 
-    const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
+    const uint64_t physAddr = memmgr->translateAddressForCore(virtualAddress, coreID);
     commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
 }
 
-void ArielCore::handleFenceEvent(ArielFenceEvent *fEv) {
+void ArielCore::handleFenceEvent() {
     /*  Todo: Should we treat this like the Flush event, and require that the Fence
     *  be put into a transaction queue?  */
     // Possibility A:
@@ -1234,9 +1258,7 @@ void ArielCore::handleGpuEvent(ArielGpuEvent* gEv){
                                 output->verbose(CALL_INFO, 16, 0, "\n");
                             }
 
-                            ArielWriteEvent* awe;
-                            awe = new ArielWriteEvent(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
-                            handleWriteRequest(awe);
+                            handleWriteRequest(getCurrentAddress(), current_transfer, &getDataAddress()[index]);
                             setCurrentAddress(getCurrentAddress() + current_transfer);
                             setRemainingPageTransfer(getRemainingPageTransfer() - current_transfer);
                         }
@@ -1333,21 +1355,20 @@ void ArielCore::handleGpuEvent(ArielGpuEvent* gEv){
 }
 
 void ArielCore::handleGpuAckEvent(SST::Event* e){
+    wakeup();
     BalarEvent * ev = dynamic_cast<BalarComponent::BalarEvent*>(e);
     if (ev->getType() == BalarComponent::EventType::RESPONSE){
         if((ev->API == GPU_MEMCPY_RET)&&(ev->CA.cuda_memcpy.kind == cudaMemcpyDeviceToHost)){
             // Device to Host still needs us to get the data for fesimple
-            ArielReadEvent *are;
             while((getOpenTransactions() > 0) && (getRemainingTransfer() > 0)){
                 if(getRemainingTransfer() <= 64) {
-                    are = new ArielReadEvent(getCurrentAddress(), getRemainingTransfer());
+                    handleReadRequest(getCurrentAddress(), getRemainingTransfer());
                     setRemainingTransfer(0);
                 }else {
-                    are = new ArielReadEvent(getCurrentAddress(), 64);
+                    handleReadRequest(getCurrentAddress(), 64);
                     setRemainingTransfer(getRemainingTransfer()-64);
                     setCurrentAddress(getCurrentAddress() + 64);
                 }
-                handleReadRequest(are);
             }
         } else {
             output->verbose(CALL_INFO, 16, 0, "CUDA: Ariel recieved ACK\n");
@@ -1376,7 +1397,8 @@ void ArielCore::handleGpuAckEvent(SST::Event* e){
 #endif
 
 void ArielCore::handleRtlAckEvent(SST::Event* e) {
-    
+    wakeup();
+
     output->verbose(CALL_INFO, 16, 0, "\nAriel received Event from RTL\n");
     ArielRtlEvent* ev = dynamic_cast<ArielRtlEvent*>(e);
     if(ev->getEventRecvAck() == true) {
@@ -1396,9 +1418,8 @@ void ArielCore::handleRtlAckEvent(SST::Event* e) {
     }
     if(ev->RtlData.rtl_inp_ptr != nullptr) {
         rtl_inp_ptr = ev->RtlData.rtl_inp_ptr;
-        ArielReadEvent *are = new ArielReadEvent((uint64_t)ev->RtlData.rtl_inp_ptr, (uint64_t)ev->RtlData.rtl_inp_size);
         output->verbose(CALL_INFO, 1, 0, "\nAriel received Event from RTL. Generating Read Request\n");
-        handleReadRequest(are);
+        handleReadRequest((uint64_t)ev->RtlData.rtl_inp_ptr, (uint32_t)ev->RtlData.rtl_inp_size);
     }
 
     return;    
@@ -1413,7 +1434,7 @@ bool ArielCore::processNextEvent() {
     // Upon every call, check if the core is drained and we are fenced. If so, unfence
     // return true; /* Todo: reevaluate if this is needed */
     // Attempt to refill the queue
-    if(coreQ->empty()) {
+    if(coreQ.empty()) {
         bool addedItems = refillQueue();
 
         ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Attempted a queue fill, %s data\n",
@@ -1428,10 +1449,10 @@ bool ArielCore::processNextEvent() {
 
     ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Processing next event in core %" PRIu32 "...\n", coreID));
 
-    ArielEvent* nextEvent = coreQ->front();
+    ArielEventRecord& nextEvent = coreQ.front();
     bool removeEvent = false;
 
-    switch(nextEvent->getEventType()) {
+    switch(nextEvent.type) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
                 statInstructionCount->addData(1);
@@ -1449,7 +1470,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(nextEvent.addr, nextEvent.length);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1465,7 +1486,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    handleWriteRequest(nextEvent.addr, nextEvent.length, nextEvent.payload);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1485,25 +1506,25 @@ bool ArielCore::processNextEvent() {
         case SWITCH_POOL:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SWITCH_POOL\n", coreID));
                 removeEvent = true;
-                handleSwitchPoolEvent(dynamic_cast<ArielSwitchPoolEvent*>(nextEvent));
+                handleSwitchPoolEvent(nextEvent.length);
                 break;
 
         case FREE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is FREE\n", coreID));
                 removeEvent = true;
-                handleFreeEvent(dynamic_cast<ArielFreeEvent*>(nextEvent));
+                handleFreeEvent(nextEvent.addr);
                 break;
 
         case MALLOC:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MALLOC\n", coreID));
                 removeEvent = true;
-                handleAllocationEvent(dynamic_cast<ArielAllocateEvent*>(nextEvent));
+                handleAllocationEvent(nextEvent.addr, nextEvent.allocLength, nextEvent.length, nextEvent.instPtr);
                 break;
 
         case MMAP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is MMAP\n", coreID));
                 removeEvent = true;
-                handleMmapEvent(dynamic_cast<ArielMmapEvent*>(nextEvent));
+                handleMmapEvent(nextEvent.fileID, nextEvent.addr, nextEvent.allocLength, nextEvent.length, nextEvent.instPtr);
                 break;
 
         case CORE_EXIT:
@@ -1519,7 +1540,7 @@ bool ArielCore::processNextEvent() {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a FLUSH event, fewer pending transactions than permitted so will process..\n"));
                     statInstructionCount->addData(1);
                     inst_count++;
-                    handleFlushEvent(dynamic_cast<ArielFlushEvent*>(nextEvent));
+                    handleFlushEvent(nextEvent.addr);
                     removeEvent = true;
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ",core will stall for new events\n", coreID));
@@ -1529,7 +1550,7 @@ bool ArielCore::processNextEvent() {
         case FENCE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FENCE\n", coreID));
                 if(!isCoreFenced()) {// If core is fenced, drop this fence - they can be merged
-                    handleFenceEvent(dynamic_cast<ArielFenceEvent*>(nextEvent));
+                    handleFenceEvent();
                 }
                 removeEvent = true;
                 break;
@@ -1538,7 +1559,7 @@ bool ArielCore::processNextEvent() {
             ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 "next event is RTL (RTLEvent call)\n", coreID));
             output->verbose(CALL_INFO, 1, 0, "\nArielRTLEvent is being issued");
             removeEvent = true;
-            handleRtlEvent(dynamic_cast<ArielRtlEvent*>(nextEvent));
+            handleRtlEvent(static_cast<ArielRtlEvent*>(nextEvent.ext));
             break;
 
 #ifdef HAVE_CUDA
@@ -1547,7 +1568,7 @@ bool ArielCore::processNextEvent() {
             removeEvent = true;
             stall();
             gpu();
-            handleGpuEvent(dynamic_cast<ArielGpuEvent*>(nextEvent));
+            handleGpuEvent(static_cast<ArielGpuEvent*>(nextEvent.ext));
             break;
 #endif
         default:
@@ -1558,10 +1579,10 @@ bool ArielCore::processNextEvent() {
     // If the event has actually been processed this cycle then remove it from the queue
     if(removeEvent) {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Removing event from pending queue, there are %" PRIu32 " events in the queue before deletion.\n",
-                            (uint32_t) coreQ->size()));
-        coreQ->pop();
+                            (uint32_t) coreQ.size()));
+        delete nextEvent.ext;
+        coreQ.pop();
 
-        delete nextEvent;
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
@@ -1607,3 +1628,67 @@ void ArielCore::tick() {
         isHalted=true;
 }
 
+/*
+ * A core can sleep if ticking it would only count cycles until an event arrives:
+ * it is stalled, or the event at the head of its queue needs a transaction slot
+ * and all maxtranscore are in use. A core with an empty queue polls the tunnel
+ * every tick, which has no way to signal new data, so it keeps ticking.
+ */
+bool ArielCore::canSleep() {
+    if(isHalted) {
+        return false;
+    }
+
+    if(isStalled) {
+        return true;
+    }
+
+    if(coreQ.empty() || pending_transaction_count < maxPendingTransactions) {
+        return false;
+    }
+
+    switch(coreQ.front().type) {
+        case READ_ADDRESS:
+        case WRITE_ADDRESS:
+        case FLUSH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ArielCore::sleep(SST::Cycle_t cycle) {
+    ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Core %" PRIu32 " going to sleep after cycle %" PRIu64 "\n", coreID, (uint64_t) cycle));
+    sleeping = true;
+    sleepCycle = cycle;
+
+    // A blocked core still has an event to look at each tick, a stalled one does not
+    sleepActive = !isStalled;
+}
+
+void ArielCore::wakeup() {
+    if(sleeping) {
+        sleeping = false;
+        cpu->wakeCore();
+    }
+}
+
+/* Account for the ticks skipped since the core went to sleep, up to but not including 'cycle' */
+void ArielCore::creditSleepCycles(SST::Cycle_t cycle) {
+    if(sleepCycle == NotSleeping) {
+        return;
+    }
+
+    const uint64_t skipped = cycle - sleepCycle - 1;
+    sleepCycle = NotSleeping;
+
+    if(skipped > 0) {
+        currentCycles += skipped;
+        statCycles->addDataNTimes(skipped, 1);
+
+        if(sleepActive) {
+            statActiveCycles->addDataNTimes(skipped, 1);
+        }
+    }
+}
+
@@ -47,6 +47,9 @@
 #include "arielfenceev.h"
 #include "arielswitchpool.h"
 #include "arielrtlev.h"
+#include "arieleventring.h"
+#include "arielstream.h"
+#include "arielfrontend.h"
 #include "tb_header.h"
 
 #include "ariel_shmem.h"
@@ -63,6 +66,7 @@ using namespace SST::ArielComponent;
 namespace SST {
 namespace ArielComponent {
 
+class ArielCPU;
 
 class ArielCore : public ComponentExtension {
 
@@ -147,14 +151,14 @@ class ArielCore : public ComponentExtension {
 #endif
 
         void handleEvent(StandardMem::Request* event);
-        void handleReadRequest(ArielReadEvent* wEv);
-        void handleWriteRequest(ArielWriteEvent* wEv);
-        void handleAllocationEvent(ArielAllocateEvent* aEv);
-        void handleMmapEvent(ArielMmapEvent* aEv);
-        void handleFreeEvent(ArielFreeEvent* aFE);
-        void handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE);
-        void handleFlushEvent(ArielFlushEvent *flEv);
-        void handleFenceEvent(ArielFenceEvent *fEv);
+        void handleReadRequest(uint64_t readAddress, uint32_t length);
+        void handleWriteRequest(uint64_t writeAddress, uint32_t length, const uint8_t* payload);
+        void handleAllocationEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr);
+        void handleMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr);
+        void handleFreeEvent(uint64_t vAddr);
+        void handleSwitchPoolEvent(uint32_t pool);
+        void handleFlushEvent(uint64_t vAddr);
+        void handleFenceEvent();
         void handleRtlEvent(ArielRtlEvent* RtlEv);
         void handleRtlAckEvent(SST::Event* e);
 
@@ -188,12 +192,27 @@ class ArielCore : public ComponentExtension {
         // Setting the max number of instructions to be simulated
         void setMaxInsts(uint64_t i){max_insts=i;}
 
+        // Record every command read from the tunnel
+        void setRecorder(ArielStreamWriter* rec){recorder=rec;}
+
+        // Ask the frontend for more commands whenever the tunnel is empty
+        void setFrontend(ArielFrontend* fe){frontend=fe;}
+
+        // Clock gating: a core whose ticks could only count cycles sleeps until an event arrives
+        void setClockGating(ArielCPU* parent){cpu=parent;}
+        bool isSleeping() const {return sleeping;}
+        bool canSleep();
+        void sleep(SST::Cycle_t cycle);
+        void creditSleepCycles(SST::Cycle_t cycle);
+
         void printCoreStatistics();
         void printTraceEntry(const bool isRead, const uint64_t address, const uint32_t length);
 
     private:
         bool processNextEvent();
         bool refillQueue();
+        void recordCommand(const ArielCommand& ac);
+        void wakeup();
         bool writePayloads;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
@@ -217,7 +236,7 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventRing coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
@@ -254,6 +273,14 @@ class ArielCore : public ComponentExtension {
         uint64_t max_insts;
 
         ArielTraceGenerator* traceGen;
+        ArielStreamWriter* recorder;
+        ArielFrontend* frontend;
+
+        ArielCPU* cpu;              // Set if clock gating is enabled
+        bool sleeping;
+        bool sleepActive;           // Whether the skipped ticks would have been active cycles
+        SST::Cycle_t sleepCycle;    // Last cycle ticked before sleeping, NotSleeping if none to credit
+        static const SST::Cycle_t NotSleeping = ~(SST::Cycle_t)0;
 
         Statistic<uint64_t>* statReadRequests;
         Statistic<uint64_t>* statWriteRequests;
@@ -169,7 +169,9 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
     std::string cpu_clock = params.find<std::string>("clock", "1GHz");
     output->verbose(CALL_INFO, 1, 0, "Registering ArielCPU clock at %s\n", cpu_clock.c_str());
 
-    TimeConverter* timeconverter = registerClock( cpu_clock, new Clock::Handler<ArielCPU>(this, &ArielCPU::tick ) );
+    clockHandler = new Clock::Handler<ArielCPU>(this, &ArielCPU::tick );
+    TimeConverter* timeconverter = registerClock( cpu_clock, clockHandler );
+    cpuClock = timeconverter;
 
     output->verbose(CALL_INFO, 1, 0, "Clocks registered.\n");
 
@@ -188,6 +190,27 @@ ArielCPU::ArielCPU(ComponentId_t id, Params& params) :
 
         // Set max number of instructions
         cpu_cores[i]->setMaxInsts(max_insts);
+        cpu_cores[i]->setFrontend(frontend);
+    }
+
+    recorder = nullptr;
+    std::string recordfile = params.find<std::string>("recordfile", "");
+    if ("" != recordfile) {
+        recorder = new ArielStreamWriter();
+        if (!recorder->open(recordfile, core_count, params.find<int>("writepayloadtrace", 0) != 0))
+            output->fatal(CALL_INFO, -1, "%s, Error: unable to create recordfile '%s'\n", getName().c_str(), recordfile.c_str());
+        output->verbose(CALL_INFO, 1, 0, "Recording core command streams to %s\n", recordfile.c_str());
+        for (uint32_t i = 0; i < core_count; ++i)
+            cpu_cores[i]->setRecorder(recorder);
+    }
+
+    clockGating = params.find<bool>("clockgating", false);
+    clockSuspended = false;
+    lastCycle = 0;
+    if (clockGating) {
+        output->verbose(CALL_INFO, 1, 0, "Clock gating is enabled for idle cores\n");
+        for (uint32_t i = 0; i < core_count; ++i)
+            cpu_cores[i]->setClockGating(this);
     }
 
     // Find all the components loaded into the "memory" slot
@@ -258,6 +281,14 @@ void ArielCPU::init(unsigned int phase)
 }
 
 void ArielCPU::finish() {
+    // Credit cores still asleep for the cycles an ungated run would have ticked them
+    if(clockGating && !stopTicking) {
+        SST::Cycle_t end = clockSuspended ? getCurrentSimTime(cpuClock) + 1 : lastCycle + 1;
+        for(uint32_t i = 0; i < core_count; ++i) {
+            cpu_cores[i]->creditSleepCycles(end);
+        }
+    }
+
     for(uint32_t i = 0; i < core_count; ++i) {
         cpu_cores[i]->finishCore();
     }
@@ -271,6 +302,9 @@ void ArielCPU::finish() {
 
     memmgr->printStats();
     frontend->finish();
+
+    if (recorder && !recorder->close())
+        output->fatal(CALL_INFO, -1, "%s, Error: failed writing recordfile\n", getName().c_str());
 }
 
 bool ArielCPU::tick( SST::Cycle_t cycle) {
@@ -280,25 +314,69 @@ bool ArielCPU::tick( SST::Cycle_t cycle) {
     tunnel->updateTime(getCurrentSimTimeNano());
     tunnel->incrementCycles();
 
+    lastCycle = cycle;
+    uint32_t awake = 0;
+
     // Keep ticking unless one of the cores says it is time to stop.
     for(uint32_t i = 0; i < core_count; ++i) {
+        if(clockGating) {
+            if(cpu_cores[i]->isSleeping()) {
+                continue;
+            }
+            cpu_cores[i]->creditSleepCycles(cycle);
+        }
+
         cpu_cores[i]->tick();
 
         if(cpu_cores[i]->isCoreHalted()) {
                 stopTicking = true;
+
+                // Sleeping cores would have ticked up to here in an ungated run
+                for(uint32_t j = 0; clockGating && j < core_count; ++j) {
+                    cpu_cores[j]->creditSleepCycles(j < i ? cycle + 1 : cycle);
+                }
                 break;
         }
+
+        if(clockGating && cpu_cores[i]->canSleep()) {
+            cpu_cores[i]->sleep(cycle);
+        } else {
+            awake++;
+        }
     }
 
     // Its time to end, that's all folks
     if(stopTicking) {
         primaryComponentOKToEndSim();
+        return true;
     }
 
-    return stopTicking;
+    // Nothing can happen until a core is woken, stop the clock until then
+    if(clockGating && awake == 0) {
+        output->verbose(CALL_INFO, 16, 0, "All cores are asleep, suspending clock after cycle %" PRIu64 "\n", (uint64_t) cycle);
+        clockSuspended = true;
+        return true;
+    }
+
+    return false;
 }
 
-ArielCPU::~ArielCPU() { }
+void ArielCPU::wakeCore() {
+    if(!clockSuspended) {
+        return;
+    }
+
+    clockSuspended = false;
+    SST::Cycle_t next = reregisterClock(cpuClock, clockHandler);
+
+    // Keep the cycle count seen by the application as if the clock had kept running
+    tunnel->addCycles(next - lastCycle - 1);
+    output->verbose(CALL_INFO, 16, 0, "Core woken, resuming clock at cycle %" PRIu64 "\n", (uint64_t) next);
+}
+
+ArielCPU::~ArielCPU() {
+    delete recorder;
+}
 
 void ArielCPU::emergencyShutdown() {
     /* Ask the cores to finish up.  This should flush logging */
@@ -31,6 +31,7 @@
 #include "arielcore.h"
 #include "arielfrontend.h"
 #include "ariel_shmem.h"
+#include "arielstream.h"
 
 namespace SST {
 namespace ArielComponent {
@@ -81,6 +82,8 @@ class ArielCPU : public SST::Component {
         {"tracegen", "Select the trace generator for Ariel (which records traced memory operations", ""},
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
+        {"recordfile", "Record the command stream every core reads from the frontend to this file so it can be replayed with ariel.frontend.replay", ""},
+        {"clockgating", "Set to 1 to stop ticking cores that are stalled or blocked on maxtranscore until an event wakes them, and to stop the CPU clock while all cores sleep. Cycle statistics are credited for the skipped ticks", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
         {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
 
@@ -126,6 +129,9 @@ class ArielCPU : public SST::Component {
         virtual void finish();
         virtual bool tick( SST::Cycle_t );
 
+        /* Called by a sleeping core when an event wakes it */
+        void wakeCore();
+
     private:
         SST::Output* output;
         ArielMemoryManager* memmgr;
@@ -139,8 +145,15 @@ class ArielCPU : public SST::Component {
 
         ArielFrontend* frontend;
         ArielTunnel* tunnel;
+        ArielStreamWriter* recorder;
         bool stopTicking;
 
+        bool clockGating;
+        bool clockSuspended;        // Every core is asleep and the clock handler is unregistered
+        SST::Cycle_t lastCycle;     // Last cycle ticked
+        TimeConverter* cpuClock;
+        Clock::HandlerBase* clockHandler;
+
 #ifdef HAVE_CUDA
         GpuReturnTunnel* tunnelR;
         GpuDataTunnel* tunnelD;
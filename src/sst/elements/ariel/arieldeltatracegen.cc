@@ -0,0 +1,63 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+
+
+#include "arieldeltatracegen.h"
+
+using namespace SST::ArielComponent;
+
+ArielDeltaTraceGenerator::ArielDeltaTraceGenerator(Params& params) :
+    ArielTraceGenerator() {
+
+    tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    blockRecords = params.find<uint32_t>("block_records", SST::Prospero::DeltaTrace::DefaultBlockRecords);
+    compressionLevel = params.find<int>("compression_level", 1);
+    coreID = 0;
+
+    output = new Output("ArielDeltaTraceGenerator: ", 0, 0, Output::STDOUT);
+
+    if (0 == blockRecords) {
+        output->fatal(CALL_INFO, -1, "Error: block_records must be at least 1\n");
+    }
+}
+
+ArielDeltaTraceGenerator::~ArielDeltaTraceGenerator() {
+    if (!writer.close()) {
+        output->fatal(CALL_INFO, -1, "Error: unable to complete trace %s: %s\n", tracePath.c_str(), writer.error().c_str());
+    }
+    delete output;
+}
+
+void ArielDeltaTraceGenerator::publishEntry(const uint64_t picoS,
+    const uint64_t physAddr, const uint32_t reqLength,
+    const ArielTraceEntryOperation op) {
+
+    if (!writer.append(picoS, physAddr, reqLength, op == WRITE)) {
+        output->fatal(CALL_INFO, -1, "Error: unable to write trace %s: %s\n", tracePath.c_str(), writer.error().c_str());
+    }
+}
+
+void ArielDeltaTraceGenerator::setCoreID(const uint32_t core) {
+    coreID = core;
+
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s-%" PRIu32 ".trace.pdt", tracePrefix.c_str(), core);
+    tracePath = path;
+
+    if (!writer.open(tracePath, blockRecords, compressionLevel)) {
+        output->fatal(CALL_INFO, -1, "Error: %s\n", writer.error().c_str());
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_DELTA_TRACE_GEN
+#define _H_SST_ARIEL_DELTA_TRACE_GEN
+
+#include <climits>
+
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+
+#include "arieltracegen.h"
+#include "sst/elements/prospero/prosdeltatrace.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Writes the block delta trace format read by prospero.ProsperoDeltaTraceReader,
+ * one file per core named <trace_prefix>-<core>.trace.pdt
+ */
+class ArielDeltaTraceGenerator : public ArielTraceGenerator {
+
+    public:
+        SST_ELI_REGISTER_MODULE(
+            ArielDeltaTraceGenerator,
+            "ariel",
+            "DeltaTraceGenerator",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Provides tracing to block delta compressed file capabilities",
+            SST::ArielComponent::ArielTraceGenerator
+        )
+
+        SST_ELI_DOCUMENT_PARAMS(
+            { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" },
+            { "block_records", "Number of records per trace block", "65536" },
+            { "compression_level", "Deflate level applied to each block, 0 to store blocks uncompressed (requires libz)", "1" }
+        )
+
+        ArielDeltaTraceGenerator(Params& params);
+
+        ~ArielDeltaTraceGenerator();
+
+        void publishEntry(const uint64_t picoS, const uint64_t physAddr,
+                const uint32_t reqLength, const ArielTraceEntryOperation op);
+
+        void setCoreID(const uint32_t core);
+
+    private:
+        Output* output;
+        SST::Prospero::DeltaTrace::Writer writer;
+        std::string tracePrefix;
+        std::string tracePath;
+        uint32_t coreID;
+        uint32_t blockRecords;
+        int compressionLevel;
+
+};
+
+}
+}
+
+#endif
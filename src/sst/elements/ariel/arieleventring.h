@@ -0,0 +1,112 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_EVENT_RING
+#define _H_SST_ARIEL_EVENT_RING
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "arielevent.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * One queued core event, stored inline. Which fields are valid depends on 'type'.
+ * RTL and GPU events are rare and are sent on to other components, so they
+ * remain heap-allocated ArielEvents referenced by 'ext'.
+ */
+struct ArielEventRecord {
+    ArielEventType type;
+    uint32_t length;        // READ/WRITE: access size, MALLOC/MMAP: level, SWITCH_POOL: pool
+    uint64_t addr;          // READ/WRITE: address, MALLOC/MMAP/FREE/FLUSH: virtual address
+    uint64_t allocLength;   // MALLOC/MMAP
+    uint64_t instPtr;       // MALLOC/MMAP
+    uint32_t fileID;        // MMAP
+    ArielEvent* ext;        // RTL/GPU
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];    // WRITE, if payloads are being traced
+};
+
+/*
+ * Per-core FIFO of ArielEventRecords in a power-of-two ring.
+ *
+ * The ring is sized from the core's maximum queue length (maxcorequeue). The
+ * core only checks that limit between instructions, so one instruction's reads
+ * and writes can overflow it; the ring then doubles, which happens at most a
+ * few times per run. Nothing is allocated per event.
+ */
+class ArielEventRing {
+public:
+    ArielEventRing() : ring(nullptr), mask(0), head(0), tail(0) { }
+
+    ~ArielEventRing() {
+        while (!empty()) {
+            delete front().ext;
+            pop();
+        }
+    }
+
+    void reserve(uint32_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity)
+            cap <<= 1;
+        if (cap > mask + 1 || !ring)
+            resize(cap);
+    }
+
+    bool empty() const { return head == tail; }
+    size_t size() const { return tail - head; }
+
+    ArielEventRecord& front() { return ring[head & mask]; }
+    void pop() { head++; }
+
+    /* Append a record of the given type; the caller fills in its fields */
+    ArielEventRecord& push(ArielEventType type) {
+        if (!ring || size() > mask)
+            resize(ring ? (mask + 1) << 1 : 1);
+        ArielEventRecord& rec = ring[tail++ & mask];
+        rec.type = type;
+        rec.ext = nullptr;
+        return rec;
+    }
+
+private:
+    void resize(size_t cap) {
+        std::unique_ptr<ArielEventRecord[]> next(new ArielEventRecord[cap]);
+        size_t count = size();
+        for (size_t i = 0; i < count; i++)
+            next[i] = ring[(head + i) & mask];
+        ring = std::move(next);
+        mask = cap - 1;
+        head = 0;
+        tail = count;
+    }
+
+    std::unique_ptr<ArielEventRecord[]> ring;
+    size_t mask;
+    size_t head;    // Free-running indices
+    size_t tail;
+};
+
+}
+}
+
+#endif
@@ -55,6 +55,10 @@ public:
 
     virtual void init(unsigned int phase) = 0;
     virtual void setup() { }
+
+    /* Called on the simulation thread when a core finds its tunnel buffer empty.
+     * Frontends that produce commands in process can queue more for the core here. */
+    virtual void refill(uint32_t core) { }
     virtual void finish() { }
     virtual void emergencyShutdown() { }
 
@@ -26,6 +26,7 @@
 #include <unordered_map>
 
 #include "arielmemmgr.h"
+#include "arielpagetable.h"
 
 using namespace SST;
 using namespace SST::RNG;
@@ -47,18 +48,22 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentries", "Entries in each core's direct-mapped translation cache (rounded up to a power of two) to improve emulated core performance", "4096"}
 
     #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
         { "tlb_translate_queries","Number of TLB translations performed", "translations", 2 },\
         { "tlb_shootdown",        "Number of TLB clears because of page-frees", "shootdowns", 2 },\
-        { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 }
+        { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 },\
+        { "pagetable_hits_4k",    "TLB misses resolved by a 4KiB page in the page table", "hits", 2 },\
+        { "pagetable_hits_2m",    "TLB misses resolved by a 2MiB page in the page table", "hits", 2 },\
+        { "pagetable_hits_1g",    "TLB misses resolved by a 1GiB page in the page table", "hits", 2 },\
+        { "pagetable_misses",     "TLB misses that were not mapped and caused a page allocation", "misses", 2 }
 
         /* Constructor
             *  Supports multiple memory pools with independent page sizes/counts
             *  Constructs free page sets for each memory pool
-            *  Initializes a translation cache
+            *  Initializes the per-core translation caches
             */
         ArielMemoryManagerCache(ComponentId_t id, Params& params) : ArielMemoryManager(id, params) {
             translationEnabled = params.find<bool>("vtop_translate", true);
@@ -69,6 +74,10 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             statTranslationQueries      = registerStatistic<uint64_t>("tlb_translate_queries");
             statTranslationShootdown    = registerStatistic<uint64_t>("tlb_shootdown");
             statPageAllocationCount     = registerStatistic<uint64_t>("tlb_page_allocs");
+            statPageTableHits4K         = registerStatistic<uint64_t>("pagetable_hits_4k");
+            statPageTableHits2M         = registerStatistic<uint64_t>("pagetable_hits_2m");
+            statPageTableHits1G         = registerStatistic<uint64_t>("pagetable_hits_1g");
+            statPageTableMisses         = registerStatistic<uint64_t>("pagetable_misses");
 
             /* Get page map policy */
             mapPolicy = ArielPageMappingPolicy::LINEAR;
@@ -82,16 +91,56 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown page mapping policy \"%s\"\n", mappingPolicy.c_str());
             }
 
-            // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
+            // Set up translation caches, more are added as cores show up
             translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
+            if (translationCacheEntries == 0) {
+                output->fatal(CALL_INFO, -8, "Ariel memory manager - translatecacheentries must be at least 1\n");
+            }
+            translationCache.resize(1, ArielTLB(translationCacheEntries));
 
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
         ~ArielMemoryManagerCache() {};
+
+        uint64_t translateAddress(uint64_t virtAddr) {
+            return translateAddressForCore(virtAddr, 0);
+        }
+
+        /* Translate through the core's TLB, walking the page table on a miss */
+        uint64_t translateAddressForCore(uint64_t virtAddr, uint32_t core) {
+            // If translation is disabled, then just return address
+            if( ! translationEnabled ) {
+                return virtAddr;
+            }
+
+            // Keep track of how many translations we are performing
+            statTranslationQueries->addData(1);
+
+            if (core >= translationCache.size()) {
+                translationCache.resize(core + 1, ArielTLB(translationCacheEntries));
+            }
+
+            uint64_t physAddr;
+            if (translationCache[core].lookup(virtAddr, physAddr)) {
+                statTranslationCacheHits->addData(1);
+                return physAddr;
+            }
+
+            uint64_t rangeStart, rangeEnd;
+            physAddr = walkPageTable(virtAddr, rangeStart, rangeEnd);
+
+            if (translationCache[core].insert(virtAddr, physAddr, rangeStart, rangeEnd)) {
+                statTranslationCacheEvict->addData(1);
+            }
+            return physAddr;
+        }
+
         void get_tlb_info(std::unordered_map<uint64_t, uint64_t>* translationcache, uint32_t& translationcacheentries, bool& translationenabled) {
-            memcpy((void*)translationcache, (void*)translationCache, sizeof(*translationCache));
+            translationcache->clear();
+            for (const ArielTLB& tlb : translationCache) {
+                tlb.forEach([translationcache](uint64_t virtA, uint64_t physA) { translationcache->insert(std::make_pair(virtA, physA)); });
+            }
             translationcacheentries = translationCacheEntries;
             translationenabled = translationEnabled;
 
@@ -105,12 +154,74 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
         Statistic<uint64_t>* statTranslationQueries;
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
+        Statistic<uint64_t>* statPageTableHits4K;
+        Statistic<uint64_t>* statPageTableHits2M;
+        Statistic<uint64_t>* statPageTableHits1G;
+        Statistic<uint64_t>* statPageTableMisses;
 
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        std::vector<ArielTLB> translationCache;     // One per core
         uint32_t translationCacheEntries;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
 
+        ArielPageTable pageTable;                   // Demand-allocated and pinned pages
+
+        /*
+         * Translate an address that missed in the TLB, allocating a page for it if needed.
+         * Sets [rangeStart, rangeEnd) to the virtual range around virtAddr that has the same
+         * virtual to physical offset so the TLB can cache it.
+         */
+        virtual uint64_t walkPageTable(uint64_t virtAddr, uint64_t& rangeStart, uint64_t& rangeEnd) = 0;
+
+        /* Look virtAddr up in pageTable and, if 'count' is set, record which page size it hit in.
+         * Walks that re-find a page they just allocated pass false so each access counts once */
+        bool findPage(uint64_t virtAddr, uint64_t& physAddr, uint64_t& rangeStart, uint64_t& rangeEnd, bool count = true) {
+            uint64_t physPage;
+            const uint64_t size = pageTable.find(virtAddr, physPage);
+
+            if (size == 0) {
+                if (count) statPageTableMisses->addData(1);
+                return false;
+            }
+            if (count) {
+                switch (size) {
+                    case ArielPageTable::PageSize4K: statPageTableHits4K->addData(1); break;
+                    case ArielPageTable::PageSize2M: statPageTableHits2M->addData(1); break;
+                    case ArielPageTable::PageSize1G: statPageTableHits1G->addData(1); break;
+                }
+            }
+
+            rangeStart = virtAddr & ~(size - 1);
+            rangeEnd = rangeStart + size;
+            physAddr = physPage + (virtAddr - rangeStart);
+            return true;
+        }
+
+        /* Drop cached translations for [start, end) from every core, e.g., after pages are remapped */
+        void invalidateTranslations(uint64_t start, uint64_t end) {
+            for (ArielTLB& tlb : translationCache) {
+                tlb.invalidate(start, end);
+            }
+        }
+
+        /* Pages are mapped into the page table in 4KiB units */
+        void checkPageSize(uint64_t pageSize) {
+            if (translationEnabled && (pageSize == 0 || pageSize % ArielPageTable::PageSize4K != 0)) {
+                output->fatal(CALL_INFO, -8, "Ariel memory manager - page size %" PRIu64 " is not a multiple of %" PRIu64 "\n",
+                        pageSize, ArielPageTable::PageSize4K);
+            }
+        }
+
+        /* Fill an RTL page map with pageSize-aligned entries from pageTable */
+        void exportPageTable(std::unordered_map<uint64_t, uint64_t>* pagetable, uint64_t pageSize) {
+            pagetable->clear();
+            pageTable.forEach([pagetable, pageSize](uint64_t virtA, uint64_t size, uint64_t physA) {
+                for (uint64_t page = (virtA + pageSize - 1) / pageSize * pageSize; page < virtA + size; page += pageSize) {
+                    pagetable->insert(std::make_pair(page, physA + (page - virtA)));
+                }
+            });
+        }
+
         void mapPagesLinear(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, std::deque<uint64_t>* freePagePool) {
             output->verbose(CALL_INFO, 2, 0, "Page mapping policy is LINEAR map...\n");
             uint64_t nextMemoryAddress = startAddr;
@@ -153,9 +264,11 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
         }
 
-        void populatePageTable(std::string popFilePath, std::unordered_map<uint64_t, uint64_t> * pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
+        /* Pin the pages listed in popFilePath, returns the number of pages pinned */
+        uint64_t populatePageTable(std::string popFilePath, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
             FILE * popFile = fopen(popFilePath.c_str(), "rt");
             uint64_t pinAddr = 0;
+            uint64_t pinned = 0;
 
             while( ! feof(popFile) ) {
                 if (EOF == fscanf(popFile, "%" PRIu64 "\n", &pinAddr)) {
@@ -177,21 +290,12 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
                 output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
                             pinAddr, freePhysical);
 
-                pageTable->insert( std::pair<uint64_t, uint64_t>( pinAddr, freePhysical ) );
+                pageTable.mapRange(pinAddr, pageSize, freePhysical);
+                pinned++;
             }
 
             fclose(popFile);
-        }
-
-        void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
-            }
-
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
+            return pinned;
         }
 
 };
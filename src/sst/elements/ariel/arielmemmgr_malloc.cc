@@ -16,6 +16,8 @@
 #include <sst_config.h>
 #include <stdio.h>
 
+#include <algorithm>
+
 #include "arielmemmgr_malloc.h"
 
 using namespace SST::ArielComponent;
@@ -31,13 +33,12 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     freePages = (std::deque<uint64_t>**) malloc(sizeof(std::deque<uint64_t>*) * memoryLevels);
     pageSizes = (uint64_t*) malloc(sizeof(uint64_t) * memoryLevels);
 
-    // PageAllocation and PageTable structures
+    // PageAllocation structures, the page table itself is shared by all levels
     pageAllocations = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    pageTables = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
     for (uint32_t i = 0; i <memoryLevels; ++i) {
         pageAllocations[i] = new std::unordered_map<uint64_t, uint64_t>();
-        pageTables[i] = new std::unordered_map<uint64_t, uint64_t>();
     }
+    demandPages.resize(memoryLevels, 0);
 
     // Initialize data structures
     size_t level_buffer_size = sizeof(char) * 256;
@@ -48,6 +49,7 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         snprintf(level_buffer, level_buffer_size, "pagesize%" PRIu32, i);
         pageSizes[i] = (uint64_t) params.find<uint64_t>(level_buffer, 4096);
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page size is %" PRIu64 "\n", i, pageSizes[i]);
+        checkPageSize(pageSizes[i]);
 
         // Page count
         snprintf(level_buffer, level_buffer_size, "pagecount%" PRIu32, i);
@@ -71,7 +73,7 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         std::string popFilePath = params.find<std::string>(level_buffer, "");
         if (popFilePath != "") {
             output->verbose(CALL_INFO, 1, 0, "Populating page tables for level %" PRIu32 " from %s...\n", i, popFilePath.c_str());
-            populatePageTable(popFilePath, pageTables[i], freePages[i], pageSizes[i]);
+            demandPages[i] += populatePageTable(popFilePath, freePages[i], pageSizes[i]);
         }
 
         /* Register statistics per pool */
@@ -82,6 +84,8 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     }
 
     free(level_buffer);
+
+    statMallocHits = registerStatistic<uint64_t>("malloc_hits");
 }
 
 ArielMemoryManagerMalloc::~ArielMemoryManagerMalloc() {
@@ -148,7 +152,8 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
         const uint64_t nextPhysPage = freePages[level]->front();
         freePages[level]->pop_front();
 
-        pageTables[level]->insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTable.mapRange(nextVirtPage, pageSize, nextPhysPage);
+        demandPages[level]++;
 
         output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
                 nextPhysPage, nextVirtPage);
@@ -177,16 +182,10 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     output->verbose(CALL_INFO, 4, 0, "Allocate malloc received. VA: %" PRIu64 ". Size: %" PRIu64 ". Level: %" PRIu32 ".\n", virtualAddress, size, level);
 
     // Check whether a malloc mapping already exists (i.e., we missed a free)
-    std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtualAddress);
-    if (it == mallocTranslations.begin()) it = mallocTranslations.end();
-    else if (!mallocTranslations.empty()) it--;
-
-    if (it != mallocTranslations.end() && it->first <= virtualAddress) {
-        uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-        if (virtualAddress < primaryAddr + (mallocInformation.find(primaryAddr)->second).size) {
-            output->verbose(CALL_INFO, 4, 0, "Found conflicting malloc, freeing address %" PRIu64 "\n", primaryAddr);
-            freeMalloc(primaryAddr);
-        }
+    uint64_t primaryAddr = virtualAddress;
+    if (findMalloc(virtualAddress, primaryAddr) || mallocInformation.find(virtualAddress) != mallocInformation.end()) {
+        output->verbose(CALL_INFO, 4, 0, "Found conflicting malloc, freeing address %" PRIu64 "\n", primaryAddr);
+        freeMalloc(primaryAddr);
     }
 
     // Allocate new page(s). Round malloc to nearest whole page TODO fix so we can map partial pages -> needs a local VA->Ariel_VA mapping
@@ -200,24 +199,20 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
     }
 
     // Allocate the pages
-    std::unordered_set<uint64_t>* virtualPages = new std::unordered_set<uint64_t>;
-    uint64_t nextVirtPage = virtualAddress;
-    uint64_t firstPhysAddr, lastPhysAddr;
-    firstPhysAddr = freePages[level]->front();
+    mallocInfo& info = mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level))).first->second;
+    info.physPages.reserve(pageCount);
     for (uint64_t i = 0; i != pageCount; i++) {
-        uint64_t nextPhysPage = freePages[level]->front();
-        mallocTranslations.insert(std::make_pair(nextVirtPage, nextPhysPage));
-        mallocPrimaryVAMap.insert(std::make_pair(nextVirtPage, virtualAddress));
+        info.physPages.push_back(freePages[level]->front());
         freePages[level]->pop_front();
-        virtualPages->insert(nextVirtPage);
-        nextVirtPage += pageSizes[level];
-        lastPhysAddr = nextPhysPage;
     }
 
-    output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, firstPhysAddr, lastPhysAddr, pageCount);
+    if (pageCount) {
+        output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, info.physPages.front(), info.physPages.back(), pageCount);
+    }
 
-    // Record malloc
-    mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
+    // Record malloc and drop stale translations for its range
+    indexMalloc(virtualAddress, size);
+    invalidateTranslations(virtualAddress, virtualAddress + size);
 
     statBytesAlloc[level]->addData(size);
     return true;
@@ -228,123 +223,180 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
     output->verbose(CALL_INFO, 4, 0, "Freeing %" PRIu64 "\n", virtualAddress);
 
     // Lookup VA in mallocInformation
-    std::map<uint64_t, mallocInfo>::iterator it = mallocInformation.find(virtualAddress);
+    std::unordered_map<uint64_t, mallocInfo>::iterator it = mallocInformation.find(virtualAddress);
     if (it == mallocInformation.end()) return;
 
-    statBytesFree[it->second.level]->addData(it->second.size);
+    const mallocInfo& info = it->second;
+    statBytesFree[info.level]->addData(info.size);
 
-    // Free each VA in mallocInformation from mallocTranslations & mallocPrimaryVAMap TODO fix so that mapping stays but address is available for future mallocs
-    std::unordered_set<uint64_t>* myKeys = (it->second.VAKeys);
-    for (std::unordered_set<uint64_t>::iterator vaIt = myKeys->begin(); vaIt != myKeys->end(); vaIt++) {
-        mallocPrimaryVAMap.erase(*vaIt);
-        freePages[(it->second).level]->push_front(mallocTranslations.find(*vaIt)->second);
-        mallocTranslations.erase(*vaIt);
+    // Return the pages to the pool TODO fix so that mapping stays but address is available for future mallocs
+    for (std::vector<uint64_t>::const_iterator pageIt = info.physPages.begin(); pageIt != info.physPages.end(); pageIt++) {
+        freePages[info.level]->push_front(*pageIt);
     }
 
-    // Remove mallocInformation entry
-    delete myKeys;
-    mallocInformation.erase(virtualAddress);
+    // Remove the mapping and any cached translations of it
+    unindexMalloc(virtualAddress, info.size);
+    invalidateTranslations(virtualAddress, virtualAddress + info.size);
+    statTranslationShootdown->addData(1);
+
+    mallocInformation.erase(it);
 }
 
 
-uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
-    // If translation is disabled, then just return address
-    if( ! translationEnabled ) {
-        return virtAddr;
+/*
+ *  Find the malloc containing virtAddr from the mallocs indexed at its 4KiB page
+ */
+bool ArielMemoryManagerMalloc::findMalloc(const uint64_t virtAddr, uint64_t& primaryAddr) {
+    uint64_t value;
+    if (!mallocIndex.find(virtAddr, value)) return false;
+
+    if (!(value & 1)) {
+        const uint64_t candidate = value >> 1;
+        if (virtAddr < candidate || virtAddr >= candidate + mallocInformation.find(candidate)->second.size) return false;
+        primaryAddr = candidate;
+        return true;
     }
 
-    // Keep track of how many translations we are performing
-    statTranslationQueries->addData(1);
-
-    uint64_t physAddr = (uint64_t) -1;
+    // Several mallocs share this page, take the latest-starting one that contains the address
     bool found = false;
-
-    output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
-
-    // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
+    const std::vector<uint64_t>& candidates = sharedMallocPages.find(virtAddr & ~(ArielPageTable::PageSize4K - 1))->second;
+    for (std::vector<uint64_t>::const_iterator it = candidates.begin(); it != candidates.end(); it++) {
+        if (virtAddr >= *it && virtAddr < *it + mallocInformation.find(*it)->second.size && (!found || *it > primaryAddr)) {
+            primaryAddr = *it;
+            found = true;
+        }
     }
+    return found;
+}
 
-    // Check malloc mappings
-    if (!mallocTranslations.empty()) {
-        std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtAddr);
-        if (it == mallocTranslations.begin()) it = mallocTranslations.end();
-        else it--;
-
-        if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
-            uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
-                uint64_t offset = virtAddr - it->first;
-                physAddr = offset + it->second;
-                found = true;
-            }
+void ArielMemoryManagerMalloc::indexMalloc(const uint64_t primaryAddr, const uint64_t size) {
+    for (uint64_t page = primaryAddr & ~(ArielPageTable::PageSize4K - 1); page < primaryAddr + size; page += ArielPageTable::PageSize4K) {
+        uint64_t value;
+        if (!mallocIndex.find(page, value)) {
+            mallocIndex.map(page, ArielPageTable::PageSize4K, primaryAddr << 1);
+        } else if (value & 1) {
+            sharedMallocPages[page].push_back(primaryAddr);
+        } else {
+            sharedMallocPages[page] = { value >> 1, primaryAddr };
+            mallocIndex.unmap(page);
+            mallocIndex.map(page, ArielPageTable::PageSize4K, 1);
         }
     }
+}
 
-    // We will have to search every memory level to find where the address lies
-    for(uint32_t i = 0; i < memoryLevels; ++i) {
-        if (!found) {
-        std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-        const uint64_t pageSize = pageSizes[i];
-            const uint64_t page_offset = virtAddr % pageSize;
-        const uint64_t page_start = virtAddr - page_offset;
+void ArielMemoryManagerMalloc::unindexMalloc(const uint64_t primaryAddr, const uint64_t size) {
+    for (uint64_t page = primaryAddr & ~(ArielPageTable::PageSize4K - 1); page < primaryAddr + size; page += ArielPageTable::PageSize4K) {
+        uint64_t value;
+        if (!mallocIndex.find(page, value)) continue;
 
-        page_itr = pageTables[i]->find(page_start);
+        if (!(value & 1)) {
+            if ((value >> 1) == primaryAddr) mallocIndex.unmap(page);
+            continue;
+        }
+
+        std::unordered_map<uint64_t, std::vector<uint64_t> >::iterator shared = sharedMallocPages.find(page);
+        std::vector<uint64_t>& candidates = shared->second;
+        candidates.erase(std::remove(candidates.begin(), candidates.end(), primaryAddr), candidates.end());
+        if (candidates.size() == 1) {
+            mallocIndex.unmap(page);
+            mallocIndex.map(page, ArielPageTable::PageSize4K, candidates.front() << 1);
+            sharedMallocPages.erase(shared);
+        }
+    }
+}
 
-            if (page_itr != pageTables[i]->end()) {
-                // Located
-            physAddr = page_itr->second + page_offset;
+/*
+ *  Shrink [rangeStart, rangeEnd) so it excludes any part of virtAddr's 4KiB page that translates
+ *  through a different malloc, i.e., any malloc for a demand-mapped address, or one that starts
+ *  later (and so takes precedence) for an address in the malloc at primaryAddr
+ */
+void ArielMemoryManagerMalloc::clipRange(const uint64_t virtAddr, const bool inMalloc, const uint64_t primaryAddr, uint64_t& rangeStart, uint64_t& rangeEnd) {
+    uint64_t value;
+    if (!mallocIndex.find(virtAddr, value)) return;
+
+    const uint64_t single = value >> 1;
+    const uint64_t* candidates = &single;
+    size_t count = 1;
+    if (value & 1) {
+        const std::vector<uint64_t>& shared = sharedMallocPages.find(virtAddr & ~(ArielPageTable::PageSize4K - 1))->second;
+        candidates = shared.data();
+        count = shared.size();
+    }
 
-                output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                    virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t start = candidates[i];
+        if (inMalloc && start <= primaryAddr) continue;
 
-            found = true;
-            break;
-        }
-        } else {
-            break;
+        const uint64_t end = start + mallocInformation.find(start)->second.size;
+        if (end <= virtAddr) {
+            rangeStart = std::max(rangeStart, end);
+        } else if (start > virtAddr) {
+            rangeEnd = std::min(rangeEnd, start);
         }
     }
+}
 
-    if(found) {
-        cacheTranslation(virtAddr, physAddr);
+uint64_t ArielMemoryManagerMalloc::walkPageTable(uint64_t virtAddr, uint64_t& rangeStart, uint64_t& rangeEnd) {
+    output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
+
+    // Check malloc mappings
+    uint64_t primaryAddr;
+    if (findMalloc(virtAddr, primaryAddr)) {
+        const mallocInfo& info = mallocInformation.find(primaryAddr)->second;
+        const uint64_t pageSize = pageSizes[info.level];
+        const uint64_t chunk = (virtAddr - primaryAddr) / pageSize;
+
+        // The translation is linear over this chunk of the malloc only
+        rangeStart = primaryAddr + chunk * pageSize;
+        rangeEnd = std::min(rangeStart + pageSize, primaryAddr + info.size);
+        clipRange(virtAddr, true, primaryAddr, rangeStart, rangeEnd);
+
+        statMallocHits->addData(1);
+        return info.physPages[chunk] + (virtAddr - rangeStart);
+    }
+
+    uint64_t physAddr;
+    if (findPage(virtAddr, physAddr, rangeStart, rangeEnd)) {
+        clipRange(virtAddr, false, 0, rangeStart, rangeEnd);
+        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys address: %" PRIu64 "\n",
+                virtAddr, rangeStart, rangeEnd, physAddr);
         return physAddr;
+    }
+
+    output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
+
+    // We did not find the address in memory, that means we should allocate it one from our default pool
+    uint64_t offset = virtAddr % pageSizes[defaultLevel];
+
+    output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
+            virtAddr, offset, (virtAddr - offset));
+
+    // Perform an allocation so we can then re-find the address
+    // Attempt defaultLevel but fall through to other levels if needed/available
+    if (canAllocateInLevel(8, defaultLevel)) {
+        allocate(8, defaultLevel, virtAddr - offset);
     } else {
-        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
-
-        // We did not find the address in memory, that means we should allocate it one from our default pool
-        uint64_t offset = virtAddr % pageSizes[defaultLevel];
-
-        output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
-                virtAddr, offset, (virtAddr - offset));
-
-        // Perform an allocation so we can then re-find the address
-        // Attempt defaultLevel but fall through to other levels if needed/available
-            if (canAllocateInLevel(8, defaultLevel)) {
-                allocate(8, defaultLevel, virtAddr - offset);
-            } else {
-                bool allocated = false;
-                for (uint32_t i = 0; i < memoryLevels; i++) {
-                    if (canAllocateInLevel(8, i)) {
-                        offset = virtAddr % pageSizes[i];
-                        allocate(8, i, virtAddr - offset);
-                        allocated = true;
-                        break;
-                    }
-                }
-                if (!allocated) output->fatal(CALL_INFO, -1, "Attempted to allocate page for address %" PRIu64 " but no free pages are available\n", virtAddr);
+        bool allocated = false;
+        for (uint32_t i = 0; i < memoryLevels; i++) {
+            if (canAllocateInLevel(8, i)) {
+                offset = virtAddr % pageSizes[i];
+                allocate(8, i, virtAddr - offset);
+                allocated = true;
+                break;
             }
+        }
+        if (!allocated) output->fatal(CALL_INFO, -1, "Attempted to allocate page for address %" PRIu64 " but no free pages are available\n", virtAddr);
+    }
 
-        // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+    // Now refind it, without counting the access again
+    uint64_t newPhysAddr;
+    if (!findPage(virtAddr, newPhysAddr, rangeStart, rangeEnd, false))
+        output->fatal(CALL_INFO, -1, "Page table has no mapping for virtual address %" PRIu64 " after allocating its page\n", virtAddr);
+    clipRange(virtAddr, false, 0, rangeStart, rangeEnd);
 
-        output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
+    output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
 
-        return newPhysAddr;
-    }
+    return newPhysAddr;
 }
 
 void ArielMemoryManagerMalloc::printStats() {
@@ -355,13 +407,13 @@ void ArielMemoryManagerMalloc::printStats() {
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand map entries at level %" PRIu32 "         %" PRIu32 "\n",
-            i, (uint32_t) pageTables[i]->size());
+            i, (uint32_t) demandPages[i]);
     }
 
     output->output("Page Table Coverages:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand bytes at level %" PRIu32 "              %" PRIu64 "\n",
-            i, ((uint64_t) pageTables[i]->size()) * ((uint64_t) pageSizes[i]));
+            i, demandPages[i] * pageSizes[i]);
     }
 }
@@ -54,7 +54,8 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 #define ARIEL_MEMMGR_MALLOC_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS, \
             { "bytes_allocated_in_pool", "Number of bytes allocated explicitly to memory pool <SubId>. Count is # of allocations", "bytes", 3 }, \
             { "bytes_freed_from_pool",     "Number of bytes freed explicitly from memory pool <SubId>. Count is # of frees", "bytes", 3}, \
-            { "demand_page_allocs",      "Number of on-demand page allocations in memory pool <SubId>", "count", 3}
+            { "demand_page_allocs",      "Number of on-demand page allocations in memory pool <SubId>", "count", 3}, \
+            { "malloc_hits",             "TLB misses resolved by a malloc mapping", "hits", 2 }
         SST_ELI_DOCUMENT_PARAMS( ARIEL_MEMMGR_MALLOC_ELI_PARAMS )
         SST_ELI_DOCUMENT_STATISTICS( ARIEL_MEMMGR_MALLOC_ELI_STATS )
 
@@ -66,26 +67,35 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         void setDefaultPool(uint32_t pool);
         uint32_t getDefaultPool();
 
-        uint64_t translateAddress(uint64_t virtAddr);
         void printStats();
 
         void freeMalloc(const uint64_t vAddr);
         bool allocateMalloc(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t thread);
 
+    protected:
+        uint64_t walkPageTable(uint64_t virtAddr, uint64_t& rangeStart, uint64_t& rangeEnd);
+
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
         bool canAllocateInLevel(const uint64_t size, const uint32_t level);
 
+        bool findMalloc(const uint64_t virtAddr, uint64_t& primaryAddr);
+        void indexMalloc(const uint64_t primaryAddr, const uint64_t size);
+        void unindexMalloc(const uint64_t primaryAddr, const uint64_t size);
+        void clipRange(const uint64_t virtAddr, const bool inMalloc, const uint64_t primaryAddr, uint64_t& rangeStart, uint64_t& rangeEnd);
+
         struct mallocInfo {
             uint64_t size;
             uint32_t level;
-            std::unordered_set<uint64_t>* VAKeys;
-            mallocInfo(uint64_t size, uint32_t level, std::unordered_set<uint64_t>* VAKeys) : size(size), level(level), VAKeys(VAKeys) {};
+            std::vector<uint64_t> physPages;    // Physical page backing each page-sized chunk of the malloc
+            mallocInfo(uint64_t size, uint32_t level) : size(size), level(level) {};
         };
 
-        std::map<uint64_t, uint64_t> mallocPrimaryVAMap;    // Map VA of each PA to the primary VA of the malloc -> used to find the mallocInfo
-        std::map<uint64_t, uint64_t> mallocTranslations;    // Map VA to PA for mallocs -> primary lookup
-        std::map<uint64_t, mallocInfo> mallocInformation;   // Map mallocID to information about the malloc -> use for frees/allocs
+        /* Mallocs overlapping each 4KiB virtual page. A leaf holds (primary VA << 1) if there is one,
+         * or 1 if there are several, which are then listed in sharedMallocPages */
+        ArielPageTable mallocIndex;
+        std::unordered_map<uint64_t, std::vector<uint64_t> > sharedMallocPages;
+        std::unordered_map<uint64_t, mallocInfo> mallocInformation;   // Map primary VA of each malloc to information about it
 
         uint32_t defaultLevel;
         uint32_t memoryLevels;
@@ -93,11 +103,12 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 
         std::deque<uint64_t>** freePages;
         std::unordered_map<uint64_t, uint64_t>** pageAllocations;
-        std::unordered_map<uint64_t, uint64_t>** pageTables;
+        std::vector<uint64_t> demandPages;      // Pages mapped into pageTable from each level
 
         std::vector<Statistic<uint64_t>* > statBytesAlloc;
         std::vector<Statistic<uint64_t>* > statBytesFree;
         std::vector<Statistic<uint64_t>* > statDemandAllocs;
+        Statistic<uint64_t>* statMallocHits;
 };
 
 }
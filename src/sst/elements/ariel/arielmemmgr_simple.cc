@@ -25,6 +25,7 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
 
     pageSize = (uint64_t) params.find<uint64_t>("pagesize0", 4096);
     output->verbose(CALL_INFO, 2, 0, "Page size is %" PRIu64 "\n", pageSize);
+    checkPageSize(pageSize);
 
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
@@ -40,7 +41,7 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     std::string popFilePath = params.find<std::string>("page_populate_0", "");
     if (popFilePath != "") {
         output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
-        populatePageTable(popFilePath, &pageTable, &freePages, pageSize);
+        populatePageTable(popFilePath, &freePages, pageSize);
     }
 
 }
@@ -77,7 +78,7 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
         const uint64_t nextPhysPage = freePages.front();
         freePages.pop_front();
 
-        pageTable.insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTable.mapRange(nextVirtPage, pageSize, nextPhysPage);
 
         output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
                 nextPhysPage, nextVirtPage);
@@ -90,63 +91,39 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
 
 }
 
-uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
-    // If translation is disabled, then just return address
-    if( ! translationEnabled ) {
-        return virtAddr;
-    }
-
+uint64_t ArielMemoryManagerSimple::walkPageTable(uint64_t virtAddr, uint64_t& rangeStart, uint64_t& rangeEnd) {
     if( output->getVerboseLevel() > 15 ) {
 	printTable();
     }
 
-    // Keep track of how many translations we are performing
-    statTranslationQueries->addData(1);
-
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
-    // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
-    }
-
-    std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-    const uint64_t page_offset = virtAddr % pageSize;
-    const uint64_t page_start = virtAddr - page_offset;
-
-    page_itr = pageTable.find(page_start);
-
-    if(page_itr != pageTable.end()) {
-        // Located
-        uint64_t physAddr = page_itr->second + page_offset;
-
-        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
-
-        cacheTranslation(virtAddr, physAddr);
+    uint64_t physAddr;
+    if (findPage(virtAddr, physAddr, rangeStart, rangeEnd)) {
+        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys address: %" PRIu64 "\n",
+                virtAddr, rangeStart, rangeEnd, physAddr);
         return physAddr;
+    }
 
-    } else {
-        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
+    output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
 
-        // We did not find the address in memory, that means we should allocate it one from our default pool
-        uint64_t offset = virtAddr % pageSize;
+    // We did not find the address in memory, that means we should allocate it one from our default pool
+    uint64_t offset = virtAddr % pageSize;
 
-        output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
-                virtAddr, offset, (virtAddr - offset));
+    output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
+            virtAddr, offset, (virtAddr - offset));
 
-        // Perform an allocation so we can then re-find the address
-        allocate(8, 0, virtAddr - offset);
+    // Perform an allocation so we can then re-find the address
+    allocate(8, 0, virtAddr - offset);
 
-        // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
+    // Now refind it, without counting the access again
+    uint64_t newPhysAddr;
+    if (!findPage(virtAddr, newPhysAddr, rangeStart, rangeEnd, false))
+        output->fatal(CALL_INFO, -1, "Page table has no mapping for virtual address %" PRIu64 " after allocating its page\n", virtAddr);
 
-        output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
+    output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
 
-        return newPhysAddr;
-    }
+    return newPhysAddr;
 }
 
 void ArielMemoryManagerSimple::printStats() {
@@ -155,13 +132,13 @@ void ArielMemoryManagerSimple::printStats() {
     output->output("---------------------------------------------------------------------\n");
     output->output("Page Table Sizes:\n");
 
-    output->output("- Map entries         %" PRIu32 "\n",
-        (uint32_t) pageTable.size());
+    output->output("- 4KiB entries        %" PRIu64 "\n", pageTable.count(ArielPageTable::PageSize4K));
+    output->output("- 2MiB entries        %" PRIu64 "\n", pageTable.count(ArielPageTable::PageSize2M));
+    output->output("- 1GiB entries        %" PRIu64 "\n", pageTable.count(ArielPageTable::PageSize1G));
 
     output->output("Page Table Coverages:\n");
 
-    output->output("- Bytes               %" PRIu64 "\n",
-        ((uint64_t) pageTable.size()) * ((uint64_t) pageSize));
+    output->output("- Bytes               %" PRIu64 "\n", pageTable.coverage());
 }
 
 void ArielMemoryManagerSimple::printTable() {
@@ -169,18 +146,18 @@ void ArielMemoryManagerSimple::printTable() {
     	output->output("---------------------------------------------------------------------\n");
 	output->verbose(CALL_INFO, 16, 0, "Page Table Map:\n");
 
-	for( auto table_itr : pageTable ) {
-		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 "\n",
-			table_itr.first, table_itr.second);
-	}
+	pageTable.forEach([this](uint64_t virtA, uint64_t size, uint64_t physA) {
+		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 " (%" PRIu64 " bytes)\n",
+			virtA, physA, size);
+	});
 
     	output->output("---------------------------------------------------------------------\n");
 
 }
 
 void ArielMemoryManagerSimple::get_page_info(std::unordered_map<uint64_t, uint64_t>* pagetable, std::deque<uint64_t>* freepages, uint64_t& pagesize) {
-    memcpy((void*)pagetable, (void*)(&pageTable), sizeof(pageTable));
-    memcpy((void*)freepages, (void*)(&freePages), sizeof(freePages)); 
+    exportPageTable(pagetable, pageSize);
+    *freepages = freePages;
     pagesize = pageSize;
 
     return;
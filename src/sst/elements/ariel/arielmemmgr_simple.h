@@ -56,18 +56,18 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         ArielMemoryManagerSimple(ComponentId_t id, Params& params);
         ~ArielMemoryManagerSimple();
 
-        uint64_t translateAddress(uint64_t virtAddr);
         void printStats();
         void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&); 
 
+    protected:
+        uint64_t walkPageTable(uint64_t virtAddr, uint64_t& rangeStart, uint64_t& rangeEnd);
+
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
 	void printTable();
 
         uint64_t pageSize;
         std::deque<uint64_t> freePages;
-
-        std::unordered_map<uint64_t, uint64_t> pageTable;
 };
 
 }
@@ -0,0 +1,321 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_PAGE_TABLE
+#define _H_SST_ARIEL_PAGE_TABLE
+
+#include <stdint.h>
+#include <string.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Multi-level radix page table used by the Ariel memory managers
+ *
+ * The layout follows x86-64: four levels of 512 entries index bits 47:12 of
+ * the virtual address. Leaves may sit at the bottom three levels and map a
+ * 4KiB, 2MiB or 1GiB page. Each leaf holds a 63-bit value; the memory managers
+ * store the physical address of the start of the page. Addresses at or above
+ * 2^48 get their own top-level table, found through a hash map.
+ *
+ * This class has no dependencies on sst-core so it can be tested standalone.
+ */
+class ArielPageTable {
+public:
+    static const uint64_t PageSize4K = 1ULL << 12;
+    static const uint64_t PageSize2M = 1ULL << 21;
+    static const uint64_t PageSize1G = 1ULL << 30;
+
+    ArielPageTable() : low(new Node()) {
+        memset(mapped, 0, sizeof(mapped));
+    }
+
+    ~ArielPageTable() {
+        release(low, 0);
+        for (auto& root : high)
+            release(root.second, 0);
+    }
+
+    ArielPageTable(const ArielPageTable&) = delete;
+    ArielPageTable& operator=(const ArielPageTable&) = delete;
+
+    /*
+     * Return the size of the page mapping vaddr and set value to its leaf value,
+     * or return 0 if vaddr is unmapped
+     */
+    uint64_t find(uint64_t vaddr, uint64_t& value) const {
+        const Node* node = root(vaddr);
+        if (!node)
+            return 0;
+        for (int level = 0; level < Levels; level++) {
+            uint64_t entry = node->entry[index(vaddr, level)];
+            if (entry & LeafBit) {
+                value = entry >> 1;
+                return 1ULL << shift(level);
+            }
+            if (!entry)
+                return 0;
+            node = reinterpret_cast<const Node*>(entry);
+        }
+        return 0;
+    }
+
+    /*
+     * Map a single 4KiB, 2MiB or 1GiB page at vaddr, which must be aligned to pageSize.
+     * Fails if any part of the page is already mapped.
+     */
+    bool map(uint64_t vaddr, uint64_t pageSize, uint64_t value) {
+        int leafLevel = levelOf(pageSize);
+        if (leafLevel < 0 || (vaddr & (pageSize - 1)))
+            return false;
+
+        Node* node = root(vaddr, true);
+        for (int level = 0; level < leafLevel; level++) {
+            uint64_t& entry = node->entry[index(vaddr, level)];
+            if (entry & LeafBit)
+                return false;
+            if (!entry)
+                entry = reinterpret_cast<uint64_t>(new Node());
+            node = reinterpret_cast<Node*>(entry);
+        }
+        uint64_t& entry = node->entry[index(vaddr, leafLevel)];
+        if (entry)
+            return false;
+        entry = (value << 1) | LeafBit;
+        mapped[leafLevel]++;
+        return true;
+    }
+
+    /*
+     * Map [vaddr, vaddr + size) onto [paddr, paddr + size) using the largest
+     * pages that both addresses are aligned to. Parts of the range that are
+     * already mapped keep their existing mapping. vaddr, paddr and size must be
+     * multiples of 4KiB.
+     */
+    void mapRange(uint64_t vaddr, uint64_t size, uint64_t paddr) {
+        while (size) {
+            uint64_t step = PageSize4K;
+            for (uint64_t pageSize : { PageSize1G, PageSize2M }) {
+                if (size >= pageSize && !((vaddr | paddr) & (pageSize - 1)) && map(vaddr, pageSize, paddr)) {
+                    step = pageSize;
+                    break;
+                }
+            }
+            if (step == PageSize4K)
+                map(vaddr, PageSize4K, paddr);
+            vaddr += step;
+            paddr += step;
+            size -= step;
+        }
+    }
+
+    /* Remove the page mapping vaddr. Page table nodes are not reclaimed. */
+    bool unmap(uint64_t vaddr) {
+        Node* node = root(vaddr);
+        if (!node)
+            return false;
+        for (int level = 0; level < Levels; level++) {
+            uint64_t& entry = node->entry[index(vaddr, level)];
+            if (entry & LeafBit) {
+                entry = 0;
+                mapped[level]--;
+                return true;
+            }
+            if (!entry)
+                return false;
+            node = reinterpret_cast<Node*>(entry);
+        }
+        return false;
+    }
+
+    /* Number of pages mapped with the given page size */
+    uint64_t count(uint64_t pageSize) const {
+        int level = levelOf(pageSize);
+        return level < 0 ? 0 : mapped[level];
+    }
+
+    /* Bytes of virtual address space mapped */
+    uint64_t coverage() const {
+        return mapped[1] * PageSize1G + mapped[2] * PageSize2M + mapped[3] * PageSize4K;
+    }
+
+    /* Call f(vaddr, pageSize, value) for every mapped page */
+    template<typename F>
+    void forEach(F f) const {
+        visit(low, 0, 0, f);
+        for (auto& root : high)
+            visit(root.second, 0, root.first << 48, f);
+    }
+
+private:
+    static const int Levels = 4;
+    static const uint64_t LeafBit = 1;
+
+    struct Node {
+        uint64_t entry[512];    // 0: empty, LeafBit set: (value << 1) | LeafBit, otherwise a Node*
+        Node() { memset(entry, 0, sizeof(entry)); }
+    };
+
+    static int shift(int level) { return 39 - 9 * level; }
+    static unsigned index(uint64_t vaddr, int level) { return (vaddr >> shift(level)) & 511; }
+
+    /* Level at which a leaf maps pageSize bytes, -1 if the size is not supported */
+    static int levelOf(uint64_t pageSize) {
+        switch (pageSize) {
+            case PageSize1G: return 1;
+            case PageSize2M: return 2;
+            case PageSize4K: return 3;
+            default: return -1;
+        }
+    }
+
+    Node* root(uint64_t vaddr, bool create = false) const {
+        if (!(vaddr >> 48))
+            return low;
+        auto it = high.find(vaddr >> 48);
+        if (it != high.end())
+            return it->second;
+        if (!create)
+            return nullptr;
+        Node* node = new Node();
+        high[vaddr >> 48] = node;
+        return node;
+    }
+
+    static void release(Node* node, int level) {
+        for (int i = 0; level < Levels - 1 && i < 512; i++) {
+            if (node->entry[i] && !(node->entry[i] & LeafBit))
+                release(reinterpret_cast<Node*>(node->entry[i]), level + 1);
+        }
+        delete node;
+    }
+
+    template<typename F>
+    static void visit(const Node* node, int level, uint64_t base, F& f) {
+        for (uint64_t i = 0; i < 512; i++) {
+            uint64_t entry = node->entry[i];
+            uint64_t vaddr = base | (i << shift(level));
+            if (entry & LeafBit)
+                f(vaddr, 1ULL << shift(level), entry >> 1);
+            else if (entry)
+                visit(reinterpret_cast<const Node*>(entry), level + 1, vaddr, f);
+        }
+    }
+
+    Node* low;                                          // Addresses below 2^48
+    mutable std::unordered_map<uint64_t, Node*> high;   // Top-level tables for higher addresses, by vaddr >> 48
+    uint64_t mapped[Levels];                            // Leaves at each level
+};
+
+/*
+ * Direct-mapped software TLB, one per core, in front of the page table
+ *
+ * Each entry caches the translation of one 4KiB virtual page as an offset from
+ * virtual to physical. An entry may cover only part of its page, so pages
+ * shared by several mallocs remapped to different physical pages can still be
+ * cached one piece at a time.
+ */
+class ArielTLB {
+public:
+    ArielTLB(uint32_t entries = 1) {
+        size_t size = 1;
+        while (size < entries)
+            size <<= 1;
+        table.resize(size);
+        mask = size - 1;
+    }
+
+    bool lookup(uint64_t vaddr, uint64_t& paddr) const {
+        const Entry& entry = table[(vaddr >> PageShift) & mask];
+        uint32_t offset = vaddr & PageMask;
+        if (entry.tag != (vaddr >> PageShift) + 1 || offset < entry.start || offset >= entry.end)
+            return false;
+        paddr = vaddr + entry.delta;
+        return true;
+    }
+
+    /*
+     * Cache the translation of vaddr to paddr for the part of vaddr's page that
+     * lies in [start, end), the virtual range over which the translation is
+     * linear. Returns true if a valid entry for another page was evicted.
+     */
+    bool insert(uint64_t vaddr, uint64_t paddr, uint64_t start, uint64_t end) {
+        Entry& entry = table[(vaddr >> PageShift) & mask];
+        const uint64_t page = vaddr & ~PageMask;
+        const bool evict = entry.tag && entry.tag != (vaddr >> PageShift) + 1;
+        entry.tag = (vaddr >> PageShift) + 1;
+        entry.delta = paddr - vaddr;
+        entry.start = start > page ? start - page : 0;
+        entry.end = (end - page) < (PageMask + 1) ? end - page : PageMask + 1;
+        return evict;
+    }
+
+    void flush() {
+        for (Entry& entry : table)
+            entry.tag = 0;
+    }
+
+    /* Drop any entries for pages overlapping [start, end) */
+    void invalidate(uint64_t start, uint64_t end) {
+        if (end <= start)
+            return;
+        const uint64_t first = start >> PageShift;
+        const uint64_t last = (end - 1) >> PageShift;
+        if (last - first >= mask) {
+            flush();
+            return;
+        }
+        for (uint64_t page = first; page <= last; page++) {
+            Entry& entry = table[page & mask];
+            if (entry.tag == page + 1)
+                entry.tag = 0;
+        }
+    }
+
+    /* Call f(vaddr, paddr) for the first address of each valid entry */
+    template<typename F>
+    void forEach(F f) const {
+        for (const Entry& entry : table) {
+            if (entry.tag) {
+                uint64_t vaddr = ((entry.tag - 1) << PageShift) + entry.start;
+                f(vaddr, vaddr + entry.delta);
+            }
+        }
+    }
+
+private:
+    static const int PageShift = 12;
+    static const uint64_t PageMask = (1ULL << PageShift) - 1;
+
+    struct Entry {
+        uint64_t tag = 0;   // Virtual page number + 1, 0 if invalid
+        uint64_t delta = 0; // Physical minus virtual address
+        uint32_t start = 0; // Valid offsets in the page
+        uint32_t end = 0;
+    };
+
+    std::vector<Entry> table;
+    uint64_t mask;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,428 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_STREAM
+#define _H_SST_ARIEL_STREAM
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Recorded Ariel command streams
+ *
+ * A stream file holds the ArielCommands each core read from the tunnel, so a
+ * run can be replayed (ariel.frontend.replay) without Pin or the application.
+ *
+ *   Header
+ *   Chunk*         { ChunkHeader, encoded commands }
+ *
+ * Each chunk holds commands for one core; a core's chunks appear in order.
+ * Commands are one command byte followed by LEB128 varint fields. Read/write
+ * addresses are zigzag-encoded deltas from the previous access on that core,
+ * reset at the start of every chunk so chunks decode independently. Write
+ * payloads are stored only if the stream was recorded with payloads.
+ * RTL and CUDA commands carry pointers into the traced process and cannot be
+ * recorded.
+ */
+class ArielStream {
+public:
+    static constexpr const char* Magic = "ARIELSTR";
+    static const uint32_t Version = 1;
+    static const uint32_t FlagPayloads = 1;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint32_t numCores;
+        uint32_t reserved;
+    };
+
+    struct ChunkHeader {
+        uint32_t core;
+        uint32_t bytes;     // Encoded commands following this header
+        uint64_t commands;
+    };
+
+    static inline uint8_t* putVarint(uint8_t* p, uint64_t v) {
+        while (v >= 0x80) {
+            *p++ = (uint8_t)(v | 0x80);
+            v >>= 7;
+        }
+        *p++ = (uint8_t) v;
+        return p;
+    }
+
+    static inline const uint8_t* getVarint(const uint8_t* p, const uint8_t* end, uint64_t* v) {
+        uint64_t result = 0;
+        for (unsigned int shift = 0; p < end && shift < 64; shift += 7) {
+            uint8_t b = *p++;
+            result |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                *v = result;
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    static inline uint64_t zigzag(int64_t v) { return ((uint64_t) v << 1) ^ (uint64_t)(v >> 63); }
+    static inline int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+};
+
+/*
+ * Records command streams. Each core encodes its commands through a cursor into
+ * a block allocated once at open; the block is written out as a chunk when it
+ * fills, so cores are interleaved in the file at chunk granularity.
+ */
+class ArielStreamWriter {
+public:
+    static const size_t ChunkBytes = 256 * 1024;
+
+    ArielStreamWriter() : fp(nullptr), payloads(false), failed(false) { }
+    ~ArielStreamWriter() { close(); }
+
+    bool open(const std::string& path, uint32_t numCores, bool withPayloads) {
+        fp = fopen(path.c_str(), "wb");
+        if (!fp)
+            return false;
+        payloads = withPayloads;
+        cores.resize(numCores);
+        for (auto& c : cores)
+            c.block.resize(ChunkBytes + MaxRecord);
+
+        ArielStream::Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, ArielStream::Magic, sizeof(header.magic));
+        header.version = ArielStream::Version;
+        header.flags = payloads ? ArielStream::FlagPayloads : 0;
+        header.numCores = numCores;
+        failed = (1 != fwrite(&header, sizeof(header), 1, fp));
+        return !failed;
+    }
+
+    bool isOpen() const { return fp != nullptr; }
+
+    /* Returns false if the command cannot be recorded */
+    bool record(uint32_t core, const ArielCommand& ac) {
+        // Blocks are flushed once ChunkBytes are used, so there is room for a whole record
+        CoreBuffer& c = cores[core];
+        uint8_t* p = c.block.data() + c.used;
+        *p++ = (uint8_t) ac.command;
+
+        switch (ac.command) {
+            case ARIEL_START_INSTRUCTION:
+                p = ArielStream::putVarint(p, ac.inst.instClass);
+                p = ArielStream::putVarint(p, ac.inst.simdElemCount);
+                break;
+            case ARIEL_PERFORM_READ:
+            case ARIEL_PERFORM_WRITE:
+                p = ArielStream::putVarint(p, ArielStream::zigzag((int64_t)(ac.inst.addr - c.lastAddr)));
+                p = ArielStream::putVarint(p, ac.inst.size);
+                c.lastAddr = ac.inst.addr;
+                if (payloads && ac.command == ARIEL_PERFORM_WRITE) {
+                    uint32_t len = std::min(ac.inst.size, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE);
+                    memcpy(p, ac.inst.payload, len);
+                    p += len;
+                }
+                break;
+            case ARIEL_ISSUE_TLM_MAP:
+                p = ArielStream::putVarint(p, ac.mlm_map.vaddr);
+                p = ArielStream::putVarint(p, ac.mlm_map.alloc_len);
+                p = ArielStream::putVarint(p, ac.mlm_map.alloc_level);
+                p = ArielStream::putVarint(p, ac.instPtr);
+                break;
+            case ARIEL_ISSUE_TLM_MMAP:
+                p = ArielStream::putVarint(p, ac.mlm_mmap.vaddr);
+                p = ArielStream::putVarint(p, ac.mlm_mmap.alloc_len);
+                p = ArielStream::putVarint(p, ac.mlm_mmap.alloc_level);
+                p = ArielStream::putVarint(p, ac.mlm_mmap.fileID);
+                p = ArielStream::putVarint(p, ac.instPtr);
+                break;
+            case ARIEL_ISSUE_TLM_FREE:
+                p = ArielStream::putVarint(p, ac.mlm_free.vaddr);
+                break;
+            case ARIEL_SWITCH_POOL:
+                p = ArielStream::putVarint(p, ac.switchPool.pool);
+                break;
+            case ARIEL_FLUSHLINE_INSTRUCTION:
+                p = ArielStream::putVarint(p, ac.flushline.vaddr);
+                break;
+            case ARIEL_END_INSTRUCTION:
+            case ARIEL_NOOP:
+            case ARIEL_FENCE_INSTRUCTION:
+            case ARIEL_PERFORM_EXIT:
+            case ARIEL_OUTPUT_STATS:
+                break;
+            default:
+                return false;
+        }
+        c.used = p - c.block.data();
+        c.commands++;
+
+        if (c.used >= ChunkBytes)
+            flush(core);
+        return true;
+    }
+
+    /* Write out all buffered commands and close the file. Returns false if any write failed */
+    bool close() {
+        if (!fp)
+            return !failed;
+        for (uint32_t core = 0; core < cores.size(); core++)
+            flush(core);
+        failed |= (0 != fclose(fp));
+        fp = nullptr;
+        return !failed;
+    }
+
+private:
+    /* Largest encoded command: command byte, five 10-byte varints or two plus a payload */
+    static const size_t MaxRecord = 1 + 5 * 10 + ARIEL_MAX_PAYLOAD_SIZE;
+
+    struct CoreBuffer {
+        CoreBuffer() : used(0), commands(0), lastAddr(0) { }
+        std::vector<uint8_t> block;     // ChunkBytes + MaxRecord, allocated at open
+        size_t used;                    // Encoded bytes in block
+        uint64_t commands;
+        uint64_t lastAddr;
+    };
+
+    void flush(uint32_t core) {
+        CoreBuffer& c = cores[core];
+        if (c.commands == 0)
+            return;
+        ArielStream::ChunkHeader chunk;
+        chunk.core = core;
+        chunk.bytes = c.used;
+        chunk.commands = c.commands;
+        failed |= (1 != fwrite(&chunk, sizeof(chunk), 1, fp));
+        failed |= (1 != fwrite(c.block.data(), c.used, 1, fp));
+        c.used = 0;
+        c.commands = 0;
+        c.lastAddr = 0;
+    }
+
+    FILE* fp;
+    bool payloads;
+    bool failed;
+    std::vector<CoreBuffer> cores;
+};
+
+/*
+ * Reads a stream file through a read-only mapping. Cursors decode one core's
+ * commands in order and ask the kernel to read ahead the next chunks.
+ */
+class ArielStreamReader {
+public:
+    ArielStreamReader() : base(nullptr), size(0), header() { }
+    ~ArielStreamReader() {
+        if (base)
+            munmap(base, size);
+    }
+
+    /* Returns an error message, or an empty string on success */
+    std::string open(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return "unable to open " + path;
+        struct stat st;
+        if (0 != fstat(fd, &st) || (size_t) st.st_size < sizeof(ArielStream::Header)) {
+            ::close(fd);
+            return path + " is not an Ariel stream";
+        }
+        size = st.st_size;
+        base = (uint8_t*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            return "unable to map " + path;
+        }
+        madvise(base, size, MADV_SEQUENTIAL);
+
+        memcpy(&header, base, sizeof(header));
+        if (0 != memcmp(header.magic, ArielStream::Magic, sizeof(header.magic)))
+            return path + " is not an Ariel stream";
+        if (header.version != ArielStream::Version)
+            return path + " has an unsupported stream version";
+
+        chunks.resize(header.numCores);
+        size_t offset = sizeof(header);
+        while (offset < size) {
+            ArielStream::ChunkHeader chunk;
+            if (size - offset < sizeof(chunk))
+                return path + " is truncated";
+            memcpy(&chunk, base + offset, sizeof(chunk));
+            offset += sizeof(chunk);
+            if (chunk.core >= header.numCores || size - offset < chunk.bytes)
+                return path + " is corrupt or truncated";
+            chunks[chunk.core].push_back(offset);
+            offset += chunk.bytes;
+        }
+        return "";
+    }
+
+    uint32_t getNumCores() const { return header.numCores; }
+    bool hasPayloads() const { return header.flags & ArielStream::FlagPayloads; }
+
+    class Cursor {
+    public:
+        Cursor(const ArielStreamReader* r, uint32_t coreID, size_t readAheadChunks) :
+            reader(r), core(coreID), readAhead(readAheadChunks), nextChunk(0), p(nullptr), end(nullptr), lastAddr(0), error(false) { }
+
+        /* Returns false at the end of the stream or if the stream is corrupt (see hasError()) */
+        bool next(ArielCommand* ac) {
+            while (p == end) {
+                if (!startChunk())
+                    return false;
+            }
+            uint8_t cmd = *p++;
+            uint64_t a, b, c, d, e;
+            ac->command = (ArielShmemCmd_t) cmd;
+            switch (cmd) {
+                case ARIEL_START_INSTRUCTION:
+                    if (!get(&a) || !get(&b)) return false;
+                    ac->inst.instClass = a;
+                    ac->inst.simdElemCount = b;
+                    break;
+                case ARIEL_PERFORM_READ:
+                case ARIEL_PERFORM_WRITE:
+                    if (!get(&a) || !get(&b)) return false;
+                    lastAddr += ArielStream::unzigzag(a);
+                    ac->inst.addr = lastAddr;
+                    ac->inst.size = b;
+                    if (cmd == ARIEL_PERFORM_WRITE && reader->hasPayloads()) {
+                        size_t len = std::min(b, (uint64_t) ARIEL_MAX_PAYLOAD_SIZE);
+                        if ((size_t)(end - p) < len) return fail();
+                        memcpy(ac->inst.payload, p, len);
+                        p += len;
+                    }
+                    break;
+                case ARIEL_ISSUE_TLM_MAP:
+                    if (!get(&a) || !get(&b) || !get(&c) || !get(&d)) return false;
+                    ac->mlm_map.vaddr = a;
+                    ac->mlm_map.alloc_len = b;
+                    ac->mlm_map.alloc_level = c;
+                    ac->instPtr = d;
+                    break;
+                case ARIEL_ISSUE_TLM_MMAP:
+                    if (!get(&a) || !get(&b) || !get(&c) || !get(&d) || !get(&e)) return false;
+                    ac->mlm_mmap.vaddr = a;
+                    ac->mlm_mmap.alloc_len = b;
+                    ac->mlm_mmap.alloc_level = c;
+                    ac->mlm_mmap.fileID = d;
+                    ac->instPtr = e;
+                    break;
+                case ARIEL_ISSUE_TLM_FREE:
+                    if (!get(&a)) return false;
+                    ac->mlm_free.vaddr = a;
+                    break;
+                case ARIEL_SWITCH_POOL:
+                    if (!get(&a)) return false;
+                    ac->switchPool.pool = a;
+                    break;
+                case ARIEL_FLUSHLINE_INSTRUCTION:
+                    if (!get(&a)) return false;
+                    ac->flushline.vaddr = a;
+                    break;
+                case ARIEL_END_INSTRUCTION:
+                case ARIEL_NOOP:
+                case ARIEL_FENCE_INSTRUCTION:
+                case ARIEL_PERFORM_EXIT:
+                case ARIEL_OUTPUT_STATS:
+                    break;
+                default:
+                    return fail();
+            }
+            return true;
+        }
+
+        bool hasError() const { return error; }
+
+    private:
+        bool startChunk() {
+            const std::vector<size_t>& list = reader->chunks[core];
+            if (nextChunk >= list.size())
+                return false;
+            /* Ask for the chunk 'readAhead' chunks from now so it is resident when we get to it */
+            if (readAhead && nextChunk + readAhead < list.size())
+                reader->willNeed(list[nextChunk + readAhead]);
+            size_t offset = list[nextChunk++];
+            ArielStream::ChunkHeader chunk;
+            memcpy(&chunk, reader->base + offset - sizeof(chunk), sizeof(chunk));
+            p = reader->base + offset;
+            end = p + chunk.bytes;
+            lastAddr = 0;
+            return true;
+        }
+
+        bool get(uint64_t* v) {
+            p = ArielStream::getVarint(p, end, v);
+            return p ? true : fail();
+        }
+
+        bool fail() {
+            error = true;
+            p = end = nullptr;
+            nextChunk = reader->chunks[core].size();
+            return false;
+        }
+
+        const ArielStreamReader* reader;
+        uint32_t core;
+        size_t readAhead;
+        size_t nextChunk;
+        const uint8_t* p;
+        const uint8_t* end;
+        uint64_t lastAddr;
+        bool error;
+    };
+
+    Cursor getCursor(uint32_t core, size_t readAheadChunks) const { return Cursor(this, core, readAheadChunks); }
+
+private:
+    void willNeed(size_t offset) const {
+        ArielStream::ChunkHeader chunk;
+        memcpy(&chunk, base + offset - sizeof(chunk), sizeof(chunk));
+        size_t page = sysconf(_SC_PAGESIZE);
+        size_t start = offset & ~(page - 1);
+        madvise(base + start, offset + chunk.bytes - start, MADV_WILLNEED);
+    }
+
+    uint8_t* base;
+    size_t size;
+    ArielStream::Header header;
+    std::vector<std::vector<size_t> > chunks;  // Per core, offsets of chunk data
+};
+
+}
+}
+
+#endif
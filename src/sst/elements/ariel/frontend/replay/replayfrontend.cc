@@ -0,0 +1,144 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+
+using namespace SST::ArielComponent;
+
+ReplayFrontend::ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool), running(0), sawExit(false), exitSent(false) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+    readahead = params.find<size_t>("readahead", 4);
+
+    std::string streamfile = params.find<std::string>("streamfile", "");
+    if ("" == streamfile) {
+        output->fatal(CALL_INFO, -1, "The input deck did not specify a streamfile to replay\n");
+    }
+
+    std::string error = stream.open(streamfile);
+    if ("" != error) {
+        output->fatal(CALL_INFO, -1, "Error: cannot replay stream: %s\n", error.c_str());
+    }
+    if (stream.getNumCores() > core_count) {
+        output->fatal(CALL_INFO, -1, "Error: stream %s was recorded with %" PRIu32 " cores but only %" PRIu32 " are configured\n",
+                streamfile.c_str(), stream.getNumCores(), core_count);
+    }
+    output->verbose(CALL_INFO, 1, 0, "Replaying %" PRIu32 " core streams from %s (write payloads %s)\n",
+            stream.getNumCores(), streamfile.c_str(), stream.hasPayloads() ? "recorded" : "not recorded");
+
+    // One slot of each tunnel buffer is always left empty
+    capacity = maxCoreQueueLen - 1;
+    if (capacity == 0) {
+        output->fatal(CALL_INFO, -1, "Error: maxcorequeue must be at least 2 to replay a stream\n");
+    }
+
+    for (uint32_t core = 0; core < stream.getNumCores(); core++)
+        cores.emplace_back(stream.getCursor(core, readahead));
+    running = stream.getNumCores();
+
+    tunnelmgr = new SST::Core::Interprocess::MMAPParent<ArielTunnel>(id, core_count, maxCoreQueueLen);
+    tunnel = tunnelmgr->getTunnel();
+}
+
+ReplayFrontend::~ReplayFrontend() {
+    delete tunnelmgr;
+}
+
+void ReplayFrontend::init(unsigned int phase) { }
+
+void ReplayFrontend::emergencyShutdown() {
+    delete tunnelmgr; // Clean up tmp file
+    tunnelmgr = nullptr;
+}
+
+ArielTunnel* ReplayFrontend::getTunnel() {
+    return tunnel;
+}
+
+bool ReplayFrontend::send(uint32_t core, const ArielCommand& ac) {
+    return tunnel->writeMessageNB(core, &ac);
+}
+
+/*
+ * Decode the core's next instruction (START_INSTRUCTION through END_INSTRUCTION)
+ * or single command into its group. The core reads the middle of an instruction
+ * with a blocking read, so an instruction is only ever queued whole.
+ * Returns false once the stream has ended.
+ */
+bool ReplayFrontend::decodeGroup(uint32_t core) {
+    CoreStream& cs = cores[core];
+    if (cs.done)
+        return false;
+
+    ArielCommand ac;
+    do {
+        memset(&ac, 0, sizeof(ac));
+        if (!cs.cursor.next(&ac)) {
+            if (cs.cursor.hasError() || !cs.group.empty()) {
+                output->fatal(CALL_INFO, -1, "Error: stream for core %" PRIu32 " is corrupt after %" PRIu64 " commands\n", core, cs.count);
+            }
+            output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " stream complete after %" PRIu64 " commands\n", core, cs.count);
+            cs.done = true;
+            running--;
+            return false;
+        }
+        if (ac.command == ARIEL_PERFORM_EXIT)
+            sawExit = true;
+        cs.group.push_back(ac);
+        cs.count++;
+    } while (cs.group.front().command == ARIEL_START_INSTRUCTION && ac.command != ARIEL_END_INSTRUCTION);
+
+    if (cs.group.size() > capacity) {
+        output->fatal(CALL_INFO, -1, "Error: an instruction on core %" PRIu32 " has %zu commands but the tunnel only holds %zu. Increase maxcorequeue.\n",
+                core, cs.group.size(), capacity);
+    }
+    return true;
+}
+
+/* The core's tunnel is empty, so there is room for 'capacity' commands */
+void ReplayFrontend::refill(uint32_t core) {
+    size_t space = capacity;
+
+    if (core < cores.size()) {
+        CoreStream& cs = cores[core];
+        while (!cs.group.empty() || decodeGroup(core)) {
+            if (cs.group.size() > space)
+                break;
+            for (const ArielCommand& ac : cs.group) {
+                if (!send(core, ac)) {
+                    output->fatal(CALL_INFO, -1, "Error: tunnel for core %" PRIu32 " is full while replaying\n", core);
+                }
+            }
+            space -= cs.group.size();
+            cs.group.clear();
+        }
+    }
+
+    // A stream recorded from a run that was cut short has no exit. End the
+    // simulation on core 0 once every core's stream has been queued.
+    if (core == 0 && 0 == running && !sawExit && !exitSent && space > 0) {
+        output->verbose(CALL_INFO, 1, 0, "No exit was recorded, ending replay on core 0\n");
+        ArielCommand ac;
+        memset(&ac, 0, sizeof(ac));
+        ac.command = ARIEL_PERFORM_EXIT;
+        exitSent = send(0, ac);
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/params.h>
+#include <sst/core/interprocess/mmapparent.h>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "ariel_shmem.h"
+#include "arielstream.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Replays a command stream recorded with the ariel 'recordfile' parameter.
+ * Commands are decoded on the simulation thread: each time a core finds its
+ * tunnel empty, refill() decodes that core's next commands from the mapped
+ * file and queues as many whole instructions as the tunnel holds.
+ */
+class ReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT(ReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend that replays a recorded command stream instead of running Pin", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"streamfile", "Command stream to replay, written by an ariel run with 'recordfile' set", ""},
+        {"readahead", "Number of stream chunks (256KiB each) per core to ask the OS to read ahead", "4"})
+
+        /* Ariel class */
+        ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+        ~ReplayFrontend();
+        virtual void emergencyShutdown();
+        virtual void init(unsigned int phase);
+        virtual void setup() {}
+        virtual ArielTunnel* getTunnel();
+        virtual void refill(uint32_t core);
+
+    private:
+        /* Decode stream state for one core */
+        struct CoreStream {
+            CoreStream(const ArielStreamReader::Cursor& c) : cursor(c), count(0), done(false) { }
+
+            ArielStreamReader::Cursor cursor;
+            std::vector<ArielCommand> group;    // Next instruction, waiting for room in the tunnel
+            uint64_t count;                     // Commands decoded
+            bool done;                          // Stream has ended
+        };
+
+        bool decodeGroup(uint32_t core);
+        bool send(uint32_t core, const ArielCommand& ac);
+
+        SST::Output* output;
+
+        uint32_t core_count;
+        size_t readahead;
+        size_t capacity;                    // Commands the tunnel holds per core
+        SST::Core::Interprocess::MMAPParent<ArielTunnel>* tunnelmgr;
+        ArielTunnel* tunnel;
+
+        ArielStreamReader stream;
+        std::vector<CoreStream> cores;
+        uint32_t running;                   // Core streams that have not ended
+        bool sawExit;                       // Some core's stream ended the program
+        bool exitSent;                      // Queued the exit for a stream without one
+};
+
+}
+}
+
+#endif
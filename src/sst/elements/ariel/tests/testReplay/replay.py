@@ -0,0 +1,96 @@
+import sst
+import sys
+
+# Replays a recorded Ariel command stream, no Pin needed
+# Usage: --model-options="<streamfile> [<recordfile>]"
+#   recordfile: record the replayed commands again, for round-trip tests
+
+if len(sys.argv) < 2:
+    print("ERROR: {0} requires the stream file to replay".format(sys.argv[0]))
+    sys.exit(1)
+
+streamfile = sys.argv[1]
+recordfile = sys.argv[2] if len(sys.argv) > 2 else ""
+
+corecount = 2
+
+sst.setProgramOption("timebase", "1ps")
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "0",
+        "corecount" : corecount,
+        "maxcorequeue" : "256",
+        "maxissuepercycle" : "2",
+        "recordfile" : recordfile,
+})
+
+frontend = ariel.setSubComponent("frontend", "ariel.frontend.replay")
+frontend.addParams({
+        "streamfile" : streamfile,
+})
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+memmgr.addParams({
+        "translatecacheentries" : "16",
+})
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({
+        "bus_frequency" : "2 Ghz",
+})
+
+for core in range(corecount):
+    l1cache = sst.Component("l1cache_" + str(core), "memHierarchy.Cache")
+    l1cache.addParams({
+            "cache_frequency" : "2 Ghz",
+            "cache_size" : "16 KB",
+            "coherence_protocol" : "MESI",
+            "replacement_policy" : "lru",
+            "associativity" : "4",
+            "access_latency_cycles" : "1",
+            "cache_line_size" : "64",
+            "L1" : "1",
+    })
+
+    cpu_cache_link = sst.Link("cpu_cache_link_" + str(core))
+    cpu_cache_link.connect( (ariel, "cache_link_" + str(core), "50ps"), (l1cache, "high_network_0", "50ps") )
+
+    cache_bus_link = sst.Link("cache_bus_link_" + str(core))
+    cache_bus_link.connect( (l1cache, "low_network_0", "50ps"), (bus, "high_network_" + str(core), "50ps") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+        "clock" : "1GHz",
+        "addr_range_end" : 512*1024*1024-1,
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+        "access_time" : "10ns",
+        "mem_size" : "512MiB",
+})
+
+memory_link = sst.Link("mem_bus_link")
+memory_link.connect( (bus, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticLoadLevel(5)
+sst.setStatisticOutput("sst.statOutputConsole")
+
+ariel.enableStatistics([
+      "instruction_count",
+      "read_requests",
+      "write_requests",
+])
+
+memmgr.enableStatistics([
+      "tlb_translate_queries",
+      "tlb_hits",
+      "tlb_evicts",
+      "tlb_page_allocs",
+      "tlb_shootdown",
+      "pagetable_hits_4k",
+      "pagetable_hits_2m",
+      "pagetable_hits_1g",
+      "pagetable_misses",
+])
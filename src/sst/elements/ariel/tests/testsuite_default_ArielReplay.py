@@ -0,0 +1,91 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+import filecmp
+import os
+import re
+
+
+class testcase_ArielReplay(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        # Put test based setup code here. it is called once before every test
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+    # testReplay/replay.stream was recorded with ArielStreamWriter and needs
+    # neither Pin nor an application. Core 0 makes two passes over 32 pages,
+    # core 1 one pass over the first 8, with three reads and a write per page.
+    # With 16-entry TLBs the page table allocates each of the 32 pages once and
+    # resolves the other 40 TLB misses (32 on core 0's second pass, 8 on core 1).
+    def test_Ariel_replay_round_trip(self):
+        self.ariel_replay_template("replay")
+
+#####
+
+    def ariel_replay_template(self, testcase, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        replaydir = "{0}/testReplay".format(test_path)
+        sdlfile = "{0}/{1}.py".format(replaydir, testcase)
+        streamfile = "{0}/{1}.stream".format(replaydir, testcase)
+        reffile = "{0}/ref/{1}_stats.out".format(replaydir, testcase)
+        recordfile = "{0}/test_Ariel_{1}.stream".format(tmpdir, testcase)
+        outfile = "{0}/test_Ariel_{1}.out".format(outdir, testcase)
+        errfile = "{0}/test_Ariel_{1}.err".format(outdir, testcase)
+        mpioutfiles = "{0}/test_Ariel_{1}.testfile".format(outdir, testcase)
+
+        if os.path.exists(recordfile):
+            os.remove(recordfile)
+
+        otherargs = '--model-options=\"{0} {1}\"'.format(streamfile, recordfile)
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs,
+                     mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        testing_remove_component_warning_from_file(outfile)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        # Recording the replayed commands must reproduce the stream byte for byte
+        self.assertTrue(os.path.isfile(recordfile), "Replay did not record {0}".format(recordfile))
+        self.assertTrue(filecmp.cmp(streamfile, recordfile, shallow=False),
+                "Stream recorded during replay {0} differs from the replayed stream {1}".format(recordfile, streamfile))
+
+        # Statistic sums over all cores must match the reference
+        ref = self._readReference(reffile)
+        out = self._readStatSums(outfile, ref.keys())
+        diffs = ["{0}: expected {1}, got {2}".format(name, ref[name], out.get(name)) for name in ref if out.get(name) != ref[name]]
+        self.assertFalse(diffs, "Statistics in {0} differ from {1}:\n{2}".format(outfile, reffile, "\n".join(diffs)))
+
+    def _readReference(self, reffile):
+        ref = {}
+        with open(reffile, 'r') as fp:
+            for line in fp:
+                fields = line.split()
+                if len(fields) == 2:
+                    ref[fields[0]] = int(fields[1])
+        return ref
+
+    # Sum each named statistic over every component, subcomponent and core reporting it
+    def _readStatSums(self, outfile, names):
+        sums = {}
+        statline = re.compile(r"\s*(\S+) : Accumulator : Sum.u64 = (\d+);")
+        with open(outfile, 'r') as fp:
+            for line in fp:
+                m = statline.match(line)
+                if not m:
+                    continue
+                fields = re.split(r"[.:]", m.group(1))
+                for name in names:
+                    if name in fields:
+                        sums[name] = sums.get(name, 0) + int(m.group(2))
+        return sums
@@ -0,0 +1,260 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Ariel core event queue microbenchmark
+ *
+ * Replays a stream of ArielCommands through the decode/enqueue/dispatch path
+ * that ArielCore::refillQueue() and ArielCore::processNextEvent() use, once with
+ * heap-allocated ArielEvents in a std::queue (the previous implementation) and
+ * once with the ArielEventRing, and reports events per second for each.
+ * Memory translation and issue are not modeled so the queue cost dominates.
+ *
+ * The stream is either a file of raw ArielCommand records, as they appear in
+ * the tunnel, or a synthetic read/write/noop mix.
+ *
+ * Usage: queuebench [-f stream] [-n commands] [-q maxcorequeue] [-r repeats]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "ariel_shmem.h"
+#include "arieleventring.h"
+#include "arielreadev.h"
+#include "arielwriteev.h"
+#include "arielnoop.h"
+#include "arielexitev.h"
+#include "arielallocev.h"
+#include "arielfreeev.h"
+#include "arielswitchpool.h"
+#include "arielfenceev.h"
+
+using namespace SST::ArielComponent;
+
+/* Consumer state so the dispatch loops cannot be optimized away */
+struct Sink {
+    uint64_t events = 0;
+    uint64_t bytes = 0;
+    uint64_t check = 0;
+
+    void access(uint64_t addr, uint32_t size, const uint8_t* payload) {
+        events++;
+        bytes += size;
+        check += addr ^ (payload ? payload[0] : 0);
+    }
+    void other(uint64_t value) {
+        events++;
+        check += value;
+    }
+};
+
+static std::vector<ArielCommand> loadStream(const char* path) {
+    std::vector<ArielCommand> stream;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "Error: unable to open %s\n", path);
+        exit(1);
+    }
+    ArielCommand ac;
+    while (1 == fread(&ac, sizeof(ac), 1, fp))
+        stream.push_back(ac);
+    fclose(fp);
+    return stream;
+}
+
+/* Instructions with one to three memory operations, separated by no-ops */
+static std::vector<ArielCommand> makeStream(size_t count) {
+    std::vector<ArielCommand> stream;
+    std::mt19937_64 rng(1);
+    ArielCommand ac;
+    memset(&ac, 0, sizeof(ac));
+    while (stream.size() < count) {
+        if (rng() % 4 == 0) {
+            ac.command = ARIEL_NOOP;
+            stream.push_back(ac);
+            continue;
+        }
+        ac.command = ARIEL_START_INSTRUCTION;
+        ac.inst.instClass = 0;
+        ac.inst.simdElemCount = 1;
+        stream.push_back(ac);
+        for (int ops = 1 + rng() % 3; ops > 0; ops--) {
+            ac.command = (rng() % 3) ? ARIEL_PERFORM_READ : ARIEL_PERFORM_WRITE;
+            ac.inst.addr = (rng() % (1 << 26)) & ~7ULL;
+            ac.inst.size = 8;
+            memset(ac.inst.payload, (int) ac.inst.addr, 8);
+            stream.push_back(ac);
+        }
+        ac.command = ARIEL_END_INSTRUCTION;
+        stream.push_back(ac);
+    }
+    return stream;
+}
+
+/* Previous implementation: one heap-allocated, polymorphic event per operation */
+static void runHeap(const std::vector<ArielCommand>& stream, uint32_t maxQLength, Sink& sink) {
+    std::queue<ArielEvent*> coreQ;
+    size_t next = 0;
+    while (next < stream.size()) {
+        while (coreQ.size() < maxQLength && next < stream.size()) {
+            const ArielCommand& ac = stream[next++];
+            switch (ac.command) {
+                case ARIEL_START_INSTRUCTION:
+                    while (next < stream.size() && stream[next].command != ARIEL_END_INSTRUCTION) {
+                        const ArielCommand& op = stream[next++];
+                        if (op.command == ARIEL_PERFORM_READ)
+                            coreQ.push(new ArielReadEvent(op.inst.addr, op.inst.size));
+                        else
+                            coreQ.push(new ArielWriteEvent(op.inst.addr, op.inst.size, op.inst.payload));
+                    }
+                    next++;
+                    break;
+                case ARIEL_NOOP: coreQ.push(new ArielNoOpEvent()); break;
+                case ARIEL_FENCE_INSTRUCTION: coreQ.push(new ArielFenceEvent()); break;
+                case ARIEL_ISSUE_TLM_MAP: coreQ.push(new ArielAllocateEvent(ac.mlm_map.vaddr, ac.mlm_map.alloc_len, ac.mlm_map.alloc_level, ac.instPtr)); break;
+                case ARIEL_ISSUE_TLM_FREE: coreQ.push(new ArielFreeEvent(ac.mlm_free.vaddr)); break;
+                case ARIEL_SWITCH_POOL: coreQ.push(new ArielSwitchPoolEvent(ac.switchPool.pool)); break;
+                case ARIEL_PERFORM_EXIT: coreQ.push(new ArielExitEvent()); break;
+                default: break;
+            }
+        }
+        while (!coreQ.empty()) {
+            ArielEvent* ev = coreQ.front();
+            switch (ev->getEventType()) {
+                case READ_ADDRESS: {
+                    ArielReadEvent* rEv = dynamic_cast<ArielReadEvent*>(ev);
+                    sink.access(rEv->getAddress(), rEv->getLength(), nullptr);
+                    break;
+                }
+                case WRITE_ADDRESS: {
+                    ArielWriteEvent* wEv = dynamic_cast<ArielWriteEvent*>(ev);
+                    sink.access(wEv->getAddress(), wEv->getLength(), wEv->getPayload());
+                    break;
+                }
+                case MALLOC: sink.other(dynamic_cast<ArielAllocateEvent*>(ev)->getVirtualAddress()); break;
+                case FREE: sink.other(dynamic_cast<ArielFreeEvent*>(ev)->getVirtualAddress()); break;
+                case SWITCH_POOL: sink.other(dynamic_cast<ArielSwitchPoolEvent*>(ev)->getPool()); break;
+                default: sink.other(0); break;
+            }
+            coreQ.pop();
+            delete ev;
+        }
+    }
+}
+
+/* Current implementation: inline records in a per-core ring */
+static void runRing(const std::vector<ArielCommand>& stream, uint32_t maxQLength, Sink& sink) {
+    ArielEventRing coreQ;
+    coreQ.reserve(maxQLength);
+    size_t next = 0;
+    while (next < stream.size()) {
+        while (coreQ.size() < maxQLength && next < stream.size()) {
+            const ArielCommand& ac = stream[next++];
+            switch (ac.command) {
+                case ARIEL_START_INSTRUCTION:
+                    while (next < stream.size() && stream[next].command != ARIEL_END_INSTRUCTION) {
+                        const ArielCommand& op = stream[next++];
+                        ArielEventRecord& ev = coreQ.push(op.command == ARIEL_PERFORM_READ ? READ_ADDRESS : WRITE_ADDRESS);
+                        ev.addr = op.inst.addr;
+                        ev.length = op.inst.size;
+                        if (op.command == ARIEL_PERFORM_WRITE)
+                            memcpy(ev.payload, op.inst.payload, std::min(op.inst.size, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE));
+                    }
+                    next++;
+                    break;
+                case ARIEL_NOOP: coreQ.push(NOOP); break;
+                case ARIEL_FENCE_INSTRUCTION: coreQ.push(FENCE); break;
+                case ARIEL_ISSUE_TLM_MAP: {
+                    ArielEventRecord& ev = coreQ.push(MALLOC);
+                    ev.addr = ac.mlm_map.vaddr;
+                    ev.allocLength = ac.mlm_map.alloc_len;
+                    ev.length = ac.mlm_map.alloc_level;
+                    ev.instPtr = ac.instPtr;
+                    break;
+                }
+                case ARIEL_ISSUE_TLM_FREE: coreQ.push(FREE).addr = ac.mlm_free.vaddr; break;
+                case ARIEL_SWITCH_POOL: coreQ.push(SWITCH_POOL).length = ac.switchPool.pool; break;
+                case ARIEL_PERFORM_EXIT: coreQ.push(CORE_EXIT); break;
+                default: break;
+            }
+        }
+        while (!coreQ.empty()) {
+            ArielEventRecord& ev = coreQ.front();
+            switch (ev.type) {
+                case READ_ADDRESS: sink.access(ev.addr, ev.length, nullptr); break;
+                case WRITE_ADDRESS: sink.access(ev.addr, ev.length, ev.payload); break;
+                case MALLOC: sink.other(ev.addr); break;
+                case FREE: sink.other(ev.addr); break;
+                case SWITCH_POOL: sink.other(ev.length); break;
+                default: sink.other(0); break;
+            }
+            coreQ.pop();
+        }
+    }
+}
+
+template<typename F>
+static void measure(const char* name, F run, int repeats) {
+    double best = 0;
+    Sink sink;
+    for (int i = 0; i < repeats; i++) {
+        sink = Sink();
+        auto start = std::chrono::steady_clock::now();
+        run(sink);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, sink.events / elapsed.count());
+    }
+    printf("%-6s %12" PRIu64 " events %14.0f events/s (checksum %" PRIx64 ")\n", name, sink.events, best, sink.check);
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = nullptr;
+    size_t count = 10000000;
+    uint32_t maxQLength = 64;
+    int repeats = 3;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:q:r:")) != -1) {
+        switch (opt) {
+            case 'f': path = optarg; break;
+            case 'n': count = strtoull(optarg, nullptr, 0); break;
+            case 'q': maxQLength = strtoul(optarg, nullptr, 0); break;
+            case 'r': repeats = atoi(optarg); break;
+            default:
+                fprintf(stderr, "Usage: %s [-f stream] [-n commands] [-q maxcorequeue] [-r repeats]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (maxQLength == 0 || repeats < 1) {
+        fprintf(stderr, "Error: -q and -r must be at least 1\n");
+        return 1;
+    }
+
+    std::vector<ArielCommand> stream = path ? loadStream(path) : makeStream(count);
+    printf("Replaying %zu commands, maxcorequeue=%" PRIu32 "\n", stream.size(), maxQLength);
+
+    measure("heap", [&](Sink& s) { runHeap(stream, maxQLength, s); }, repeats);
+    measure("ring", [&](Sink& s) { runRing(stream, maxQLength, s); }, repeats);
+    return 0;
+}
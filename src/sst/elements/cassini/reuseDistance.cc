@@ -0,0 +1,282 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "reuseDistance.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+
+#include "sst/core/params.h"
+#include <sst/core/unitAlgebra.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+/* Human-readable cache size for statistic names and the CSV file */
+static std::string sizeName(uint64_t bytes) {
+    char name[32];
+    if (bytes % (1ULL << 30) == 0)
+        snprintf(name, sizeof(name), "%" PRIu64 "GiB", bytes >> 30);
+    else if (bytes % (1ULL << 20) == 0)
+        snprintf(name, sizeof(name), "%" PRIu64 "MiB", bytes >> 20);
+    else if (bytes % (1ULL << 10) == 0)
+        snprintf(name, sizeof(name), "%" PRIu64 "KiB", bytes >> 10);
+    else
+        snprintf(name, sizeof(name), "%" PRIu64 "B", bytes);
+    return name;
+}
+
+ReuseDistance::ReuseDistance(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    int verbosity = params.find<int>("verbose", 0);
+    output = new Output("ReuseDistance[@f:@l:@p] ", verbosity, 0, Output::STDOUT);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    maxTracked = params.find<uint32_t>("max_tracked_lines", 16384);
+    double rate = params.find<double>("sample_rate", 1.0);
+    mrcFile = params.find<std::string>("mrc_file", "");
+
+    if (blockSize == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size must be non-zero\n", getName().c_str());
+    if (maxTracked == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: max_tracked_lines must be at least 1\n", getName().c_str());
+    if (rate <= 0.0 || rate > 1.0)
+        output->fatal(CALL_INFO, -1, "%s, Error: sample_rate (%f) must be in (0, 1]\n", getName().c_str(), rate);
+    threshold = std::max((uint64_t) 1, (uint64_t) (rate * HashSpace));
+
+    UnitAlgebra minSize(params.find<std::string>("mrc_min_size", "256KiB"));
+    UnitAlgebra maxSize(params.find<std::string>("mrc_max_size", "64MiB"));
+    uint32_t points = params.find<uint32_t>("mrc_points_per_doubling", 1);
+    if (!minSize.hasUnits("B") || !maxSize.hasUnits("B"))
+        output->fatal(CALL_INFO, -1, "%s, Error: mrc_min_size and mrc_max_size must be specified in bytes (e.g. 256KiB)\n", getName().c_str());
+    if (points == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: mrc_points_per_doubling must be at least 1\n", getName().c_str());
+
+    const uint64_t minBytes = std::max(blockSize, (uint64_t) minSize.getRoundedValue());
+    const uint64_t maxBytes = maxSize.getRoundedValue();
+    for (uint32_t i = 0; ; i++) {
+        uint64_t size = (uint64_t) llround(minBytes * pow(2.0, (double) i / points));
+        size -= size % blockSize;
+        if (size > maxBytes)
+            break;
+        if (!mrcSizes.empty() && size == mrcSizes.back())
+            continue;
+        mrcSizes.push_back(size);
+        statEstimatedMisses.push_back(registerStatistic<uint64_t>("estimated_misses", sizeName(size)));
+    }
+    if (mrcSizes.empty())
+        output->fatal(CALL_INFO, -1, "%s, Error: mrc_min_size must not exceed mrc_max_size\n", getName().c_str());
+
+    // Slots are reused after compaction, which renumbers the live ones from 1
+    fenwick.assign(4 * (uint64_t) maxTracked + 1, 0);
+    nextSlot = 1;
+    liveSlots = 0;
+
+    histogram.assign(bucketOf(UINT64_MAX) + 1, 0.0);
+    coldMisses = 0.0;
+    references = 0;
+    sampledReferences = 0;
+    reported = false;
+
+    statReferences = registerStatistic<uint64_t>("references");
+    statSampledReferences = registerStatistic<uint64_t>("sampled_references");
+
+    output->verbose(CALL_INFO, 1, 0, "%s, ReuseDistance created, sample rate: %f, tracking up to %" PRIu32 " lines, %zu cache sizes\n",
+        getName().c_str(), rate, maxTracked, mrcSizes.size());
+}
+
+ReuseDistance::~ReuseDistance() {
+    delete output;
+}
+
+size_t ReuseDistance::bucketOf(uint64_t distance) {
+    if (distance < Sub)
+        return distance;
+    int exp = 63 - __builtin_clzll(distance);
+    return Sub + (exp - SubBits) * Sub + ((distance >> (exp - SubBits)) & (Sub - 1));
+}
+
+uint64_t ReuseDistance::bucketStart(size_t bucket) {
+    if (bucket < Sub)
+        return bucket;
+    const uint64_t exp = (bucket - Sub) / Sub + SubBits;
+    return (Sub + (bucket % Sub)) << (exp - SubBits);
+}
+
+uint64_t ReuseDistance::hashLine(Addr line) const {
+    uint64_t h = line;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h & (HashSpace - 1);
+}
+
+void ReuseDistance::fenwickAdd(uint64_t slot, int delta) {
+    for (; slot < fenwick.size(); slot += slot & (~slot + 1))
+        fenwick[slot] += delta;
+}
+
+uint64_t ReuseDistance::fenwickSum(uint64_t slot) const {
+    int64_t sum = 0;
+    for (; slot > 0; slot -= slot & (~slot + 1))
+        sum += fenwick[slot];
+    return sum;
+}
+
+void ReuseDistance::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    references++;
+    statReferences->addData(1);
+
+    const Addr line = notify.getPhysicalAddress() / blockSize;
+    const uint64_t hash = hashLine(line);
+    if (hash >= threshold)
+        return;
+
+    sampledReferences++;
+    statSampledReferences->addData(1);
+
+    if (nextSlot == fenwick.size())
+        compact();
+    const uint64_t slot = nextSlot++;
+
+    auto it = lastAccess.find(line);
+    if (it == lastAccess.end()) {
+        coldMisses += 1.0;
+        lastAccess.emplace(line, slot);
+        byHash.emplace(hash, line);
+        fenwickAdd(slot, 1);
+        liveSlots++;
+        if (lastAccess.size() > maxTracked)
+            lowerThreshold();
+        return;
+    }
+
+    // Distinct sampled lines touched since this line's last access. Scaling d
+    // sampled lines by 1/R alone biases short distances towards zero; (d + 1) / R - 1
+    // is the expected full-stream distance given d, and exact when R is 1.
+    const uint64_t distance = liveSlots - fenwickSum(it->second);
+    histogram[bucketOf((uint64_t) ((distance + 1) * (double) HashSpace / threshold - 1.0))] += 1.0;
+
+    fenwickAdd(it->second, -1);
+    fenwickAdd(slot, 1);
+    it->second = slot;
+}
+
+/*
+ * Drop the lines with the largest hash until the budget is met and lower the
+ * threshold to exclude them. The histogram was collected at the old rate, so
+ * it is rescaled to what the new rate would have sampled.
+ */
+void ReuseDistance::lowerThreshold() {
+    const uint64_t oldThreshold = threshold;
+    threshold = byHash.rbegin()->first;
+
+    while (!byHash.empty() && byHash.rbegin()->first >= threshold) {
+        auto last = std::prev(byHash.end());
+        auto it = lastAccess.find(last->second);
+        fenwickAdd(it->second, -1);
+        liveSlots--;
+        lastAccess.erase(it);
+        byHash.erase(last);
+    }
+
+    const double scale = (double) threshold / oldThreshold;
+    for (double& count : histogram)
+        count *= scale;
+    coldMisses *= scale;
+
+    output->verbose(CALL_INFO, 2, 0, "%s, Sample rate lowered to %f\n", getName().c_str(), (double) threshold / HashSpace);
+}
+
+/* Renumber the live access slots 1..n in order so the Fenwick tree can be reused */
+void ReuseDistance::compact() {
+    std::vector<std::pair<uint64_t, Addr>> live;
+    live.reserve(lastAccess.size());
+    for (auto& entry : lastAccess)
+        live.emplace_back(entry.second, entry.first);
+    std::sort(live.begin(), live.end());
+
+    std::fill(fenwick.begin(), fenwick.end(), 0);
+    nextSlot = 1;
+    for (auto& entry : live) {
+        lastAccess[entry.second] = nextSlot;
+        fenwickAdd(nextSlot++, 1);
+    }
+}
+
+/* Estimated sampled misses of a fully associative LRU cache holding 'lines' lines */
+double ReuseDistance::missesAt(uint64_t lines) const {
+    double misses = coldMisses;
+    for (size_t bucket = bucketOf(lines); bucket < histogram.size(); bucket++) {
+        const uint64_t start = bucketStart(bucket);
+        if (start >= lines) {
+            misses += histogram[bucket];
+        } else {
+            // Assume distances are spread evenly over the bucket containing the cache size
+            const uint64_t end = bucket + 1 < histogram.size() ? bucketStart(bucket + 1) : UINT64_MAX;
+            misses += histogram[bucket] * (double) (end - lines) / (end - start);
+        }
+    }
+    return misses;
+}
+
+void ReuseDistance::registerResponseCallback(Event::HandlerBase *handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void ReuseDistance::printStats(Output &out) {
+    if (reported)
+        return;
+    reported = true;
+
+    // Normalize by the rescaled histogram rather than references * R: with a
+    // shrinking rate the two drift apart, and crediting the difference to short
+    // distances (SHARDS-adj) skews the curve for small caches
+    double total = coldMisses;
+    for (double count : histogram)
+        total += count;
+
+    FILE* csv = nullptr;
+    if (!mrcFile.empty()) {
+        csv = fopen(mrcFile.c_str(), "w");
+        if (!csv)
+            output->fatal(CALL_INFO, -1, "%s, Error: unable to open %s for writing\n", getName().c_str(), mrcFile.c_str());
+        fprintf(csv, "cache_size,cache_bytes,miss_ratio,estimated_misses\n");
+    }
+
+    for (size_t i = 0; i < mrcSizes.size(); i++) {
+        const double ratio = total > 0 ? std::min(1.0, missesAt(mrcSizes[i] / blockSize) / total) : 0.0;
+        const uint64_t misses = (uint64_t) llround(ratio * references);
+        statEstimatedMisses[i]->addData(misses);
+        output->verbose(CALL_INFO, 1, 0, "%s, %s: miss ratio %.4f\n", getName().c_str(), sizeName(mrcSizes[i]).c_str(), ratio);
+        if (csv)
+            fprintf(csv, "%s,%" PRIu64 ",%.6f,%" PRIu64 "\n", sizeName(mrcSizes[i]).c_str(), mrcSizes[i], ratio, misses);
+    }
+
+    if (csv)
+        fclose(csv);
+}
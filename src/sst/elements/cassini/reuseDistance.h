@@ -0,0 +1,138 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_REUSE_DISTANCE
+#define _H_SST_REUSE_DISTANCE
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/core/output.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Online stack reuse distance profiler producing a miss ratio curve
+ *
+ * Follows fixed-size SHARDS (Waldspurger et al., FAST'15). A cache line is
+ * sampled if a hash of its address falls below a threshold, so every access to
+ * a sampled line is seen and its reuse distance among sampled lines, scaled by
+ * the sampling rate, estimates the distance in the full stream. At most
+ * 'max_tracked_lines' lines are kept; when the budget is exceeded the lines
+ * with the largest hashes are dropped, the threshold is lowered to match and
+ * the histogram is rescaled. Each sampled access costs O(log n) through a
+ * Fenwick tree over last-access times.
+ *
+ * When the cache finishes, the estimated miss ratio of a fully associative LRU
+ * cache is reported for each size between 'mrc_min_size' and 'mrc_max_size',
+ * as the 'estimated_misses' statistic per size and optionally as a CSV file.
+ */
+class ReuseDistance : public SST::MemHierarchy::CacheListener {
+public:
+    ReuseDistance(ComponentId_t id, Params& params);
+    ~ReuseDistance();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        ReuseDistance,
+        "cassini",
+        "reuseDistance",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Sampled reuse distance profiler that estimates a miss ratio curve",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the profiler is attached to", "64" },
+        { "sample_rate", "Initial fraction of cache lines sampled, lowered automatically to stay within max_tracked_lines", "1.0" },
+        { "max_tracked_lines", "Maximum number of sampled lines tracked at once", "16384" },
+        { "mrc_min_size", "Smallest cache size on the miss ratio curve", "256KiB" },
+        { "mrc_max_size", "Largest cache size on the miss ratio curve", "64MiB" },
+        { "mrc_points_per_doubling", "Number of cache sizes per doubling of size on the miss ratio curve", "1" },
+        { "mrc_file", "If set, write the miss ratio curve to this file as CSV", "" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "references", "Number of read and write accesses seen", "accesses", 1 },
+        { "sampled_references", "Number of accesses to sampled lines", "accesses", 1 },
+        { "estimated_misses", "Estimated misses of a fully associative LRU cache, one sub-statistic per cache size on the curve", "misses", 1 }
+    )
+
+private:
+    /* Log-linear histogram buckets: exact below Sub, then Sub buckets per power of two */
+    static const int SubBits = 3;
+    static const uint64_t Sub = 1ULL << SubBits;
+    static size_t bucketOf(uint64_t distance);
+    static uint64_t bucketStart(size_t bucket);
+
+    uint64_t hashLine(Addr line) const;
+    void lowerThreshold();
+    void compact();
+    void fenwickAdd(uint64_t slot, int delta);
+    uint64_t fenwickSum(uint64_t slot) const;      // Live entries in slots [1, slot]
+    double missesAt(uint64_t lines) const;
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    uint64_t blockSize;
+    uint32_t maxTracked;
+
+    static const uint64_t HashSpace = 1ULL << 24;
+    uint64_t threshold;                             // Lines with hash < threshold are sampled
+
+    std::unordered_map<Addr, uint64_t> lastAccess;  // Sampled line -> slot of its last access
+    std::set<std::pair<uint64_t, Addr>> byHash;     // Sampled lines ordered by hash, to drop the largest
+    std::vector<int32_t> fenwick;                   // Over access slots, 1-based
+    uint64_t nextSlot;
+    uint64_t liveSlots;
+
+    std::vector<double> histogram;                  // Scaled reuse distances in lines, by bucket
+    double coldMisses;
+    uint64_t references;
+    uint64_t sampledReferences;
+
+    std::vector<uint64_t> mrcSizes;
+    std::vector<Statistic<uint64_t>*> statEstimatedMisses;
+    std::string mrcFile;
+    bool reported;
+
+    Statistic<uint64_t>* statReferences;
+    Statistic<uint64_t>* statSampledReferences;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,274 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "rptprefetch.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+static uint32_t roundUpPow2(uint64_t count) {
+    uint32_t size = 1;
+    while (size < count)
+        size <<= 1;
+    return size;
+}
+
+RPTPrefetcher::RPTPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    snprintf(new_prefix, sizeof(char)*128, "RPTPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    overrunPageBoundary = params.find<uint32_t>("overrun_page_boundaries", 0) != 0;
+
+    uint32_t sets = roundUpPow2(params.find<uint32_t>("table_sets", 64));
+    ways = params.find<uint32_t>("table_ways", 4);
+    uint32_t confMax = params.find<uint32_t>("confidence_max", 3);
+    uint32_t confThreshold = params.find<uint32_t>("confidence_threshold", 2);
+    uint32_t minDeg = params.find<uint32_t>("min_degree", 1);
+    uint32_t maxDeg = params.find<uint32_t>("max_degree", 4);
+    uint64_t filterEntries = params.find<uint64_t>("filter_entries", 256);
+
+    if (blockSize == 0 || pageSize == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size and page_size must be non-zero\n", getName().c_str());
+    if (ways == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: table_ways must be at least 1\n", getName().c_str());
+    if (confMax == 0 || confMax > 255 || confThreshold == 0 || confThreshold > confMax)
+        output->fatal(CALL_INFO, -1, "%s, Error: confidence_threshold (%" PRIu32 ") must be in [1, confidence_max], and confidence_max (%" PRIu32 ") in [1, 255]\n",
+                getName().c_str(), confThreshold, confMax);
+    if (minDeg == 0 || maxDeg > 255 || minDeg > maxDeg)
+        output->fatal(CALL_INFO, -1, "%s, Error: min_degree (%" PRIu32 ") must be in [1, max_degree], and max_degree (%" PRIu32 ") at most 255\n",
+                getName().c_str(), minDeg, maxDeg);
+
+    confidenceMax = confMax;
+    confidenceThreshold = confThreshold;
+    minDegree = minDeg;
+    maxDegree = maxDeg;
+
+    setMask = sets - 1;
+    setShift = 0;
+    while ((1U << setShift) < sets)
+        setShift++;
+    lruClock = 0;
+    table.resize((size_t) sets * ways, Entry());
+
+    if (filterEntries) {
+        filter.resize(roundUpPow2(filterEntries), 0);
+        filterMask = filter.size() - 1;
+    } else {
+        filterMask = 0;
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "RPTPrefetcher created, cache line: %" PRIu64 ", page size: %" PRIu64 ", table: %" PRIu32 " sets x %" PRIu32 " ways\n",
+        blockSize, pageSize, sets, ways);
+
+    statPrefetchOpportunities = registerStatistic<uint64_t>("prefetch_opportunities");
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
+    statPrefetchIssueCanceledByFilter = registerStatistic<uint64_t>("prefetches_canceled_by_filter");
+    statTableHits = registerStatistic<uint64_t>("table_hits");
+    statTableMisses = registerStatistic<uint64_t>("table_misses");
+    statStrideMispredictions = registerStatistic<uint64_t>("stride_mispredictions");
+}
+
+RPTPrefetcher::~RPTPrefetcher() {
+    delete output;
+}
+
+/*
+ * Find the entry for pc. On a miss the least recently used way of its set is
+ * handed back with lru cleared for the caller to initialize.
+ */
+RPTPrefetcher::Entry& RPTPrefetcher::lookup(Addr pc) {
+    // Instruction pointers are rarely aligned to more than a few bytes, fold the
+    // bits above the set index in so nearby instructions spread across sets
+    const uint64_t hash = (pc >> 2) ^ (pc >> (2 + setShift));
+    Entry* set = &table[(hash & setMask) * ways];
+    Entry* victim = set;
+
+    if (++lruClock == 0) {
+        // Clock wrapped, renumber the used entries of each set 1..n by age so the
+        // LRU order within every set is kept
+        std::vector<Entry*> used;
+        used.reserve(ways);
+        for (size_t first = 0; first < table.size(); first += ways) {
+            used.clear();
+            for (uint32_t way = 0; way < ways; way++) {
+                if (table[first + way].lru)
+                    used.push_back(&table[first + way]);
+            }
+            std::sort(used.begin(), used.end(), [](const Entry* a, const Entry* b) { return a->lru < b->lru; });
+            for (size_t rank = 0; rank < used.size(); rank++)
+                used[rank]->lru = rank + 1;
+        }
+        lruClock = ways + 1;
+    }
+
+    for (uint32_t way = 0; way < ways; way++) {
+        Entry& entry = set[way];
+        if (entry.lru && entry.pc == pc) {
+            entry.lru = lruClock;
+            statTableHits->addData(1);
+            return entry;
+        }
+        if (entry.lru < victim->lru)
+            victim = &entry;
+    }
+
+    statTableMisses->addData(1);
+    victim->pc = pc;
+    victim->lru = 0;
+    return *victim;
+}
+
+void RPTPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const Addr addr = notify.getPhysicalAddress();
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    Entry& entry = lookup(notify.getInstructionPointer());
+
+    if (entry.lru == 0) {
+        entry.lru = lruClock;
+        entry.lastAddr = addr;
+        entry.stride = 0;
+        entry.confidence = 0;
+        entry.degree = minDegree;
+        return;
+    }
+
+    const int64_t stride = (int64_t) (addr - entry.lastAddr);
+
+    // Repeated accesses to the same address say nothing about the stride
+    if (stride == 0)
+        return;
+
+    const bool sameLine = (addr / blockSize) == (entry.lastAddr / blockSize);
+    entry.lastAddr = addr;
+
+    if (stride == entry.stride) {
+        if (entry.confidence < confidenceMax) {
+            entry.confidence++;
+        } else if (entry.degree < maxDegree) {
+            entry.degree++;
+        }
+    } else {
+        if (entry.confidence >= confidenceThreshold)
+            statStrideMispredictions->addData(1);
+        entry.degree = minDegree;
+        if (entry.confidence > 0) {
+            entry.confidence--;
+        } else {
+            entry.stride = stride;
+        }
+    }
+
+    // Short strides stay in a line for several accesses, which would all
+    // prefetch the same lines
+    if (entry.confidence >= confidenceThreshold && !sameLine) {
+        statPrefetchOpportunities->addData(1);
+        issuePrefetches(entry);
+    }
+}
+
+/*
+ * Prefetch the next 'degree' lines along the entry's stride. Strides shorter
+ * than a line advance one line at a time in the stride's direction so that
+ * the degree always counts distinct lines.
+ */
+void RPTPrefetcher::issuePrefetches(const Entry& entry) {
+    const Addr base = entry.lastAddr - (entry.lastAddr % blockSize);
+    int64_t step = entry.stride;
+    if (step > -(int64_t) blockSize && step < (int64_t) blockSize)
+        step = step < 0 ? -(int64_t) blockSize : (int64_t) blockSize;
+
+    Addr target = entry.lastAddr;
+    for (uint32_t i = 0; i < entry.degree; i++) {
+        const Addr next = target + step;
+
+        // Stop rather than wrap around the address space
+        if ((step > 0) != (next > target))
+            break;
+        target = next;
+
+        const Addr lineAddr = target - (target % blockSize);
+        if (!overrunPageBoundary && (lineAddr / pageSize) != (base / pageSize)) {
+            output->verbose(CALL_INFO, 2, 0, "Cancel prefetch issue, request exceeds physical page limit\n");
+            output->verbose(CALL_INFO, 4, 0, "Target address: %" PRIx64 ", Prefetch address: %" PRIx64 "\n", entry.lastAddr, lineAddr);
+            statPrefetchIssueCanceledByPageBoundary->addData(1);
+            break;
+        }
+
+        if (recentlyPrefetched(lineAddr)) {
+            statPrefetchIssueCanceledByFilter->addData(1);
+            continue;
+        }
+
+        output->verbose(CALL_INFO, 2, 0, "Issue prefetch, pc: %" PRIx64 ", address: %" PRIx64 ", prefetch address: %" PRIx64 " (stride=%" PRId64 ", degree=%" PRIu32 ")\n",
+                entry.pc, entry.lastAddr, lineAddr, entry.stride, (uint32_t) entry.degree);
+        statPrefetchEventsIssued->addData(1);
+
+        // Cycle over each registered call back and notify them that we want to issue a prefetch request
+        for (std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+            // Create a new read request, we cannot issue a write because the data will get
+            // overwritten and corrupt memory (even if we really do want to do a write)
+            MemEvent* newEv = new MemEvent(getName(), lineAddr, lineAddr, Command::GetS);
+            newEv->setSize(blockSize);
+            newEv->setPrefetchFlag(true);
+            (*(*callbackItr))(newEv);
+        }
+    }
+}
+
+/*
+ * Check whether lineAddr was prefetched recently and record it if not. The
+ * filter is direct-mapped on a hash of the line address, so a colliding line
+ * simply replaces the older one.
+ */
+bool RPTPrefetcher::recentlyPrefetched(Addr lineAddr) {
+    if (filter.empty())
+        return false;
+
+    const uint64_t line = lineAddr / blockSize;
+    Addr& slot = filter[((line * 0x9E3779B97F4A7C15ULL) >> 32) & filterMask];
+    if (slot == lineAddr + 1)
+        return true;
+    slot = lineAddr + 1;
+    return false;
+}
+
+void RPTPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void RPTPrefetcher::printStats(Output &out) {
+}
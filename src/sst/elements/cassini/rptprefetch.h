@@ -0,0 +1,143 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_RPT_PREFETCH
+#define _H_SST_RPT_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Reference prediction table prefetcher
+ *
+ * Each load/store instruction (by instruction pointer) gets an entry in a
+ * set-associative table holding the last address it touched, the stride between
+ * its last two accesses, a saturating confidence counter and a prefetch degree.
+ * Every access updates one entry in constant time. Once an entry's stride has
+ * repeated often enough, the next 'degree' lines along the stride are
+ * prefetched; the degree grows while the stride keeps repeating and falls back
+ * to the minimum when it breaks. Lines prefetched recently are remembered in a
+ * small hashed filter so a steady stream does not re-request the same lines.
+ *
+ * Caches whose CPU does not supply instruction pointers see a single entry,
+ * which behaves like a global stride detector.
+ */
+class RPTPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    RPTPrefetcher(ComponentId_t id, Params& params);
+    ~RPTPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        RPTPrefetcher,
+        "cassini",
+        "RPTPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "PC-indexed reference prediction table stride prefetcher",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "page_size", "Page size for this controller", "4096" },
+        { "overrun_page_boundaries", "Allow prefetcher to run over page boundaries, 0 is no, 1 is yes", "0" },
+        { "table_sets", "Number of sets in the reference prediction table, rounded up to a power of two", "64" },
+        { "table_ways", "Associativity of the reference prediction table", "4" },
+        { "confidence_max", "Saturation value of each entry's stride confidence counter", "3" },
+        { "confidence_threshold", "Confidence an entry needs before it issues prefetches", "2" },
+        { "min_degree", "Lines prefetched ahead by an entry that has just become confident", "1" },
+        { "max_degree", "Lines an entry may prefetch ahead once its stride keeps repeating", "4" },
+        { "filter_entries", "Entries in the filter of recently issued prefetches, rounded up to a power of two, 0 disables the filter", "256" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
+        { "prefetches_canceled_by_page_boundary",
+                "Prefetches which would not be executed because they span over a page boundary.", "prefetches", 1 },
+        { "prefetches_canceled_by_filter",
+                "Prefetches which did not get issued because the line was prefetched recently", "prefetches", 1 },
+        { "prefetch_opportunities", "Count of accesses from a confident table entry", "prefetches", 1 },
+        { "table_hits", "Accesses whose instruction pointer was found in the prediction table", "accesses", 2 },
+        { "table_misses", "Accesses that allocated a new prediction table entry", "accesses", 2 },
+        { "stride_mispredictions", "Accesses that broke the stride of an entry confident enough to prefetch", "accesses", 2 }
+    )
+
+private:
+    struct Entry {
+        Addr pc;            // Instruction pointer, valid if lru != 0
+        Addr lastAddr;      // Address of the last access by this instruction
+        int64_t stride;     // Bytes between its last two accesses, when confident
+        uint32_t lru;       // Last use, 0 if the entry is free
+        uint8_t confidence;
+        uint8_t degree;
+    };
+
+    Entry& lookup(Addr pc);
+    void issuePrefetches(const Entry& entry);
+    bool recentlyPrefetched(Addr lineAddr);
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    uint64_t blockSize;
+    uint64_t pageSize;
+    bool overrunPageBoundary;
+
+    std::vector<Entry> table;   // Sets are 'ways' consecutive entries
+    uint32_t setMask;
+    uint32_t setShift;
+    uint32_t ways;
+    uint32_t lruClock;
+    uint8_t confidenceMax;
+    uint8_t confidenceThreshold;
+    uint8_t minDegree;
+    uint8_t maxDegree;
+
+    std::vector<Addr> filter;   // Line address + 1 by hash of line address, 0 if empty
+    uint64_t filterMask;
+
+    Statistic<uint64_t>* statPrefetchOpportunities;
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByPageBoundary;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByFilter;
+    Statistic<uint64_t>* statTableHits;
+    Statistic<uint64_t>* statTableMisses;
+    Statistic<uint64_t>* statStrideMispredictions;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,332 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "spatialprefetch.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+static uint32_t roundUpPow2(uint64_t count) {
+    uint32_t size = 1;
+    while (size < count)
+        size <<= 1;
+    return size;
+}
+
+/* Return the least recently used way of a set, preferring free ways */
+template<typename T>
+static T& victimOf(T* set, uint32_t ways) {
+    T* victim = set;
+    for (uint32_t way = 1; way < ways; way++) {
+        if (set[way].lru < victim->lru)
+            victim = &set[way];
+    }
+    return *victim;
+}
+
+SpatialPrefetcher::SpatialPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    snprintf(new_prefix, sizeof(char)*128, "SpatialPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    regionSize = params.find<uint64_t>("region_size", 2048);
+
+    if (blockSize == 0 || (blockSize & (blockSize - 1)))
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size (%" PRIu64 ") must be a power of two\n", getName().c_str(), blockSize);
+    if (regionSize < blockSize || (regionSize & (regionSize - 1)) || regionSize / blockSize > 64)
+        output->fatal(CALL_INFO, -1, "%s, Error: region_size (%" PRIu64 ") must be a power of two between one and 64 cache lines\n",
+                getName().c_str(), regionSize);
+    linesPerRegion = regionSize / blockSize;
+
+    uint32_t accSets = roundUpPow2(params.find<uint32_t>("accumulation_table_sets", 16));
+    accWays = params.find<uint32_t>("accumulation_table_ways", 4);
+    uint32_t patternSets = roundUpPow2(params.find<uint32_t>("pattern_table_sets", 256));
+    patternWays = params.find<uint32_t>("pattern_table_ways", 8);
+    if (accWays == 0 || patternWays == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: accumulation_table_ways and pattern_table_ways must be at least 1\n", getName().c_str());
+
+    accSetMask = accSets - 1;
+    accumulationTable.resize((size_t) accSets * accWays, Generation());
+    patternSetMask = patternSets - 1;
+    patternTable.resize((size_t) patternSets * patternWays, Pattern());
+    lruClock = 0;
+
+    issueRate = params.find<uint32_t>("issue_rate", 4);
+    queueSize = params.find<uint32_t>("queue_size", 64);
+    trackedRegions = params.find<uint32_t>("tracked_regions", 1024);
+    if (issueRate == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: issue_rate must be at least 1\n", getName().c_str());
+
+    output->verbose(CALL_INFO, 1, 0, "SpatialPrefetcher created, cache line: %" PRIu64 ", region: %" PRIu64 ", pattern table: %" PRIu32 " sets x %" PRIu32 " ways\n",
+        blockSize, regionSize, patternSets, patternWays);
+
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchUseful = registerStatistic<uint64_t>("prefetches_useful");
+    statPrefetchLate = registerStatistic<uint64_t>("prefetches_late");
+    statPrefetchUseless = registerStatistic<uint64_t>("prefetches_useless");
+    statPrefetchDropped = registerStatistic<uint64_t>("prefetches_dropped");
+    statPrefetchOpportunities = registerStatistic<uint64_t>("prefetch_opportunities");
+    statRegionTriggers = registerStatistic<uint64_t>("region_triggers");
+    statMissEventsProcessed = registerStatistic<uint64_t>("miss_events_processed");
+    statHitEventsProcessed = registerStatistic<uint64_t>("hit_events_processed");
+
+    issuedCount = 0;
+    usefulCount = 0;
+    lateCount = 0;
+    missCount = 0;
+}
+
+SpatialPrefetcher::~SpatialPrefetcher() {
+    delete output;
+}
+
+void SpatialPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const Addr addr = notify.getPhysicalAddress();
+    const Addr region = addr & ~(regionSize - 1);
+    const uint32_t offset = (addr & (regionSize - 1)) / blockSize;
+    const uint64_t bit = 1ULL << offset;
+
+    if (notifyType == EVICT) {
+        auto tracked = prefetchedLines.find(region);
+        if (tracked != prefetchedLines.end() && (tracked->second & bit)) {
+            statPrefetchUseless->addData(1);
+            if (!(tracked->second &= ~bit))
+                prefetchedLines.erase(tracked);
+        }
+
+        // Losing a line ends the region's generation
+        Generation* gen = findGeneration(region);
+        if (gen)
+            closeGeneration(*gen);
+        return;
+    }
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    const bool miss = notify.getResultType() == MISS;
+    if (miss) {
+        statMissEventsProcessed->addData(1);
+        missCount++;
+    } else {
+        statHitEventsProcessed->addData(1);
+    }
+
+    auto tracked = prefetchedLines.find(region);
+    if (tracked != prefetchedLines.end() && (tracked->second & bit)) {
+        if (miss) {
+            statPrefetchLate->addData(1);
+            lateCount++;
+        } else {
+            statPrefetchUseful->addData(1);
+            usefulCount++;
+        }
+        if (!(tracked->second &= ~bit))
+            prefetchedLines.erase(tracked);
+    }
+
+    Generation* gen = findGeneration(region);
+    if (gen) {
+        gen->footprint |= bit;
+        gen->lru = nextLru();
+    } else {
+        statRegionTriggers->addData(1);
+        openGeneration(region, notify.getInstructionPointer(), offset);
+
+        const Pattern* pattern = findPattern(region, notify.getInstructionPointer(), offset);
+        if (pattern) {
+            statPrefetchOpportunities->addData(1);
+
+            // Queue the footprint nearest the trigger first, alternating forward and backward
+            const uint64_t footprint = pattern->footprint & ~bit;
+            for (uint32_t dist = 1; dist < linesPerRegion; dist++) {
+                for (int64_t line : { (int64_t) offset + dist, (int64_t) offset - dist }) {
+                    if (line < 0 || line >= linesPerRegion || !(footprint & (1ULL << line)))
+                        continue;
+                    if (prefetchQueue.size() >= queueSize) {
+                        statPrefetchDropped->addData(1);
+                        continue;
+                    }
+                    prefetchQueue.push_back(region + line * blockSize);
+                }
+            }
+        }
+    }
+
+    issuePrefetches(issueRate);
+}
+
+/* Issue up to count queued prefetches, skipping lines already demanded or prefetched */
+void SpatialPrefetcher::issuePrefetches(uint32_t count) {
+    while (count && !prefetchQueue.empty()) {
+        const Addr lineAddr = prefetchQueue.front();
+        prefetchQueue.pop_front();
+
+        const Addr region = lineAddr & ~(regionSize - 1);
+        const uint64_t bit = 1ULL << ((lineAddr & (regionSize - 1)) / blockSize);
+
+        Generation* gen = findGeneration(region);
+        if (gen && (gen->footprint & bit))
+            continue;
+
+        auto tracked = prefetchedLines.find(region);
+        if (tracked != prefetchedLines.end() && (tracked->second & bit))
+            continue;
+
+        if (trackedRegions) {
+            if (tracked == prefetchedLines.end()) {
+                // Forget an arbitrary region rather than grow without bound when the cache drops prefetches
+                if (prefetchedLines.size() >= trackedRegions)
+                    prefetchedLines.erase(prefetchedLines.begin());
+                tracked = prefetchedLines.emplace(region, 0).first;
+            }
+            tracked->second |= bit;
+        }
+
+        output->verbose(CALL_INFO, 2, 0, "Issue prefetch, region: %" PRIx64 ", prefetch address: %" PRIx64 "\n", region, lineAddr);
+        statPrefetchEventsIssued->addData(1);
+        issuedCount++;
+        count--;
+
+        // Cycle over each registered call back and notify them that we want to issue a prefetch request
+        for (std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+            // Create a new read request, we cannot issue a write because the data will get
+            // overwritten and corrupt memory (even if we really do want to do a write)
+            MemEvent* newEv = new MemEvent(getName(), lineAddr, lineAddr, Command::GetS);
+            newEv->setSize(blockSize);
+            newEv->setPrefetchFlag(true);
+            (*(*callbackItr))(newEv);
+        }
+    }
+}
+
+SpatialPrefetcher::Generation* SpatialPrefetcher::findGeneration(Addr region) {
+    Generation* set = &accumulationTable[((region / regionSize) & accSetMask) * accWays];
+    for (uint32_t way = 0; way < accWays; way++) {
+        if (set[way].lru && set[way].region == region)
+            return &set[way];
+    }
+    return nullptr;
+}
+
+/* Advance the clock shared by both tables' LRU stamps */
+uint32_t SpatialPrefetcher::nextLru() {
+    if (++lruClock == 0) {
+        // Clock wrapped, restart it keeping only free/in-use
+        for (Generation& gen : accumulationTable)
+            gen.lru = gen.lru ? 1 : 0;
+        for (Pattern& pattern : patternTable)
+            pattern.lru = pattern.lru ? 1 : 0;
+        lruClock = 2;
+    }
+    return lruClock;
+}
+
+SpatialPrefetcher::Generation& SpatialPrefetcher::openGeneration(Addr region, Addr pc, uint32_t offset) {
+    Generation& gen = victimOf(&accumulationTable[((region / regionSize) & accSetMask) * accWays], accWays);
+    if (gen.lru)
+        closeGeneration(gen);
+
+    gen.region = region;
+    gen.pc = pc;
+    gen.offset = offset;
+    gen.footprint = 1ULL << offset;
+    gen.lru = nextLru();
+    return gen;
+}
+
+void SpatialPrefetcher::closeGeneration(Generation& gen) {
+    // A lone trigger says nothing about the region's layout
+    if (gen.footprint & (gen.footprint - 1))
+        storePattern(gen);
+    gen.lru = 0;
+}
+
+uint64_t SpatialPrefetcher::patternSet(Addr pc, uint32_t offset) const {
+    const uint64_t hash = ((pc >> 2) * 0x9E3779B97F4A7C15ULL) ^ offset;
+    return (hash ^ (hash >> 29)) & patternSetMask;
+}
+
+/*
+ * Prefer a pattern recorded for the same instruction and region, otherwise use
+ * the most recent one recorded for the same instruction and offset
+ */
+const SpatialPrefetcher::Pattern* SpatialPrefetcher::findPattern(Addr region, Addr pc, uint32_t offset) {
+    Pattern* set = &patternTable[patternSet(pc, offset) * patternWays];
+    Pattern* match = nullptr;
+    for (uint32_t way = 0; way < patternWays; way++) {
+        Pattern& pattern = set[way];
+        if (!pattern.lru || pattern.pc != pc || pattern.offset != offset)
+            continue;
+        if (pattern.region == region) {
+            match = &pattern;
+            break;
+        }
+        if (!match || pattern.lru > match->lru)
+            match = &pattern;
+    }
+    if (match)
+        match->lru = nextLru();
+    return match;
+}
+
+void SpatialPrefetcher::storePattern(const Generation& gen) {
+    Pattern* set = &patternTable[patternSet(gen.pc, gen.offset) * patternWays];
+    Pattern* slot = nullptr;
+    for (uint32_t way = 0; way < patternWays; way++) {
+        if (set[way].lru && set[way].pc == gen.pc && set[way].offset == gen.offset && set[way].region == gen.region) {
+            slot = &set[way];
+            break;
+        }
+    }
+    if (!slot)
+        slot = &victimOf(set, patternWays);
+
+    slot->region = gen.region;
+    slot->pc = gen.pc;
+    slot->offset = gen.offset;
+    slot->footprint = gen.footprint;
+    slot->lru = nextLru();
+}
+
+void SpatialPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void SpatialPrefetcher::printStats(Output &out) {
+    if (output->getVerboseLevel() < 1 || issuedCount == 0)
+        return;
+
+    output->verbose(CALL_INFO, 1, 0, "Prefetches issued: %" PRIu64 ", accuracy: %.3f, coverage: %.3f, late: %.3f\n",
+        issuedCount,
+        (double) usefulCount / issuedCount,
+        (usefulCount + missCount) ? (double) usefulCount / (usefulCount + missCount) : 0.0,
+        (usefulCount + lateCount) ? (double) lateCount / (usefulCount + lateCount) : 0.0);
+}
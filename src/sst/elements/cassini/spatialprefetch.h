@@ -0,0 +1,175 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_SPATIAL_PREFETCH
+#define _H_SST_SPATIAL_PREFETCH
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Spatial footprint prefetcher in the style of SMS and Bingo
+ *
+ * Memory is divided into fixed-size regions. The first access to a region
+ * (the trigger) opens a generation in the accumulation table, which records a
+ * bitmap of the lines touched until one of the region's lines is evicted or
+ * the entry is displaced. Every access to an open region makes its entry the
+ * most recently used, and the least recently used entry in the set is the one
+ * displaced. The bitmap is then stored in the pattern table under
+ * the trigger's instruction pointer and offset within the region, tagged with
+ * the region address. On the next trigger the pattern table is searched for an
+ * entry with the same instruction pointer and address, falling back to the
+ * most recent one with the same instruction pointer and offset, and the lines
+ * of its footprint are queued for prefetch.
+ *
+ * Queued prefetches are issued at most 'issue_rate' per demand access. Each
+ * issued line is tracked until it is used or evicted so that accuracy,
+ * coverage and lateness can be derived from the statistics:
+ *   accuracy = prefetches_useful / prefetches_issued
+ *   coverage = prefetches_useful / (prefetches_useful + miss_events_processed)
+ *   lateness = prefetches_late / (prefetches_useful + prefetches_late)
+ */
+class SpatialPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    SpatialPrefetcher(ComponentId_t id, Params& params);
+    ~SpatialPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        SpatialPrefetcher,
+        "cassini",
+        "SpatialPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Spatial footprint (SMS/Bingo-style) region prefetcher",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "region_size", "Size of a spatial region in bytes, a power of two of at most 64 cache lines", "2048" },
+        { "accumulation_table_sets", "Number of sets in the table of open regions, rounded up to a power of two", "16" },
+        { "accumulation_table_ways", "Associativity of the table of open regions", "4" },
+        { "pattern_table_sets", "Number of sets in the footprint history table, rounded up to a power of two", "256" },
+        { "pattern_table_ways", "Associativity of the footprint history table", "8" },
+        { "issue_rate", "Maximum prefetches issued per demand access", "4" },
+        { "queue_size", "Maximum prefetches waiting to be issued, further prefetches are dropped", "64" },
+        { "tracked_regions", "Number of regions whose issued prefetches are tracked for accuracy statistics", "1024" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
+        { "prefetches_useful", "Prefetched lines hit by a demand access", "prefetches", 1 },
+        { "prefetches_late", "Prefetched lines missed by a demand access, usually because the prefetch was still in flight", "prefetches", 1 },
+        { "prefetches_useless", "Prefetched lines evicted before any demand access", "prefetches", 1 },
+        { "prefetches_dropped", "Prefetches discarded because the issue queue was full", "prefetches", 1 },
+        { "prefetch_opportunities", "Region triggers that found a footprint in the pattern table", "prefetches", 1 },
+        { "region_triggers", "Accesses that opened a new region generation", "accesses", 2 },
+        { "miss_events_processed", "Number of demand cache misses received", "misses", 2 },
+        { "hit_events_processed", "Number of demand cache hits received", "hits", 2 }
+    )
+
+private:
+    /* An open region in the accumulation table */
+    struct Generation {
+        Addr region;
+        Addr pc;            // Trigger instruction pointer
+        uint64_t footprint; // Lines accessed so far, bit i is line i of the region
+        uint32_t lru;       // Last use, 0 if the entry is free
+        uint32_t offset;    // Trigger line within the region
+    };
+
+    /* A footprint learned from a closed generation */
+    struct Pattern {
+        Addr region;
+        Addr pc;
+        uint64_t footprint;
+        uint32_t lru;
+        uint32_t offset;
+    };
+
+    Generation* findGeneration(Addr region);
+    Generation& openGeneration(Addr region, Addr pc, uint32_t offset);
+    void closeGeneration(Generation& gen);
+    const Pattern* findPattern(Addr region, Addr pc, uint32_t offset);
+    void storePattern(const Generation& gen);
+    void issuePrefetches(uint32_t count);
+
+    uint64_t patternSet(Addr pc, uint32_t offset) const;
+    uint32_t nextLru();
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    uint64_t blockSize;
+    uint64_t regionSize;
+    uint32_t linesPerRegion;
+
+    std::vector<Generation> accumulationTable;  // Sets are 'accWays' consecutive entries
+    uint32_t accSetMask;
+    uint32_t accWays;
+    std::vector<Pattern> patternTable;
+    uint32_t patternSetMask;
+    uint32_t patternWays;
+    uint32_t lruClock;
+
+    std::deque<Addr> prefetchQueue;             // Line addresses waiting to be issued
+    uint32_t issueRate;
+    uint32_t queueSize;
+
+    std::unordered_map<Addr, uint64_t> prefetchedLines;    // Issued and not yet used or evicted, by region
+    uint32_t trackedRegions;
+
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchUseful;
+    Statistic<uint64_t>* statPrefetchLate;
+    Statistic<uint64_t>* statPrefetchUseless;
+    Statistic<uint64_t>* statPrefetchDropped;
+    Statistic<uint64_t>* statPrefetchOpportunities;
+    Statistic<uint64_t>* statRegionTriggers;
+    Statistic<uint64_t>* statMissEventsProcessed;
+    Statistic<uint64_t>* statHitEventsProcessed;
+
+    uint64_t issuedCount;
+    uint64_t usefulCount;
+    uint64_t lateCount;
+    uint64_t missCount;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,88 @@
+import sst
+
+DEBUG_L1 = 0
+DEBUG_L2 = 0
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "memHierarchy.streamCPU")
+comp_cpu.addParams({
+      "do_write" : "1",
+      "num_loadstore" : "100000",
+      "commFreq" : "100",
+      "memSize" : "524288"
+})
+
+iface = comp_cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams({
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "debug" : DEBUG_L1,
+      "L1" : "1",
+      "cache_size" : "2 KB"
+})
+
+# Shared non-inclusive MESI L2 with the throttled prefetcher. One prefetch may be
+# outstanding at a time so that some are dropped.
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams({
+      "access_latency_cycles" : "6",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "cache_type" : "noninclusive_with_directory",
+      "noninclusive_directory_entries" : "4096",
+      "noninclusive_directory_associativity" : "8",
+      "max_outstanding_prefetch" : "1",
+      "debug" : DEBUG_L2,
+      "cache_size" : "16 KB"
+})
+
+# At the initial level the throttle pushes prefetches 512 lines ahead, twice
+# the L2, so they are evicted unused. At the lowest level they stay where the
+# wrapped prefetcher put them and the stream reaches them before they return.
+throttle = comp_l2cache.setSubComponent("prefetcher", "cassini.ThrottlingPrefetcher")
+throttle.addParams({
+      "page_size" : "1048576",
+      "levels" : "5",
+      "initial_level" : "3",
+      "max_distance" : "1024",
+      "interval" : "64"
+})
+throttle.setSubComponent("prefetcher", "cassini.RPTPrefetcher")
+
+# Enable statistics outputs
+comp_l2cache.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+throttle.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams({
+      "clock" : "1GHz",
+      "addr_range_start" : 0
+})
+backend = comp_memory.setSubComponent("backend", "memHierarchy.simpleMem")
+backend.addParams({
+      "access_time" : "1000 ns",
+      "mem_size" : "512MiB",
+})
+
+# Define the simulation links
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (iface, "port", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+link_l1_l2_link = sst.Link("link_l1_l2_link")
+link_l1_l2_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_l2cache, "high_network_0", "50ps") )
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l2cache, "low_network_0", "50ps"), (comp_memory, "direct_link", "50ps") )
@@ -3,6 +3,8 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+import re
+
 
 class testcase_cassini_prefetch(SSTTestCase):
 
@@ -28,6 +30,30 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_rpt skipped if threads > 3")
+    def test_cassini_prefetch_rpt(self):
+        self.cassini_prefetch_stats_template("rpt", self._checkRPT)
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_reuse_distance skipped if threads > 3")
+    def test_cassini_reuse_distance(self):
+        self.cassini_prefetch_stats_template("reuse", self._checkReuseDistance)
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_spatial skipped if threads > 3")
+    def test_cassini_prefetch_spatial(self):
+        self.cassini_prefetch_stats_template("spatial", self._checkSpatial)
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_throttle skipped if threads > 3")
+    def test_cassini_prefetch_throttle(self):
+        self.cassini_throttle_test_template("throttle", "l1cache")
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_throttle_noninclusive skipped if threads > 3")
+    def test_cassini_prefetch_throttle_noninclusive(self):
+        self.cassini_throttle_test_template("throttle-noninclusive", "l2cache")
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_throttle_incoherent skipped if threads > 3")
+    def test_cassini_prefetch_throttle_incoherent(self):
+        self.cassini_throttle_test_template("throttle-incoherent", "l2cache")
+
 #####
 
     def cassini_prefetch_test_template(self, testcase, testtimeout=180):
@@ -66,6 +92,124 @@ class testcase_cassini_prefetch(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    # Run a config and check its statistics against the run without a prefetcher
+    def cassini_prefetch_stats_template(self, testcase, check, testtimeout=180):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_cassini_prefetch_{0}".format(testcase)
+
+        sdlfile = "{0}/streamcpu-{1}.py".format(test_path, testcase)
+        nopffile = "{0}/refFiles/test_cassini_prefetch_nopf.out".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("cassini_prefetch test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        check(self._readStats(outfile), self._readStats(nopffile))
+
+    # Run a config whose cache prefetches through a ThrottlingPrefetcher, and check
+    # the outcomes the cache reported to it against the cache's own statistics
+    def cassini_throttle_test_template(self, testcase, cache, initial_level=3):
+        outfile = "{0}/test_cassini_prefetch_{1}.out".format(self.get_test_output_run_dir(), testcase)
+
+        def check(stats, nopf):
+            self._checkThrottle(stats, self._readStats(outfile, "Min"), self._readStats(outfile, "Max"), cache, initial_level)
+
+        self.cassini_prefetch_stats_template(testcase, check)
+
+    def _readStats(self, filename, field="Sum"):
+        stats = {}
+        with open(filename, 'r') as fp:
+            for line in fp:
+                m = re.match(r"\s*(\S+) : Accumulator : .*\b{0}.u64 = (\d+);".format(field), line)
+                if m:
+                    stats[m.group(1)] = int(m.group(2))
+        return stats
+
+    def _hits(self, stats):
+        return stats["l1cache.GetSHit_Arrival"] + stats["l1cache.GetXHit_Arrival"]
+
+    def _checkRPT(self, stats, nopf):
+        # The stream CPU supplies no instruction pointer, so its single table entry
+        # sees the whole stream and should lock on to the stride
+        self.assertTrue(stats["l1cache.prefetch_opportunities"] > 0, "RPTPrefetcher never became confident in the stream's stride")
+        self.assertTrue(stats["l1cache.prefetches_issued"] > 0, "RPTPrefetcher issued no prefetches")
+        self.assertTrue(self._hits(stats) > self._hits(nopf),
+            "RPTPrefetcher did not add L1 hits: {0} with, {1} without".format(self._hits(stats), self._hits(nopf)))
+
+    def _checkReuseDistance(self, stats, nopf):
+        # The stream CPU sweeps 512KiB of memory in order, so a line is only reused
+        # after every other line. Caches smaller than that miss on each pass and
+        # larger ones only take the 8192 cold misses.
+        sizes = ["256KiB", "512KiB", "1MiB"]
+        misses = [stats["l1cache.estimated_misses.{0}".format(size)] for size in sizes]
+        self.assertTrue(stats["l1cache.references"] > 0, "reuseDistance saw no references")
+        for i in range(1, len(sizes)):
+            self.assertTrue(misses[i] <= misses[i - 1],
+                "Miss ratio curve rises from {0} ({1}) to {2} ({3})".format(sizes[i - 1], misses[i - 1], sizes[i], misses[i]))
+        self.assertTrue(misses[0] > misses[-1],
+            "Miss ratio curve is flat at {0} misses across a cache the size of the stream".format(misses[0]))
+        self.assertTrue(abs(misses[-1] - 8192) <= 8192 * 0.1,
+            "Expected about 8192 cold misses at {0}, estimated {1}".format(sizes[-1], misses[-1]))
+
+    def _checkSpatial(self, stats, nopf):
+        # A streaming access pattern fills every region, so once the first footprints
+        # are learned the first access to most lines should hit on a prefetched line
+        issued = stats["l1cache.prefetches_issued"]
+        useful = stats["l1cache.prefetches_useful"]
+        self.assertTrue(useful > 0, "SpatialPrefetcher issued {0} prefetches but none were used".format(issued))
+        self.assertTrue(useful + stats["l1cache.prefetches_late"] + stats["l1cache.prefetches_useless"] <= issued,
+            "SpatialPrefetcher counted more prefetch outcomes than prefetches issued ({0})".format(issued))
+
+        # Without a prefetcher every miss is a demand miss
+        misses = stats["l1cache.miss_events_processed"]
+        nopfMisses = nopf["l1cache.GetSMiss_Arrival"] + nopf["l1cache.GetXMiss_Arrival"]
+        self.assertTrue(misses < nopfMisses,
+            "SpatialPrefetcher did not reduce demand misses: {0} with, {1} without".format(misses, nopfMisses))
+
+    # Statistic of the subcomponent in a cache's prefetcher slot, not of the prefetcher it wraps
+    def _prefetcherStat(self, stats, cache, name):
+        values = [v for k, v in stats.items() if re.match(r"{0}:[^:.]+\.{1}$".format(cache, name), k)]
+        self.assertEqual(len(values), 1, "Expected one {0} statistic for the prefetcher of {1}, found {2}".format(name, cache, len(values)))
+        return values[0]
+
+    def _checkThrottle(self, stats, mins, maxs, cache, initial_level):
+        # Prefetches start far enough ahead to be evicted before use, which should
+        # throttle the prefetcher down to where they are used but late. Only one
+        # prefetch may be outstanding, so some are dropped.
+        throttle = lambda name: self._prefetcherStat(stats, cache, name)
+        cacheStat = lambda name: stats.get("{0}.{1}".format(cache, name), 0)
+
+        issued = throttle("prefetches_issued")
+        useful = throttle("prefetch_useful")
+        late = throttle("prefetch_late")
+        polluting = throttle("prefetch_polluting")
+        dropped = throttle("prefetch_dropped")
+        self.assertTrue(issued > 0, "ThrottlingPrefetcher issued no prefetches")
+        self.assertTrue(useful > 0, "{0} reported no useful prefetches".format(cache))
+        self.assertTrue(late > 0, "{0} reported no late prefetches".format(cache))
+        self.assertTrue(polluting > 0, "{0} reported no prefetches evicted unused".format(cache))
+        self.assertTrue(dropped > 0, "{0} reported no dropped prefetches".format(cache))
+        self.assertTrue(late <= issued, "ThrottlingPrefetcher saw {0} late prefetches but issued {1}".format(late, issued))
+
+        # Every outcome the cache counts is also reported to its prefetcher
+        self.assertEqual(issued, cacheStat("Prefetch_requests"))
+        self.assertEqual(useful, cacheStat("prefetch_useful") + cacheStat("prefetch_coherence_miss"))
+        self.assertEqual(polluting, cacheStat("prefetch_evict") + cacheStat("prefetch_inv"))
+        self.assertEqual(dropped, cacheStat("Prefetch_drops"))
+
+        # The level is recorded at the end of each interval
+        low = self._prefetcherStat(mins, cache, "aggressiveness")
+        high = self._prefetcherStat(maxs, cache, "aggressiveness")
+        self.assertTrue(throttle("aggressiveness") > 0, "ThrottlingPrefetcher never updated its aggressiveness")
+        self.assertTrue(low != high or low != initial_level,
+            "ThrottlingPrefetcher stayed at aggressiveness level {0}".format(initial_level))
+
     def _prettyPrintDiffs(self, stat_diff, oth_diff):
         out = ""
         if len(stat_diff) != 0:
@@ -0,0 +1,219 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "throttleprefetch.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace SST::Cassini;
+
+ThrottlingPrefetcher::ThrottlingPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    snprintf(new_prefix, sizeof(char)*128, "ThrottlingPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    levels = params.find<uint32_t>("levels", 5);
+    level = params.find<uint32_t>("initial_level", 3);
+    maxDegree = params.find<uint32_t>("max_degree", 4);
+    maxDistance = params.find<uint32_t>("max_distance", 0);
+    interval = params.find<uint32_t>("interval", 256);
+    accuracyHigh = params.find<double>("accuracy_high", 0.75);
+    accuracyLow = params.find<double>("accuracy_low", 0.40);
+    latenessThreshold = params.find<double>("lateness_threshold", 0.10);
+    pollutionThreshold = params.find<double>("pollution_threshold", 0.25);
+    dropThreshold = params.find<double>("drop_threshold", 0.25);
+
+    if (blockSize == 0 || pageSize == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size and page_size must be non-zero\n", getName().c_str());
+    if (levels == 0 || level == 0 || level > levels)
+        output->fatal(CALL_INFO, -1, "%s, Error: initial_level (%" PRIu32 ") must be between 1 and levels (%" PRIu32 ")\n",
+                getName().c_str(), level, levels);
+    if (maxDegree == 0 || interval == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: max_degree and interval must be at least 1\n", getName().c_str());
+    if (accuracyLow > accuracyHigh)
+        output->fatal(CALL_INFO, -1, "%s, Error: accuracy_low (%f) must not exceed accuracy_high (%f)\n", getName().c_str(), accuracyLow, accuracyHigh);
+
+    prefetcher = loadUserSubComponent<CacheListener>("prefetcher", ComponentInfo::SHARE_NONE);
+    if (!prefetcher) {
+        std::string type = params.find<std::string>("prefetcher", "");
+        if (type.empty())
+            output->fatal(CALL_INFO, -1, "%s, Error: no prefetcher to throttle, fill the 'prefetcher' slot or set the 'prefetcher' parameter\n", getName().c_str());
+        Params prefParams = params.get_scoped_params("prefetcher");
+        prefetcher = loadAnonymousSubComponent<CacheListener>(type, "prefetcher", 0, ComponentInfo::INSERT_STATS, prefParams);
+    }
+    prefetcher->registerResponseCallback(new Event::Handler<ThrottlingPrefetcher>(this, &ThrottlingPrefetcher::handlePrefetch));
+
+    triggerAddr = 0;
+    issuedThisAccess = 0;
+    updateLevel();
+
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchThrottled = registerStatistic<uint64_t>("prefetches_throttled");
+    statPrefetchUseful = registerStatistic<uint64_t>("prefetch_useful");
+    statPrefetchLate = registerStatistic<uint64_t>("prefetch_late");
+    statPrefetchPolluting = registerStatistic<uint64_t>("prefetch_polluting");
+    statPrefetchRedundant = registerStatistic<uint64_t>("prefetch_redundant");
+    statPrefetchDropped = registerStatistic<uint64_t>("prefetch_dropped");
+    statAggressiveness = registerStatistic<uint64_t>("aggressiveness");
+}
+
+ThrottlingPrefetcher::~ThrottlingPrefetcher() {
+    delete output;
+}
+
+/* Derive degree and distance from the aggressiveness level, both grow linearly up to their maximum */
+void ThrottlingPrefetcher::updateLevel() {
+    degree = std::max((uint32_t) 1, (maxDegree * level + levels - 1) / levels);
+    distance = levels > 1 ? (maxDistance * (level - 1)) / (levels - 1) : maxDistance;
+}
+
+void ThrottlingPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+
+    if (notifyType == READ || notifyType == WRITE) {
+        triggerAddr = notify.getPhysicalAddress();
+        issuedThisAccess = 0;
+    }
+
+    prefetcher->notifyAccess(notify);
+}
+
+/* Prefetch from the wrapped prefetcher, called while it handles notifyAccess */
+void ThrottlingPrefetcher::handlePrefetch(Event* ev) {
+    MemEvent* event = static_cast<MemEvent*>(ev);
+    Addr target = event->getAddr() - (event->getAddr() % blockSize);
+    delete event;
+
+    if (issuedThisAccess >= degree) {
+        statPrefetchThrottled->addData(1);
+        return;
+    }
+    issuedThisAccess++;
+
+    if (distance) {
+        // Push the prefetch further in the direction it already points, staying on the trigger's page
+        const Addr triggerLine = triggerAddr - (triggerAddr % blockSize);
+        Addr shifted = target;
+        if (target > triggerLine)
+            shifted = target + distance * blockSize;
+        else if (target < triggerLine && target >= distance * blockSize)
+            shifted = target - distance * blockSize;
+        if (shifted / pageSize == triggerAddr / pageSize)
+            target = shifted;
+    }
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch, trigger address: %" PRIx64 ", prefetch address: %" PRIx64 " (level=%" PRIu32 ", degree=%" PRIu32 ", distance=%" PRIu32 ")\n",
+            triggerAddr, target, level, degree, distance);
+
+    statPrefetchEventsIssued->addData(1);
+    current.issued += 1;
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for (std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+        MemEvent* newEv = new MemEvent(getName(), target, target, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+        (*(*callbackItr))(newEv);
+    }
+
+    if (current.issued >= interval)
+        updateAggressiveness();
+}
+
+void ThrottlingPrefetcher::notifyPrefetchResult(Addr addr, PrefetchResult result) {
+    switch (result) {
+        case PrefetchResult::USEFUL:
+            statPrefetchUseful->addData(1);
+            current.useful += 1;
+            break;
+        case PrefetchResult::LATE:
+            statPrefetchLate->addData(1);
+            current.late += 1;
+            break;
+        case PrefetchResult::EVICTED:
+        case PrefetchResult::INVALIDATED:
+            statPrefetchPolluting->addData(1);
+            current.polluting += 1;
+            break;
+        case PrefetchResult::REDUNDANT:
+            statPrefetchRedundant->addData(1);
+            break;
+        case PrefetchResult::DROPPED:
+            statPrefetchDropped->addData(1);
+            current.dropped += 1;
+            break;
+    }
+
+    prefetcher->notifyPrefetchResult(addr, result);
+}
+
+/*
+ * End of an interval: fold its counts into the history, halving the weight of
+ * older intervals, and move the aggressiveness level by at most one step
+ */
+void ThrottlingPrefetcher::updateAggressiveness() {
+    history.issued = (history.issued + current.issued) / 2;
+    history.useful = (history.useful + current.useful) / 2;
+    history.late = (history.late + current.late) / 2;
+    history.polluting = (history.polluting + current.polluting) / 2;
+    history.dropped = (history.dropped + current.dropped) / 2;
+    current = Feedback();
+
+    const double accuracy = history.issued > 0 ? history.useful / history.issued : 0.0;
+    const bool late = history.useful > 0 && history.late / history.useful > latenessThreshold;
+    const bool polluting = history.issued > 0 && history.polluting / history.issued > pollutionThreshold;
+    const bool dropping = history.issued > 0 && history.dropped / history.issued > dropThreshold;
+
+    int step = 0;
+    if (dropping)
+        step = -1;
+    else if (accuracy >= accuracyHigh)
+        step = late ? 1 : 0;
+    else if (accuracy >= accuracyLow)
+        step = polluting ? -1 : (late ? 1 : 0);
+    else
+        step = -1;
+
+    if ((step > 0 && level < levels) || (step < 0 && level > 1)) {
+        level += step;
+        updateLevel();
+        output->verbose(CALL_INFO, 1, 0, "Aggressiveness now %" PRIu32 " (accuracy %.2f%s%s%s), degree=%" PRIu32 ", distance=%" PRIu32 "\n",
+                level, accuracy, late ? ", late" : "", polluting ? ", polluting" : "", dropping ? ", dropping" : "", degree, distance);
+    }
+    statAggressiveness->addData(level);
+}
+
+void ThrottlingPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void ThrottlingPrefetcher::printStats(Output &out) {
+    prefetcher->printStats(out);
+}
@@ -0,0 +1,159 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_THROTTLE_PREFETCH
+#define _H_SST_THROTTLE_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Feedback-directed throttle around another prefetcher
+ *
+ * Wraps any CacheListener prefetcher and sits between it and the cache. The
+ * wrapped prefetcher sees every access as usual; the prefetches it returns
+ * during one access are cut to the current degree and, if max_distance is
+ * set, pushed further ahead in the direction of the prefetch. The cache
+ * reports what became of each prefetch (useful, late, evicted unused,
+ * redundant, dropped). After every 'interval' prefetches the smoothed
+ * accuracy, lateness, pollution and drop rate move the aggressiveness level
+ * up or down, following feedback-directed prefetching (Srinath et al.,
+ * HPCA'07):
+ *   drop rate high          -> decrease
+ *   accuracy high           -> increase if late
+ *   accuracy medium         -> decrease if polluting, otherwise increase if late
+ *   accuracy low            -> decrease
+ */
+class ThrottlingPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    ThrottlingPrefetcher(ComponentId_t id, Params& params);
+    ~ThrottlingPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void notifyPrefetchResult(Addr addr, PrefetchResult result);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        ThrottlingPrefetcher,
+        "cassini",
+        "ThrottlingPrefetcher",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Feedback-directed throttle for another prefetcher",
+        SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "prefetcher", "Prefetcher to wrap if none is loaded into the 'prefetcher' slot, its parameters are scoped under 'prefetcher.'", "" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "page_size", "Prefetches are not pushed across this boundary by the distance adjustment", "4096" },
+        { "levels", "Number of aggressiveness levels", "5" },
+        { "initial_level", "Aggressiveness level to start at, between 1 and levels", "3" },
+        { "max_degree", "Prefetches passed on per access at the highest level", "4" },
+        { "max_distance", "Lines prefetches are pushed ahead at the highest level, 0 leaves addresses unchanged", "0" },
+        { "interval", "Prefetches issued between aggressiveness updates", "256" },
+        { "accuracy_high", "Accuracy at or above which the prefetcher is considered accurate", "0.75" },
+        { "accuracy_low", "Accuracy below which the prefetcher is throttled down", "0.40" },
+        { "lateness_threshold", "Fraction of useful prefetches arriving late above which the prefetcher is considered late", "0.10" },
+        { "pollution_threshold", "Fraction of prefetches evicted or invalidated unused above which the prefetcher is considered polluting", "0.25" },
+        { "drop_threshold", "Fraction of prefetches dropped by the cache above which the prefetcher is throttled down", "0.25" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Prefetches passed on to the cache", "prefetches", 1 },
+        { "prefetches_throttled", "Prefetches discarded because they exceeded the current degree", "prefetches", 1 },
+        { "prefetch_useful", "Prefetched lines used by a demand access", "prefetches", 1 },
+        { "prefetch_late", "Prefetches a demand access had to wait for", "prefetches", 1 },
+        { "prefetch_polluting", "Prefetched lines evicted or invalidated before use", "prefetches", 1 },
+        { "prefetch_redundant", "Prefetches for lines already in the cache", "prefetches", 1 },
+        { "prefetch_dropped", "Prefetches dropped by the cache", "prefetches", 1 },
+        { "aggressiveness", "Aggressiveness level, recorded at the end of each interval", "level", 1 }
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        { "prefetcher", "Prefetcher to throttle", "SST::MemHierarchy::CacheListener" }
+    )
+
+private:
+    void handlePrefetch(Event* ev);
+    void updateLevel();
+    void updateAggressiveness();
+
+    Output* output;
+    CacheListener* prefetcher;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    uint64_t blockSize;
+    uint64_t pageSize;
+
+    uint32_t levels;
+    uint32_t level;
+    uint32_t maxDegree;
+    uint32_t maxDistance;
+    uint32_t degree;            // Derived from level
+    uint32_t distance;
+
+    Addr triggerAddr;           // Access being handled by the wrapped prefetcher
+    uint32_t issuedThisAccess;
+
+    uint32_t interval;
+    double accuracyHigh;
+    double accuracyLow;
+    double latenessThreshold;
+    double pollutionThreshold;
+    double dropThreshold;
+
+    /* Feedback counts for the current interval, and smoothed over past intervals */
+    struct Feedback {
+        double issued = 0;
+        double useful = 0;
+        double late = 0;
+        double polluting = 0;
+        double dropped = 0;
+    };
+    Feedback current;
+    Feedback history;
+
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchThrottled;
+    Statistic<uint64_t>* statPrefetchUseful;
+    Statistic<uint64_t>* statPrefetchLate;
+    Statistic<uint64_t>* statPrefetchPolluting;
+    Statistic<uint64_t>* statPrefetchRedundant;
+    Statistic<uint64_t>* statPrefetchDropped;
+    Statistic<uint64_t>* statAggressiveness;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -45,8 +45,11 @@ Bus::Bus(ComponentId_t id, Params& params) : Component(id) {
 }
 
 
-void Bus::processIncomingEvent(SST::Event* ev) {
-    eventQueue_.push(ev);
+void Bus::processIncomingEvent(SST::Event* ev, int port) {
+    BusEntry entry;
+    entry.event = ev;
+    entry.srcPort = port;
+    eventQueue_.push(entry);
     if (!busOn_) {
         reregisterClock(defaultTimeBase_, clockHandler_);
         busOn_ = true;
@@ -65,18 +68,19 @@ bool Bus::clockTick(Cycle_t time) {
         return true;
     }
 
+    uint64_t sent = 0;
     while (!eventQueue_.empty()) {
-        SST::Event* event = eventQueue_.front();
+        BusEntry& entry = eventQueue_.front();
 
         if (broadcast_)
-            broadcastEvent(event);
+            broadcastEvent(entry.event, entry.srcPort);
         else
-            sendSingleEvent(event);
+            sendSingleEvent(entry.event, entry.srcPort);
 
         eventQueue_.pop();
         idleCount_ = 0;
 
-        if (!drain_ )
+        if (!drain_ && ++sent == lanes_)
             break;
     }
 
@@ -84,18 +88,12 @@ bool Bus::clockTick(Cycle_t time) {
 }
 
 
-void Bus::broadcastEvent(SST::Event* ev) {
+void Bus::broadcastEvent(SST::Event* ev, int srcPort) {
     MemEventBase* memEvent = static_cast<MemEventBase*>(ev);
-    SST::Link* srcLink = lookupNode(memEvent->getSrc());
 
-    for (int i = 0; i < numHighNetPorts_; i++) {
-        if (highNetPorts_[i] == srcLink) continue;
-        highNetPorts_[i]->send(memEvent->clone());
-    }
-
-    for (int i = 0; i < numLowNetPorts_; i++) {
-        if (lowNetPorts_[i] == srcLink) continue;
-        lowNetPorts_[i]->send(memEvent->clone());
+    for (int i = 0; i < (int)ports_.size(); i++) {
+        if (i == srcPort) continue;
+        ports_[i]->send(memEvent->clone());
     }
 
     delete memEvent;
@@ -103,7 +101,7 @@ void Bus::broadcastEvent(SST::Event* ev) {
 
 
 
-void Bus::sendSingleEvent(SST::Event* ev) {
+void Bus::sendSingleEvent(SST::Event* ev, int srcPort) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
 #ifdef __SST_DEBUG_OUTPUT__
     if (is_debug_event(event)) {
@@ -112,7 +110,25 @@ void Bus::sendSingleEvent(SST::Event* ev) {
         fflush(stdout);
     }
 #endif
-    SST::Link* dstLink = lookupNode(event->getDst());
+    /* Events cross the bus, so the destination is on the other side from the source.
+     * If that side has a single port, there is nothing to look up. The first event from
+     * each source (every event in debug builds) is still looked up to catch a bad destination. */
+    int dstPort = srcPort < numHighNetPorts_ ? lowPort_ : highPort_;
+#ifdef __SST_DEBUG_OUTPUT__
+    bool checkDst = true;
+#else
+    bool checkDst = !dstChecked_[srcPort];
+#endif
+    if (dstPort == NO_PORT) {
+        dstPort = lookupNode(event->getDst());
+    } else if (checkDst) {
+        int mappedPort = lookupNode(event->getDst());
+        if (mappedPort != dstPort)
+            dbg_.fatal(CALL_INFO, -1, "%s, Error: event from port %d is for %s, which is on port %d, not on the other side of the bus (port %d). Event: %s\n",
+                    getName().c_str(), srcPort, event->getDst().c_str(), mappedPort, dstPort, event->getVerboseString().c_str());
+        dstChecked_[srcPort] = true;
+    }
+    SST::Link* dstLink = ports_[dstPort];
     MemEventBase* forwardEvent = event->clone();
     dstLink->send(forwardEvent);
 
@@ -123,18 +139,18 @@ void Bus::sendSingleEvent(SST::Event* ev) {
  * Helper functions
  *---------------------------------------*/
 
-void Bus::mapNodeEntry(const std::string& name, SST::Link* link) {
-    std::map<std::string, SST::Link*>::iterator it = nameMap_.find(name);
+void Bus::mapNodeEntry(const std::string& name, int port) {
+    std::unordered_map<std::string, int>::iterator it = nameMap_.find(name);
     if (it != nameMap_.end() ) {
-        if (it->second != link)
+        if (it->second != port)
             dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus attempting to map node that has already been mapped\n", getName().c_str());
         return;
     }
-    nameMap_[name] = link;
+    nameMap_[name] = port;
 }
 
-SST::Link* Bus::lookupNode(const std::string& name) {
-    std::map<std::string, SST::Link*>::iterator it = nameMap_.find(name);
+int Bus::lookupNode(const std::string& name) {
+    std::unordered_map<std::string, int>::iterator it = nameMap_.find(name);
     if (nameMap_.end() == it) {
         dbg_.fatal(CALL_INFO, -1, "%s, Error: Bus lookup of node %s returned no mapping\n", getName().c_str(), name.c_str());
     }
@@ -146,10 +162,11 @@ void Bus::configureLinks() {
     std::string linkprefix = "high_network_";
     std::string linkname = linkprefix + "0";
     while (isPortConnected(linkname)) {
-        link = configureLink(linkname, new Event::Handler<Bus>(this, &Bus::processIncomingEvent));
+        link = configureLink(linkname, new Event::Handler<Bus, int>(this, &Bus::processIncomingEvent, ports_.size()));
         if (!link)
             dbg_.fatal(CALL_INFO, -1, "%s, Error: unable to configure link on port '%s'\n", getName().c_str(), linkname.c_str());
         highNetPorts_.push_back(link);
+        ports_.push_back(link);
         numHighNetPorts_++;
         linkname = linkprefix + std::to_string(numHighNetPorts_);
     }
@@ -157,16 +174,21 @@ void Bus::configureLinks() {
     linkprefix = "low_network_";
     linkname = linkprefix + "0";
     while (isPortConnected(linkname)) {
-        link = configureLink(linkname, "50 ps", new Event::Handler<Bus>(this, &Bus::processIncomingEvent));
+        link = configureLink(linkname, "50 ps", new Event::Handler<Bus, int>(this, &Bus::processIncomingEvent, ports_.size()));
         if (!link)
             dbg_.fatal(CALL_INFO, -1, "%s, Error: unable to configure link on port '%s'\n", getName().c_str(), linkname.c_str());
         lowNetPorts_.push_back(link);
+        ports_.push_back(link);
         numLowNetPorts_++;
         linkname = linkprefix + std::to_string(numLowNetPorts_);
     }
 
     if (numLowNetPorts_ < 1 || numHighNetPorts_ < 1) dbg_.fatal(CALL_INFO, -1,"couldn't find number of Ports (numPorts)\n");
 
+    highPort_ = numHighNetPorts_ == 1 ? 0 : NO_PORT;
+    lowPort_ = numLowNetPorts_ == 1 ? numHighNetPorts_ : NO_PORT;
+    dstChecked_.resize(ports_.size(), false);
+
 }
 
 void Bus::configureParameters(SST::Params& params) {
@@ -189,8 +211,10 @@ void Bus::configureParameters(SST::Params& params) {
     broadcast_    = params.find<bool>("broadcast", 0);
     fanout_       = params.find<bool>("fanout", 0);  /* TODO:  Fanout: Only send messages to lower level caches */
     drain_        = params.find<bool>("drain_bus", false);
+    lanes_        = params.find<uint64_t>("lanes", 1);
 
     if (busFrequency_ == "Invalid") dbg_.fatal(CALL_INFO, -1, "Bus Frequency was not specified\n");
+    if (lanes_ == 0) dbg_.fatal(CALL_INFO, -1, "Invalid param(%s): lanes - must be at least 1\n", getName().c_str());
     
      /* Multiply Frequency times two.  This is because an SST Bus components has
         2 SST Links (highNEt & LowNet) and thus it takes a least 2 cycles for any
@@ -214,7 +238,7 @@ void Bus::init(unsigned int phase) {
 
             if (memEvent && memEvent->getCmd() == Command::NULLCMD) {
                 dbg_.debug(_L10_, "bus %s broadcasting upper event to lower ports (%d): %s\n", getName().c_str(), numLowNetPorts_, memEvent->getVerboseString().c_str());
-                mapNodeEntry(memEvent->getSrc(), highNetPorts_[i]);
+                mapNodeEntry(memEvent->getSrc(), i);
                 for (int k = 0; k < numLowNetPorts_; k++)
                     lowNetPorts_[k]->sendUntimedData(memEvent->clone());
             } else if (memEvent) {
@@ -232,7 +256,7 @@ void Bus::init(unsigned int phase) {
             if (!memEvent) delete memEvent;
             else if (memEvent->getCmd() == Command::NULLCMD) {
                 dbg_.debug(_L10_, "bus %s broadcasting lower event to upper ports (%d): %s\n", getName().c_str(), numHighNetPorts_, memEvent->getVerboseString().c_str());
-                mapNodeEntry(memEvent->getSrc(), lowNetPorts_[i]);
+                mapNodeEntry(memEvent->getSrc(), numHighNetPorts_ + i);
                 for (int i = 0; i < numHighNetPorts_; i++) {
                     highNetPorts_[i]->sendUntimedData(memEvent->clone());
                 }
@@ -18,6 +18,7 @@
 
 #include <queue>
 #include <map>
+#include <unordered_map>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -55,6 +56,7 @@ public:
             {"bus_latency_cycles",  "(uint) Bus latency in cycles", "0"},
             {"idle_max",            "(uint) Bus temporarily turns off clock after this number of idle cycles", "6"},
             {"drain_bus",           "(bool) Drain bus on every cycle", "0"},
+            {"lanes",               "(uint) Number of events the bus transfers per cycle. Ignored if drain_bus is set.", "1"},
             {"debug",               "(uint) Output location for debug statements. Requires core configuration flag '--enable-debug'. --0[None], 1[STDOUT], 2[STDERR], 3[FILE]--", "0"},
             {"debug_level",         "(uint) Debugging level: 0 to 10", "0"},
             {"debug_addr",          "(comma separated uints) Address(es) to be debugged. Leave empty for all, otherwise specify one or more comma separated values. Start and end string with brackets", ""} )
@@ -75,13 +77,13 @@ public:
 private:
 
     /** Adds event to the incoming event queue.  Reregisters clock if needed */
-    void processIncomingEvent(SST::Event *ev);
+    void processIncomingEvent(SST::Event *ev, int port);
 
     /** Send event to a single destination */
-    void sendSingleEvent(SST::Event *ev);
+    void sendSingleEvent(SST::Event *ev, int srcPort);
 
-    /** Broadcast event to all ports */
-    void broadcastEvent(SST::Event *ev);
+    /** Broadcast event to all ports except the one it arrived on */
+    void broadcastEvent(SST::Event *ev, int srcPort);
 
     /**  Clock Handler */
     bool clockTick(Cycle_t);
@@ -90,8 +92,16 @@ private:
     void configureParameters(SST::Params&);
     void configureLinks();
 
-    void mapNodeEntry(const std::string&, SST::Link*);
-    SST::Link* lookupNode(const std::string&);
+    void mapNodeEntry(const std::string&, int port);
+    int lookupNode(const std::string&);
+
+    static const int NO_PORT = -1;
+
+    /* An event waiting for the bus and the port it arrived on */
+    struct BusEntry {
+        SST::Event* event;
+        int srcPort;
+    };
 
 
     Output                          dbg_;
@@ -101,6 +111,7 @@ private:
     uint64_t                        idleCount_;
     uint64_t                        latency_;
     uint64_t                        idleMax_;
+    uint64_t                        lanes_;
     bool                            fanout_;
     bool                            broadcast_;
     bool                            busOn_;
@@ -112,8 +123,12 @@ private:
     std::string                     bus_latency_cycles_;
     std::vector<SST::Link*>         highNetPorts_;
     std::vector<SST::Link*>         lowNetPorts_;
-    std::map<string,SST::Link*>     nameMap_;
-    std::queue<SST::Event*>         eventQueue_;
+    std::vector<SST::Link*>         ports_;         // Indexed by port ID: high network ports, then low network ports
+    std::unordered_map<string,int>  nameMap_;       // Endpoint name -> port ID, built during init
+    int                             highPort_;      // Port ID for all events headed up if there is one high network port, else NO_PORT
+    int                             lowPort_;       // Port ID for all events headed down if there is one low network port, else NO_PORT
+    std::vector<bool>               dstChecked_;    // Per source port, the destination of an event from it has been checked against highPort_/lowPort_
+    std::queue<BusEntry>            eventQueue_;
 
 };
 
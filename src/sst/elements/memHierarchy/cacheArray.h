@@ -25,6 +25,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/lineTypes.h"
+#include "sst/elements/memHierarchy/flatTagArray.h"
 
 using namespace std;
 
@@ -33,6 +34,12 @@ namespace SST { namespace MemHierarchy {
 /*
  * CacheArrays should  be templated on a line type
  * See the comment in lineTypes.h for the required API
+ *
+ * Two tag layouts are supported (see setLayout()):
+ *  default: lookups walk the line objects of the set and compare getAddr()
+ *  flat:    line addresses are mirrored in a contiguous, 64B-aligned block per set
+ *           (FlatTagArray) and compared there, optionally with SIMD. The line
+ *           objects remain the owners of coherence state and data.
  */
 
 template <class T>
@@ -51,7 +58,16 @@ class CacheArray {
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        FlatTagArray*   flatTags_;  // Non-null if using the flat layout
+        bool            replAddr_;  // Replacement policy wants line addresses on update
+
+        inline void touchLine(unsigned int index, Addr addr) {
+            if (replAddr_)
+                replacementMgr_->updateWithAddr(index, lines_[index]->getReplacementInfo(), addr);
+            else
+                replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+        }
     public:
 
         CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
@@ -88,6 +104,8 @@ class CacheArray {
     /**** Configuration and output */
         void setSliceAware(Addr size, Addr step);
         void setBanked(unsigned int numBanks);
+        /** Select tag layout: 'default' or 'flat'. SIMD compare only applies to 'flat' and requires an AVX2 build */
+        void setLayout(std::string layout, bool simd);
         void printCacheArray(Output &out);
 };
 
@@ -95,7 +113,9 @@ class CacheArray {
 
 template <class T>
 CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
-    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
+    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash), flatTags_(nullptr) {
+
+    replAddr_ = replacementMgr_->usesAddress();
 
     // Error check parameters
     if (numLines_ == 0)
@@ -126,15 +146,17 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     }
 
     // Construct rInfo
+    rInfo.resize(numSets_);
     for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
+        rInfo[i].reserve(associativity);
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    ReplacementInfo * info = rInfo[0].front();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
+    for (unsigned int i = 0; i < numLines_; i++)
+        replacementMgr_->attach(i, lines_[i]->getReplacementInfo());
 
     setStates = new State[associativity_];
 }
@@ -146,6 +168,7 @@ CacheArray<T>::~CacheArray() {
     delete replacementMgr_;
     delete hash_;
     delete [] setStates;
+    delete flatTags_;
 }
 
 template <class T>
@@ -163,10 +186,19 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
     int setBegin = set * associativity_;
     int setEnd = setBegin + associativity_;
 
+    if (flatTags_) {
+        int i = flatTags_->find(set, addr);
+        if (i == FlatTagArray::NotFound)
+            return nullptr;
+        if (updateReplacement)
+            touchLine(i, addr);
+        return lines_[i];
+    }
+
     for (int i = setBegin; i < setEnd; i++) {
         if (lines_[i]->getAddr() == addr) {
             if (updateReplacement)
-                replacementMgr_->update(i, lines_[i]->getReplacementInfo());
+                touchLine(i, addr);
             return lines_[i];
         }
     }
@@ -189,7 +221,9 @@ void CacheArray<T>::replace(Addr addr, T* candidate) {
     replacementMgr_->replaced(index);
     candidate->reset();
     candidate->setAddr(addr);
-    replacementMgr_->update(index, lines_[index]->getReplacementInfo());
+    if (flatTags_)
+        flatTags_->setTag(index, addr);
+    touchLine(index, addr);
 }
 
 template <class T>
@@ -212,6 +246,26 @@ void CacheArray<T>::setBanked(unsigned int numBanks) {
     banks_ = numBanks;
 }
 
+template <class T>
+void CacheArray<T>::setLayout(std::string layout, bool simd) {
+    to_lower(layout);
+    delete flatTags_;
+    flatTags_ = nullptr;
+
+    if (layout == "default")
+        return;
+    if (layout != "flat")
+        dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: invalid array layout '%s'. Options are 'default' and 'flat'.\n", layout.c_str());
+
+    flatTags_ = new FlatTagArray(numSets_, associativity_, simd);
+    if (!flatTags_->valid())
+        dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: unable to allocate flat tag array for %u sets.\n", numSets_);
+
+    // Mirror any addresses already assigned
+    for (unsigned int i = 0; i < numLines_; i++)
+        flatTags_->setTag(i, lines_[i]->getAddr());
+}
+
 template <class T>
 void CacheArray<T>::printCacheArray(Output &out) {
     for (unsigned int i = 0; i < numLines_; i++) {
@@ -178,6 +178,8 @@ bool Cache::clockTick(Cycle_t time) {
             statPrefetchDrop->addData(1);
             coherenceMgr_->removeRequestRecord(prefetchBuffer_.front()->getID());
 	    MemEventBase* ev = prefetchBuffer_.front();
+            for (int i = 0; i < listeners_.size(); i++)
+                listeners_[i]->notifyPrefetchResult(ev->getRoutingAddress(), PrefetchResult::DROPPED);
 	    prefetchBuffer_.pop();
 	    delete ev;
         }
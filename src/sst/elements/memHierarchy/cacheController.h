@@ -69,6 +69,7 @@ public:
             {"noninclusive_directory_entries", "(uint) Number of entries in the directory. Must be at least 1 if the non-inclusive directory exists.", "0"},
             {"noninclusive_directory_associativity", "(uint) For a set-associative directory, number of ways.", "1"},
             {"mshr_num_entries",        "(int) Number of MSHR entries. Not valid for L1s because L1 MSHRs assumed to be sized for the CPU's load/store queue. Setting this to -1 will create a very large MSHR.", "-1"},
+            {"mshr_type",               "(string) MSHR implementation. Options: 'map' (ordered map of per-address lists) or 'hash' (hash table with preallocated entries, faster at high miss rates). Behavior is identical.", "map"},
             {"tag_access_latency_cycles",
                 "(uint) Latency (in cycles) to access tag portion only of cache. Paid by misses and coherence requests that don't need data. If not specified, defaults to access_latency_cycles","access_latency_cycles"},
             {"mshr_latency_cycles",
@@ -90,6 +91,8 @@ public:
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
+            {"array_layout",            "(string) Tag storage layout for the cache (and directory) array. Options: 'default' (walk line objects), 'flat' (contiguous 64B-aligned tag block per set). Results are identical, 'flat' is faster for large/highly associative arrays", "default"},
+            {"array_simd",              "(bool) For array_layout='flat', compare tags several ways at a time with SIMD instructions. Ignored unless memHierarchy was built with AVX2 support", "true"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
             {"network_bw",                  "MOVED - Now a member of the MemNIC subcomponent.", "80GiB/s"}, // Remove 9.0
@@ -22,6 +22,7 @@
 #include "util.h"
 #include "cacheListener.h"
 #include "mshr.h"
+#include "mshrHash.h"
 #include "memLinkBase.h"
 
 using namespace SST::MemHierarchy;
@@ -156,6 +157,8 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("dassoc", params.find<std::string>("noninclusive_directory_associativity", "0"));
     coherenceParams.insert("drpolicy", params.find<std::string>("noninclusive_directory_repl", "lru"));
     coherenceParams.insert("cache_frequency", params.find<std::string>("cache_frequency", "")); // Not used by all managers, already error checked
+    coherenceParams.insert("array_layout", params.find<std::string>("array_layout", "default"));
+    coherenceParams.insert("array_simd", params.find<std::string>("array_simd", "true"));
     bool prefetch = (statPrefetchRequest != nullptr);
 
     if (!L1) {
@@ -640,7 +643,13 @@ uint64_t Cache::createMSHR(Params &params, uint64_t accessLatency, bool L1) {
     if (mshrSize == 1 || mshrSize == 0)
         out_->fatal(CALL_INFO, -1, "Invalid param: mshr_num_entries - MSHR requires at least 2 entries to avoid deadlock. You specified %d\n", mshrSize);
 
-    mshr_ = loadComponentExtension<MSHR>(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    std::string mshrType = params.find<std::string>("mshr_type", "map");
+    if (mshrType == "map")
+        mshr_ = loadComponentExtension<MSHR>(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    else if (mshrType == "hash")
+        mshr_ = loadComponentExtension<HashMSHR>(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    else
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: mshr_type - must be 'map' or 'hash'. You specified '%s'\n", getName().c_str(), mshrType.c_str());
 
     if (mshrLatency > 0 && found)
         return mshrLatency;
@@ -38,6 +38,16 @@ namespace MemHierarchy {
     enum NotifyAccessType{ READ, WRITE, EVICT, PREFETCH };
     enum NotifyResultType{ HIT, MISS, NA };
 
+    /* What became of a line the cache prefetched on behalf of its listeners
+     *  USEFUL      - a demand access used the line (also reported after LATE)
+     *  LATE        - a demand access arrived while the prefetch was still in flight
+     *  EVICTED     - the line was evicted before any demand access used it
+     *  INVALIDATED - the line was invalidated before any demand access used it
+     *  REDUNDANT   - the line was already present when the prefetch arrived
+     *  DROPPED     - the cache discarded the prefetch without issuing it
+     */
+    enum class PrefetchResult { USEFUL, LATE, EVICTED, INVALIDATED, REDUNDANT, DROPPED };
+
 class CacheListenerNotification {
 public:
     CacheListenerNotification(const Addr tAddr, const Addr pAddr, const Addr vAddr,
@@ -86,6 +96,9 @@ public:
 
     virtual void printStats(Output &UNUSED(out)) {}
     virtual void notifyAccess(const CacheListenerNotification& UNUSED(notify)) {}
+    /* Feedback on prefetches issued through the response callback. The cache cannot tell which
+     * of several listeners requested a line, so every listener sees the results for all of them. */
+    virtual void notifyPrefetchResult(Addr UNUSED(addr), PrefetchResult UNUSED(result)) {}
     virtual void registerResponseCallback(Event::HandlerBase *handler) { delete handler; }
 };
 
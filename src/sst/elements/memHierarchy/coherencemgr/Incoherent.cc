@@ -78,10 +78,11 @@ bool Incoherent::handleGetS(MemEvent * event, bool inMSHR) {
             }
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1);
+                notifyListenerOfPrefetchResult(addr, PrefetchResult::REDUNDANT);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 return DONE;
             }
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             recordLatencyType(event->getID(), LatType::HIT);
 
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
@@ -154,7 +155,7 @@ bool Incoherent::handleGetX(MemEvent * event, bool inMSHR) {
                     stat_hit[2][(int)inMSHR]->addData(1);
                 stat_hits->addData(1);
             }
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
             line->setTimestamp(sendTime);
             recordLatencyType(event->getID(), LatType::HIT);
@@ -210,7 +211,7 @@ bool Incoherent::handleFlushLine(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), &(event->readPayload()), event->getDirty(), 0);
                 mshr_->setInProgress(addr);
             }
             break;
@@ -260,14 +261,14 @@ bool Incoherent::handleFlushLineInv(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), &(event->readPayload()), event->getDirty(), 0);
                 mshr_->setInProgress(addr);
             }
             break;
         case E:
         case M:
             if (status == MemEventStatus::OK) {
-                recordPrefetchResult(line, statPrefetchEvict);
+                recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
                 forwardFlush(event, true, line->getData(), state == M, line->getTimestamp());
                 line->setState(I_B);
                 mshr_->setInProgress(addr);
@@ -303,7 +304,7 @@ bool Incoherent::handlePutE(MemEvent * event, bool inMSHR) {
         case I:
             status = allocateLine(event, line, inMSHR);
             if (status == MemEventStatus::OK) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 line->setState(E);
                 if (sendWritebackAck_)
                     sendWritebackAck(event);
@@ -346,7 +347,7 @@ bool Incoherent::handlePutM(MemEvent * event, bool inMSHR) {
         case I:
             status = allocateLine(event, line, inMSHR);
             if (status == MemEventStatus::OK) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 line->setState(M);
                 if (sendWritebackAck_)
                     sendWritebackAck(event);
@@ -356,7 +357,7 @@ bool Incoherent::handlePutM(MemEvent * event, bool inMSHR) {
         case E:
             line->setState(M);
         case M:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
             if (sendWritebackAck_)
                 sendWritebackAck(event);
             cleanUpAfterRequest(event, inMSHR);
@@ -391,11 +392,11 @@ bool Incoherent::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    sendResponseUp(req, &event->getPayload(), true, 0);
+    sendResponseUp(req, &event->readPayload(), true, 0);
 
     if (line) {
         line->setState(E);
-        line->setData(event->getPayload(), 0);
+        line->setData(event->readPayload(), 0);
         // Has to be a local prefetch
         line->setPrefetch(true);
         recordPrefetchLatency(req->getID(), LatType::MISS);
@@ -425,7 +426,7 @@ bool Incoherent::handleGetXResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    sendResponseUp(req, &event->getPayload(), true, 0);
+    sendResponseUp(req, &event->readPayload(), true, 0);
 
     cleanUpAfterResponse(event);
 
@@ -620,7 +621,7 @@ bool Incoherent::handleEviction(Addr addr, PrivateCacheLine* &line, dbgin &diStr
             return false;
     }
 
-    recordPrefetchResult(line, statPrefetchEvict);
+    recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
     return true;
 }
 
@@ -681,7 +682,7 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
     if (state == E || state == M) {
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
         }
 
         event->setEvict(false);
@@ -692,7 +693,7 @@ void Incoherent::doEvict(MemEvent * event, PrivateCacheLine * line) {
  * Event creation and send
  ***********************************************************************************************************/
 
-SimTime_t Incoherent::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
+SimTime_t Incoherent::sendResponseUp(MemEvent * event, const vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -738,7 +739,7 @@ void Incoherent::sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty)
 }
 
 
-void Incoherent::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+void Incoherent::forwardFlush(MemEvent * event, bool evict, const std::vector<uint8_t>* data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
@@ -791,10 +792,11 @@ MemEventInitCoherence * Incoherent::getInitCoherenceEvent() {
     return new MemEventInitCoherence(cachename_, Endpoint::Cache, false, false, false, lineSize_, true);
 }
 
-void Incoherent::recordPrefetchResult(PrivateCacheLine * line, Statistic<uint64_t>* stat) {
+void Incoherent::recordPrefetchResult(PrivateCacheLine * line, Statistic<uint64_t>* stat, PrefetchResult result) {
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetchResult(line->getAddr(), result);
     }
 }
 
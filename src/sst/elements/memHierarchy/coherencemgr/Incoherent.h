@@ -148,6 +148,7 @@ public:
 
         cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
         stat_eventState[(int)Command::GetS][E] = registerStatistic<uint64_t>("stateEvent_GetS_E");
@@ -303,18 +304,18 @@ private:
 
     void doEvict(MemEvent * event, PrivateCacheLine * line);
 
-    SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = true);
+    SimTime_t sendResponseUp(MemEvent * event, const vector<uint8_t> * data, bool inMSHR, SimTime_t time, Command cmd = Command::NULLCMD, bool success = true);
 
     void sendWriteback(Command cmd, PrivateCacheLine * line, bool dirty);
 
-    void forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t> * data, bool dirty, uint64_t time);
+    void forwardFlush(MemEvent * event, bool evict, const std::vector<uint8_t> * data, bool dirty, uint64_t time);
 
     void sendWritebackAck(MemEvent * event);
 
     void forwardByAddress(MemEventBase* ev, Cycle_t timestamp);
     void forwardByDestination(MemEventBase* ev, Cycle_t timestamp);
 
-    void recordPrefetchResult(PrivateCacheLine * line, Statistic<uint64_t> * stat);
+    void recordPrefetchResult(PrivateCacheLine * line, Statistic<uint64_t> * stat, PrefetchResult result);
 
     void printLine(Addr addr);
 
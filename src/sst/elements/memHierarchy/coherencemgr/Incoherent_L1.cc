@@ -83,12 +83,12 @@ bool IncoherentL1::handleGetS(MemEvent* event, bool inMSHR){
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
             }
             if (localPrefetch) {
-                recordPrefetchResult(line, statPrefetchRedundant);
+                recordPrefetchResult(line, statPrefetchRedundant, PrefetchResult::REDUNDANT);
                 cleanUpAfterRequest(event, inMSHR);
                 break;
             }
 
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             recordLatencyType(event->getID(), LatType::HIT);
 
             if (event->isLoadLink())
@@ -170,7 +170,7 @@ bool IncoherentL1::handleGetX(MemEvent* event, bool inMSHR) {
             line->setState(M);
         case M:
             // Profile
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             if (!inMSHR || !mshr_->getProfiled(addr)) {
                 notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::HIT);
                 recordLatencyType(event->getID(), LatType::HIT);
@@ -181,7 +181,7 @@ bool IncoherentL1::handleGetX(MemEvent* event, bool inMSHR) {
 
             // Handle
             if (!event->isStoreConditional() || line->isAtomic(event->getThreadID())) { /* Don't write on a non-atomic SC */
-                line->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                line->setData(event->readPayload(), event->getAddr() - event->getBaseAddr());
                 line->atomicEnd();
                 if (is_debug_addr(addr))
                     printDataValue(addr, line->getData(), true);
@@ -257,7 +257,7 @@ bool IncoherentL1::handleGetSX(MemEvent* event, bool inMSHR) {
             line->setState(M);
         case M:
             // Profile
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             if (!inMSHR || !mshr_->getProfiled(addr)) {
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
                 recordLatencyType(event->getID(), LatType::HIT);
@@ -386,7 +386,7 @@ bool IncoherentL1::handleFlushLineInv(MemEvent* event, bool inMSHR) {
     if (!mshr_->getProfiled(addr)) {
         stat_eventState[(int)Command::FlushLineInv][state]->addData(1);
         if (line)
-            recordPrefetchResult(line, statPrefetchEvict);
+            recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
         mshr_->setProfiled(addr);
     }
 
@@ -417,7 +417,7 @@ bool IncoherentL1::handleGetSResp(MemEvent * event, bool inMSHR) {
         eventDI.prefill(event->getID(), Command::GetSResp, (localPrefetch ? "-pref" : ""), addr, state);
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->readPayload(), 0);
     line->setState(E);
     if (is_debug_addr(addr))
         printDataValue(addr, line->getData(), false);
@@ -468,7 +468,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     req->setMemFlags(event->getMemFlags());
 
     // Set line data
-    line->setData(event->getPayload(), 0);
+    line->setData(event->readPayload(), 0);
     if (is_debug_addr(line->getAddr()))
         printDataValue(line->getAddr(), line->getData(), true);
 
@@ -481,7 +481,7 @@ bool IncoherentL1::handleGetXResp(MemEvent * event, bool inMSHR) {
     bool success = true;
     if (req->getCmd() == Command::GetX || req->getCmd() == Command::Write) {
         if (!req->isStoreConditional() || line->isAtomic(req->getThreadID())) {
-            line->setData(req->getPayload(), offset);
+            line->setData(req->readPayload(), offset);
             if (is_debug_addr(line->getAddr()))
                 printDataValue(line->getAddr(), line->getData(), true);
             line->atomicEnd();
@@ -738,7 +738,7 @@ bool IncoherentL1::handleEviction(Addr addr, L1CacheLine*& line) {
     }
 
     line->atomicEnd();
-    recordPrefetchResult(line, statPrefetchEvict);
+    recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
     return true;
 }
 
@@ -818,7 +818,7 @@ void IncoherentL1::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t IncoherentL1::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, bool success) {
+uint64_t IncoherentL1::sendResponseUp(MemEvent * event, const vector<uint8_t> * data, bool inMSHR, uint64_t time, bool success) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
 
@@ -962,10 +962,11 @@ void IncoherentL1::printLine(Addr addr) {
 }
 
 /* Record the result of a prefetch. important: assumes line is not null */
-void IncoherentL1::recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t> * stat) {
+void IncoherentL1::recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t> * stat, PrefetchResult result) {
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetchResult(line->getAddr(), result);
     }
 }
 
@@ -138,6 +138,7 @@ public:
 
         cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         llscBlockCycles_ = params.find<Cycle_t>("llsc_block_cycles", 0);
 
@@ -278,7 +279,7 @@ private:
     void forwardFlush(MemEvent * event, L1CacheLine * line, bool data);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool success = true);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent * event, L1CacheLine * line, bool data);
@@ -293,7 +294,7 @@ private:
 /* Miscellaneous */
 
     /* Statistics recording */
-    void recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t> * stat);
+    void recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t> * stat, PrefetchResult result);
     void recordLatency(Command cmd, int type, uint64_t timestamp);
 
     /* Debug output */
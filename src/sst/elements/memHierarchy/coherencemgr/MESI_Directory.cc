@@ -792,7 +792,7 @@ void MESIDirectory::handleFetchResp(MemEvent * ev, bool keepEvent) {
             dbg.fatal(CALL_INFO, -1, "%s, Error: Directory received %s but state is %s. Event: %s. Time = %" PRIu64 "ns, %" PRIu64 " cycles\n",
                     getName().c_str(), CommandString[(int)ev->getCmd()], StateString[state], ev->getVerboseString().c_str(), getCurrentSimTimeNano(), timestamp);
     }
-    respEv->setPayload(ev->getPayload());
+    respEv->setPayload(ev->getPayloadBuffer());
     profileResponseSent(respEv);
     if (reqEv->getCmd() == Command::FetchInv || reqEv->getCmd() == Command::ForceInv)
         memMsgQueue.insert(std::make_pair(timestamp + mshrLatency, respEv));
@@ -832,7 +832,7 @@ void MESIDirectory::handleFetchXResp(MemEvent * ev, bool keepEvent) {
     MemEvent * respEv = reqEv->makeResponse();
     entry->addSharer(node_id(reqEv->getSrc()));
 
-    respEv->setPayload(ev->getPayload());
+    respEv->setPayload(ev->getPayloadBuffer());
     profileResponseSent(respEv);
     sendEventToCaches(respEv, timestamp + mshrLatency);
 
@@ -1091,7 +1091,7 @@ void MESIDirectory::handleDataResponse(MemEvent * ev) {
     }
 
     respEv->setSize(cacheLineSize);
-    respEv->setPayload(ev->getPayload());
+    respEv->setPayload(ev->getPayloadBuffer());
     respEv->setMemFlags(ev->getMemFlags());
     profileResponseSent(respEv);
     sendEventToCaches(respEv, timestamp + mshrLatency);
@@ -1420,13 +1420,12 @@ void MESIDirectory::sendEntryToMemory(DirEntry *entry){
 MemEvent::id_type MESIDirectory::writebackData(MemEvent *data_event, Command wbCmd) {
     MemEvent *ev       = new MemEvent(getName(), data_event->getBaseAddr(), data_event->getBaseAddr(), wbCmd, cacheLineSize);
 
-    if(data_event->getPayload().size() != cacheLineSize) {
+    if(data_event->getPayloadBuffer().size() != cacheLineSize) {
 	dbg.fatal(CALL_INFO, -1, "%s, Error: Writing back data request but payload does not match cache line size of %uB. Event: %s. Time = %" PRIu64 "ns\n",
                 getName().c_str(), cacheLineSize, ev->getVerboseString().c_str(), getCurrentSimTimeNano());
     }
 
-    ev->setSize(data_event->getPayload().size());
-    ev->setPayload(data_event->getPayload());
+    ev->setPayload(data_event->getPayloadBuffer());
     ev->setDst(memoryName);
     profileRequestSent(ev);
 
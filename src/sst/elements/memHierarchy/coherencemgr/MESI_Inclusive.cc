@@ -93,6 +93,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
                 if (localPrefetch) {
                     statPrefetchRedundant->addData(1);
+                    notifyListenerOfPrefetchResult(addr, PrefetchResult::REDUNDANT);
                     recordPrefetchLatency(event->getID(), LatType::HIT);
                 } else {
                     recordLatencyType(event->getID(), LatType::HIT);
@@ -109,7 +110,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                 break;
             }
 
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             line->addSharer(event->getSrc());
 
             sendTime = sendResponseUp(event, line->getData(), inMSHR, line->getTimestamp());
@@ -130,6 +131,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                     stat_hits->addData(1);
                     notifyListenerOfAccess(event, NotifyAccessType::PREFETCH, NotifyResultType::HIT);
                     statPrefetchRedundant->addData(1);
+                    notifyListenerOfPrefetchResult(addr, PrefetchResult::REDUNDANT);
                     recordPrefetchLatency(event->getID(), LatType::HIT);
                 }
                 if (is_debug_event(event))
@@ -138,7 +140,7 @@ bool MESIInclusive::handleGetS(MemEvent * event, bool inMSHR) {
                 break;
             }
 
-            recordPrefetchResult(line, statPrefetchHit); // Accessed a prefetched line
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL); // Accessed a prefetched line
 
             if (line->hasOwner()) {
                 if (!inMSHR)
@@ -253,7 +255,7 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
                         notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
                         mshr_->setProfiled(addr);
                     }
-                    recordPrefetchResult(line, statPrefetchUpgradeMiss);
+                    recordPrefetchResult(line, statPrefetchUpgradeMiss, PrefetchResult::USEFUL);
                     recordLatencyType(event->getID(), LatType::UPGRADE);
 
                     sendTime = forwardMessage(event, lineSize_, 0, nullptr);
@@ -281,7 +283,7 @@ bool MESIInclusive::handleGetX(MemEvent * event, bool inMSHR) {
                     mshr_->setProfiled(addr);
             }
 
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
 
             if (line->hasOtherSharers(event->getSrc())) {
                 if (!inMSHR)
@@ -441,7 +443,7 @@ bool MESIInclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
         bool downgrade = (state == E || state == M);
         forwardFlush(event, line, downgrade);
         if (line) {
-            recordPrefetchResult(line, statPrefetchEvict);
+            recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
             if (state != I)
                 line->setState(S_B);
         }
@@ -567,7 +569,7 @@ bool MESIInclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
         }
         mshr_->setInProgress(addr);
         if (line)
-            recordPrefetchResult(line, statPrefetchEvict);
+            recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
         forwardFlush(event, line, state != I);
 
         if (state != I)
@@ -952,7 +954,7 @@ bool MESIInclusive::handleInv(MemEvent * event, bool inMSHR) {
     if (handle) {
         if (!inMSHR || mshr_->getProfiled(addr)) {
             stat_eventState[(int)Command::Inv][state]->addData(1);
-            recordPrefetchResult(line, statPrefetchInv);
+            recordPrefetchResult(line, statPrefetchInv, PrefetchResult::INVALIDATED);
             if (inMSHR) mshr_->setProfiled(addr);
         }
         if (line->hasSharers() && !inMSHR)
@@ -1071,7 +1073,7 @@ bool MESIInclusive::handleForceInv(MemEvent * event, bool inMSHR) {
 
     if ((handle || profile) && (!inMSHR || !mshr_->getProfiled(addr))) {
         stat_eventState[(int)Command::ForceInv][state]->addData(1);
-        recordPrefetchResult(line, statPrefetchInv);
+        recordPrefetchResult(line, statPrefetchInv, PrefetchResult::INVALIDATED);
         if (inMSHR || profile) mshr_->setProfiled(addr);
     }
 
@@ -1193,7 +1195,7 @@ bool MESIInclusive::handleFetchInv(MemEvent * event, bool inMSHR) {
 
     if ((handle || profile) && (!inMSHR || !mshr_->getProfiled(addr))) {
         stat_eventState[(int)Command::FetchInv][state]->addData(1);
-        recordPrefetchResult(line, statPrefetchInv);
+        recordPrefetchResult(line, statPrefetchInv, PrefetchResult::INVALIDATED);
         if (inMSHR || profile) mshr_->setProfiled(addr);
     }
 
@@ -1328,7 +1330,7 @@ bool MESIInclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->readPayload(), 0);
     line->setState(S);
 
     if (is_debug_addr(addr))
@@ -1377,7 +1379,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     switch (state) {
         case IS:
         {
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
 
             if (event->getDirty())  {
                 line->setState(M); // Sometimes get dirty data from a noninclusive cache
@@ -1407,7 +1409,7 @@ bool MESIInclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             break;
         }
         case IM:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
             if (is_debug_addr(line->getAddr()))
                 printDataValue(addr, line->getData(), true);
         case SM:
@@ -1864,7 +1866,7 @@ bool MESIInclusive::handleEviction(Addr addr, SharedCacheLine *& line) {
         mshr_->insertWriteback(line->getAddr(), false);
     }
 
-    recordPrefetchResult(line, statPrefetchEvict);
+    recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
     return evict;
 }
 
@@ -1964,10 +1966,10 @@ void MESIInclusive::retry(Addr addr) {
 
 State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State state) {
     State nState = state;
-    recordPrefetchResult(line, statPrefetchEvict);
+    recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
 
     if (event->getDirty()) {
-        line->setData(event->getPayload(), 0);
+        line->setData(event->readPayload(), 0);
         if (is_debug_addr(event->getBaseAddr())) {
                 printDataValue(event->getBaseAddr(), line->getData(), true);
         }
@@ -2001,7 +2003,7 @@ State MESIInclusive::doEviction(MemEvent * event, SharedCacheLine * line, State
  * Event creation and send
  ***********************************************************************************************************/
 
-SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+SimTime_t MESIInclusive::sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -2289,10 +2291,11 @@ void MESIInclusive::forwardByDestination(MemEventBase* ev, Cycle_t timestamp) {
  * Statistics and listeners
  ***********************************************************************************************************/
 
-void MESIInclusive::recordPrefetchResult(SharedCacheLine * line, Statistic<uint64_t> * stat) {
+void MESIInclusive::recordPrefetchResult(SharedCacheLine * line, Statistic<uint64_t> * stat, PrefetchResult result) {
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetchResult(line->getAddr(), result);
     }
 }
 
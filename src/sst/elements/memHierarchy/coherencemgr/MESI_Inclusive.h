@@ -261,6 +261,7 @@ public:
         HashFunction * ht = createHashFunction(params);
         cacheArray_ = new CacheArray<SharedCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         /* Statistics */
         stat_evict[I] =         registerStatistic<uint64_t>("evict_I");
@@ -558,7 +559,7 @@ private:
     void forwardFlush(MemEvent * event, SharedCacheLine * line, bool data);
 
     /** Send response up (towards processor) */
-    SimTime_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd = Command::NULLCMD, bool success = true);
+    SimTime_t sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t time, Command cmd = Command::NULLCMD, bool success = true);
 
     /** Send response down (towards memory) */
     void sendResponseDown(MemEvent * event, SharedCacheLine * line, bool data, bool evict);
@@ -581,7 +582,7 @@ private:
 
 /* Miscellaneous functions */
     /* Record prefetch statistics. Line cannot be null. */
-    void recordPrefetchResult(SharedCacheLine * line, Statistic<uint64_t> * stat);
+    void recordPrefetchResult(SharedCacheLine * line, Statistic<uint64_t> * stat, PrefetchResult result);
 
     /* Record latency */
     void recordLatency(Command cmd, int type, uint64_t latency);
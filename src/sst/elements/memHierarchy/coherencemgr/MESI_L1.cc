@@ -96,12 +96,13 @@ bool MESIL1::handleGetS(MemEvent * event, bool inMSHR) {
 
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1); // Unneccessary prefetch
+                notifyListenerOfPrefetchResult(addr, PrefetchResult::REDUNDANT);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
                 break;
             }
 
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
 
             if (event->isLoadLink()) {
                 line->atomicStart(timestamp_ + llscBlockCycles_, event->getThreadID());
@@ -220,7 +221,7 @@ bool MESIL1::handleGetX(MemEvent* event, bool inMSHR) {
                     stat_misses->addData(1);
                     mshr_->setProfiled(addr);
                 }
-                recordPrefetchResult(line, statPrefetchUpgradeMiss);
+                recordPrefetchResult(line, statPrefetchUpgradeMiss, PrefetchResult::USEFUL);
 
                 sendTime = forwardMessage(event, lineSize_, 0, nullptr, Command::GetX);
                 line->setState(SM);
@@ -233,7 +234,7 @@ bool MESIL1::handleGetX(MemEvent* event, bool inMSHR) {
         case E:
             line->setState(M);
         case M:
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             if (!inMSHR || !mshr_->getProfiled(addr)) {
                 notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::HIT);
                 recordLatencyType(event->getID(), LatType::HIT);
@@ -243,7 +244,7 @@ bool MESIL1::handleGetX(MemEvent* event, bool inMSHR) {
             }
 
             if (!event->isStoreConditional() || line->isAtomic(event->getThreadID())) { // Don't write on a non-atomic SC
-                line->setData(event->getPayload(), event->getAddr() - event->getBaseAddr());
+                line->setData(event->readPayload(), event->getAddr() - event->getBaseAddr());
                 line->atomicEnd();
                 if (is_debug_addr(addr))
                     printDataValue(addr, line->getData(), true);
@@ -344,7 +345,7 @@ bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
                     stat_misses->addData(1);
                     mshr_->setProfiled(addr);
                 }
-                recordPrefetchResult(line, statPrefetchUpgradeMiss);
+                recordPrefetchResult(line, statPrefetchUpgradeMiss, PrefetchResult::USEFUL);
 
                 sendTime = forwardMessage(event, lineSize_, 0, nullptr);
                 line->setState(SM);
@@ -356,7 +357,7 @@ bool MESIL1::handleGetSX(MemEvent* event, bool inMSHR) {
             break;
         case E:
         case M:
-            recordPrefetchResult(line, statPrefetchHit);
+            recordPrefetchResult(line, statPrefetchHit, PrefetchResult::USEFUL);
             if (!inMSHR || !mshr_->getProfiled(addr)) {
                 notifyListenerOfAccess(event, NotifyAccessType::READ, NotifyResultType::HIT);
                 recordLatencyType(event->getID(), LatType::HIT);
@@ -498,7 +499,7 @@ bool MESIL1::handleFlushLineInv(MemEvent* event, bool inMSHR) {
     if (!mshr_->getProfiled(addr)) {
         stat_eventState[(int)Command::FlushLineInv][state]->addData(1);
         if (line)
-            recordPrefetchResult(line, statPrefetchEvict);
+            recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
         mshr_->setProfiled(addr);
     }
 
@@ -570,7 +571,7 @@ bool MESIL1::handleInv(MemEvent* event, bool inMSHR) {
 
     stat_eventState[(int)Command::Inv][state]->addData(1);
     if (line)
-        recordPrefetchResult(line, statPrefetchInv);
+        recordPrefetchResult(line, statPrefetchInv, PrefetchResult::INVALIDATED);
 
     switch (state) {
         case S:
@@ -670,7 +671,7 @@ bool MESIL1::handleForceInv(MemEvent* event, bool inMSHR) {
 
     stat_eventState[(int)Command::ForceInv][state]->addData(1);
     if (line) {
-        recordPrefetchResult(line, statPrefetchInv);
+        recordPrefetchResult(line, statPrefetchInv, PrefetchResult::INVALIDATED);
 
         if (is_debug_event(event)) {
             eventDI.newst = line->getState();
@@ -750,7 +751,7 @@ bool MESIL1::handleFetchInv(MemEvent* event, bool inMSHR) {
     stat_eventState[(int)Command::FetchInv][state]->addData(1);
 
     if (line) {
-        recordPrefetchResult(line, statPrefetchInv);
+        recordPrefetchResult(line, statPrefetchInv, PrefetchResult::INVALIDATED);
 
         if (is_debug_event(event)) {
             eventDI.newst = line->getState();
@@ -848,7 +849,7 @@ bool MESIL1::handleGetSResp(MemEvent* event, bool inMSHR) {
     req->setMemFlags(event->getMemFlags()); // Copy MemFlags through
 
     // Update line
-    line->setData(event->getPayload(), 0);
+    line->setData(event->readPayload(), 0);
     line->setState(S);
     if (is_debug_addr(addr))
         printDataValue(addr, line->getData(), false);
@@ -906,7 +907,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
     switch (state) {
         case IS:
             {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
                     printDataValue(addr, line->getData(), true);
 
@@ -927,7 +928,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
                 break;
             }
         case IM:
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
             if (is_debug_addr(addr))
                 printDataValue(addr, line->getData(), true);
         case SM:
@@ -936,7 +937,7 @@ bool MESIL1::handleGetXResp(MemEvent* event, bool inMSHR) {
 
                 if (req->getCmd() == Command::Write || req->getCmd() == Command::GetX) {
                     if (!req->isStoreConditional() || line->isAtomic(req->getThreadID())) { // Normal or successful store-conditional
-                        line->setData(req->getPayload(), offset);
+                        line->setData(req->readPayload(), offset);
 
                         if (is_debug_addr(addr))
                             printDataValue(addr, line->getData(), true);
@@ -1261,7 +1262,7 @@ bool MESIL1::handleEviction(Addr addr, L1CacheLine*& line) {
     }
 
     line->atomicEnd();
-    recordPrefetchResult(line, statPrefetchEvict);
+    recordPrefetchResult(line, statPrefetchEvict, PrefetchResult::EVICTED);
     return true;
 }
 
@@ -1379,7 +1380,7 @@ void MESIL1::handleLoadLinkExpiration(SST::Event* ev) {
  *
  *  Return: time that the requested cacheline can again be accessed
  */
-uint64_t MESIL1::sendResponseUp(MemEvent* event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success) {
+uint64_t MESIL1::sendResponseUp(MemEvent* event, const vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success) {
     Command cmd = event->getCmd();
     MemEvent * responseEvent = event->makeResponse();
     
@@ -1526,10 +1527,11 @@ void MESIL1::forwardByDestination(MemEventBase* ev, Cycle_t ts) {
  ***********************************************************************************************************/
 
 /* Record result of a prefetch. Important: assumes line is not null */
-void MESIL1::recordPrefetchResult(L1CacheLine* line, Statistic<uint64_t>* stat) {
+void MESIL1::recordPrefetchResult(L1CacheLine* line, Statistic<uint64_t>* stat, PrefetchResult result) {
     if (line->getPrefetch()) {
         stat->addData(1);
         line->setPrefetch(false);
+        notifyListenerOfPrefetchResult(line->getAddr(), result);
     }
 }
 
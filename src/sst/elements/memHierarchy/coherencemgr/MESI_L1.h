@@ -208,6 +208,7 @@ public:
 
         cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         // Register statistics
         stat_eventState[(int)Command::GetS][I] =      registerStatistic<uint64_t>("stateEvent_GetS_I");
@@ -417,7 +418,7 @@ private:
     void handleLoadLinkExpiration(SST::Event* ev);
 
     /** Event send */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t time, bool success = true);
     void sendResponseDown(MemEvent * event, L1CacheLine * line, bool data);
     void forwardFlush(MemEvent * event, L1CacheLine * line, bool evict);
     void sendWriteback(Command cmd, L1CacheLine * line, bool dirty);
@@ -426,7 +427,7 @@ private:
     void forwardByDestination(MemEventBase* ev, Cycle_t timestamp);
 
     /** Statistics/Listeners */
-    inline void recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t>* stat);
+    inline void recordPrefetchResult(L1CacheLine * line, Statistic<uint64_t>* stat, PrefetchResult result);
     void recordLatency(Command cmd, int type, uint64_t latency);
     void eventProfileAndNotify(MemEvent * event, State state, NotifyAccessType type, NotifyResultType result, bool inMSHR);
 
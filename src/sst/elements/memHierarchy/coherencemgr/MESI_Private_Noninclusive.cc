@@ -233,7 +233,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0);
+                forwardFlush(event, event->getEvict(), &(event->readPayload()), event->getDirty(), 0);
                 event->setEvict(false);
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
@@ -241,7 +241,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                     mshr_->setProfiled(addr);
                 }
             } else if (mshr_->getAcksNeeded(addr) != 0 && event->getEvict()) {
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->getPayloadBuffer(), event->getDirty());
                 event->setEvict(false);
                 if ((static_cast<MemEvent*>(mshr_->getFrontEvent(addr)))->getCmd() == Command::FetchInvX) {
                     responses.erase(addr);
@@ -269,7 +269,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                     line->setOwned(false);
                     line->setShared(true);
                     if (event->getDirty()) {
-                        line->setData(event->getPayload(), 0);
+                        line->setData(event->readPayload(), 0);
                         if (is_debug_addr(addr))
                             printDataValue(line->getAddr(), line->getData(), true);
                     }
@@ -290,7 +290,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
                 line->setOwned(false);
                 line->setShared(true);
                 if (event->getDirty()) {
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->readPayload(), 0);
                     if (is_debug_addr(addr))
                         printDataValue(line->getAddr(), line->getData(), true);
                     line->setState(M_Inv);
@@ -304,7 +304,7 @@ bool MESIPrivNoninclusive::handleFlushLine(MemEvent * event, bool inMSHR) {
             line->setOwned(false);
             line->setShared(true);
             if (event->getDirty()) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
                     printDataValue(line->getAddr(), line->getData(), true);
                 line->setState(M_Inv);
@@ -352,7 +352,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             if (inMSHR && mshr_->getInProgress(addr))
                 break; // Triggered an unneccessary retry
             if (status == MemEventStatus::OK) {
-                forwardFlush(event, event->getEvict(), &(event->getPayload()), event->getDirty(), 0); // No need to evict since we didn't race
+                forwardFlush(event, event->getEvict(), &(event->readPayload()), event->getDirty(), 0); // No need to evict since we didn't race
                 mshr_->setInProgress(addr);
                 if (!mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::FlushLineInv][I]->addData(1);
@@ -375,7 +375,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                     break;
 
                 // Copy data in and update state to resolve race with conflicting event
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->getPayloadBuffer(), event->getDirty());
                 if (race->getCmd() == Command::FetchInvX) {
                     event->setDirty(false);
                 } else if (race->getCmd() != Command::Fetch) { // FetchInv, ForceInv, or Inv
@@ -407,7 +407,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
                     line->setOwned(false);
                     line->setShared(false);
                     if (event->getDirty()) {
-                        line->setData(event->getPayload(), 0);
+                        line->setData(event->readPayload(), 0);
                         line->setState(M);
                         if (is_debug_addr(addr))
                             printDataValue(line->getAddr(), line->getData(), true);
@@ -437,7 +437,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             line->setOwned(false);
             line->setShared(false);
             if (event->getDirty()) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 line->setState(M);
                 if (is_debug_addr(addr))
                     printDataValue(line->getAddr(), line->getData(), true);
@@ -456,7 +456,7 @@ bool MESIPrivNoninclusive::handleFlushLineInv(MemEvent * event, bool inMSHR) {
             line->setOwned(false);
             line->setShared(false);
             if (event->getDirty()) {
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
                     printDataValue(line->getAddr(), line->getData(), true);
             }
@@ -502,14 +502,14 @@ bool MESIPrivNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (!inMSHR && mshr_->exists(addr)) { // Raced with something; must be an Inv/Fetch since there can only be one cache above us
-                mshr_->setData(addr, event->getPayload(), false);
+                mshr_->setData(addr, event->getPayloadBuffer(), false);
                 responses.erase(addr);
                 mshr_->decrementAcksNeeded(addr);
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::Fetch) {
                     status = allocateLine(event, line, false);
                     if (status == MemEventStatus::OK) {
                         line->setState(S);
-                        line->setData(event->getPayload(), 0);
+                        line->setData(event->readPayload(), 0);
                         if (is_debug_addr(addr))
                             printDataValue(line->getAddr(), line->getData(), true);
                         mshr_->clearData(addr);
@@ -526,7 +526,7 @@ bool MESIPrivNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     line->setState(S);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->readPayload(), 0);
                     if (is_debug_addr(addr))
                         printDataValue(line->getAddr(), line->getData(), true);
                     if (mshr_->hasData(addr)) mshr_->clearData(addr);
@@ -608,13 +608,13 @@ bool MESIPrivNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
-                    mshr_->setData(addr, event->getPayload(), false);
+                    mshr_->setData(addr, event->getPayloadBuffer(), false);
                     event->setCmd(Command::PutS);
                     event->setDirty(false);
                     retry(addr);
                     status = allocateMSHR(event, false, 1, true);
                 } else {
-                    mshr_->setData(addr, event->getPayload(), false);
+                    mshr_->setData(addr, event->getPayloadBuffer(), false);
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
                     sendWritebackAck(event);
@@ -625,7 +625,7 @@ bool MESIPrivNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     event->getDirty() ? line->setState(M) : line->setState(E);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->readPayload(), 0);
                     if (is_debug_addr(addr))
                         printDataValue(line->getAddr(), line->getData(), true);
                     sendWritebackAck(event);
@@ -698,13 +698,13 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 if (mshr_->getFrontType(addr) == MSHREntryType::Event && mshr_->getFrontEvent(addr)->getCmd() == Command::FetchInvX) {
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
-                    mshr_->setData(addr, event->getPayload(), true);
+                    mshr_->setData(addr, event->getPayloadBuffer(), true);
                     event->setCmd(Command::PutS);
                     event->setDirty(false);
                     retry(addr);
                     status = allocateMSHR(event, false, 1);
                 } else { // Eviction or invalidation -> we won't need a line
-                    mshr_->setData(addr, event->getPayload(), true);
+                    mshr_->setData(addr, event->getPayloadBuffer(), true);
                     mshr_->decrementAcksNeeded(addr);
                     responses.erase(addr);
                     sendWritebackAck(event);
@@ -715,7 +715,7 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     line->setState(M);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->readPayload(), 0);
                     if (is_debug_addr(addr))
                         printDataValue(line->getAddr(), line->getData(), true);
                     if (mshr_->hasData(addr)) mshr_->clearData(addr);
@@ -728,7 +728,7 @@ bool MESIPrivNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
         case M:
             line->setOwned(false);
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
             if (is_debug_addr(addr))
                 printDataValue(line->getAddr(), line->getData(), true);
             sendWritebackAck(event);
@@ -783,7 +783,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
             if (mshr_->getAcksNeeded(addr)) {
-                mshr_->setData(addr, event->getPayload(), event->getDirty());
+                mshr_->setData(addr, event->getPayloadBuffer(), event->getDirty());
                 sendWritebackAck(event);
                 delete event;
 
@@ -796,7 +796,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 status = allocateLine(event, line, inMSHR);
                 if (status == MemEventStatus::OK) {
                     event->getDirty() ? line->setState(M) : line->setState(E);
-                    line->setData(event->getPayload(), 0);
+                    line->setData(event->readPayload(), 0);
                     if (is_debug_addr(addr))
                         printDataValue(line->getAddr(), line->getData(), true);
                     sendWritebackAck(event);
@@ -811,7 +811,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             line->setShared(true);
             if (event->getDirty()) {
                 line->setState(M);
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
                     printDataValue(line->getAddr(), line->getData(), true);
             }
@@ -824,7 +824,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             line->setShared(true);
             if (event->getDirty()) {
                 line->setState(M_Inv);
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
                     printDataValue(line->getAddr(), line->getData(), true);
             }
@@ -839,7 +839,7 @@ bool MESIPrivNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
             line->setShared(true);
             if (event->getDirty()) {
                 line->setState(M);
-                line->setData(event->getPayload(), 0);
+                line->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
                         printDataValue(line->getAddr(), line->getData(), true);
             } else {
@@ -896,7 +896,7 @@ bool MESIPrivNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
                     delete event;
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutS) { // Raced with replacement
                     MemEvent* put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-                    sendResponseDown(event, event->getSize(), &(put->getPayload()), false);
+                    sendResponseDown(event, event->getSize(), &(put->readPayload()), false);
                     delete event;
                 } else { // Raced with GetX or FlushLine
                     status = allocateMSHR(event, true, 0);
@@ -1105,7 +1105,7 @@ bool MESIPrivNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             } else if (mshr_->exists(addr) && mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) { // Drop PutX, Ack it, forward request up
                 MemEvent * put = static_cast<MemEvent*>(mshr_->swapFrontEvent(addr, event));
                 sendWritebackAck(put);
-                mshr_->setData(addr, put->getPayload(), put->getDirty());
+                mshr_->setData(addr, put->getPayloadBuffer(), put->getDirty());
                 delete put;
                 sendFwdRequest(event, Command::ForceInv, upperCacheName_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
@@ -1236,7 +1236,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 if (entry) {
                     if (entry->getCmd() == Command::PutS) {
                         // Return AckInv
-                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->getPayload()), false);
+                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->readPayload()), false);
                         delete event;
                         // Drop PutS
                         if (mshr_->hasData(addr)) mshr_->clearData(addr);
@@ -1246,7 +1246,7 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                         break;
                     } else if (entry->getCmd() == Command::FlushLineInv) {
                         // Handle FetchInv
-                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->getPayload()), false);
+                        sendResponseDown(event, event->getSize(), &(static_cast<MemEvent*>(entry)->readPayload()), false);
                         if (mshr_->hasData(addr)) mshr_->clearData(addr);
                         // Drop evict part of Flush if needed
                         MemEvent* flush = static_cast<MemEvent*>(entry);
@@ -1268,13 +1268,13 @@ bool MESIPrivNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             } else if (mshr_->exists(addr) && mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) { // Drop PutX, Ack it, forward request up
                 MemEvent * put = static_cast<MemEvent*>(mshr_->swapFrontEvent(addr, event));
                 sendWritebackAck(put);
-                mshr_->setData(addr, put->getPayload(), put->getDirty());
+                mshr_->setData(addr, put->getPayloadBuffer(), put->getDirty());
                 delete put;
                 sendFwdRequest(event, Command::FetchInv, upperCacheName_, event->getSize(), 0, inMSHR);
             } else if (mshr_->exists(addr) && (CommandWriteback[(int)mshr_->getFrontEvent(addr)->getCmd()])) {
                 MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                 sendWritebackAck(put);
-                sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                sendResponseDown(event, put->getSize(), &(put->readPayload()), put->getDirty());
                 mshr_->removeFront(addr);
                 delete put;
                 cleanUpAfterRequest(event, inMSHR);
@@ -1390,14 +1390,14 @@ bool MESIPrivNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutX) {
                     MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
                     sendWritebackAck(put);
-                    sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                    sendResponseDown(event, put->getSize(), &(put->readPayload()), put->getDirty());
                     delete put;
                     mshr_->removeFront(addr);
                     cleanUpAfterRequest(event, inMSHR);
                     break;
                 } else if (mshr_->getFrontEvent(addr)->getCmd() == Command::PutE || mshr_->getFrontEvent(addr)->getCmd() == Command::PutM) {
                     MemEvent * put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-                    sendResponseDown(event, put->getSize(), &(put->getPayload()), put->getDirty());
+                    sendResponseDown(event, put->getSize(), &(put->readPayload()), put->getDirty());
                     put->setCmd(Command::PutS); // Make this a PutS so we only record the block in shared later
                     put->setDirty(false);
                     delete event;
@@ -1467,11 +1467,11 @@ bool MESIPrivNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
     MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
     req->setFlags(event->getMemFlags());
 
-    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, line ? line->getTimestamp() : 0);
+    uint64_t sendTime = sendResponseUp(req, &(event->readPayload()), true, line ? line->getTimestamp() : 0);
 
     // Update line
     if (line) {
-        line->setData(event->getPayload(), 0);
+        line->setData(event->readPayload(), 0);
         line->setState(S);
         line->setShared(true);
         line->setTimestamp(sendTime-1);
@@ -1508,7 +1508,7 @@ bool MESIPrivNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
     switch (state) {
         case I:
         {
-            sendExclusiveResponse(req, &(event->getPayload()), true, 0, event->getDirty());
+            sendExclusiveResponse(req, &(event->readPayload()), true, 0, event->getDirty());
             cleanUpAfterResponse(event, inMSHR);
             break;
         }
@@ -1598,12 +1598,12 @@ bool MESIPrivNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
 
     if (state == I) { // Fetch or FetchInv
         MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-        sendResponseDown(req, event->getSize(), &(event->getPayload()), event->getDirty());
+        sendResponseDown(req, event->getSize(), &(event->readPayload()), event->getDirty());
         cleanUpAfterResponse(event, inMSHR);
     } else {    // FetchInv only
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
             if (is_debug_addr(addr))
                 printDataValue(line->getAddr(), line->getData(), true);
         } else if (state == M_Inv) {
@@ -1643,14 +1643,14 @@ bool MESIPrivNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     if (state == I) {
         MemEvent * req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-        sendResponseDown(req, event->getSize(), &(event->getPayload()), event->getDirty());
+        sendResponseDown(req, event->getSize(), &(event->readPayload()), event->getDirty());
         cleanUpAfterResponse(event, inMSHR);
     } else {
         line->setOwned(false);
         line->setShared(true);
         if (event->getDirty()) {
             line->setState(M);
-            line->setData(event->getPayload(), 0);
+            line->setData(event->readPayload(), 0);
             if (is_debug_addr(addr))
                 printDataValue(line->getAddr(), line->getData(), true);
         } else if (state == M_InvX) {
@@ -2137,7 +2137,7 @@ void MESIPrivNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t time, bool dirty) {
+uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t time, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
     responseEvent->setCmd(Command::GetXResp);
 
@@ -2165,7 +2165,7 @@ uint64_t MESIPrivNoninclusive::sendExclusiveResponse(MemEvent * event, vector<ui
     return deliveryTime;
 }
 
-uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, const vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -2197,7 +2197,7 @@ uint64_t MESIPrivNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
     return deliveryTime;
 }
 
-void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vector<uint8_t>* data, bool dirty) {
+void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, const vector<uint8_t>* data, bool dirty) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
@@ -2218,7 +2218,7 @@ void MESIPrivNoninclusive::sendResponseDown(MemEvent * event, uint32_t size, vec
 }
 
 
-uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, const std::vector<uint8_t>* data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
@@ -2257,7 +2257,7 @@ uint64_t MESIPrivNoninclusive::forwardFlush(MemEvent * event, bool evict, std::v
  *  Latency: cache access + tag to read data that is being written back and update coherence state
  */
 
-uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, std::vector<uint8_t>* data, bool dirty, uint64_t startTime) {
+uint64_t MESIPrivNoninclusive::sendWriteback(Addr addr, uint32_t size, Command cmd, const std::vector<uint8_t>* data, bool dirty, uint64_t startTime) {
     MemEvent* writeback = new MemEvent(cachename_, addr, addr, cmd);
     writeback->setSize(size);
 
@@ -231,6 +231,7 @@ public:
         HashFunction * ht = createHashFunction(params);
         cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
+        cacheArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         stat_evict[I] =      registerStatistic<uint64_t>("evict_I");
         stat_evict[S] =      registerStatistic<uint64_t>("evict_S");
@@ -490,20 +491,20 @@ private:
     void retry(Addr addr);
 
     /** Forward a flush line request, with or without data */
-    uint64_t forwardFlush(MemEvent* event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time);
+    uint64_t forwardFlush(MemEvent* event, bool evict, const std::vector<uint8_t>* data, bool dirty, uint64_t time);
 
     /** Forward a request */
     uint64_t sendFwdRequest(MemEvent * event, Command cmd, std::string dst, uint32_t size, uint64_t startTime, bool inMSHR);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::GetSResp, bool success = true);
-    uint64_t sendExclusiveResponse(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool dirty);
+    uint64_t sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::GetSResp, bool success = true);
+    uint64_t sendExclusiveResponse(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, bool dirty);
 
     /** Send response down (towards memory) */
-    void sendResponseDown(MemEvent * event, uint32_t size, vector<uint8_t>* data, bool dirty);
+    void sendResponseDown(MemEvent * event, uint32_t size, const vector<uint8_t>* data, bool dirty);
 
     /** Send writeback request to lower level caches */
-    uint64_t sendWriteback(Addr addr, uint32_t size, Command cmd, std::vector<uint8_t>* data, bool dirty, uint64_t time = 0);
+    uint64_t sendWriteback(Addr addr, uint32_t size, Command cmd, const std::vector<uint8_t>* data, bool dirty, uint64_t time = 0);
 
     void sendWritebackAck(MemEvent * event);
 
@@ -96,6 +96,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
 
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1);
+                notifyListenerOfPrefetchResult(addr, PrefetchResult::REDUNDANT);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 if (is_debug_event(event))
                     eventDI.action = "Done";
@@ -103,7 +104,7 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
                 break;
             }
 
-            recordPrefetchResult(tag, statPrefetchHit);
+            recordPrefetchResult(tag, statPrefetchHit, PrefetchResult::USEFUL);
 
             if (data || mshr_->hasData(addr)) {
                 tag->addSharer(event->getSrc());
@@ -146,12 +147,13 @@ bool MESISharNoninclusive::handleGetS(MemEvent* event, bool inMSHR) {
 
             if (localPrefetch) {
                 statPrefetchRedundant->addData(1);
+                notifyListenerOfPrefetchResult(addr, PrefetchResult::REDUNDANT);
                 recordPrefetchLatency(event->getID(), LatType::HIT);
                 cleanUpAfterRequest(event, inMSHR);
                 break;
             }
 
-            recordPrefetchResult(tag, statPrefetchHit);
+            recordPrefetchResult(tag, statPrefetchHit, PrefetchResult::USEFUL);
 
             if (tag->hasOwner()) {
                 if (!inMSHR) {
@@ -274,7 +276,7 @@ bool MESISharNoninclusive::handleGetX(MemEvent * event, bool inMSHR) {
                         notifyListenerOfAccess(event, NotifyAccessType::WRITE, NotifyResultType::MISS);
                         mshr_->setProfiled(addr);
                     }
-                    recordPrefetchResult(tag, statPrefetchUpgradeMiss);
+                    recordPrefetchResult(tag, statPrefetchUpgradeMiss, PrefetchResult::USEFUL);
                     recordLatencyType(event->getID(), LatType::UPGRADE);
 
                     sendTime = forwardMessage(event, lineSize_, 0, nullptr);
@@ -655,9 +657,9 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->readPayload()), true);
                 inMSHR = true;
             }
             if (!inMSHR || !mshr_->getProfiled(addr)) {
@@ -703,7 +705,7 @@ bool MESISharNoninclusive::handlePutS(MemEvent * event, bool inMSHR) {
             if (event->getSrc() == *(tag->getSharers()->begin())) { // Sent fetch to this requestor
                 // Retry the pending fetch
                 mshr_->decrementAcksNeeded(addr);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty())
                     responses.erase(addr);
@@ -786,9 +788,9 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->readPayload()), true);
                 inMSHR = true;
             }
             tag->removeOwner();
@@ -803,7 +805,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -833,7 +835,7 @@ bool MESISharNoninclusive::handlePutE(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -892,9 +894,9 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                     break;
                 }
                 data = dataArray_->lookup(addr, true);
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->readPayload()), true);
                 inMSHR = true;
             } else if (!inMSHR || !mshr_->getProfiled(addr)) {
                 stat_eventState[(int)Command::PutM][state]->addData(1);
@@ -921,15 +923,15 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::PutM][state]->addData(1);
                 }
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->readPayload()), true);
                 sendWritebackAck(event);
                 cleanUpEvent(event, inMSHR);
             } else {
                 tag->addSharer(event->getSrc());
                 event->setCmd(Command::PutS);
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
                 if (inMSHR)
                     mshr_->removeFront(addr); // Need to reinsert after the conflicting request
                 MemEventBase* entry = mshr_->getEntryEvent(addr, 1);
@@ -950,7 +952,7 @@ bool MESISharNoninclusive::handlePutM(MemEvent * event, bool inMSHR) {
             tag->removeOwner();
             mshr_->decrementAcksNeeded(addr);
             if (!data && !mshr_->hasData(addr))
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty())
                 responses.erase(addr);
@@ -1004,9 +1006,9 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(M);
 
             if (data) {
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
                 if (is_debug_addr(addr))
-                    printDataValue(addr, &(event->getPayload()), true);
+                    printDataValue(addr, &(event->readPayload()), true);
             }
             cleanUpAfterRequest(event, inMSHR);
             break;
@@ -1018,12 +1020,12 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(E);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
             
             if (is_debug_addr(addr))
-                printDataValue(addr, &(event->getPayload()), true);
+                printDataValue(addr, &(event->readPayload()), true);
 
             mshr_->decrementAcksNeeded(addr);
 
@@ -1035,12 +1037,12 @@ bool MESISharNoninclusive::handlePutX(MemEvent * event, bool inMSHR) {
                 tag->setState(M_Inv);
 
             if (data)
-                data->setData(event->getPayload(), 0);
+                data->setData(event->readPayload(), 0);
             else
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
             
             if (is_debug_addr(addr))
-                printDataValue(addr, &(event->getPayload()), true);
+                printDataValue(addr, &(event->readPayload()), true);
 
             cleanUpEvent(event, inMSHR);
             break;
@@ -1107,7 +1109,7 @@ bool MESISharNoninclusive::handleFetch(MemEvent * event, bool inMSHR) {
         case SA:
             //Look for a PutS in the MSHR
             put = static_cast<MemEvent*>(mshr_->getFirstEventEntry(addr, Command::PutS));
-            sendResponseDown(event, &(put->getPayload()), false, false);
+            sendResponseDown(event, &(put->readPayload()), false, false);
             stat_eventState[(int)Command::Fetch][state]->addData(1);
             cleanUpEvent(event, inMSHR);
             break;
@@ -1203,7 +1205,7 @@ bool MESISharNoninclusive::handleInv(MemEvent * event, bool inMSHR) {
 
             if (status == MemEventStatus::OK) {
                 if (!mshr_->getProfiled(addr)) {
-                    recordPrefetchResult(tag, statPrefetchInv);
+                    recordPrefetchResult(tag, statPrefetchInv, PrefetchResult::INVALIDATED);
                     stat_eventState[(int)Command::Inv][state]->addData(1);
                     mshr_->setProfiled(addr);
                 }
@@ -1352,7 +1354,7 @@ bool MESISharNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
 
             if (status == MemEventStatus::OK) {
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
-                    recordPrefetchResult(tag, statPrefetchInv);
+                    recordPrefetchResult(tag, statPrefetchInv, PrefetchResult::INVALIDATED);
                     stat_eventState[(int)Command::ForceInv][state]->addData(1);
                     if (tag->hasSharers()) mshr_->setProfiled(addr);
                 }
@@ -1380,7 +1382,7 @@ bool MESISharNoninclusive::handleForceInv(MemEvent * event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::ForceInv][state]->addData(1);
-                    recordPrefetchResult(tag, statPrefetchInv);
+                    recordPrefetchResult(tag, statPrefetchInv, PrefetchResult::INVALIDATED);
                 }
                 if (tag->hasSharers()) {
                     if (!applyPendingReplacement(addr))
@@ -1539,7 +1541,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
 
             if (status == MemEventStatus::OK) {
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
-                    recordPrefetchResult(tag, statPrefetchInv);
+                    recordPrefetchResult(tag, statPrefetchInv, PrefetchResult::INVALIDATED);
                     stat_eventState[(int)Command::FetchInv][state]->addData(1);
                     if (tag->hasSharers()) mshr_->setProfiled(addr);
                 }
@@ -1571,7 +1573,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
                 if (!inMSHR || !mshr_->getProfiled(addr)) {
                     stat_eventState[(int)Command::FetchInv][state]->addData(1);
                     if (tag->hasOwner() || tag->hasSharers()) mshr_->setProfiled(addr);
-                    recordPrefetchResult(tag, statPrefetchInv);
+                    recordPrefetchResult(tag, statPrefetchInv, PrefetchResult::INVALIDATED);
                 }
                 if (applyPendingReplacement(addr)) {
                     state == E ? tag->setState(E_Inv) : tag->setState(M_Inv);
@@ -1638,7 +1640,7 @@ bool MESISharNoninclusive::handleFetchInv(MemEvent * event, bool inMSHR){
             // TODO make sure the pending eviction won't mess anything up when it tries to replay
             put = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
             sendWritebackAck(put);
-            sendResponseDown(event, &(put->getPayload()), state == MA, true);
+            sendResponseDown(event, &(put->readPayload()), state == MA, true);
             dirArray_->deallocate(tag);
             if (mshr_->hasData(addr))
                 mshr_->clearData(addr);
@@ -1800,7 +1802,7 @@ bool MESISharNoninclusive::handleFetchInvX(MemEvent * event, bool inMSHR) {
                 stat_eventState[(int)Command::FetchInvX][state]->addData(1);
             }
             req = static_cast<MemEvent*>(mshr_->getFrontEvent(addr));
-            sendResponseDown(event, &(req->getPayload()), state == M, true); // TODO Double check that a downgrade counts as an evict
+            sendResponseDown(event, &(req->readPayload()), state == M, true); // TODO Double check that a downgrade counts as an evict
             // Clean up so that when we replay the replacement we get the right downgraded state
             req->setCmd(Command::PutS);
             tag->removeOwner();
@@ -1855,9 +1857,9 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     tag->setState(S);
     if (data) {
-        data->setData(event->getPayload(), 0);
+        data->setData(event->readPayload(), 0);
         if (is_debug_addr(addr))
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->readPayload()), true);
     }
 
     if (localPrefetch) {
@@ -1866,7 +1868,7 @@ bool MESISharNoninclusive::handleGetSResp(MemEvent * event, bool inMSHR) {
             eventDI.action = "Done";
     } else {
         tag->addSharer(req->getSrc());
-        uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
+        uint64_t sendTime = sendResponseUp(req, &(event->readPayload()), true, tag->getTimestamp(), Command::GetSResp);
         tag->setTimestamp(sendTime-1);
     }
 
@@ -1900,9 +1902,9 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
         eventDI.prefill(event->getID(), Command::GetXResp, (localPrefetch ? "-pref" : ""), addr, state);
 
     if (data) {
-        data->setData(event->getPayload(), 0);
+        data->setData(event->readPayload(), 0);
         if (is_debug_addr(addr))
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->readPayload()), true);
     }
 
     stat_eventState[(int)Command::GetXResp][state]->addData(1);
@@ -1923,11 +1925,11 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 if (tag->getState() == S || !protocol_ || mshr_->getSize(addr) > 1) {
                     tag->addSharer(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetSResp);
+                    uint64_t sendTime = sendResponseUp(req, &(event->readPayload()), true, tag->getTimestamp(), Command::GetSResp);
                     tag->setTimestamp(sendTime - 1);
                 } else {
                     tag->setOwner(req->getSrc());
-                    uint64_t sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
+                    uint64_t sendTime = sendResponseUp(req, &(event->readPayload()), true, tag->getTimestamp(), Command::GetXResp);
                     tag->setTimestamp(sendTime - 1);
                 }
             }
@@ -1945,7 +1947,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
                 tag->removeSharer(req->getSrc());
                 sendTime = sendResponseUp(req, nullptr, true, tag->getTimestamp(), Command::GetXResp);
             } else if (event->getPayloadSize() != 0) {
-                sendTime = sendResponseUp(req, &(event->getPayload()), true, tag->getTimestamp(), Command::GetXResp);
+                sendTime = sendResponseUp(req, &(event->readPayload()), true, tag->getTimestamp(), Command::GetXResp);
             } else {
                 sendTime = sendResponseUp(req, &(mshr_->getData(addr)), true, tag->getTimestamp(), Command::GetXResp);
             }
@@ -1961,7 +1963,7 @@ bool MESISharNoninclusive::handleGetXResp(MemEvent * event, bool inMSHR) {
             tag->setState(M_Inv);
             mshr_->setInProgress(addr, false);
             if (!data && event->getPayloadSize() != 0)
-                mshr_->setData(addr, event->getPayload());
+                mshr_->setData(addr, event->getPayloadBuffer());
             if (is_debug_event(event)) {
                 eventDI.action = "Stall";
                 eventDI.reason = "Acks needed";
@@ -2048,12 +2050,12 @@ bool MESISharNoninclusive::handleFetchResp(MemEvent * event, bool inMSHR) {
         responses.erase(addr);
 
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->readPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getPayloadBuffer());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, &(event->readPayload()), true);
 
     stat_eventState[(int)Command::FetchResp][state]->addData(1);
 
@@ -2152,12 +2154,12 @@ bool MESISharNoninclusive::handleFetchXResp(MemEvent * event, bool inMSHR) {
 
     // Save data
     if (data)
-        data->setData(event->getPayload(), 0);
+        data->setData(event->readPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getPayloadBuffer());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, &(event->readPayload()), true);
 
     // Clean up and retry
     retry(addr);
@@ -2591,7 +2593,7 @@ bool MESISharNoninclusive::handleDirEviction(Addr addr, DirectoryLine*& tag) {
         mshr_->insertWriteback(tag->getAddr(), false);
     }
 
-    recordPrefetchResult(tag, statPrefetchEvict);
+    recordPrefetchResult(tag, statPrefetchEvict, PrefetchResult::EVICTED);
     return evict;
 }
 
@@ -2621,7 +2623,7 @@ bool MESISharNoninclusive::handleDataEviction(Addr addr, DataLine *&data) {
                     sendWritebackFromCache(Command::PutS, tag, data, false);
                     if (recvWritebackAck_)
                         mshr_->insertWriteback(tag->getAddr(), false);
-                    recordPrefetchResult(tag, statPrefetchEvict);
+                    recordPrefetchResult(tag, statPrefetchEvict, PrefetchResult::EVICTED);
                     notifyListenerOfEvict(data->getAddr(), lineSize_, 0);
                     tag->setState(I);
                     dirArray_->deallocate(tag);
@@ -2641,7 +2643,7 @@ bool MESISharNoninclusive::handleDataEviction(Addr addr, DataLine *&data) {
                     sendWritebackFromCache(Command::PutE, tag, data, false);
                     if (recvWritebackAck_)
                         mshr_->insertWriteback(tag->getAddr(), false);
-                    recordPrefetchResult(tag, statPrefetchEvict);
+                    recordPrefetchResult(tag, statPrefetchEvict, PrefetchResult::EVICTED);
                     notifyListenerOfEvict(data->getAddr(), lineSize_, 0);
                     tag->setState(I);
                     dirArray_->deallocate(tag);
@@ -2661,7 +2663,7 @@ bool MESISharNoninclusive::handleDataEviction(Addr addr, DataLine *&data) {
                     sendWritebackFromCache(Command::PutM, tag, data, false);
                     if (recvWritebackAck_)
                         mshr_->insertWriteback(tag->getAddr(), false);
-                    recordPrefetchResult(tag, statPrefetchEvict);
+                    recordPrefetchResult(tag, statPrefetchEvict, PrefetchResult::EVICTED);
                     notifyListenerOfEvict(data->getAddr(), lineSize_, 0);
                     tag->setState(I);
                     dirArray_->deallocate(tag);
@@ -2791,7 +2793,7 @@ void MESISharNoninclusive::retry(Addr addr) {
  * Protocol helper functions
  ***********************************************************************************************************/
 
-uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
+uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, const vector<uint8_t> * data, bool inMSHR, uint64_t time, Command cmd, bool success) {
     MemEvent * responseEvent = event->makeResponse();
     if (cmd != Command::NULLCMD)
         responseEvent->setCmd(cmd);
@@ -2819,7 +2821,7 @@ uint64_t MESISharNoninclusive::sendResponseUp(MemEvent * event, vector<uint8_t>
     return deliveryTime;
 }
 
-void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_t> * data, bool dirty, bool evict) {
+void MESISharNoninclusive::sendResponseDown(MemEvent * event, const std::vector<uint8_t> * data, bool dirty, bool evict) {
     MemEvent * responseEvent = event->makeResponse();
 
     if (data) {
@@ -2839,7 +2841,7 @@ void MESISharNoninclusive::sendResponseDown(MemEvent * event, std::vector<uint8_
 }
 
 
-uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time) {
+uint64_t MESISharNoninclusive::forwardFlush(MemEvent * event, bool evict, const std::vector<uint8_t>* data, bool dirty, uint64_t time) {
     MemEvent * flush = new MemEvent(*event);
 
     uint64_t latency = tagLatency_;
@@ -3145,7 +3147,7 @@ void MESISharNoninclusive::removeSharerViaInv(MemEvent * event, DirectoryLine *
     Addr addr = event->getBaseAddr();
     tag->removeSharer(event->getSrc());
     if (!data && !mshr_->hasData(addr))
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getPayloadBuffer());
 
     if (remove) {
         responses.find(addr)->second.erase(event->getSrc());
@@ -3158,12 +3160,12 @@ void MESISharNoninclusive::removeOwnerViaInv(MemEvent * event, DirectoryLine * t
     Addr addr = event->getBaseAddr();
     tag->removeOwner();
     if (data) 
-        data->setData(event->getPayload(), 0);
+        data->setData(event->readPayload(), 0);
     else
-        mshr_->setData(addr, event->getPayload());
+        mshr_->setData(addr, event->getPayloadBuffer());
     
     if (is_debug_addr(addr))
-        printDataValue(addr, &(event->getPayload()), true);
+        printDataValue(addr, &(event->readPayload()), true);
 
     if (event->getDirty()) {
         if (tag->getState() == E)
@@ -3181,10 +3183,11 @@ void MESISharNoninclusive::removeOwnerViaInv(MemEvent * event, DirectoryLine * t
     }
 }
 
-void MESISharNoninclusive::recordPrefetchResult(DirectoryLine * tag, Statistic<uint64_t> * stat) {
+void MESISharNoninclusive::recordPrefetchResult(DirectoryLine * tag, Statistic<uint64_t> * stat, PrefetchResult result) {
     if (tag->getPrefetch()) {
         stat->addData(1);
         tag->setPrefetch(false);
+        notifyListenerOfPrefetchResult(tag->getAddr(), result);
     }
 }
 
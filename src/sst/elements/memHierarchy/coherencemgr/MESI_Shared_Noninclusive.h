@@ -279,6 +279,7 @@ public:
         HashFunction * ht = createHashFunction(params);
         dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht);
         dataArray_->setBanked(params.find<uint64_t>("banks", 0));
+        dataArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         uint64_t dLines = params.find<uint64_t>("dlines");
         uint64_t dAssoc = params.find<uint64_t>("dassoc");
@@ -286,6 +287,7 @@ public:
         ReplacementPolicy *drmgr = createReplacementPolicy(dLines, dAssoc, params, false, 1);
         dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht);
         dirArray_->setBanked(params.find<uint64_t>("banks", 0));
+        dirArray_->setLayout(params.find<std::string>("array_layout", "default"), params.find<bool>("array_simd", true));
 
         /* Statistics */
         stat_evict[I] =         registerStatistic<uint64_t>("evict_I");
@@ -594,13 +596,13 @@ private:
     bool invalidateOwner(MemEvent * event, DirectoryLine * line, bool inMSHR, Command cmd = Command::FetchInv);
 
     /** Forward a flush line request, with or without data */
-    uint64_t forwardFlush(MemEvent* event, bool evict, std::vector<uint8_t>* data, bool dirty, uint64_t time);
+    uint64_t forwardFlush(MemEvent* event, bool evict, const std::vector<uint8_t>* data, bool dirty, uint64_t time);
 
     /** Send response up (to processor) */
-    uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = true);
+    uint64_t sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool inMSHR, uint64_t baseTime, Command cmd = Command::NULLCMD, bool success = true);
 
     /** Send response down (towards memory) */
-    void sendResponseDown(MemEvent* event, std::vector<uint8_t>* data, bool dirty, bool evict);
+    void sendResponseDown(MemEvent* event, const std::vector<uint8_t>* data, bool dirty, bool evict);
 
     /** Send writeback request to lower level caches */
     void sendWritebackFromCache(Command cmd, DirectoryLine* tag, DataLine* data, bool dirty);
@@ -625,7 +627,7 @@ private:
 
 /* Statistics */
     void recordLatency(Command cmd, int type, uint64_t latency);
-    void recordPrefetchResult(DirectoryLine * line, Statistic<uint64_t> * stat);
+    void recordPrefetchResult(DirectoryLine * line, Statistic<uint64_t> * stat, PrefetchResult result);
 
 /* Private data members */
     CacheArray<DataLine>* dataArray_;
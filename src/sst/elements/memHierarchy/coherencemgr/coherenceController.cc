@@ -150,8 +150,13 @@ ReplacementPolicy* CoherenceController::createReplacementPolicy(uint64_t lines,
     }
     if (policy == "random") return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.random", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
     if (policy == "nmru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.nmru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "plru")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.plru", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "srrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.srrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "brrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.brrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "drrip")  return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.drrip", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
+    if (policy == "ship")   return loadAnonymousSubComponent<ReplacementPolicy>("memHierarchy.replacement.ship", "replacement", slotnum, ComponentInfo::SHARE_NONE, emptyparams, lines, assoc);
 
-    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', and 'nmru'. You specified '%s'.\n", getName().c_str(), policy.c_str());
+    debug->fatal(CALL_INFO, -1, "%s, Invalid param: replacement_policy - supported policies are 'lru', 'lfu', 'random', 'mru', 'nmru', 'plru', 'srrip', 'brrip', 'drrip', and 'ship'. You specified '%s'.\n", getName().c_str(), policy.c_str());
     return nullptr;
 }
 
@@ -402,11 +407,11 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
     event->setSrc(cachename_);
-    std::string dst = linkDown_->findTargetDestination(event->getRoutingAddress());
+    const std::string& dst = linkDown_->findTargetDestination(event->getRoutingAddress());
     if (is_debug_event(event)){
         //TODO
         debug->debug(_L4_, "T: %-20" PRIu64 " %-20" PRIu64 " %-20s Dest    (%s)\n",
-                getCurrentSimCycle(), timestamp_, cachename_.c_str(), dst);
+                getCurrentSimCycle(), timestamp_, cachename_.c_str(), dst.c_str());
     }
 
     if (dst != "") { /* Common case */
@@ -414,9 +419,9 @@ void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
         Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
         addToOutgoingQueue(fwdReq);
     } else {
-        dst = linkUp_->findTargetDestination(event->getRoutingAddress());
-        if (dst != "") {
-            event->setDst(dst);
+        const std::string& dstUp = linkUp_->findTargetDestination(event->getRoutingAddress());
+        if (dstUp != "") {
+            event->setDst(dstUp);
             Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
             addToOutgoingQueueUp(fwdReq);
         } else {
@@ -520,8 +525,15 @@ void CoherenceController::notifyListenerOfEvict(Addr addr, uint32_t size, Addr i
 }
 
 
+void CoherenceController::notifyListenerOfPrefetchResult(Addr addr, PrefetchResult result) {
+    for (int i = 0; i < listeners_.size(); i++) {
+        listeners_[i]->notifyPrefetchResult(addr, result);
+    }
+}
+
+
 /* Forward a message to a lower level (towards memory) in the hierarchy */
-uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data, Command fwdCmd) {
+uint64_t CoherenceController::forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, const vector<uint8_t>* data, Command fwdCmd) {
     /* Create event to be forwarded */
     MemEvent* forwardEvent;
     forwardEvent = new MemEvent(*event);
@@ -583,19 +595,19 @@ void CoherenceController::resendEvent(MemEvent * event, bool towardsCPU) {
 
 
 /* Send response up (towards CPU). L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success) {
     return sendResponseUp(event, CommandResponse[(int)event->getCmd()], data, false, replay, baseTime, success);
 }
 
 
 /* Send response up (towards CPU). L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, const vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success) {
     return sendResponseUp(event, cmd, data, false, replay, baseTime, success);
 }
 
 
 /* Send response towards the CPU. L1s need to implement their own to split out the requested block */
-uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool success) {
+uint64_t CoherenceController::sendResponseUp(MemEvent * event, Command cmd, const vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool success) {
     MemEvent * responseEvent = event->makeResponse(cmd);
     responseEvent->setSize(event->getSize());
     if (data != nullptr) responseEvent->setPayload(*data);
@@ -634,7 +646,19 @@ MemEventStatus CoherenceController::allocateMSHR(MemEvent * event, bool fwdReq,
         }
     }
 
+    // A demand request that has to wait behind this cache's own prefetch of the line means the prefetch was late
+    bool latePrefetch = false;
+    const Command cmd = event->getCmd();
+    if (!fwdReq && !event->isPrefetch() && (cmd == Command::GetS || cmd == Command::GetX || cmd == Command::GetSX)
+            && !listeners_.empty() && mshr_->getSize(event->getBaseAddr()) == 1
+            && mshr_->getFrontType(event->getBaseAddr()) == MSHREntryType::Event) {
+        MemEvent* front = dynamic_cast<MemEvent*>(mshr_->getFrontEvent(event->getBaseAddr()));
+        latePrefetch = front && front->isPrefetch() && front->getRqstr() == cachename_;
+    }
+
     int end_pos = mshr_->insertEvent(event->getBaseAddr(), event, pos, fwdReq, stallEvict);
+    if (latePrefetch && end_pos != -1)
+        notifyListenerOfPrefetchResult(event->getBaseAddr(), PrefetchResult::LATE);
     if (end_pos == -1) {
         if (is_debug_event(event)) {
             eventDI.action = "Reject";
@@ -714,7 +738,7 @@ void CoherenceController::printDebugAlloc(bool alloc, Addr addr, std::string not
         debug->debug(_L5_, "\n");
 }
 
-void CoherenceController::printDataValue(Addr addr, vector<uint8_t> * data, bool set) {
+void CoherenceController::printDataValue(Addr addr, const vector<uint8_t> * data, bool set) {
     if (dlevel < 11)
         return;
 
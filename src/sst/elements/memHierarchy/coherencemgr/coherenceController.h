@@ -193,9 +193,10 @@ protected:
     /* Listener callbacks */
     virtual void notifyListenerOfAccess(MemEvent * event, NotifyAccessType accessT, NotifyResultType resultT);
     virtual void notifyListenerOfEvict(Addr addr, uint32_t size, uint64_t ip);
+    void notifyListenerOfPrefetchResult(Addr addr, PrefetchResult result);
 
     /* Forward a message to a lower memory level (towards memory) */
-    uint64_t forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, vector<uint8_t>* data, Command fwdCmd = Command::LAST_CMD);
+    uint64_t forwardMessage(MemEvent * event, unsigned int requestSize, uint64_t baseTime, const vector<uint8_t>* data, Command fwdCmd = Command::LAST_CMD);
 
     /* Insert event into MSHR */
     MemEventStatus allocateMSHR(MemEvent * event, bool fwdReq, int pos = -1, bool stallEvict = false);
@@ -247,7 +248,7 @@ protected:
 
     virtual void printDebugInfo(dbgin * diStruct);
     virtual void printDebugAlloc(bool alloc, Addr addr, std::string note);
-    virtual void printDataValue(Addr addr, vector<uint8_t> * data, bool set);
+    virtual void printDataValue(Addr addr, const vector<uint8_t> * data, bool set);
 
     /* Initialization */
     ReplacementPolicy * createReplacementPolicy(uint64_t lines, uint64_t assoc, Params& params, bool L1, int slotnum = 0);
@@ -322,9 +323,9 @@ protected:
     /* Add a new event to the outgoing command queue towards the CPU */
     virtual void addToOutgoingQueueUp(Response& resp);
 
-    virtual uint64_t sendResponseUp(MemEvent * event, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success = true);
-    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success = true);
-    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool success = true);
+    virtual uint64_t sendResponseUp(MemEvent * event, const vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success = true);
+    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, const vector<uint8_t>* data, bool replay, uint64_t baseTime, bool success = true);
+    virtual uint64_t sendResponseUp(MemEvent * event, Command cmd, const vector<uint8_t>* data, bool dirty, bool replay, uint64_t baseTime, bool success = true);
 
     std::string getSrc();
 
@@ -0,0 +1,408 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_DIRSHARERS_H
+#define MEMHIERARCHY_DIRSHARERS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <deque>
+#include <new>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Sharer/owner tracking for DirectoryController entries
+ *
+ * Endpoints (caches) are given dense integer IDs. IDs for the endpoints known
+ * at setup() are assigned in name order; endpoints first seen later (e.g.,
+ * caches behind a bus) are appended. Each entry then stores its sharers in
+ * one of these formats (parameter 'sharer_format'):
+ *  - Set:       std::set of IDs ordered by endpoint name. Same behavior as
+ *               the original std::set<std::string>, invalidations are sent in name order.
+ *  - BitVector: one bit per endpoint. Up to 128 endpoints are stored in the
+ *               entry, larger vectors come from the pool's free lists.
+ *  - Limited:   up to 'PointerCount' IDs stored in the entry. The entry
+ *               switches to a bit vector when more endpoints share the line
+ *               and back to pointers once it has no sharers.
+ *
+ * All formats are exact. The directory relies on an ack from every cache it
+ * invalidates and caches drop invalidations for lines they do not hold, so a
+ * format that over-approximates the sharers (e.g., a coarse vector) would hang.
+ */
+class DirEndpointTable {
+public:
+    static const uint32_t None = 0xFFFFFFFF;
+
+    /* Look up an ID, assigning the next one if 'name' has not been seen */
+    uint32_t getID(const std::string& name) {
+        std::unordered_map<std::string, uint32_t>::iterator it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+        uint32_t id = names_.size();
+        ids_.insert(std::make_pair(name, id));
+        names_.push_back(name);
+        return id;
+    }
+
+    /* Look up an ID without assigning one. Returns None if 'name' has not been seen */
+    uint32_t findID(const std::string& name) const {
+        std::unordered_map<std::string, uint32_t>::const_iterator it = ids_.find(name);
+        return it == ids_.end() ? None : it->second;
+    }
+
+    /* Returns "" for None. References stay valid as the table grows */
+    const std::string& getName(uint32_t id) const {
+        static const std::string noName = "";
+        return id == None ? noName : names_[id];
+    }
+
+    uint32_t size() const { return names_.size(); }
+
+private:
+    std::unordered_map<std::string, uint32_t> ids_;
+    std::deque<std::string> names_;
+};
+
+class DirSharerPool;
+
+class DirSharers {
+public:
+    static const unsigned int PointerCount = 4;
+    static const unsigned int InlineWords = 2;
+
+    enum class Format { Set, BitVector, Limited };
+
+    explicit DirSharers(const DirSharerPool& pool);
+
+    size_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    bool contains(uint32_t id) const;
+    void add(uint32_t id, DirSharerPool& pool);
+    void remove(uint32_t id, DirSharerPool& pool);
+    void clear(DirSharerPool& pool);
+
+    /* Call f(id) for each sharer: name order for Set, ID order otherwise */
+    template<typename F>
+    void forEach(F f) const {
+        switch (kind_) {
+            case Kind::Names:
+                if (u_.names) {
+                    for (std::set<uint32_t, NameOrder>::const_iterator it = u_.names->begin(); it != u_.names->end(); it++)
+                        f(*it);
+                }
+                return;
+            case Kind::Pointers:
+                for (uint32_t i = 0; i < count_; i++)
+                    f(u_.ptrs[i]);
+                return;
+            default:
+                const uint64_t* w = words();
+                for (uint32_t i = 0; i < nwords_; i++) {
+                    uint64_t bits = w[i];
+                    while (bits) {
+                        f((i << 6) + __builtin_ctzll(bits));
+                        bits &= bits - 1;
+                    }
+                }
+                return;
+        }
+    }
+
+    struct NameOrder {
+        const DirEndpointTable* table;
+        bool operator()(uint32_t a, uint32_t b) const { return table->getName(a) < table->getName(b); }
+    };
+
+private:
+    enum class Kind : uint8_t { Names, Pointers, InlineBits, HeapBits };
+
+    const uint64_t* words() const { return kind_ == Kind::HeapBits ? u_.words : u_.bits; }
+    uint64_t* words() { return kind_ == Kind::HeapBits ? u_.words : u_.bits; }
+
+    void reset(const DirSharerPool& pool);
+    void toBits(DirSharerPool& pool);
+    void growBits(uint32_t id, DirSharerPool& pool);
+
+    union {
+        uint64_t bits[InlineWords];
+        uint32_t ptrs[PointerCount];
+        uint64_t* words;
+        std::set<uint32_t, NameOrder>* names;
+    } u_;
+    uint32_t count_;
+    uint32_t nwords_;   // Bit vector length in words
+    Kind kind_;
+};
+
+/* Per-directory state shared by all entries: endpoint IDs, sharer format, and free lists for large bit vectors */
+class DirSharerPool {
+public:
+    static const unsigned int ChunkSize = 64;
+
+    DirSharerPool(DirSharers::Format format) : format_(format) { }
+
+    ~DirSharerPool() {
+        for (std::vector<uint64_t*>::iterator it = chunks_.begin(); it != chunks_.end(); it++)
+            delete [] *it;
+    }
+
+    DirSharers::Format getFormat() const { return format_; }
+
+    DirEndpointTable& getEndpoints() { return endpoints_; }
+    const DirEndpointTable& getEndpoints() const { return endpoints_; }
+
+    /* Bit vector length needed to cover every endpoint known so far */
+    uint32_t getWords() const { return (endpoints_.size() + 63) / 64; }
+
+    /* Zeroed vector of 'nwords' words */
+    uint64_t* allocateWords(uint32_t nwords) {
+        if (freeWords_.size() <= nwords)
+            freeWords_.resize(nwords + 1);
+        std::vector<uint64_t*>& freeList = freeWords_[nwords];
+        if (freeList.empty()) {
+            uint64_t* chunk = new uint64_t[(size_t)nwords * ChunkSize];
+            chunks_.push_back(chunk);
+            for (unsigned int i = ChunkSize; i > 0; i--)
+                freeList.push_back(chunk + (size_t)(i - 1) * nwords);
+        }
+        uint64_t* w = freeList.back();
+        freeList.pop_back();
+        memset(w, 0, sizeof(uint64_t) * nwords);
+        return w;
+    }
+
+    void releaseWords(uint64_t* w, uint32_t nwords) { freeWords_[nwords].push_back(w); }
+
+private:
+    DirSharers::Format format_;
+    DirEndpointTable endpoints_;
+    std::vector<uint64_t*> chunks_;
+    std::vector<std::vector<uint64_t*> > freeWords_; // Indexed by vector length
+};
+
+inline DirSharers::DirSharers(const DirSharerPool& pool) {
+    reset(pool);
+}
+
+inline void DirSharers::reset(const DirSharerPool& pool) {
+    count_ = 0;
+    nwords_ = 0;
+    switch (pool.getFormat()) {
+        case Format::Set:
+            kind_ = Kind::Names;
+            u_.names = nullptr;
+            break;
+        case Format::BitVector:
+            kind_ = Kind::InlineBits;
+            nwords_ = InlineWords;
+            memset(u_.bits, 0, sizeof(u_.bits));
+            break;
+        case Format::Limited:
+            kind_ = Kind::Pointers;
+            break;
+    }
+}
+
+inline bool DirSharers::contains(uint32_t id) const {
+    switch (kind_) {
+        case Kind::Names:
+            return u_.names && u_.names->find(id) != u_.names->end();
+        case Kind::Pointers:
+            for (uint32_t i = 0; i < count_; i++) {
+                if (u_.ptrs[i] == id)
+                    return true;
+            }
+            return false;
+        default:
+            if ((id >> 6) >= nwords_)
+                return false;
+            return (words()[id >> 6] >> (id & 63)) & 1;
+    }
+}
+
+inline void DirSharers::add(uint32_t id, DirSharerPool& pool) {
+    switch (kind_) {
+        case Kind::Names:
+            if (!u_.names)
+                u_.names = new std::set<uint32_t, NameOrder>(NameOrder{&pool.getEndpoints()});
+            count_ += u_.names->insert(id).second ? 1 : 0;
+            return;
+        case Kind::Pointers: {
+            uint32_t pos = 0;
+            while (pos < count_ && u_.ptrs[pos] < id)
+                pos++;
+            if (pos < count_ && u_.ptrs[pos] == id)
+                return;
+            if (count_ < PointerCount) { // Keep pointers sorted so forEach() matches bit vector order
+                for (uint32_t i = count_; i > pos; i--)
+                    u_.ptrs[i] = u_.ptrs[i - 1];
+                u_.ptrs[pos] = id;
+                count_++;
+                return;
+            }
+            toBits(pool);
+            break;
+        }
+        default:
+            break;
+    }
+
+    if ((id >> 6) >= nwords_)
+        growBits(id, pool);
+    uint64_t& w = words()[id >> 6];
+    uint64_t mask = 1ULL << (id & 63);
+    if (!(w & mask)) {
+        w |= mask;
+        count_++;
+    }
+}
+
+inline void DirSharers::remove(uint32_t id, DirSharerPool& pool) {
+    switch (kind_) {
+        case Kind::Names:
+            if (u_.names && u_.names->erase(id))
+                count_--;
+            break;
+        case Kind::Pointers:
+            for (uint32_t i = 0; i < count_; i++) {
+                if (u_.ptrs[i] == id) {
+                    for (uint32_t j = i + 1; j < count_; j++)
+                        u_.ptrs[j - 1] = u_.ptrs[j];
+                    count_--;
+                    break;
+                }
+            }
+            return;
+        default:
+            if ((id >> 6) < nwords_) {
+                uint64_t& w = words()[id >> 6];
+                uint64_t mask = 1ULL << (id & 63);
+                if (w & mask) {
+                    w &= ~mask;
+                    count_--;
+                }
+            }
+            break;
+    }
+    if (count_ == 0)
+        clear(pool);
+}
+
+inline void DirSharers::clear(DirSharerPool& pool) {
+    if (kind_ == Kind::Names)
+        delete u_.names;
+    else if (kind_ == Kind::HeapBits)
+        pool.releaseWords(u_.words, nwords_);
+    reset(pool);
+}
+
+/* Limited pointers overflowed, move them to a bit vector */
+inline void DirSharers::toBits(DirSharerPool& pool) {
+    uint32_t ptrs[PointerCount];
+    memcpy(ptrs, u_.ptrs, sizeof(ptrs));
+    uint32_t n = count_;
+
+    uint32_t nwords = pool.getWords();
+    if (nwords <= InlineWords) {
+        kind_ = Kind::InlineBits;
+        nwords_ = InlineWords;
+        memset(u_.bits, 0, sizeof(u_.bits));
+    } else {
+        kind_ = Kind::HeapBits;
+        nwords_ = nwords;
+        u_.words = pool.allocateWords(nwords);
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        if ((ptrs[i] >> 6) >= nwords_)
+            growBits(ptrs[i], pool);
+        words()[ptrs[i] >> 6] |= 1ULL << (ptrs[i] & 63);
+    }
+}
+
+/* Endpoints were added after this vector was sized */
+inline void DirSharers::growBits(uint32_t id, DirSharerPool& pool) {
+    uint32_t nwords = pool.getWords();
+    if (nwords <= (id >> 6))
+        nwords = (id >> 6) + 1;
+    uint64_t* w = pool.allocateWords(nwords);
+    memcpy(w, words(), sizeof(uint64_t) * nwords_);
+    if (kind_ == Kind::HeapBits)
+        pool.releaseWords(u_.words, nwords_);
+    kind_ = Kind::HeapBits;
+    u_.words = w;
+    nwords_ = nwords;
+}
+
+/*
+ * Slab allocator for fixed-size objects (directory entries)
+ * Objects are carved out of large chunks and recycled through an intrusive free list.
+ * Chunks are only returned when the slab is destroyed; live objects must be released first.
+ */
+template<typename T>
+class DirSlab {
+public:
+    static const unsigned int ChunkSize = 1024;
+
+    DirSlab() : free_(nullptr) { }
+
+    ~DirSlab() {
+        for (typename std::vector<Slot*>::iterator it = chunks_.begin(); it != chunks_.end(); it++)
+            delete [] *it;
+    }
+
+    template<typename... Args>
+    T* allocate(Args&&... args) {
+        if (!free_)
+            addChunk();
+        Slot* slot = free_;
+        free_ = slot->next;
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    void release(T* t) {
+        t->~T();
+        Slot* slot = reinterpret_cast<Slot*>(t);
+        slot->next = free_;
+        free_ = slot;
+    }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void addChunk() {
+        Slot* chunk = new Slot[ChunkSize];
+        chunks_.push_back(chunk);
+        for (unsigned int i = ChunkSize; i > 0; i--) {
+            chunk[i - 1].next = free_;
+            free_ = &chunk[i - 1];
+        }
+    }
+
+    Slot* free_;
+    std::vector<Slot*> chunks_;
+};
+
+}}
+#endif /* MEMHIERARCHY_DIRSHARERS_H */
@@ -15,6 +15,7 @@
 
 #include <sst_config.h>
 #include "directoryController.h"
+#include "mshrHash.h"
 
 
 #include <sst/core/params.h>
@@ -311,7 +312,23 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
 
     int mshrSize    = params.find<int>("mshr_num_entries",-1);
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
-    mshr                = loadComponentExtension<MSHR>(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    std::string mshrType = params.find<std::string>("mshr_type", "map");
+    if (mshrType == "map")
+        mshr            = loadComponentExtension<MSHR>(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    else if (mshrType == "hash")
+        mshr            = loadComponentExtension<HashMSHR>(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    else
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_type - must be 'map' or 'hash'. You specified: %s\n", getName().c_str(), mshrType.c_str());
+
+    std::string sharerFormat = params.find<std::string>("sharer_format", "set");
+    if (sharerFormat == "set")
+        sharerPool = new DirSharerPool(DirSharers::Format::Set);
+    else if (sharerFormat == "bitvector")
+        sharerPool = new DirSharerPool(DirSharers::Format::BitVector);
+    else if (sharerFormat == "limited")
+        sharerPool = new DirSharerPool(DirSharers::Format::Limited);
+    else
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): sharer_format - must be 'set', 'bitvector', or 'limited'. You specified: %s\n", getName().c_str(), sharerFormat.c_str());
 
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
@@ -322,9 +339,10 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
 
 DirectoryController::~DirectoryController(){
     for(std::unordered_map<Addr, DirEntry*>::iterator i = directory.begin(); i != directory.end() ; ++i){
-        delete i->second;
+        entrySlab.release(i->second);
     }
     directory.clear();
+    delete sharerPool;
 }
 
 
@@ -714,6 +732,14 @@ void DirectoryController::setup(void){
     if (cpuLink != memLink)
         memLink->setup();
     //MemLinkBase * mem = memLink ? memLink : network;
+
+    /* Give the caches we know about IDs in name order. Others get one when first seen */
+    std::set<std::string> srcNames;
+    std::set<MemLinkBase::EndpointInfo>* srcs = cpuLink->getSources();
+    for (std::set<MemLinkBase::EndpointInfo>::iterator it = srcs->begin(); it != srcs->end(); it++)
+        srcNames.insert(it->name);
+    for (std::set<std::string>::iterator it = srcNames.begin(); it != srcNames.end(); it++)
+        sharerPool->getEndpoints().getID(*it);
 }
 
 
@@ -754,16 +780,16 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                     out.output("ALERT (%s): mshr should NOT have data for 0x%" PRIx64 " but it does...\n", getName().c_str(), addr);
                 else {
                     if (incoherentSrc.find(event->getSrc()) != incoherentSrc.end()) {
-                        sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
+                        sendDataResponse(event, entry, mshr->getDataBuffer(addr), Command::GetSResp);
                     } else if (protocol == CoherenceProtocol::MESI) {
                         entry->setState(M);
                         entry->setOwner(event->getSrc());
-                        sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
+                        sendDataResponse(event, entry, mshr->getDataBuffer(addr), Command::GetXResp);
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
                         entry->addSharer(event->getSrc());
-                        sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
+                        sendDataResponse(event, entry, mshr->getDataBuffer(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -787,7 +813,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                 if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
                     entry->addSharer(event->getSrc());
                 }
-                sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
+                sendDataResponse(event, entry, mshr->getDataBuffer(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
                     eventDI.reason = "hit";
                     eventDI.action = "Done";
@@ -869,7 +895,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
                         entry->setState(M);
                         entry->setOwner(event->getSrc());
                     }
-                    sendDataResponse(event, entry, mshr->getData(addr), Command::GetXResp);
+                    sendDataResponse(event, entry, mshr->getDataBuffer(addr), Command::GetXResp);
                     mshr->clearData(addr);
                     if (is_debug_event(event)) {
                         eventDI.reason = "hit";
@@ -1091,7 +1117,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
                 if (event->getEvict()) {
                     entry->removeOwner();
                     entry->addSharer(event->getSrc());
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
                     issueFetch(event, entry, Command::FetchInvX);
@@ -1106,7 +1132,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeOwner();
                 entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
             }
@@ -1115,7 +1141,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (event->getEvict()) {
                 entry->removeOwner();
                 entry->addSharer(event->getSrc());
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
                 responses.find(addr)->second.erase(event->getSrc());
@@ -1188,7 +1214,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    mshr->setData(addr, event->getPayload(), event->getDirty());
+                    mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
                     event->setEvict(false);
                 }
 
@@ -1220,7 +1246,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                mshr->setData(addr, event->getPayload(), event->getDirty());
+                mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1412,14 +1438,14 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
             update = true;
             break;
         case M_Inv:
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
             entry->setState(S_Inv);
             break;
         case M_InvX:
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
             entry->setState(S);
             break;
         default:
@@ -1474,7 +1500,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1530,7 +1556,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
             mshr->decrementAcksNeeded(addr);
             responses.find(addr)->second.erase(event->getSrc());
             if (responses.find(addr)->second.empty()) responses.erase(addr);
-            mshr->setData(addr, event->getPayload(), event->getDirty());
+            mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());
             entry->setState(I);
             break;
         default:
@@ -1795,8 +1821,8 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
         entry->setState(S);
     }
 
-    sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-    mshr->setData(addr, event->getPayload(), false); // Save data for a subsequent GetS
+    sendDataResponse(reqEv, entry, event->getPayloadBuffer(), Command::GetSResp);
+    mshr->setData(addr, event->getPayloadBuffer(), false); // Save data for a subsequent GetS
     cleanUpAfterResponse(event, inMSHR);
 
     if (is_debug_addr(addr)) {
@@ -1821,12 +1847,12 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case IS:
             if (incoherentSrc.find(reqEv->getSrc()) != incoherentSrc.end()) {
                 entry->setState(I);
-                sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
+                sendDataResponse(reqEv, entry, event->getPayloadBuffer(), Command::GetSResp);
                 break;
             } else if (protocol == CoherenceProtocol::MESI) {
                 entry->setState(M);
                 entry->setOwner(reqEv->getSrc());
-                sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
+                sendDataResponse(reqEv, entry, event->getPayloadBuffer(), Command::GetXResp);
                 break;
             }
         case S_D:
@@ -1834,8 +1860,8 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
                 entry->addSharer(reqEv->getSrc());
             }
-            sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
-            mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
+            sendDataResponse(reqEv, entry, event->getPayloadBuffer(), Command::GetSResp);
+            mshr->setData(addr, event->getPayloadBuffer(), false); // So subsequent GetS can get data
             break;
         case IM:
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
@@ -1844,11 +1870,11 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             } else {
                 entry->setState(I);
             }
-            sendDataResponse(reqEv, entry, event->getPayload(), Command::GetXResp);
+            sendDataResponse(reqEv, entry, event->getPayloadBuffer(), Command::GetXResp);
             break;
         case SM_Inv:
             entry->setState(S_Inv);
-            mshr->setData(addr, event->getPayload(), false); // Save data for when the invalidations finish
+            mshr->setData(addr, event->getPayloadBuffer(), false); // Save data for when the invalidations finish
             if (is_debug_addr(addr)) {
                 eventDI.newst = entry->getState();
                 eventDI.verboseline = entry->getString();
@@ -2022,7 +2048,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty()) responses.erase(addr);
 
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
     entry->addSharer(event->getSrc());
@@ -2057,7 +2083,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
     responses.find(addr)->second.erase(event->getSrc());
     if (responses.find(addr)->second.empty())
         responses.erase(addr);
-    mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
+    mshr->setData(addr, event->getPayloadBuffer(), event->getDirty());       // Save data for retry
 
     entry->setState(I);
 
@@ -2168,7 +2194,7 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
     std::unordered_map<Addr,DirEntry*>::iterator i = directory.find(addr);
 
     if (directory.end() == i) {
-        directory[addr] = new DirEntry(addr);
+        directory[addr] = entrySlab.allocate(addr, sharerPool);
         i = directory.find(addr);
         i->second->cacheIter = entryCache.end();
         i->second->setCached(true);
@@ -2286,7 +2312,7 @@ void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a
 
         if (entry->getState() == I) {
             directory.erase(entry->getBaseAddr());
-            delete entry;
+            entrySlab.release(entry);
             return;
         } else  {
             entryCache.push_front(entry);
@@ -2342,7 +2368,7 @@ void DirectoryController::issueFlush(MemEvent* event) {
 
     if (mshr->hasData(addr) && mshr->getDataDirty(addr)) { // also writeback dirty data
         flush->setEvict(true);
-        flush->setPayload(mshr->getData(addr));
+        flush->setPayload(mshr->getDataBuffer(addr));
         flush->setDirty(true);
         mshr->clearData(addr); // Don't retain data
     } else {
@@ -2374,12 +2400,13 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 }
 
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
-    std::string rqstr = (event->getSrc());
+    DirEndpointTable& endpoints = sharerPool->getEndpoints();
+    uint32_t rqstr = endpoints.findID(event->getSrc());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
-        issueInvalidation(*it, event, entry, cmd);
-    }
+    entry->getSharers().forEach([&](uint32_t id) {
+        if (id == rqstr) return;
+        issueInvalidation(endpoints.getName(id), event, entry, cmd);
+    });
 }
 
 void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd) {
@@ -2406,7 +2433,7 @@ void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, Di
     forwardByDestination(inv, deliveryTime);
 }
 
-void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags) {
+void DirectoryController::sendDataResponse(MemEvent* event, DirEntry* entry, const Payload& data, Command cmd, uint32_t flags) {
     MemEvent * respEv = event->makeResponse(cmd);
     respEv->setSize(lineSize);
     respEv->setPayload(data);
@@ -2425,7 +2452,7 @@ void DirectoryController::sendResponse(MemEvent* event, uint32_t flags, uint32_t
 void DirectoryController::writebackData(MemEvent* event) {
     MemEvent * wb = new MemEvent(getName(), event->getBaseAddr(), event->getBaseAddr(), Command::PutM, lineSize);
     wb->copyMetadata(event);
-    wb->setPayload(event->getPayload());
+    wb->setPayload(event->getPayloadBuffer());
     wb->setDirty(event->getDirty());
 
     if (waitWBAck)
@@ -2437,7 +2464,7 @@ void DirectoryController::writebackData(MemEvent* event) {
 
 void DirectoryController::writebackDataFromMSHR(Addr addr) {
     MemEvent * wb = new MemEvent(getName(), addr, addr, Command::PutM, lineSize);
-    wb->setPayload(mshr->getData(addr));
+    wb->setPayload(mshr->getDataBuffer(addr));
     wb->setDirty(mshr->getDataDirty(addr));
     mshr->setDataDirty(addr, false);
     
@@ -2452,7 +2479,7 @@ void DirectoryController::sendFetchResponse(MemEvent * event) {
     Addr addr = event->getBaseAddr();
     MemEvent * ack = event->makeResponse();
 
-    ack->setPayload(mshr->getData(addr));
+    ack->setPayload(mshr->getDataBuffer(addr));
     ack->setDirty(mshr->getDataDirty(addr));
 
     mshr->clearData(addr);
@@ -2535,14 +2562,14 @@ void DirectoryController::sendOutgoingEvents() {
  * dirAccess has default value of false
  */
 void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool dirAccess) {
-    std::string dst = memLink->findTargetDestination(ev->getRoutingAddress());
+    const std::string& dst = memLink->findTargetDestination(ev->getRoutingAddress());
     if (dst != "") { /* Common case */
         ev->setDst(dst);
         memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
     } else {
-        dst = cpuLink->findTargetDestination(ev->getRoutingAddress());
-        if (dst != "") {
-            ev->setDst(dst);
+        const std::string& dstUp = cpuLink->findTargetDestination(ev->getRoutingAddress());
+        if (dstUp != "") {
+            ev->setDst(dstUp);
             cpuMsgQueue.insert(std::make_pair(ts, ev));
         } else {
             std::string availableDests = "cpulink:\n" + cpuLink->getAvailableDestinationsAsString();
@@ -37,6 +37,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/dirSharers.h"
 
 using namespace std;
 
@@ -58,6 +59,9 @@ public:
             {"cache_line_size",         "Size of a cache line [aka cache block] in bytes.", "64"},
             {"coherence_protocol",      "Coherence protocol.  Supported --MESI, MSI--", "MESI"},
             {"mshr_num_entries",        "Number of MSHRs. Set to -1 for almost unlimited number.", "-1"},
+            {"mshr_type",               "MSHR implementation. Options: 'map' or 'hash'. See memHierarchy.Cache.", "map"},
+            {"sharer_format",           "How each entry records its sharers. 'set': set of sharer names. 'bitvector': one bit per cache. "
+                                        "'limited': up to 4 cache IDs per entry, switching to a bitvector when more caches share the line.", "set"},
             {"net_memory_name",         "For directories connected to a memory over the network: name of the memory this directory owns", ""},
             {"access_latency_cycles",   "Latency of directory access in cycles", "0"},
             {"mshr_latency_cycles",     "Latency of mshr access in cycles", "0"},
@@ -296,21 +300,24 @@ private:
         Addr                addr;           // block address
         State               state;          // state
         std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
-        std::string         owner;          // Owner of block
+        uint32_t            owner;          // Owner of block (endpoint ID)
+        DirSharers          sharers;        // set of sharers for block
+        DirSharerPool*      pool;           // Endpoint IDs and sharer storage, shared by all entries
 
-        DirEntry(Addr a) {
+        DirEntry(Addr a, DirSharerPool* p) : sharers(*p), pool(p) {
             clearEntry();
             addr = a;
             state = I;
             cached = false;
         }
 
+        ~DirEntry() { sharers.clear(*pool); }
+
         void clearEntry(){
             cached = true;
             addr = 0;
-            sharers.clear();
-            owner = "";
+            sharers.clear(*pool);
+            owner = DirEndpointTable::None;
         }
 
         std::string getString() {
@@ -318,13 +325,13 @@ private:
             str << "State: " << StateString[state];
             str << " Sharers: [";
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            sharers.forEach([&](uint32_t id) {
                 if (comma)
                     str << ",";
-                str << *it;
+                str << pool->getEndpoints().getName(id);
                 comma = true;
-            }
-            str << "] Owner: " << owner;
+            });
+            str << "] Owner: " << getOwner();
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
         }
@@ -335,27 +342,34 @@ private:
 
         Addr getBaseAddr() { return addr; }
 
-        size_t getSharerCount() { return sharers.size(); }
+        size_t getSharerCount() { return sharers.count(); }
 
-        void clearSharers() { sharers.clear(); }
+        void clearSharers() { sharers.clear(*pool); }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(const std::string& shr) { sharers.add(pool->getEndpoints().getID(shr), *pool); }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(const std::string& shr) {
+            uint32_t id = pool->getEndpoints().findID(shr);
+            return id != DirEndpointTable::None && sharers.contains(id);
+        }
 
         bool hasSharers() { return !(sharers.empty()); }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        const DirSharers& getSharers() { return sharers; }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(const std::string& shr) {
+            uint32_t id = pool->getEndpoints().findID(shr);
+            if (id != DirEndpointTable::None)
+                sharers.remove(id, *pool);
+        }
 
-        std::string getOwner() { return owner; }
+        const std::string& getOwner() { return pool->getEndpoints().getName(owner); }
 
-        bool hasOwner() { return owner != ""; }
+        bool hasOwner() { return owner != DirEndpointTable::None; }
 
-        void removeOwner() { owner = ""; }
+        void removeOwner() { owner = DirEndpointTable::None; }
 
-        void setOwner(std::string own) { owner = own; }
+        void setOwner(const std::string& own) { owner = own.empty() ? DirEndpointTable::None : pool->getEndpoints().getID(own); }
 
         void setState(State nState) { state = nState; }
 
@@ -381,7 +395,7 @@ private:
     void issueFetch(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd);
     void issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd);
-    void sendDataResponse(MemEvent* event, DirEntry* entry, std::vector<uint8_t>& data, Command cmd, uint32_t flags = 0);
+    void sendDataResponse(MemEvent* event, DirEntry* entry, const Payload& data, Command cmd, uint32_t flags = 0);
     void sendResponse(MemEvent* event, uint32_t flags = 0, uint32_t memflags = 0);
     void writebackData(MemEvent* event);
     void writebackDataFromMSHR(Addr addr);
@@ -392,6 +406,8 @@ private:
     
     MSHR * mshr;
     std::unordered_map<Addr, DirEntry*> directory; // Master list of all directory entries, including noncached ones
+    DirSharerPool* sharerPool;
+    DirSlab<DirEntry> entrySlab;
 
 
     struct MemMsg {
@@ -0,0 +1,109 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_FLATTAGARRAY_H
+#define MEMHIERARCHY_FLATTAGARRAY_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Contiguous per-set tag storage used by CacheArray's 'flat' layout
+ *
+ * Each set owns one block of line addresses that starts on a 64B boundary:
+ *      [ tag[0] ... tag[assoc-1] | pad ]
+ * so a lookup touches assoc*8 contiguous bytes instead of dereferencing one
+ * line object per way, and the compare can be done several ways at a time.
+ * Line indices are set-major (set * assoc + way), matching CacheArray::lines_.
+ *
+ * This class has no dependencies on sst-core so it can be exercised by the
+ * standalone microbenchmark in tests/microbench.
+ */
+class FlatTagArray {
+public:
+    static const unsigned int BlockAlign = 64;
+    static const int NotFound = -1;
+
+    FlatTagArray(unsigned int numSets, unsigned int associativity, bool simd) :
+        numSets_(numSets), assoc_(associativity), simd_(simd), block_(nullptr) {
+        size_t bytes = sizeof(uint64_t) * assoc_;
+        bytes = (bytes + BlockAlign - 1) & ~((size_t)BlockAlign - 1);
+        stride_ = bytes / sizeof(uint64_t);
+        if (posix_memalign((void**)&block_, BlockAlign, bytes * numSets_) != 0)
+            block_ = nullptr;
+        if (block_)
+            memset(block_, 0, bytes * numSets_);
+#if !defined(__AVX2__)
+        simd_ = false;
+#endif
+    }
+
+    ~FlatTagArray() { free(block_); }
+
+    bool valid() const { return block_ != nullptr; }
+    bool useSIMD() const { return simd_; }
+
+    /* Returns the line index holding 'tag' in 'set' or NotFound */
+    inline int find(unsigned int set, uint64_t tag) const {
+        const uint64_t * tags = tagsOf(set);
+        unsigned int way = 0;
+#if defined(__AVX2__)
+        if (simd_) {
+            const __m256i key = _mm256_set1_epi64x((long long)tag);
+            for (; way + 4 <= assoc_; way += 4) {
+                __m256i cmp = _mm256_cmpeq_epi64(_mm256_load_si256((const __m256i*)(tags + way)), key);
+                int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+                if (mask)
+                    return set * assoc_ + way + __builtin_ctz(mask);
+            }
+        }
+#endif
+        for (; way < assoc_; way++) {
+            if (tags[way] == tag)
+                return set * assoc_ + way;
+        }
+        return NotFound;
+    }
+
+    /* Line index -> tag slot */
+    inline void setTag(unsigned int index, uint64_t tag) {
+        unsigned int set = index / assoc_;
+        tagsOf(set)[index - set * assoc_] = tag;
+    }
+
+    inline uint64_t getTag(unsigned int index) const {
+        unsigned int set = index / assoc_;
+        return tagsOf(set)[index - set * assoc_];
+    }
+
+private:
+    inline uint64_t * tagsOf(unsigned int set) const { return block_ + (size_t)set * stride_; }
+
+    unsigned int numSets_;
+    unsigned int assoc_;
+    bool simd_;
+    size_t stride_;     // Block size in 64-bit words
+    uint64_t * block_;
+};
+
+}}
+#endif /* MEMHIERARCHY_FLATTAGARRAY_H */
@@ -53,7 +53,8 @@ class DirectoryLine {
 
     public:
         DirectoryLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(I), lastSendTimestamp_(0), wasPrefetch_(false) {
-            info_ = new CoherenceReplacementInfo(index, I, false, false);
+            // State is not copied to the replacement info
+            info_ = new CoherenceReplacementInfo(index, I, false, false, false);
         }
         virtual ~DirectoryLine() { }
 
@@ -140,7 +141,8 @@ class DataLine {
     public:
         DataLine(uint8_t size, unsigned int index) : index_(index), addr_(0), tag_(nullptr) {
             data_.resize(size);
-            info_ = new CoherenceReplacementInfo(index, I, false, false);
+            // Only used while there is no tag and never updated
+            info_ = new CoherenceReplacementInfo(index, I, false, false, false);
         }
         virtual ~DataLine() { }
 
@@ -164,7 +166,7 @@ class DataLine {
 
         // Data
         vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> data, uint32_t offset) {
+        void setData(const vector<uint8_t>& data, uint32_t offset) {
             std::copy(data.begin(), data.end(), data_.begin() + offset);
         }
 
@@ -217,7 +219,7 @@ class CacheLine {
 
         // Data
         vector<uint8_t>* getData() { return &data_; }
-        void setData(vector<uint8_t> in, uint32_t offset) {
+        void setData(const vector<uint8_t>& in, uint32_t offset) {
             std::copy(in.begin(), in.end(), std::next(data_.begin(), offset));
         }
 
@@ -24,6 +24,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/payload.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -137,7 +138,7 @@ public:
         prefetch_           = false;
         NACKedEvent_        = nullptr;
         retries_            = 0;
-        payload_.clear();
+        payload_.reset();
         dirty_              = false;
 	instPtr_	    = 0;
 	vAddr_		    = 0;
@@ -194,18 +195,47 @@ public:
     void setSuccess(bool b) { b ? clearFlag(MemEventBase::F_FAIL) : setFlag(MemEventBase::F_FAIL); }
     bool success() { return !queryFlag(MemEventBase::F_FAIL); }
 
-    /** @return  the data payload. */
+    /** @return  the data payload, writable.
+     * If the payload is shared with another event it is copied first.
+     * Use readPayload() when the data is only read or forwarded.
+     */
     dataVec& getPayload(void) {
+        dataVec& payload = payload_.write();
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
-        return payload_;
+        if ( payload.size() < size_ )  payload.resize(size_);
+        return payload;
     }
 
+    /** @return  the data payload, read-only.
+     * Does not copy a payload that already holds the event's size. A shorter
+     * (not yet allocated) payload is first grown to the event's size, which
+     * copies it if it is shared with another event.
+     */
+    const dataVec& readPayload(void) {
+        if ( payload_.size() < size_ )  payload_.fill().resize(size_);
+        return payload_.read();
+    }
+
+    /** @return  the payload buffer itself, for handing data to another event or the MSHR without a copy.
+     * Grows the payload to the event's size first, like readPayload().
+     */
+    const Payload& getPayloadBuffer(void) {
+        if ( payload_.size() < size_ )  payload_.fill().resize(size_);
+        return payload_;
+    }
 
     /** Sets the data payload and payload size.
      * @param[in] data  Vector from which to copy data
      */
-    void setPayload(std::vector<uint8_t>& data) {
+    void setPayload(const std::vector<uint8_t>& data) {
+        setSize(data.size());
+        payload_.assign(data);
+    }
+
+    /** Sets the data payload and payload size by sharing another payload buffer
+     * @param[in] data  Payload to share
+     */
+    void setPayload(const Payload& data) {
         setSize(data.size());
         payload_ = data;
     }
@@ -216,16 +246,23 @@ public:
      */
     void setPayload(uint32_t size, uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        if (data == nullptr)
+            payload_.assignZero(size);
+        else
+            payload_.assign(size, data);
+    }
+
+    /** Sets the payload size and returns an unshared, zeroed payload to be filled in place.
+     * Unlike getPayload(), the buffer may still be shared with later events.
+     */
+    dataVec& initPayload(uint32_t size) {
+        setZeroPayload(size);
+        return payload_.fill();
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        payload_.assignZero(size);
     }
 
     size_t getPayloadSize() override {
@@ -268,9 +305,10 @@ public:
             str << " Data: " << (payload_.empty() ? "F" : "T");
         else {
             std::stringstream value;
+            const dataVec& payload = payload_.read();
             value << std::hex << std::setfill('0');
-            for (unsigned int i = 0; i < payload_.size(); i++)
-                value << std::hex << std::setw(2) << (int)payload_[i];
+            for (unsigned int i = 0; i < payload.size(); i++)
+                value << std::hex << std::setw(2) << (int)payload[i];
             str << " Data: 0x" << value.str();
         }
         str << " VA: 0x" << vAddr_ << " IP: 0x" << instPtr_;
@@ -316,7 +354,7 @@ private:
     bool            addrGlobal_;        // Whether address is a local or global address
     MemEvent*       NACKedEvent_;       // For a NACK, pointer to the NACKed event
     int             retries_;           // For NACKed events, how many times a retry has been sent
-    dataVec         payload_;           // Data
+    Payload         payload_;           // Data, shared copy-on-write between events
     bool            prefetch_;          // Whether this request came from a prefetcher
     bool            dirty_;             // For a replacement, whether the data is dirty or not
     bool            isEvict_;           // Whether an event is an eviction
@@ -334,7 +372,12 @@ public:
         ser & addrGlobal_;
         ser & NACKedEvent_;
         ser & retries_;
-        ser & payload_;
+        dataVec payload;
+        if (ser.mode() != SST::Core::Serialization::serializer::UNPACK)
+            payload = payload_.read();
+        ser & payload;
+        if (ser.mode() == SST::Core::Serialization::serializer::UNPACK)
+            payload_.assign(payload);
         ser & prefetch_;
         ser & dirty_;
         ser & isEvict_;
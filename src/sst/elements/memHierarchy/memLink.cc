@@ -193,8 +193,8 @@ MemEventBase * MemLink::recv() {
     return nullptr;
 }
 
-std::string MemLink::getTargetDestination(Addr addr) {
-    std::string dst = findTargetDestination(addr);
+const std::string& MemLink::getTargetDestination(Addr addr) {
+    const std::string& dst = findTargetDestination(addr);
     if ("" != dst) {
         return dst;
     }
@@ -205,14 +205,14 @@ std::string MemLink::getTargetDestination(Addr addr) {
         error << it->name << " " << it->region.toString() << endl;
     }
     dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-    return "";
+    return noTargetDestination();
 }
 
-std::string MemLink::findTargetDestination(Addr addr) {
+const std::string& MemLink::findTargetDestination(Addr addr) {
     for (std::set<EndpointInfo>::const_iterator it = remotes.begin(); it != remotes.end(); it++) {
         if (it->region.contains(addr)) return it->name;
     }
-    return "";
+    return noTargetDestination();
 }
 
 bool MemLink::isReachable(std::string dst) {
@@ -101,8 +101,8 @@ public:
     virtual std::set<EndpointInfo>* getDests();
     virtual bool isDest(std::string UNUSED(str));
     virtual bool isSource(std::string UNUSED(str));
-    virtual std::string findTargetDestination(Addr addr);
-    virtual std::string getTargetDestination(Addr addr);
+    virtual const std::string& findTargetDestination(Addr addr);
+    virtual const std::string& getTargetDestination(Addr addr);
     virtual bool isReachable(std::string dst);
 
     /* Send and receive functions for MemLink */
@@ -171,9 +171,17 @@ public:
     // Link call back for incoming events
     void recvNotify(SST::Event * ev) { (*recvHandler)(ev); }
 
-    /* Functions for managing communication according to address */
-    virtual std::string findTargetDestination(Addr addr) =0;    /* Return destination and return "" if none found */
-    virtual std::string getTargetDestination(Addr addr) =0;     /* Return destination and error if none found */
+    /* Functions for managing communication according to address
+     * These are called for every event sent by address, so they return a reference to a
+     * name the link already holds rather than building a new string */
+    virtual const std::string& findTargetDestination(Addr addr) =0;    /* Return destination and return "" if none found */
+    virtual const std::string& getTargetDestination(Addr addr) =0;     /* Return destination and error if none found */
+
+    /* Returned by findTargetDestination() when no destination is found */
+    static const std::string& noTargetDestination() {
+        static const std::string none;
+        return none;
+    }
     
     /* Check if a request address maps to our region */
     virtual bool isRequestAddressValid(Addr addr) { return info.region.contains(addr); }
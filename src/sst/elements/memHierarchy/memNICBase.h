@@ -28,6 +28,7 @@
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/routeTable.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -150,7 +151,7 @@ class MemNICBase : public MemLinkBase {
         [[deprecated("sendInitData() has been deprecated and will be removed in SST 14.  Please use sendUntimedData().")]]
         virtual void sendInitData(MemEventInit * ev, bool broadcast = true) {
             if (!broadcast) {
-                std::string dst = findTargetDestination(ev->getRoutingAddress());
+                const std::string& dst = findTargetDestination(ev->getRoutingAddress());
                 if (dst == "") {
                     // Hold this request until we know the right address
                     initWaitForDst.insert(ev);
@@ -203,7 +204,13 @@ class MemNICBase : public MemLinkBase {
         virtual std::set<EndpointInfo>* getSources() { return &sourceEndpointInfo; }
         virtual std::set<EndpointInfo>* getDests() { return &destEndpointInfo; }
         
-        virtual std::string findTargetDestination(Addr addr) {
+        virtual const std::string& findTargetDestination(Addr addr) {
+            if (routeTableReady) {
+                int route = routeTable.find(addr);
+                return route == AddrRouteTable::NoRoute ? noTargetDestination() : routes[route].name;
+            }
+
+            // Before setup() compiles the route table
             dbg.debug(_L4_, "remote size: %d\n",destEndpointInfo.size());
             dbg.debug(_L4_, "addr: %" PRIu64 "\n",addr);
 
@@ -212,11 +219,11 @@ class MemNICBase : public MemLinkBase {
                 dbg.debug(_L4_, "down addr: %" PRIu64 " upp address %" PRIu64 "\n",it->region.start, it->region.end);
                 if (it->region.contains(addr)) return it->name;
             }
-            return "";
+            return noTargetDestination();
         }
 
-        virtual std::string getTargetDestination(Addr addr) {
-            std::string dst = findTargetDestination(addr);
+        virtual const std::string& getTargetDestination(Addr addr) {
+            const std::string& dst = findTargetDestination(addr);
             if (dst != "") {
                 return dst;
             }
@@ -228,7 +235,7 @@ class MemNICBase : public MemLinkBase {
                 error << it->name << " " << it->region.toString() << endl;
             }
             dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-            return "";
+            return noTargetDestination();
         }
 
         virtual bool isReachable(std::string dst) {
@@ -252,6 +259,8 @@ class MemNICBase : public MemLinkBase {
         virtual void addDest(EndpointInfo info) { 
             destEndpointInfo.insert(info); 
             reachableNames.insert(info.name);
+            if (routeTableReady)
+                buildRouteTable();
         }
 
         virtual void addEndpoint(EndpointInfo info) { endpointInfo.insert(info); }
@@ -287,7 +296,7 @@ class MemNICBase : public MemLinkBase {
                 }
 
                 for (auto it = initWaitForDst.begin(); it != initWaitForDst.end();) {
-                    std::string dst = findTargetDestination((*it)->getRoutingAddress());
+                    const std::string& dst = findTargetDestination((*it)->getRoutingAddress());
                     if (dst != "") {
                         (*it)->setDst(dst);
                         MemRtrEvent * mre = new MemRtrEvent(*it);
@@ -456,6 +465,30 @@ class MemNICBase : public MemLinkBase {
                 dbg.fatal(CALL_INFO, -1, "%s, Error: Unable to find destination for init event %s\n",
                         getName().c_str(), (*initWaitForDst.begin())->getVerboseString(dlevel).c_str());
             }
+
+            buildRouteTable();
+            routeTableReady = true;
+        }
+
+        // Compile destEndpointInfo into the address -> destination table used by findTargetDestination() and send()
+        void buildRouteTable() {
+            routeTable.clear();
+            routes.clear();
+            std::unordered_map<std::string,int> routeIndex;
+            for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
+                std::unordered_map<std::string,int>::iterator rt = routeIndex.find(it->name);
+                if (rt == routeIndex.end()) {
+                    Route route;
+                    route.name = it->name;
+                    std::unordered_map<std::string,uint64_t>::const_iterator nt = networkAddressMap.find(it->name);
+                    route.hasNetworkAddress = (nt != networkAddressMap.end());
+                    route.networkAddress = route.hasNetworkAddress ? nt->second : 0;
+                    rt = routeIndex.insert(std::make_pair(it->name, (int)routes.size())).first;
+                    routes.push_back(route);
+                }
+                routeTable.addRegion(it->region.start, it->region.end, it->region.interleaveSize, it->region.interleaveStep, rt->second);
+            }
+            routeTable.build();
         }
 
         // Lookup the network address for a given endpoint
@@ -467,6 +500,22 @@ class MemNICBase : public MemLinkBase {
             return it->second;
         }
 
+        // Lookup the network address for an event's destination
+        // Events sent to the owner of their address take the network address that buildRouteTable()
+        // resolved for that route. The name compare only confirms that the event was routed by address;
+        // responses and other events sent to a named endpoint fall back to networkAddressMap.
+        uint64_t lookupNetworkAddress(MemEventBase* ev) const {
+            if (routeTableReady) {
+                int route = routeTable.find(ev->getRoutingAddress());
+                if (route != AddrRouteTable::NoRoute) {
+                    const Route& rt = routes[route];
+                    if (rt.hasNetworkAddress && rt.name == ev->getDst())
+                        return rt.networkAddress;
+                }
+            }
+            return lookupNetworkAddress(ev->getDst());
+        }
+
         /*
          * Some helper functions to avoid needing to repeat code everywhere
          */
@@ -541,6 +590,16 @@ class MemNICBase : public MemLinkBase {
         std::set<EndpointInfo> endpointInfo;
         std::set<std::string> reachableNames;
 
+        // Routing table, built in setup()
+        struct Route {
+            std::string name;
+            uint64_t networkAddress;
+            bool hasNetworkAddress;
+        };
+        AddrRouteTable routeTable;          // Address -> index in routes
+        std::vector<Route> routes;
+        bool routeTableReady = false;
+
         // Init queues
         std::queue<MemRtrEvent*> initQueue; // Queue for received init events
         std::queue<SST::Interfaces::SimpleNetwork::Request*> initSendQueue; // Queue of events waiting to be sent after network (linkcontrol) initializes
@@ -141,7 +141,7 @@ void MemNICFour::send(MemEventBase *ev) {
     SimpleNetwork::Request * req = new SimpleNetwork::Request();
     req->vn = 0;
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = lookupNetworkAddress(ev);
 
     unsigned int tag = sendTags[req->dest];
     sendTags[req->dest]++;
@@ -272,10 +272,10 @@ MemNICFour::OrderedMemRtrEvent* MemNICFour::processRecv(SimpleNetwork::Request *
                         getName().c_str(), imre->info.name.c_str());
             }
             if (sourceIDs.find(imre->info.id) != sourceIDs.end()) {
-                sourceEndpointInfo.insert(imre->info);
+                addSource(imre->info);
             } 
             if (destIDs.find(imre->info.id) != destIDs.end()) {
-                destEndpointInfo.insert(imre->info);
+                addDest(imre->info);
             }
             delete imre;
         }
@@ -18,7 +18,19 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <string.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -31,46 +43,276 @@ public:
     virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
-    virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void set( Addr addr, size_t size, const std::vector<uint8_t>& data) = 0;
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
     virtual void dump( FILE* ) {};
+
+    /* Binary snapshot, see BackingSnapshot. Defaults to the text dump for backings without one */
+    virtual void snapshot( FILE* fp, bool UNUSED(compress) ) { dump(fp); }
 };
 
-class BackingMMAP : public Backing {
+/*
+ * Checkpoint writers shared by the backings. A checkpoint is a list of equally
+ * sized pages in either format below; BackingMalloc( FILE* ) restores both.
+ */
+class BackingSnapshot {
 public:
-    BackingMMAP(std::string memoryFile, size_t size, size_t offset = 0) : Backing(), m_fd(-1), m_size(size), m_offset(offset) {
-        int flags = MAP_SHARED;
-        if ( ! memoryFile.empty() ) {
-            m_fd = open(memoryFile.c_str(), O_RDWR);
-            if ( m_fd < 0) {
-                throw 1;
+    typedef std::vector<std::pair<Addr, const uint8_t*> > PageList;    // Page address, contents; sorted by address
+
+    static constexpr const char* Magic = "SSTMEMSN";
+    static const uint32_t Version = 1;
+    static const uint64_t Align = 4096;
+    enum { Raw = 0, Zlib = 1 };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t init;
+        uint64_t allocUnit;
+        uint64_t numPages;
+    };
+
+    struct Page {
+        uint64_t addr;
+        uint64_t offset;    // Blob location in file
+        uint64_t size;      // Blob size in file
+        uint64_t encoding;
+    };
+
+    static uint64_t align(uint64_t offset) { return (offset + Align - 1) & ~(Align - 1); }
+
+    /* Text format, one line of 64-bit words per page */
+    static void writeText( FILE* fp, const PageList& pages, uint64_t pageSize, bool init ) {
+        fprintf(fp,"Number-of-pages: %zu\n",pages.size());
+        fprintf(fp,"m_allocUnit: %d\n",(int)pageSize);
+        fprintf(fp,"m_init: %d\n",init);
+        fprintf(fp,"m_shift: %d\n",log2Of(pageSize));
+
+        size_t length = pageSize / sizeof(uint64_t);
+        for ( auto const& x : pages ) {
+            fprintf(fp,"addr: %#" PRIx64 "\n",x.first);
+            const uint64_t* ptr = (const uint64_t*) x.second;
+            for ( size_t i = 0; i < length ; i++ ) {
+                fprintf(fp,"%#" PRIx64 "",ptr[i]);
+                if ( i + 1 < length ) {
+                    fprintf(fp," ");
+                }
+            }
+            fprintf(fp,"\n");
+        }
+    }
+
+    /*
+     * Binary format, native byte order:
+     *   Header
+     *   Page[numPages]             page index
+     *   page blobs                 raw pages start on an Align boundary
+     * Raw pages are used in place from a private (copy-on-write) mapping of the
+     * file when it is restored, so only the pages the simulation touches are read.
+     * With 'compress' (requires zlib) pages are deflated when that makes them
+     * smaller and are inflated on first access.
+     * Returns false if the file could not be written.
+     */
+    static bool writeBinary( FILE* fp, const PageList& pages, uint64_t pageSize, bool init, bool UNUSED(compress) ) {
+        Header header;
+        memcpy(header.magic, Magic, sizeof(header.magic));
+        header.version = Version;
+        header.init = init;
+        header.allocUnit = pageSize;
+        header.numPages = pages.size();
+
+        std::vector<Page> index;
+        std::vector<std::vector<uint8_t> > blobs;   // Compressed pages, empty if stored raw
+        index.reserve(pages.size());
+        blobs.resize(pages.size());
+
+        uint64_t offset = align(sizeof(Header) + sizeof(Page) * header.numPages);
+        for (size_t i = 0; i < pages.size(); i++) {
+            Page entry;
+            entry.addr = pages[i].first;
+            entry.encoding = Raw;
+            entry.size = pageSize;
+#ifdef HAVE_LIBZ
+            if (compress) {
+                uLongf len = compressBound(pageSize);
+                blobs[i].resize(len);
+                if (Z_OK == compress2(blobs[i].data(), &len, pages[i].second, pageSize, Z_BEST_SPEED) && len < pageSize) {
+                    blobs[i].resize(len);
+                    entry.encoding = Zlib;
+                    entry.size = len;
+                } else {
+                    blobs[i].clear();
+                }
             }
-        } else {
-            flags  |= MAP_ANON;
+#endif
+            if (entry.encoding == Raw)
+                offset = align(offset);
+            entry.offset = offset;
+            offset += entry.size;
+            index.push_back(entry);
         }
-        m_buffer = (uint8_t*)mmap(NULL, size, PROT_READ|PROT_WRITE, flags, m_fd, 0);
 
-        if ( m_buffer == MAP_FAILED) {
-            throw 2;
+        bool ok = (1 == fwrite(&header, sizeof(header), 1, fp));
+        if (!index.empty())
+            ok = ok && (1 == fwrite(index.data(), sizeof(Page) * index.size(), 1, fp));
+        for (size_t i = 0; i < index.size() && ok; i++) {
+            ok = (0 == fseeko(fp, index[i].offset, SEEK_SET));
+            if (index[i].encoding == Raw)
+                ok = ok && (1 == fwrite(pages[i].second, pageSize, 1, fp));
+            else
+                ok = ok && (1 == fwrite(blobs[i].data(), blobs[i].size(), 1, fp));
         }
+        return ok;
     }
+};
+
+class BackingMMAP : public Backing {
+public:
+    /*
+     * A mapping that can be shared by several BackingMMAPs, e.g., the
+     * MemControllers of an interleaved memory, each using its own slice.
+     * Anonymous mappings are sparse (MAP_NORESERVE); physical memory is only
+     * committed for pages that are touched. Writes are tracked per PageSize
+     * page so that dump() and snapshot() only visit written pages.
+     */
+    class Store {
+    public:
+        static const uint64_t PageSize = 4096;
+
+        Store(std::string memoryFile, size_t size, bool hugepages = false) : m_fd(-1), m_size(roundUp(size)), m_reserved(0) {
+            int flags = MAP_SHARED;
+            if ( ! memoryFile.empty() ) {
+                m_fd = open(memoryFile.c_str(), O_RDWR);
+                if ( m_fd < 0) {
+                    throw 1;
+                }
+                /* The mapping is rounded up to whole pages. Grow a shorter file to
+                 * match, or touching the tail past EOF would raise SIGBUS */
+                struct stat st;
+                if ( fstat( m_fd, &st ) != 0 || ( (size_t)st.st_size < m_size && ftruncate( m_fd, m_size ) != 0 ) ) {
+                    close( m_fd );
+                    throw 2;
+                }
+            } else {
+                flags = MAP_PRIVATE | MAP_ANON | MAP_NORESERVE;
+            }
+            m_buffer = (uint8_t*)mmap(NULL, m_size, PROT_READ|PROT_WRITE, flags, m_fd, 0);
+
+            if ( m_buffer == MAP_FAILED) {
+                if ( -1 != m_fd ) {
+                    close( m_fd );
+                }
+                throw 2;
+            }
+#ifdef MADV_HUGEPAGE
+            if ( hugepages && -1 == m_fd ) {
+                madvise( m_buffer, m_size, MADV_HUGEPAGE ); // Advisory, ignore failure
+            }
+#endif
+            /* Pre-loaded file contents count as touched */
+            m_words = (m_size / PageSize + 63) / 64;
+            m_touched.reset(new std::atomic<uint64_t>[m_words]);
+            for (size_t i = 0; i < m_words; i++)
+                m_touched[i].store(-1 == m_fd ? 0 : ~0ULL, std::memory_order_relaxed);
+        }
+
+        ~Store() {
+            munmap( m_buffer, m_size );
+            if ( -1 != m_fd ) {
+                close( m_fd );
+            }
+        }
+
+        /*
+         * Anonymous store shared by everyone in the process asking for 'name'.
+         * The first caller sets the size. The mapping is released with its last user.
+         */
+        static std::shared_ptr<Store> getShared(const std::string& name, size_t size, bool hugepages = false) {
+            static std::mutex mtx;
+            static std::map<std::string, std::weak_ptr<Store> > stores;
+            std::lock_guard<std::mutex> lock(mtx);
+            std::shared_ptr<Store> store = stores[name].lock();
+            if (!store) {
+                store = std::make_shared<Store>("", size, hugepages);
+                stores[name] = store;
+            }
+            return store;
+        }
+
+        /* Carve the next 'size' bytes (page aligned) out of the store. Throws 3 if it is full */
+        size_t reserve(size_t size) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            size_t base = m_reserved;
+            if (size > m_size - base)
+                throw 3;
+            m_reserved = std::min(m_size, roundUp(base + size));
+            return base;
+        }
+
+        void touch(size_t offset, size_t size) {
+            for (size_t page = offset / PageSize; page <= (offset + size - 1) / PageSize; page++) {
+                uint64_t bit = 1ULL << (page & 63);
+                if (!(m_touched[page >> 6].load(std::memory_order_relaxed) & bit))
+                    m_touched[page >> 6].fetch_or(bit, std::memory_order_relaxed);
+            }
+        }
 
-    ~BackingMMAP() {
-        munmap( m_buffer, m_size );
-        if ( -1 != m_fd ) {
-            close( m_fd );
+        /* Touched pages in [offset, offset + size), relative to 'offset' */
+        std::vector<size_t> touchedPages(size_t offset, size_t size) const {
+            std::vector<size_t> pages;
+            size_t first = offset / PageSize;
+            size_t last = std::min((offset + size + PageSize - 1) / PageSize, m_size / PageSize);
+            for (size_t w = first >> 6; w < m_words && (w << 6) < last; w++) {
+                uint64_t word = m_touched[w].load(std::memory_order_relaxed);
+                while (word) {
+                    size_t page = (w << 6) + __builtin_ctzll(word);
+                    word &= word - 1;
+                    if (page >= first && page < last)
+                        pages.push_back(page * PageSize - offset);
+                }
+            }
+            return pages;
         }
+
+        uint8_t* data() { return m_buffer; }
+        size_t size() const { return m_size; }
+
+    private:
+        static size_t roundUp(size_t size) { return (size + PageSize - 1) & ~(PageSize - 1); }
+
+        uint8_t* m_buffer;
+        int m_fd;
+        size_t m_size;
+        size_t m_reserved;
+        size_t m_words;
+        std::unique_ptr<std::atomic<uint64_t>[]> m_touched;
+        std::mutex m_mutex;
+    };
+
+    BackingMMAP(std::string memoryFile, size_t size, size_t offset = 0, bool hugepages = false) : Backing(),
+            m_store(std::make_shared<Store>(memoryFile, size, hugepages)), m_base(0), m_size(size), m_offset(offset) {
+        m_buffer = m_store->data();
+    }
+
+    /* Use the next 'size' bytes of a shared store */
+    BackingMMAP(std::shared_ptr<Store> store, size_t size, size_t offset = 0) : Backing(),
+            m_store(store), m_base(store->reserve(size)), m_size(size), m_offset(offset) {
+        m_buffer = m_store->data() + m_base;
     }
 
+    ~BackingMMAP() { }
+
     void set( Addr addr, uint8_t value ) {
+        m_store->touch(m_base + addr - m_offset, 1);
         m_buffer[addr - m_offset ] = value;
     }
 
-    void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+    void set (Addr addr, size_t size, const std::vector<uint8_t> &data) {
+        if (size == 0) return;
+        m_store->touch(m_base + addr - m_offset, size);
+        memcpy(m_buffer + (addr - m_offset), data.data(), size);
     }
 
     uint8_t get( Addr addr ) {
@@ -78,21 +320,41 @@ public:
     }
 
     void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+        memcpy(data.data(), m_buffer + (addr - m_offset), size);
+    }
+
+    /* Checkpoints contain the touched pages only and are restored with BackingMalloc */
+    void dump( FILE* fp ) {
+        BackingSnapshot::writeText(fp, touchedPages(), Store::PageSize, true);
+    }
+
+    void snapshot( FILE* fp, bool compress ) {
+        if (!BackingSnapshot::writeBinary(fp, touchedPages(), Store::PageSize, true, compress)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMMAP: Error - failed to write snapshot.\n");
+        }
     }
 
 private:
+    BackingSnapshot::PageList touchedPages() {
+        BackingSnapshot::PageList pages;
+        std::vector<size_t> offsets = m_store->touchedPages(m_base, m_size);
+        for (auto const& off : offsets)
+            pages.push_back(std::make_pair(m_offset + off, m_buffer + off));
+        return pages;
+    }
+
+    std::shared_ptr<Store> m_store;
     uint8_t* m_buffer;
-    int m_fd;
-    int m_size;
+    size_t m_base;      // Start of this backing in the store
+    size_t m_size;
     size_t m_offset;
 };
 
 #define CHECKPOINT_DBG 0
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc(size_t size, bool init = false ) : m_init(init) {
+    BackingMalloc(size_t size, bool init = false ) : m_init(init), m_snapshot(nullptr), m_snapshotSize(0) {
         m_allocUnit = size;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(m_allocUnit)) {
@@ -102,7 +364,15 @@ public:
         m_shift = log2Of(m_allocUnit);
     }
 
-    BackingMalloc( FILE* fp ) {
+    /* Restore from a checkpoint written by dump() (text) or snapshot() (binary) */
+    BackingMalloc( FILE* fp ) : m_snapshot(nullptr), m_snapshotSize(0) {
+        SnapshotHeader header;
+        if (1 == fread(&header, sizeof(header), 1, fp) && 0 == memcmp(header.magic, BackingSnapshot::Magic, sizeof(header.magic))) {
+            loadSnapshot(fp, header);
+            return;
+        }
+        rewind(fp);
+
         int num; 
         char str[80];
         fscanf(fp,"Number-of-pages: %d\n", &num );
@@ -149,38 +419,26 @@ public:
 #endif
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+        allocIfNeeded(bAddr)[offset] = value;
     }
 
-    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+    void set( Addr addr, size_t size, const std::vector<uint8_t> &data ) {
         /* Account for size exceeding alloc unit size */
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
 #if CHECKPOINT_DBG 
-        printf("%s() addr=%#lx size=%zu ",__func__,addr,size);
+        printf("%s() addr=%#lx size=%zu\n",__func__,addr,size);
 #endif
+        /* One copy per allocation unit */
         while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-#if CHECKPOINT_DBG 
-            printf("%#x ",data[dataOffset]);
-#endif
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+            size_t chunk = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(allocIfNeeded(bAddr) + offset, data.data() + dataOffset, chunk);
+            dataOffset += chunk;
+            offset = 0;
+            bAddr++;
         }
-#if CHECKPOINT_DBG 
-        printf("\n");
-#endif
     }
 
     void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
@@ -191,21 +449,15 @@ public:
         Addr offset = addr - (bAddr << m_shift);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
         assert( data.size() == size );
 
-        assert( m_buffer.find(bAddr) != m_buffer.end() ); 
-        auto buf = m_buffer[bAddr];
+        /* One copy per allocation unit */
         while (dataOffset != size) {
-            
-            data[dataOffset] = buf[offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+            size_t chunk = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(data.data() + dataOffset, allocIfNeeded(bAddr) + offset, chunk);
+            dataOffset += chunk;
+            offset = 0;
+            bAddr++;
         }
 #if CHECKPOINT_DBG 
         for ( auto i = 0; i < size; i++ ) {
@@ -218,51 +470,127 @@ public:
     uint8_t get( Addr addr ) {
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        return allocIfNeeded(bAddr)[offset];
     }
 
 
     void dump( FILE* fp ) {
-        fprintf(fp,"Number-of-pages: %zu\n",m_buffer.size());
-        fprintf(fp,"m_allocUnit: %d\n",m_allocUnit);
-        fprintf(fp,"m_init: %d\n",m_init);
-        fprintf(fp,"m_shift: %d\n",m_shift);
-
-        for ( auto const& x : m_buffer ) {
-            fprintf(fp,"addr: %#llx\n",x.first << m_shift);
-            auto length = sizeof(uint8_t)*m_allocUnit;
-            length /= sizeof(uint64_t);
-            auto ptr = (uint64_t*) x.second;
-            for ( auto i = 0; i < length ; i++ ) {
-                fprintf(fp,"%#" PRIx64 "",ptr[i]); 
-                if ( i + 1 < length ) {
-                    fprintf(fp," ");
-                }
-            }
-            fprintf(fp,"\n");
+        BackingSnapshot::writeText(fp, pages(), m_allocUnit, m_init);
+    }
+
+    /* Binary snapshot, see BackingSnapshot::writeBinary */
+    void snapshot( FILE* fp, bool compress ) {
+        if (!BackingSnapshot::writeBinary(fp, pages(), m_allocUnit, m_init, compress)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - failed to write snapshot.\n");
+        }
+    }
+
+    ~BackingMalloc() {
+        for (auto const& x : m_buffer) {
+            if (!inSnapshot(x.second))
+                free(x.second);
         }
+        if (m_snapshot)
+            munmap(m_snapshot, m_snapshotSize);
     }
 
 private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
-            if ( m_init ) {
-                bzero( data, m_allocUnit );
-            }
-            if (!data) {
-                Output out("", 1, 0, Output::STDOUT);
-                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
-            }
-            m_buffer[bAddr] = data;
+    typedef BackingSnapshot::Header SnapshotHeader;
+    typedef BackingSnapshot::Page SnapshotPage;
+
+    /* All pages sorted by address, inflating any that are still compressed */
+    BackingSnapshot::PageList pages() {
+        std::vector<Addr> lazy;
+        for (auto const& x : m_lazy)
+            lazy.push_back(x.first);
+        for (auto const& bAddr : lazy)
+            allocIfNeeded(bAddr);
+
+        BackingSnapshot::PageList list;
+        list.reserve(m_buffer.size());
+        for (auto const& x : m_buffer)
+            list.push_back(std::make_pair(x.first << m_shift, (const uint8_t*)x.second));
+        std::sort(list.begin(), list.end());
+        return list;
+    }
+
+    bool inSnapshot(const uint8_t* ptr) const { return m_snapshot && ptr >= m_snapshot && ptr < m_snapshot + m_snapshotSize; }
+
+    void loadSnapshot(FILE* fp, const SnapshotHeader& header) {
+        Output out("", 1, 0, Output::STDOUT);
+        if (header.version != BackingSnapshot::Version)
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - snapshot version %" PRIu32 " is not supported (expected %" PRIu32 ").\n", header.version, BackingSnapshot::Version);
+        if (!isPowerOfTwo(header.allocUnit))
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - snapshot page size must be a power of two. Got: %" PRIu64 "\n", header.allocUnit);
+
+        m_allocUnit = header.allocUnit;
+        m_shift = log2Of(m_allocUnit);
+        m_init = header.init;
+
+        struct stat st;
+        if (0 != fstat(fileno(fp), &st))
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - unable to stat snapshot.\n");
+        m_snapshotSize = st.st_size;
+        m_snapshot = (uint8_t*) mmap(NULL, m_snapshotSize, PROT_READ|PROT_WRITE, MAP_PRIVATE, fileno(fp), 0);
+        if (m_snapshot == MAP_FAILED)
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - unable to map snapshot.\n");
+
+        const SnapshotPage* index = (const SnapshotPage*)(m_snapshot + sizeof(SnapshotHeader));
+        if (sizeof(SnapshotHeader) + sizeof(SnapshotPage) * header.numPages > m_snapshotSize)
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - snapshot is truncated.\n");
+        for (uint64_t i = 0; i < header.numPages; i++) {
+            const SnapshotPage& page = index[i];
+            if (page.offset + page.size > m_snapshotSize)
+                out.fatal(CALL_INFO, -1, "BackingMalloc: Error - snapshot is truncated.\n");
+            Addr bAddr = page.addr >> m_shift;
+            if (page.encoding == BackingSnapshot::Raw)
+                m_buffer[bAddr] = m_snapshot + page.offset;
+            else
+                m_lazy[bAddr] = page;
         }
     }
 
+    uint8_t* allocIfNeeded(Addr bAddr) {
+        std::unordered_map<Addr,uint8_t*>::iterator it = m_buffer.find(bAddr);
+        if (it != m_buffer.end())
+            return it->second;
+
+        uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
+        if (!data) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
+        }
+        std::unordered_map<Addr,SnapshotPage>::iterator lazy = m_lazy.find(bAddr);
+        if (lazy != m_lazy.end()) {
+            inflatePage(lazy->second, data);
+            m_lazy.erase(lazy);
+        } else if ( m_init ) {
+            bzero( data, m_allocUnit );
+        }
+        m_buffer[bAddr] = data;
+        return data;
+    }
+
+    void inflatePage(const SnapshotPage& page, uint8_t* data) {
+        Output out("", 1, 0, Output::STDOUT);
+#ifdef HAVE_LIBZ
+        uLongf len = m_allocUnit;
+        if (page.encoding == BackingSnapshot::Zlib && Z_OK == uncompress(data, &len, m_snapshot + page.offset, page.size) && len == m_allocUnit)
+            return;
+        out.fatal(CALL_INFO, -1, "BackingMalloc: Error - unable to decode snapshot page at 0x%" PRIx64 ".\n", page.addr);
+#else
+        out.fatal(CALL_INFO, -1, "BackingMalloc: Error - snapshot page at 0x%" PRIx64 " is compressed but SST was built without zlib.\n", page.addr);
+#endif
+    }
+
     std::unordered_map<Addr,uint8_t*> m_buffer;
+    std::unordered_map<Addr,SnapshotPage> m_lazy;   // Compressed snapshot pages not yet accessed
     unsigned int m_allocUnit;
     unsigned int m_shift;
     bool m_init;
+    uint8_t* m_snapshot;                            // Private mapping of a restored snapshot
+    size_t m_snapshotSize;
 };
 
 }
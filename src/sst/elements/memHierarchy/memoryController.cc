@@ -82,6 +82,12 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         checkpoint_ = NO_CHECKPOINT;
     }
 
+    std::string checkpointFormat = params.find<std::string>("checkpoint_format", "binary");
+    if (checkpointFormat != "binary" && checkpointFormat != "text")
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): checkpoint_format - must be 'binary' or 'text'. You specified: %s\n", getName().c_str(), checkpointFormat.c_str());
+    checkpointBinary_ = (checkpointFormat == "binary");
+    checkpointCompress_ = params.find<bool>("checkpoint_compress", false);
+
     bool initBacking = params.find<bool>("initBacking", false);
 
     // Debug address
@@ -308,8 +314,22 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if ( 0 == memoryFile.compare( NO_STRING_DEFINED ) ) {
             memoryFile.clear();
         }
+        bool hugepages = params.find<bool>("backing_hugepages", false);
+        std::string sharedName = params.find<std::string>("backing_shared", "");
+        if (!sharedName.empty() && !memoryFile.empty())
+            out.fatal(CALL_INFO, -1, "%s, Error - 'backing_shared' cannot be used with 'memory_file'.\n", getName().c_str());
+
         try {
-            backing_ = new Backend::BackingMMAP( memoryFile, memBackendConvertor_->getMemSize() );
+            if (sharedName.empty()) {
+                backing_ = new Backend::BackingMMAP( memoryFile, memBackendConvertor_->getMemSize(), 0, hugepages );
+            } else {
+                UnitAlgebra sharedSize(params.find<std::string>("backing_shared_size", "0B"));
+                if (!sharedSize.hasUnits("B") || sharedSize.getRoundedValue() == 0)
+                    out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_shared_size. Must be a non-zero size with units of bytes (B). SI ok. You specified: %s\n",
+                            getName().c_str(), sharedSize.toString().c_str());
+                backing_ = new Backend::BackingMMAP( Backend::BackingMMAP::Store::getShared(sharedName, sharedSize.getRoundedValue(), hugepages),
+                        memBackendConvertor_->getMemSize() );
+            }
         }
         catch ( int e) {
             if (e == 1)
@@ -321,6 +341,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
                 } else {
                     out.fatal(CALL_INFO, -1, "%s, Error - Could not MMAP backing store from file %s\n", getName().c_str(), memoryFile.c_str());
                 }
+            } else if (e == 3) {
+                out.fatal(CALL_INFO, -1, "%s, Error - shared backing store '%s' is too small to hold this controller's memory\n", getName().c_str(), sharedName.c_str());
             } else
                 out.fatal(CALL_INFO, -1, "%s, Error - unable to create backing store. Exception thrown is %d.\n", getName().c_str(), e);
         }
@@ -337,6 +359,9 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         }
     }
 
+    stat_payloadBytesCopied_ = registerStatistic<uint64_t>("payload_bytes_copied");
+    stat_payloadAllocationsAvoided_ = registerStatistic<uint64_t>("payload_allocations_avoided");
+
     /* Custom command handler */
     using std::placeholders::_3;
     customCommandHandler_ = loadUserSubComponent<CustomCmdMemHandler>("customCmdHandler", ComponentInfo::SHARE_NONE,
@@ -603,13 +628,22 @@ void MemController::finish(void) {
     cycle--;
     memBackendConvertor_->finish(cycle);
     link_->finish();
+
+    static std::atomic<bool> payloadStatsReported(false);
+    if (!payloadStatsReported.exchange(true)) {
+        stat_payloadBytesCopied_->addData(PayloadStats::bytesCopied.load());
+        stat_payloadAllocationsAvoided_->addData(PayloadStats::allocationsAvoided.load());
+    }
     if ( CHECKPOINT_SAVE ==  checkpoint_ ) {
         stringstream filename;
         filename << checkpointDir_ << "/" << getName();
         auto fp = fopen(filename.str().c_str(),"w+");
         assert(fp);
         printf("Checkpoint component `%s` %s\n",getName().c_str(), filename.str().c_str());
-        backing_->dump( fp );
+        if (checkpointBinary_)
+            backing_->snapshot( fp, checkpointCompress_ );
+        else
+            backing_->dump( fp );
         fclose( fp );
     }
 }
@@ -619,10 +653,10 @@ void MemController::writeData(MemEvent* event) {
         Addr addr = event->queryFlag(MemEvent::F_NONCACHEABLE) ? event->getAddr() : event->getBaseAddr();
         if (is_debug_event(event)) { 
             Debug(_L8_, "S: Update backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); 
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->readPayload()), true);
         }
 
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->readPayload());
 
         return;
     }
@@ -631,10 +665,10 @@ void MemController::writeData(MemEvent* event) {
         Addr addr = event->getAddr();
         if (is_debug_event(event)) { 
             Debug(_L8_, "S: Update backing. Addr = %" PRIx64 ", Size = %i\n", addr, event->getSize()); 
-            printDataValue(addr, &(event->getPayload()), true);
+            printDataValue(addr, &(event->readPayload()), true);
         }
         
-        backing_->set(addr, event->getSize(), event->getPayload());
+        backing_->set(addr, event->getSize(), event->readPayload());
 
         return;
     }
@@ -646,16 +680,14 @@ void MemController::readData(MemEvent* event) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
 
-    vector<uint8_t> payload;
-    payload.resize(event->getSize(), 0);
+    /* Fill the event's pooled payload in place */
+    vector<uint8_t>& payload = event->initPayload(event->getSize());
 
     if (backing_) {
         backing_->get(localAddr, event->getSize(), payload);
         if (is_debug_addr(localAddr))
             printDataValue(localAddr, &(payload), false);
     }
-
-    event->setPayload(payload);
 }
 
 
@@ -663,9 +695,7 @@ void MemController::readData(MemEvent* event) {
 void MemController::writeData(Addr addr, std::vector<uint8_t> * data) {
     if (!backing_) return;
 
-    for (size_t i = 0; i < data->size(); i++) {
-        backing_->set(addr + i, data->at(i));
-    }
+    backing_->set(addr, data->size(), *data);
 
     if (is_debug_addr(addr))
         printDataValue(addr, data, true);
@@ -677,9 +707,8 @@ void MemController::readData(Addr addr, size_t bytes, std::vector<uint8_t> &data
 
     if (!backing_) return;
 
-    for (size_t i = 0; i < bytes; i++)
-        data[i] = backing_->get(addr + i);
-    
+    backing_->get(addr, bytes, data);
+
     if (is_debug_addr(addr))
         printDataValue(addr, &data, false);
 }
@@ -807,7 +836,7 @@ void MemController::emergencyShutdown() {
     }
 }
 
-void MemController::printDataValue(Addr addr, std::vector<uint8_t>* data, bool set) {
+void MemController::printDataValue(Addr addr, const std::vector<uint8_t>* data, bool set) {
     if (dlevel < 11) return;
 
     std::string action = set ? "WRITE" : "READ";
@@ -53,6 +53,11 @@ public:
             {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_hugepages",   "(bool) For 'mmap' backing stores without a memory_file, advise the OS to use transparent huge pages", "false"},\
+            {"backing_shared",      "(string) For 'mmap' backing stores without a memory_file, name of a mapping shared by all controllers in the process that use the same name. Each controller uses the next 'memory size' bytes of it", ""},\
+            {"backing_shared_size", "(string) Size of the mapping named by 'backing_shared'. Required with 'backing_shared'; the first controller to create the mapping sets it. SI ok.", ""},\
+            {"checkpoint_format",   "(string) Format of backing store checkpoints written at the end of simulation: 'binary' (page-indexed, restored lazily via mmap) or 'text'. Either format can be loaded into a 'malloc' backing store; 'mmap' stores only write touched pages.", "binary"},\
+            {"checkpoint_compress", "(bool) Compress pages in binary checkpoints with zlib. Ignored if SST was built without zlib.", "false"},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -70,6 +75,11 @@ public:
 
     SST_ELI_DOCUMENT_PORTS( MEMCONTROLLER_ELI_PORTS )
 
+#define MEMCONTROLLER_ELI_STATS {"payload_bytes_copied",        "Process-wide: bytes of MemEvent/MSHR data copied (reported by one memory controller per process)", "bytes", 1},\
+            {"payload_allocations_avoided", "Process-wide: data buffers shared or reused from the payload pool instead of allocated (reported by one memory controller per process)", "count", 1}
+
+    SST_ELI_DOCUMENT_STATISTICS( MEMCONTROLLER_ELI_STATS )
+
 
 #define MEMCONTROLLER_ELI_SUBCOMPONENTSLOTS {"backend", "Backend memory model to use for timing. Defaults to simpleMem", "SST::MemHierarchy::MemBackend"},\
             {"customCmdHandler", "Optional handler for custom command types", "SST::MemHierarchy::CustomCmdMemHandler"}, \
@@ -141,6 +151,8 @@ protected:
     void readData( MemEvent* );
 
     std::string checkpointDir_;
+    bool checkpointBinary_;
+    bool checkpointCompress_;
     enum { NO_CHECKPOINT, CHECKPOINT_LOAD, CHECKPOINT_SAVE }  checkpoint_;
 
     size_t memSize_;
@@ -157,11 +169,15 @@ protected:
 
     CustomCmdMemHandler * customCommandHandler_;
 
+    /* Payload pool counters are process-wide; only one controller per process reports them */
+    Statistic<uint64_t>* stat_payloadBytesCopied_;
+    Statistic<uint64_t>* stat_payloadAllocationsAvoided_;
+
     /* Debug -triggered by output.fatal() and/or SIGUSR2 */
     virtual void printStatus(Output &out);
     virtual void emergencyShutdown();
     
-    void printDataValue(Addr addr, std::vector<uint8_t>* data, bool set);
+    void printDataValue(Addr addr, const std::vector<uint8_t>* data, bool set);
 
 private:
 
@@ -605,7 +605,21 @@ uint32_t MSHR::getAcksNeeded(Addr addr) {
     return (mshr_.find(addr)->second.acksNeeded);
 }
 
-void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
+void MSHR::setData(Addr addr, const vector<uint8_t>& data, bool dirty) {
+//    if (is_debug_addr(addr))
+//        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
+    if (mshr_.find(addr) == mshr_.end()) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
+    }
+
+    if (is_debug_addr(addr))
+        printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
+
+    mshr_.find(addr)->second.dataBuffer.assign(data);
+    mshr_.find(addr)->second.dataDirty = dirty;
+}
+
+void MSHR::setData(Addr addr, const Payload& data, bool dirty) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
     if (mshr_.find(addr) == mshr_.end()) {
@@ -625,7 +639,7 @@ void MSHR::clearData(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.dataBuffer.clear();
+    mshr_.find(addr)->second.dataBuffer.reset();
     mshr_.find(addr)->second.dataDirty = false;
 }
 
@@ -635,6 +649,13 @@ vector<uint8_t>& MSHR::getData(Addr addr) {
     if (mshr_.find(addr) == mshr_.end()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
+    return mshr_.find(addr)->second.dataBuffer.write();
+}
+
+const Payload& MSHR::getDataBuffer(Addr addr) {
+    if (mshr_.find(addr) == mshr_.end()) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataBuffer(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
+    }
     return mshr_.find(addr)->second.dataBuffer;
 }
 
@@ -0,0 +1,704 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "mshrHash.h"
+
+#include <algorithm>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+HashMSHR::HashMSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr) :
+    MSHR(cid, debug, maxSize, cacheName, debugAddr), numRegisters_(0)
+{
+    /* Expect up to one address per entry plus some evictions/writebacks; an unlimited MSHR starts small and grows */
+    unsigned int expected = maxSize > 0 ? maxSize : 64;
+    size_t buckets = 16;
+    while (buckets < 2 * (size_t)expected)
+        buckets <<= 1;
+    rehash(buckets);
+
+    registers_.reserve(expected);
+    entries_.reserve(expected);
+}
+
+/**************************************************************************
+ * Hash table
+ **************************************************************************/
+
+void HashMSHR::rehash(size_t buckets) {
+    std::vector<Bucket> old;
+    old.swap(table_);
+
+    table_.assign(buckets, Bucket{0, Nil});
+    mask_ = buckets - 1;
+    hashShift_ = 64;
+    for (size_t b = buckets; b > 1; b >>= 1)
+        hashShift_--;
+
+    for (std::vector<Bucket>::iterator it = old.begin(); it != old.end(); it++) {
+        if (it->reg == Nil) continue;
+        size_t i = hash(it->addr) & mask_;
+        while (table_[i].reg != Nil)
+            i = (i + 1) & mask_;
+        table_[i] = *it;
+    }
+}
+
+int HashMSHR::find(Addr addr) {
+    size_t i = hash(addr) & mask_;
+    while (table_[i].reg != Nil) {
+        if (table_[i].addr == addr)
+            return table_[i].reg;
+        i = (i + 1) & mask_;
+    }
+    return Nil;
+}
+
+int HashMSHR::findOrFatal(Addr addr, const char* func) {
+    int reg = find(addr);
+    if (reg == Nil)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::%s(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), func, addr);
+    return reg;
+}
+
+int HashMSHR::insertRegister(Addr addr) {
+    if (2 * (numRegisters_ + 1) > table_.size())
+        rehash(table_.size() * 2);
+
+    int reg = registers_.allocate();
+    registers_[reg].addr = addr;
+    numRegisters_++;
+
+    size_t i = hash(addr) & mask_;
+    while (table_[i].reg != Nil)
+        i = (i + 1) & mask_;
+    table_[i].addr = addr;
+    table_[i].reg = reg;
+    return reg;
+}
+
+/* Backward-shift deletion keeps probe sequences intact without tombstones */
+void HashMSHR::eraseRegister(Addr addr) {
+    size_t i = hash(addr) & mask_;
+    while (table_[i].addr != addr || table_[i].reg == Nil)
+        i = (i + 1) & mask_;
+
+    Register& reg = registers_[table_[i].reg];
+    reg.dataBuffer.reset();
+    reg = Register();
+    registers_.release(table_[i].reg);
+    numRegisters_--;
+
+    table_[i].reg = Nil;
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask_;
+        if (table_[j].reg == Nil)
+            break;
+        size_t home = hash(table_[j].addr) & mask_;
+        // Leave the bucket if its home lies cyclically in (i, j]
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+            continue;
+        table_[i] = table_[j];
+        table_[j].reg = Nil;
+        i = j;
+    }
+}
+
+/**************************************************************************
+ * Entry queues
+ **************************************************************************/
+
+void HashMSHR::linkEntry(Register& reg, int slot, int before) {
+    EntrySlot& entry = entries_[slot];
+    if (before == Nil) {
+        entry.prev = reg.tail;
+        entry.next = Nil;
+        if (reg.tail != Nil) entries_[reg.tail].next = slot;
+        else reg.head = slot;
+        reg.tail = slot;
+    } else {
+        EntrySlot& succ = entries_[before];
+        entry.prev = succ.prev;
+        entry.next = before;
+        if (succ.prev != Nil) entries_[succ.prev].next = slot;
+        else reg.head = slot;
+        succ.prev = slot;
+    }
+    reg.count++;
+}
+
+void HashMSHR::unlinkEntry(Register& reg, int slot) {
+    EntrySlot& entry = entries_[slot];
+    if (entry.prev != Nil) entries_[entry.prev].next = entry.next;
+    else reg.head = entry.next;
+    if (entry.next != Nil) entries_[entry.next].prev = entry.prev;
+    else reg.tail = entry.prev;
+    entry.prev = entry.next = Nil;
+    reg.count--;
+}
+
+int HashMSHR::allocateEntry(Register& reg, int before) {
+    int slot = entries_.allocate();
+    linkEntry(reg, slot, before);
+    return slot;
+}
+
+void HashMSHR::freeEntry(Register& reg, int slot) {
+    unlinkEntry(reg, slot);
+    entries_[slot].evictPtrs.clear();
+    entries_.release(slot);
+}
+
+int HashMSHR::entryAt(Register& reg, size_t index) {
+    int slot = reg.head;
+    while (index-- > 0 && slot != Nil)
+        slot = entries_[slot].next;
+    return slot;
+}
+
+/* Common tail of removeFront/removeEntry */
+void HashMSHR::removeSlot(Addr addr, int regIndex, int slot, const char* action) {
+    Register& reg = registers_[regIndex];
+
+    if (entries_[slot].entry.getType() == MSHREntryType::Event)
+        size_--;
+
+    if (is_debug_addr(addr))
+        printDebug(10, action, addr, entries_[slot].entry.getString().c_str());
+
+    freeEntry(reg, slot);
+    if (reg.count == 0) {
+        if (is_debug_addr(addr))
+            printDebug(10, "Erase", addr, "");
+        eraseRegister(addr);
+    }
+}
+
+/**************************************************************************
+ * MSHR API
+ **************************************************************************/
+
+unsigned int HashMSHR::getSize(Addr addr) {
+    int reg = find(addr);
+    return reg == Nil ? 0 : registers_[reg].count;
+}
+
+bool HashMSHR::exists(Addr addr) {
+    return find(addr) != Nil;
+}
+
+MSHREntry HashMSHR::getEntry(Addr addr, size_t index) {
+    int reg = find(addr);
+    if (reg == Nil) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
+    }
+    if (registers_[reg].count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %u.\n", ownerName_.c_str(), addr, index, registers_[reg].count);
+    }
+    return entries_[entryAt(registers_[reg], index)].entry;
+}
+
+MSHREntry HashMSHR::getFront(Addr addr) {
+    int reg = findOrFatal(addr, "getFront");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    return entries_[registers_[reg].head].entry;
+}
+
+void HashMSHR::removeEntry(Addr addr, size_t index) {
+    int reg = find(addr);
+    if (reg == Nil) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
+    }
+    if (registers_[reg].count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
+    }
+    removeSlot(addr, reg, entryAt(registers_[reg], index), "Remove");
+}
+
+void HashMSHR::removeFront(Addr addr) {
+    int reg = findOrFatal(addr, "removeFront");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    removeSlot(addr, reg, registers_[reg].head, "RemFr");
+}
+
+MSHREntryType HashMSHR::getEntryType(Addr addr, size_t index) {
+    int reg = find(addr);
+    if (reg == Nil) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
+    }
+    if (registers_[reg].count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shorter than index.\n", ownerName_.c_str(), addr, index);
+    }
+    return entries_[entryAt(registers_[reg], index)].entry.getType();
+}
+
+MSHREntryType HashMSHR::getFrontType(Addr addr) {
+    int reg = findOrFatal(addr, "getFrontType");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    return entries_[registers_[reg].head].entry.getType();
+}
+
+MemEventBase* HashMSHR::getEntryEvent(Addr addr, size_t index) {
+    int reg = find(addr);
+    if (reg == Nil || registers_[reg].count <= index)
+        return nullptr;
+
+    MSHREntry& entry = entries_[entryAt(registers_[reg], index)].entry;
+    if (entry.getType() != MSHREntryType::Event)
+        return nullptr;
+    return entry.getEvent();
+}
+
+MemEventBase* HashMSHR::getFrontEvent(Addr addr) {
+    if (getFrontType(addr) != MSHREntryType::Event)
+        return nullptr;
+    return entries_[registers_[find(addr)].head].entry.getEvent();
+}
+
+MemEventBase* HashMSHR::getFirstEventEntry(Addr addr, Command cmd) {
+    int reg = find(addr);
+    if (reg == Nil)
+        return nullptr;
+
+    for (int slot = registers_[reg].head; slot != Nil; slot = entries_[slot].next) {
+        MSHREntry& entry = entries_[slot].entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getCmd() == cmd)
+            return entry.getEvent();
+    }
+    return nullptr;
+}
+
+std::list<Addr>* HashMSHR::getEvictPointers(Addr addr) {
+    if (getFrontType(addr) != MSHREntryType::Evict)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
+
+    return entries_[registers_[find(addr)].head].entry.getPointers();
+}
+
+bool HashMSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
+    MSHREntryType frontType = getFrontType(addr);
+    if (frontType == MSHREntryType::Event)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Front entry type is not Evict or Writeback.\n", ownerName_.c_str(), addr, addrPtr);
+
+    if (is_debug_addr(addr) || is_debug_addr(addrPtr)) {
+        stringstream reason;
+        reason << "to 0x" << std::hex << addrPtr;
+        printDebug(10, "RemPtr", addr, reason.str());
+    }
+
+    int reg = find(addr);
+    int slot = registers_[reg].head;
+
+    // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
+    if (frontType == MSHREntryType::Evict) {
+        std::list<Addr>* ptrs = entries_[slot].entry.getPointers();
+        ptrs->remove(addrPtr);
+        if (ptrs->empty()) {
+            removeFront(addr);
+            return true;
+        }
+    } else {
+        slot = entries_[slot].next;
+        if (slot == Nil || entries_[slot].entry.getType() != MSHREntryType::Evict)
+            d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
+        std::list<Addr>* ptrs = entries_[slot].entry.getPointers();
+        ptrs->remove(addrPtr);
+        if (ptrs->empty()) {
+            removeSlot(addr, reg, slot, "Remove");
+        }
+    }
+    return false;
+}
+
+bool HashMSHR::pendingWriteback(Addr addr) {
+    int reg = find(addr);
+    return reg != Nil && registers_[reg].count != 0 && entries_[registers_[reg].head].entry.getType() == MSHREntryType::Writeback;
+}
+
+bool HashMSHR::pendingWritebackIsDowngrade(Addr addr) {
+    if (pendingWriteback(addr))
+        return entries_[registers_[find(addr)].head].entry.getDowngrade();
+    return false;
+}
+
+int HashMSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest, bool stallEvict) {
+    if ((size_ == maxSize_) || (!fwdRequest && (size_ == maxSize_-1))) {
+        if (is_debug_addr(addr)) {
+            stringstream reason;
+            reason << "<" << event->getID().first << "," << event->getID().second << "> FAILED " << (fwdRequest ? "fwd, " : "") << "maxsz: " << maxSize_;
+            printDebug(10, "InsEv", addr, reason.str());
+        }
+        return -1;
+    }
+
+    // Success
+    size_++;
+
+    int reg = find(addr);
+    if (reg == Nil)
+        reg = insertRegister(addr);
+    Register& r = registers_[reg];
+
+    int index;
+    int before = Nil;
+    if (pos == -1 || pos >= (int)r.count) {
+        index = r.count;
+    } else {
+        index = pos;
+        before = entryAt(r, pos);
+    }
+    int slot = allocateEntry(r, before);
+    entries_[slot].entry = MSHREntry(event, stallEvict, getCurrentSimCycle());
+
+    if (is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << index;
+        printDebug(10, "InsEv", addr, reason.str());
+    }
+    return index;
+}
+
+int HashMSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
+    int reg = find(addr);
+    if (reg == Nil)
+        return 0;
+
+    if (size_ == maxSize_-1) { /* Assuming fwdEvent == false */
+        if (is_debug_addr(addr)) {
+            stringstream reason;
+            reason << "<" << event->getID().first << "," << event->getID().second << "> FAILED " << "maxsz: " << maxSize_;
+            printDebug(10, "InsEv", addr, reason.str());
+        }
+        return -1;
+    }
+    size_++;
+    Register& r = registers_[reg];
+    int slot = allocateEntry(r, Nil);
+    entries_[slot].entry = MSHREntry(event, false, getCurrentSimCycle());
+    if (is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (r.count - 1);
+        printDebug(10, "InsEv", addr, reason.str());
+    }
+    return (r.count - 1);
+}
+
+MemEventBase* HashMSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
+    if (is_debug_addr(addr))
+        printDebug(10, "SwpEv", addr, "");
+
+    int reg = find(addr);
+    if (reg == Nil || registers_[reg].count == 0)
+        return nullptr;
+
+    return entries_[registers_[reg].head].entry.swapEvent(event, getCurrentSimCycle());
+}
+
+void HashMSHR::moveEntryToFront(Addr addr, unsigned int index) {
+    int reg = find(addr);
+    if (reg == Nil) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
+    }
+    Register& r = registers_[reg];
+    if (r.count <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
+    }
+
+    int slot = entryAt(r, index);
+    if (is_debug_addr(addr))
+        printDebug(10, "MvEnt", addr, entries_[slot].entry.getString());
+
+    unlinkEntry(r, slot);
+    linkEntry(r, slot, r.head);
+}
+
+bool HashMSHR::insertWriteback(Addr addr, bool downgrade) {
+    if (is_debug_addr(addr)) {
+        stringstream reason;
+        reason << "Downgrade: " << (downgrade ? "T" : "F");
+        printDebug(10, "InsWB", addr, reason.str());
+    }
+
+    int reg = find(addr);
+    if (reg == Nil)
+        reg = insertRegister(addr);
+    Register& r = registers_[reg];
+    int slot = allocateEntry(r, r.head);
+    entries_[slot].entry = MSHREntry(downgrade, getCurrentSimCycle());
+    return true;
+}
+
+bool HashMSHR::insertEviction(Addr oldAddr, Addr newAddr) {
+    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr)) {
+        stringstream reason;
+        reason << "to 0x" << std::hex << newAddr;
+        printDebug(10, "InsPtr", oldAddr, reason.str());
+    }
+
+    int reg = find(oldAddr);
+    if (reg == Nil)
+        reg = insertRegister(oldAddr);
+    Register& r = registers_[reg];
+
+    if (r.tail != Nil && entries_[r.tail].entry.getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        entries_[r.tail].entry.getPointers()->push_back(newAddr);
+    } else {
+        int slot = allocateEntry(r, Nil);
+        EntrySlot& entry = entries_[slot];
+        entry.evictPtrs.push_back(newAddr);
+        entry.entry = MSHREntry(&entry.evictPtrs, getCurrentSimCycle());
+    }
+    return true;
+}
+
+void HashMSHR::addPendingRetry(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(20, "IncRetry", addr, "");
+
+    registers_[findOrFatal(addr, "addPendingRetry")].pendingRetries++;
+}
+
+void HashMSHR::removePendingRetry(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(20, "DecRetry", addr, "");
+
+    registers_[findOrFatal(addr, "removePendingRetry")].pendingRetries--;
+}
+
+uint32_t HashMSHR::getPendingRetries(Addr addr) {
+    int reg = find(addr);
+    return reg == Nil ? 0 : registers_[reg].pendingRetries;
+}
+
+void HashMSHR::setInProgress(Addr addr, bool value) {
+    if (is_debug_addr(addr))
+        printDebug(20, "InProg", addr, "");
+
+    int reg = findOrFatal(addr, "setInProgress");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    entries_[registers_[reg].head].entry.setInProgress(value);
+}
+
+bool HashMSHR::getInProgress(Addr addr) {
+    int reg = find(addr);
+    if (reg == Nil || registers_[reg].count == 0)
+        return false;
+    return entries_[registers_[reg].head].entry.getInProgress();
+}
+
+void HashMSHR::setStalledForEvict(Addr addr, bool set) {
+    if (is_debug_addr(addr)) {
+        if (set)
+            printDebug(20, "Stall", addr, "");
+        else
+            printDebug(20, "Unstall", addr, "");
+    }
+
+    int reg = findOrFatal(addr, "setStalledForEvict");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    entries_[registers_[reg].head].entry.setStalledForEvict(set);
+}
+
+bool HashMSHR::getStalledForEvict(Addr addr) {
+    int reg = find(addr);
+    if (reg == Nil || registers_[reg].count == 0)
+        return false;
+    return entries_[registers_[reg].head].entry.getStalledForEvict();
+}
+
+void HashMSHR::setProfiled(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(20, "Profile", addr, "");
+
+    int reg = findOrFatal(addr, "setProfiled");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    entries_[registers_[reg].head].entry.setProfiled();
+}
+
+bool HashMSHR::getProfiled(Addr addr) {
+    int reg = findOrFatal(addr, "getProfiled");
+    if (registers_[reg].count == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
+    }
+    return entries_[registers_[reg].head].entry.getProfiled();
+}
+
+bool HashMSHR::getProfiled(Addr addr, SST::Event::id_type id) {
+    int reg = find(addr);
+    if (reg == Nil)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
+    if (registers_[reg].count == 0)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
+
+    for (int slot = registers_[reg].head; slot != Nil; slot = entries_[slot].next) {
+        MSHREntry& entry = entries_[slot].entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id)
+            return entry.getProfiled();
+    }
+    return true; // default so we don't attempt to profile what isn't there
+}
+
+void HashMSHR::setProfiled(Addr addr, SST::Event::id_type id) {
+    if (is_debug_addr(addr))
+        printDebug(20, "Profile", addr, "");
+
+    int reg = find(addr);
+    if (reg == Nil)
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
+    if (registers_[reg].count == 0)
+        d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
+
+    for (int slot = registers_[reg].head; slot != Nil; slot = entries_[slot].next) {
+        MSHREntry& entry = entries_[slot].entry;
+        if (entry.getType() == MSHREntryType::Event && entry.getEvent()->getID() == id) {
+            entry.setProfiled();
+            return;
+        }
+    }
+}
+
+MSHREntry* HashMSHR::getOldestEntry() {
+    MSHREntry* oldest = nullptr;
+
+    for (std::vector<Bucket>::iterator it = table_.begin(); it != table_.end(); it++) {
+        if (it->reg == Nil) continue;
+        for (int slot = registers_[it->reg].head; slot != Nil; slot = entries_[slot].next) {
+            MSHREntry& entry = entries_[slot].entry;
+            if (entry.getType() == MSHREntryType::Event && (!oldest || entry.getStartTime() < oldest->getStartTime()))
+                oldest = &entry;
+        }
+    }
+    return oldest;
+}
+
+void HashMSHR::incrementAcksNeeded(Addr addr) {
+    int reg = find(addr);
+    if (reg == Nil)
+        reg = insertRegister(addr);
+    registers_[reg].acksNeeded++;
+
+    if (is_debug_addr(addr)) {
+        std::stringstream reason;
+        reason << registers_[reg].acksNeeded << " acks";
+        printDebug(10, "IncAck", addr, reason.str());
+    }
+}
+
+bool HashMSHR::decrementAcksNeeded(Addr addr) {
+    Register& reg = registers_[findOrFatal(addr, "decrementAcksNeeded")];
+    if (reg.acksNeeded == 0) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
+    }
+    reg.acksNeeded--;
+
+    if (is_debug_addr(addr)) {
+        std::stringstream reason;
+        reason << reg.acksNeeded << " acks";
+        printDebug(10, "DecAck", addr, reason.str());
+    }
+
+    return (reg.acksNeeded == 0);
+}
+
+uint32_t HashMSHR::getAcksNeeded(Addr addr) {
+    int reg = find(addr);
+    return reg == Nil ? 0 : registers_[reg].acksNeeded;
+}
+
+void HashMSHR::setData(Addr addr, const vector<uint8_t>& data, bool dirty) {
+    Register& reg = registers_[findOrFatal(addr, "setData")];
+
+    if (is_debug_addr(addr))
+        printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
+
+    reg.dataBuffer.assign(data);
+    reg.dataDirty = dirty;
+}
+
+void HashMSHR::setData(Addr addr, const Payload& data, bool dirty) {
+    Register& reg = registers_[findOrFatal(addr, "setData")];
+
+    if (is_debug_addr(addr))
+        printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
+
+    reg.dataBuffer = data;
+    reg.dataDirty = dirty;
+}
+
+void HashMSHR::clearData(Addr addr) {
+    if (is_debug_addr(addr))
+        printDebug(10, "ClrData", addr, "");
+
+    Register& reg = registers_[findOrFatal(addr, "clearData")];
+    reg.dataBuffer.reset();
+    reg.dataDirty = false;
+}
+
+vector<uint8_t>& HashMSHR::getData(Addr addr) {
+    return registers_[findOrFatal(addr, "getData")].dataBuffer.write();
+}
+
+const Payload& HashMSHR::getDataBuffer(Addr addr) {
+    return registers_[findOrFatal(addr, "getDataBuffer")].dataBuffer;
+}
+
+bool HashMSHR::hasData(Addr addr) {
+    int reg = find(addr);
+    return reg != Nil && !registers_[reg].dataBuffer.empty();
+}
+
+bool HashMSHR::getDataDirty(Addr addr) {
+    return registers_[findOrFatal(addr, "getDataDirty")].dataDirty;
+}
+
+void HashMSHR::setDataDirty(Addr addr, bool dirty) {
+    if (is_debug_addr(addr))
+        printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
+
+    registers_[findOrFatal(addr, "setDataDirty")].dataDirty = dirty;
+}
+
+// Print status in address order to match MSHR::printStatus
+void HashMSHR::printStatus(Output &out) {
+    out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", ownerName_.c_str(), size_, prefetchCount_);
+    std::vector<std::pair<Addr,int>> regs;
+    for (std::vector<Bucket>::iterator it = table_.begin(); it != table_.end(); it++) {
+        if (it->reg != Nil)
+            regs.push_back(std::make_pair(it->addr, it->reg));
+    }
+    std::sort(regs.begin(), regs.end());
+    for (std::vector<std::pair<Addr,int>>::iterator it = regs.begin(); it != regs.end(); it++) {
+        out.output("      Entry: Addr = 0x%" PRIx64 "\n", it->first);
+        for (int slot = registers_[it->second].head; slot != Nil; slot = entries_[slot].next) {
+            out.output("        %s\n", entries_[slot].entry.getString().c_str());
+        }
+    }
+    out.output("    End MSHR Status for %s\n", ownerName_.c_str());
+}
@@ -0,0 +1,203 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MSHR_HASH_H_
+#define _MSHR_HASH_H_
+
+#include <memory>
+#include <vector>
+
+#include "sst/elements/memHierarchy/mshr.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ *  MSHR with the same interface as MSHR but different storage (mshr_type = "hash")
+ *
+ *  - Addresses are found through an open-addressing (linear probing) hash table
+ *    sized from mshr_num_entries. The table grows if more addresses are tracked
+ *    than expected (evictions, writebacks, and acks do not count toward the MSHR size).
+ *  - Per-address registers and entries live in preallocated slot pools and are
+ *    recycled through free lists; nothing is allocated in steady state.
+ *  - The entries for an address form an intrusive doubly-linked queue through the
+ *    entry slots. Evict entries use a pointer list embedded in their slot.
+ *
+ *  Slot pools grow in chunks so pointers handed out by getEvictPointers() and
+ *  getOldestEntry() stay valid while the entry exists.
+ */
+class HashMSHR : public MSHR {
+public:
+
+    HashMSHR(ComponentId_t cid, Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
+    ~HashMSHR() { }
+
+    using MSHR::getSize;
+    unsigned int getSize(Addr addr) override;
+    bool exists(Addr addr) override;
+
+    MSHREntry getFront(Addr addr) override;
+    void removeFront(Addr addr) override;
+
+    MSHREntryType getFrontType(Addr addr) override;
+
+    MemEventBase* getFrontEvent(Addr addr) override;
+    std::list<Addr>* getEvictPointers(Addr addr) override;
+    bool removeEvictPointer(Addr addr, Addr ptrAddr) override;
+
+    void moveEntryToFront(Addr addr, unsigned int index) override;
+
+    MSHREntry getEntry(Addr addr, size_t index) override;
+    void removeEntry(Addr addr, size_t index) override;
+
+    MSHREntryType getEntryType(Addr addr, size_t index) override;
+    MemEventBase* getEntryEvent(Addr addr, size_t index) override;
+
+    MemEventBase* swapFrontEvent(Addr addr, MemEventBase* event) override;
+
+    bool pendingWriteback(Addr addr) override;
+    bool pendingWritebackIsDowngrade(Addr addr) override;
+
+    int insertEvent(Addr addr, MemEventBase* event, int position, bool fwdRequest, bool stallEvict) override;
+    int insertEventIfConflict(Addr addr, MemEventBase* event) override;
+    bool insertWriteback(Addr addr, bool downgrade) override;
+    bool insertEviction(Addr evictAddr, Addr newAddr) override;
+
+    void setInProgress(Addr addr, bool value = true) override;
+    bool getInProgress(Addr addr) override;
+
+    void addPendingRetry(Addr addr) override;
+    void removePendingRetry(Addr addr) override;
+    uint32_t getPendingRetries(Addr addr) override;
+
+    void setStalledForEvict(Addr addr, bool set) override;
+    bool getStalledForEvict(Addr addr) override;
+
+    void setProfiled(Addr addr) override;
+    bool getProfiled(Addr addr) override;
+
+    void setProfiled(Addr addr, SST::Event::id_type id) override;
+    bool getProfiled(Addr addr, SST::Event::id_type id) override;
+
+    MemEventBase* getFirstEventEntry(Addr addr, Command cmd) override;
+    MSHREntry* getOldestEntry() override;
+
+    void incrementAcksNeeded(Addr addr) override;
+    bool decrementAcksNeeded(Addr addr) override;
+    uint32_t getAcksNeeded(Addr addr) override;
+
+    void setData(Addr addr, const vector<uint8_t>& data, bool dirty = false) override;
+    void setData(Addr addr, const Payload& data, bool dirty = false) override;
+    void clearData(Addr addr) override;
+    vector<uint8_t>& getData(Addr addr) override;
+    const Payload& getDataBuffer(Addr addr) override;
+    bool hasData(Addr addr) override;
+    bool getDataDirty(Addr addr) override;
+    void setDataDirty(Addr addr, bool dirty) override;
+
+    void printStatus(Output &out) override;
+
+private:
+    static const int Nil = -1;
+
+    /* One MSHR entry, linked into its address' queue */
+    struct EntrySlot {
+        EntrySlot() : entry(false, 0), prev(Nil), next(Nil) { }
+        MSHREntry entry;
+        std::list<Addr> evictPtrs; // Backs entry.getPointers() for Evict entries
+        int prev;
+        int next;
+    };
+
+    /* Per-address state, equivalent to MSHRRegister */
+    struct Register {
+        Register() : addr(0), head(Nil), tail(Nil), count(0), acksNeeded(0), dataDirty(false), pendingRetries(0) { }
+        Addr addr;
+        int head;
+        int tail;
+        uint32_t count;
+        uint32_t acksNeeded;
+        Payload dataBuffer;
+        bool dataDirty;
+        uint32_t pendingRetries;
+    };
+
+    /* Chunked pool with a free list; element addresses are stable */
+    template<typename T>
+    class SlotPool {
+    public:
+        static const unsigned int ChunkBits = 6;
+        static const unsigned int ChunkSize = 1 << ChunkBits;
+
+        void reserve(unsigned int count) {
+            while (chunks_.size() * ChunkSize < count)
+                addChunk();
+        }
+
+        int allocate() {
+            if (free_.empty())
+                addChunk();
+            int index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+
+        void release(int index) { free_.push_back(index); }
+
+        T& operator[](int index) { return chunks_[index >> ChunkBits][index & (ChunkSize - 1)]; }
+
+    private:
+        void addChunk() {
+            int base = chunks_.size() * ChunkSize;
+            chunks_.emplace_back(new T[ChunkSize]);
+            for (int i = ChunkSize - 1; i >= 0; i--)
+                free_.push_back(base + i);
+        }
+
+        std::vector<std::unique_ptr<T[]>> chunks_;
+        std::vector<int> free_;
+    };
+
+    struct Bucket {
+        Addr addr;
+        int reg;    // Register index or Nil if empty
+    };
+
+    /* Hash table */
+    inline size_t hash(Addr addr) { return (size_t)((addr * 0x9E3779B97F4A7C15ULL) >> hashShift_); }
+    int find(Addr addr);
+    int findOrFatal(Addr addr, const char* func);
+    int insertRegister(Addr addr);
+    void eraseRegister(Addr addr);
+    void rehash(size_t buckets);
+
+    /* Entry queues */
+    int allocateEntry(Register& reg, int before);   // before == Nil appends
+    void freeEntry(Register& reg, int slot);
+    void unlinkEntry(Register& reg, int slot);
+    void linkEntry(Register& reg, int slot, int before);
+    int entryAt(Register& reg, size_t index);
+    void removeSlot(Addr addr, int regIndex, int slot, const char* action);
+
+    std::vector<Bucket> table_;
+    size_t mask_;
+    unsigned int hashShift_;
+    unsigned int numRegisters_;
+
+    SlotPool<Register> registers_;
+    SlotPool<EntrySlot> entries_;
+};
+
+}}
+#endif
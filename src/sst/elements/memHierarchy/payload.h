@@ -0,0 +1,205 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_PAYLOAD_H
+#define MEMHIERARCHY_PAYLOAD_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Refcounted, pooled, copy-on-write data payload
+ *
+ * Used for MemEvent payloads and MSHR data buffers so that forwarding data
+ * (e.g., response from memory -> directory -> cache) hands off a reference
+ * instead of allocating and copying the bytes at every hop.
+ *
+ * Rules:
+ *  - Copying a Payload shares the buffer
+ *  - read() never copies
+ *  - write() returns a mutable vector. If the buffer is shared it is first
+ *    copied. The buffer is then marked 'exposed' because the caller may hold
+ *    on to the reference: an exposed buffer is never shared again, copies of
+ *    it get their own bytes. This keeps the old std::vector semantics for
+ *    code that writes through a reference returned earlier.
+ *  - Released buffers go back to a per-thread free list and keep their capacity
+ */
+class PayloadBuffer {
+public:
+    std::vector<uint8_t> data;
+    std::atomic<uint32_t> refs;
+    bool exposed;
+    PayloadBuffer* next;    // Free list link
+
+    PayloadBuffer() : refs(0), exposed(false), next(nullptr) { }
+};
+
+/* Process-wide counters, see MemController statistics */
+struct PayloadStats {
+    static inline std::atomic<uint64_t> bytesCopied{0};
+    static inline std::atomic<uint64_t> allocationsAvoided{0};
+};
+
+class PayloadPool {
+public:
+    static const unsigned int SlabSize = 256;
+
+    static PayloadBuffer* acquire(size_t size) {
+        PayloadBuffer*& head = freeList();
+        if (!head)
+            allocateSlab(head);
+        PayloadBuffer* buf = head;
+        head = buf->next;
+        buf->next = nullptr;
+        if (buf->data.capacity() >= size && size != 0)
+            PayloadStats::allocationsAvoided.fetch_add(1, std::memory_order_relaxed);
+        buf->data.resize(size);
+        buf->refs.store(1, std::memory_order_relaxed);
+        buf->exposed = false;
+        return buf;
+    }
+
+    static void release(PayloadBuffer* buf) {
+        if (buf->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+        buf->data.clear();
+        PayloadBuffer*& head = freeList();
+        buf->next = head;
+        head = buf;
+    }
+
+private:
+    /* Buffers may be released on a different thread than they were acquired on; they simply migrate */
+    static PayloadBuffer*& freeList() {
+        static thread_local PayloadBuffer* head = nullptr;
+        return head;
+    }
+
+    /* Slabs are never returned to the system; the pool only grows to the peak number of live payloads */
+    static void allocateSlab(PayloadBuffer*& head) {
+        PayloadBuffer* slab = new PayloadBuffer[SlabSize];
+        for (unsigned int i = 0; i < SlabSize; i++) {
+            slab[i].next = head;
+            head = &slab[i];
+        }
+    }
+};
+
+class Payload {
+public:
+    Payload() : buf_(nullptr) { }
+
+    Payload(const Payload& other) : buf_(nullptr) { share(other); }
+
+    Payload& operator=(const Payload& other) {
+        if (this != &other) {
+            reset();
+            share(other);
+        }
+        return *this;
+    }
+
+    ~Payload() { reset(); }
+
+    const std::vector<uint8_t>& read() const {
+        return buf_ ? buf_->data : emptyVector();
+    }
+
+    std::vector<uint8_t>& write() {
+        if (!buf_) {
+            buf_ = PayloadPool::acquire(0);
+        } else if (buf_->refs.load(std::memory_order_acquire) > 1) {
+            PayloadBuffer* copy = PayloadPool::acquire(buf_->data.size());
+            copy->data.assign(buf_->data.begin(), buf_->data.end());
+            PayloadStats::bytesCopied.fetch_add(buf_->data.size(), std::memory_order_relaxed);
+            PayloadPool::release(buf_);
+            buf_ = copy;
+        }
+        buf_->exposed = true;
+        return buf_->data;
+    }
+
+    /* Mutable access to an unshared buffer that is being filled immediately (e.g., after assignZero()).
+     * Does not mark the buffer exposed so the caller must not hold on to the reference.
+     */
+    std::vector<uint8_t>& fill() {
+        if (!buf_ || buf_->refs.load(std::memory_order_acquire) > 1)
+            return write();
+        return buf_->data;
+    }
+
+    /* Replace contents with a copy of 'data' */
+    void assign(const std::vector<uint8_t>& data) {
+        assign(data.size(), data.empty() ? nullptr : data.data());
+    }
+
+    void assign(size_t size, const uint8_t* data) {
+        prepare(size);
+        if (size)
+            std::copy(data, data + size, buf_->data.begin());
+        PayloadStats::bytesCopied.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void assignZero(size_t size) {
+        prepare(size);
+        std::fill(buf_->data.begin(), buf_->data.end(), 0);
+    }
+
+    size_t size() const { return buf_ ? buf_->data.size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    void reset() {
+        if (buf_) PayloadPool::release(buf_);
+        buf_ = nullptr;
+    }
+
+private:
+    PayloadBuffer* buf_;
+
+    static const std::vector<uint8_t>& emptyVector() {
+        static const std::vector<uint8_t> e;
+        return e;
+    }
+
+    void share(const Payload& other) {
+        if (!other.buf_) return;
+        if (other.buf_->exposed) {
+            buf_ = PayloadPool::acquire(other.buf_->data.size());
+            std::copy(other.buf_->data.begin(), other.buf_->data.end(), buf_->data.begin());
+            PayloadStats::bytesCopied.fetch_add(other.buf_->data.size(), std::memory_order_relaxed);
+            return;
+        }
+        other.buf_->refs.fetch_add(1, std::memory_order_relaxed);
+        buf_ = other.buf_;
+        PayloadStats::allocationsAvoided.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /* Get an unshared buffer of 'size' bytes. An exposed buffer is reused in place so outstanding references stay valid */
+    void prepare(size_t size) {
+        if (buf_ && (buf_->exposed || buf_->refs.load(std::memory_order_acquire) == 1)) {
+            buf_->data.resize(size);
+            return;
+        }
+        reset();
+        buf_ = PayloadPool::acquire(size);
+    }
+};
+
+}}
+#endif /* MEMHIERARCHY_PAYLOAD_H */
@@ -17,6 +17,7 @@
 #define	MEMHIERARCHY_REPLACEMENT_POLICY_H
 
 #include "sst/core/subcomponent.h"
+#include "sst/core/output.h"
 #include "sst/core/rng/marsaglia.h"
 
 #include "memEvent.h"
@@ -33,23 +34,39 @@ namespace MemHierarchy {
  */
 class ReplacementInfo {
     public:
-        ReplacementInfo(unsigned int i, State s) : index(i), state(s) { }
+        ReplacementInfo(unsigned int i, State s, bool tracked = true) : index(i), state(s), stateTracked(tracked), validMask(nullptr), validBit(0) { }
         virtual ~ReplacementInfo() { }
 
         unsigned int getIndex() { return index; }
         void setIndex(unsigned int i) { index = i; }
 
         State getState() { return state; }
-        void setState(State s) { state = s; }
+        void setState(State s) {
+            state = s;
+            if (validMask) {
+                if (s == I) *validMask &= ~validBit;
+                else        *validMask |= validBit;
+            }
+        }
+
+        /* False if the owning line does not keep 'state' up to date */
+        bool hasState() { return stateTracked; }
+
+        /* Point the line at a policy-owned per-set mask so that state changes, including
+         * invalidations in place, set or clear 'bit' in it */
+        void setValidMask(uint64_t * mask, uint64_t bit) { validMask = mask; validBit = bit; }
 
     protected:
         unsigned int index;
         State state;
+        bool stateTracked;
+        uint64_t * validMask;
+        uint64_t validBit;
 };
 
 class CoherenceReplacementInfo : public ReplacementInfo {
     public:
-        CoherenceReplacementInfo(unsigned int i, State s, bool sh, bool o) : shared(sh), owned(o), ReplacementInfo(i, s) { }
+        CoherenceReplacementInfo(unsigned int i, State s, bool sh, bool o, bool tracked = true) : shared(sh), owned(o), ReplacementInfo(i, s, tracked) { }
         virtual ~CoherenceReplacementInfo() { }
 
         bool getOwned() { return owned; }
@@ -80,6 +97,14 @@ class ReplacementPolicy : public SubComponent{
         // Get replacement candidates
         virtual uint64_t getBestCandidate() = 0;
         virtual uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) = 0;
+
+        // Policies that track per-address history (e.g., SHiP) return true here and
+        // the cache array will call updateWithAddr() instead of update()
+        virtual bool usesAddress() { return false; }
+        virtual void updateWithAddr(uint64_t id, ReplacementInfo * rInfo, Addr addr) { update(id, rInfo); }
+
+        // Called by the cache array once per line after construction
+        virtual void attach(uint64_t id, ReplacementInfo * rInfo) { }
 };
 
 /* ------------------------------------------------------------------------------------------
@@ -704,6 +729,402 @@ public:
     uint64_t getBestCandidate() { return bestCandidate; }
 };
 
+/* ------------------------------------------------------------------------------------------
+ *  Set-bitmask policies
+ *  - Per-set state is a handful of bits/words instead of a per-line timestamp
+ *  - Victim selection and update are constant time (no scan of the set)
+ *  - Replacement algorithm assumes indices are contiguous for the set
+ *  - Empty ways are tracked in a per-set valid mask. replaced() clears a way and update() sets it
+ *    if the line is valid. Each line's ReplacementInfo also points at the mask so that a line
+ *    invalidated in place (setState(I) without deallocation) is seen as empty. The lines must keep
+ *    the state in their ReplacementInfo up to date; the directory and data arrays of
+ *    MESI_Shared_Noninclusive do not, and are rejected by checkCompatibility()
+ * ------------------------------------------------------------------------------------------*/
+class SetMaskReplacementPolicy : public ReplacementPolicy {
+public:
+    SetMaskReplacementPolicy(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : ReplacementPolicy(id, params, lines, associativity), bestCandidate(0) {
+        ways = associativity;
+        sets = lines / associativity;
+        if (ways == 0 || ways > 64) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: this replacement policy supports 1 to 64 ways. Associativity is %" PRIu64 ".\n", getName().c_str(), associativity);
+        }
+        allWays = (ways == 64) ? ~0ULL : ((1ULL << ways) - 1);
+        valid.resize(sets, 0);
+    }
+
+    virtual ~SetMaskReplacementPolicy() { }
+
+    /* Empty ways are found by line state */
+    bool checkCompatibility(ReplacementInfo * rInfo) { return rInfo->hasState(); }
+
+    void attach(uint64_t id, ReplacementInfo * rInfo) {
+        uint64_t bit = 1ULL << (id % ways);
+        rInfo->setValidMask(&valid[id / ways], bit);
+        markValid(id, rInfo);
+    }
+
+    uint64_t getBestCandidate() { return bestCandidate; }
+
+protected:
+    uint64_t bestCandidate;
+    uint64_t ways;
+    uint64_t sets;
+    uint64_t allWays;
+    std::vector<uint64_t> valid;    // Per set, bit per way: line state is not I. Not resized after attach()
+
+    inline void markValid(uint64_t id, ReplacementInfo * rInfo) {
+        if (rInfo->getState() != I)
+            valid[id / ways] |= (1ULL << (id % ways));
+    }
+
+    inline void markEmpty(uint64_t id) {
+        valid[id / ways] &= ~(1ULL << (id % ways));
+    }
+
+    /* Returns true (and sets way) if the set has an empty way */
+    inline bool findEmpty(uint64_t set, uint64_t &way) {
+        uint64_t empty = ~valid[set] & allWays;
+        if (!empty) return false;
+        way = __builtin_ctzll(empty);
+        return true;
+    }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Tree pseudo-LRU
+ * ------------------------------------------------------------------------------------------*/
+class TreePLRU : public SetMaskReplacementPolicy {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(TreePLRU, "memHierarchy", "replacement.plru", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "tree pseudo-LRU replacement policy, associativity must be a power of two (max 64)", SST::MemHierarchy::ReplacementPolicy);
+
+    TreePLRU(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : SetMaskReplacementPolicy(id, params, lines, associativity) {
+        if (ways & (ways - 1)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Error: tree-PLRU requires a power-of-two associativity. Associativity is %" PRIu64 ".\n", getName().c_str(), associativity);
+        }
+        levels = 0;
+        while ((1ULL << levels) < ways) levels++;
+        tree.resize(sets, 0);
+    }
+
+    virtual ~TreePLRU() { }
+
+    /* Point every node on the path to this way away from it. Node n's children are 2n and 2n+1, root is 1 */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        uint64_t set = id / ways;
+        uint64_t way = id % ways;
+        uint64_t bits = tree[set];
+        uint64_t node = 1;
+        for (int level = levels - 1; level >= 0; level--) {
+            uint64_t dir = (way >> level) & 1;
+            if (dir) bits &= ~(1ULL << node);
+            else     bits |= (1ULL << node);
+            node = 2 * node + dir;
+        }
+        tree[set] = bits;
+        markValid(id, rInfo);
+    }
+
+    void replaced(uint64_t id) { markEmpty(id); }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        uint64_t set = rInfo[0]->getIndex() / ways;
+        uint64_t way;
+        if (!findEmpty(set, way)) {
+            uint64_t bits = tree[set];
+            uint64_t node = 1;
+            way = 0;
+            for (int level = 0; level < levels; level++) {
+                uint64_t dir = (bits >> node) & 1;
+                way = (way << 1) | dir;
+                node = 2 * node + dir;
+            }
+        }
+        bestCandidate = rInfo[way]->getIndex();
+        return bestCandidate;
+    }
+
+private:
+    int levels;
+    std::vector<uint64_t> tree;     // Per set, ways-1 node bits. 1 = victim is in right subtree
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Re-reference interval prediction (RRIP)
+ *  - Each line has an RRPV in [0, max]; lines with RRPV == max are eviction candidates
+ *  - Per set, one way-bitmask per RRPV value so that victim selection and aging
+ *    (incrementing every RRPV in the set) are a few word operations
+ *  - Subclasses choose the insertion RRPV
+ * ------------------------------------------------------------------------------------------*/
+class RRIPBase : public SetMaskReplacementPolicy {
+public:
+    RRIPBase(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : SetMaskReplacementPolicy(id, params, lines, associativity) {
+        uint32_t bits = params.find<uint32_t>("rrpv_bits", 2);
+        if (bits < 1 || bits > 4) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: rrpv_bits - must be between 1 and 4. You specified %" PRIu32 ".\n", getName().c_str(), bits);
+        }
+        maxRRPV = (1 << bits) - 1;
+        levels = maxRRPV + 1;
+        rrpv.resize(sets * levels, 0);
+    }
+
+    virtual ~RRIPBase() { }
+
+    /* A touch of an invalid line is a fill, also when the line was invalidated in place and is being refetched */
+    void update(uint64_t id, ReplacementInfo * rInfo) {
+        uint64_t set = id / ways;
+        uint64_t bit = 1ULL << (id % ways);
+        if (rInfo->getState() == I) {
+            move(set, bit, insertionRRPV(id));
+        } else {
+            move(set, bit, 0);
+            hit(id);
+        }
+        markValid(id, rInfo);
+    }
+
+    void replaced(uint64_t id) {
+        uint64_t set = id / ways;
+        uint64_t bit = 1ULL << (id % ways);
+        if (occupied(set, bit))
+            evicted(id);
+        clear(set, bit);
+        markEmpty(id);
+    }
+
+    uint64_t findBestCandidate(std::vector<ReplacementInfo*> &rInfo) {
+        uint64_t set = rInfo[0]->getIndex() / ways;
+        uint64_t way;
+        if (!findEmpty(set, way)) {
+            uint64_t * mask = &rrpv[set * levels];
+            if (!mask[maxRRPV]) {
+                // Age: shift every RRPV up so that the oldest lines reach max
+                unsigned int oldest = maxRRPV - 1;
+                while (oldest > 0 && !mask[oldest]) oldest--;
+                unsigned int delta = maxRRPV - oldest;
+                for (int v = maxRRPV; v >= 0; v--)
+                    mask[v] = (v >= (int)delta) ? mask[v - delta] : 0;
+            }
+            way = __builtin_ctzll(mask[maxRRPV]);
+        }
+        bestCandidate = rInfo[way]->getIndex();
+        return bestCandidate;
+    }
+
+protected:
+    unsigned int maxRRPV;
+    unsigned int levels;
+    std::vector<uint64_t> rrpv;     // Per set, 'levels' masks. Bit w of mask v is set if way w has RRPV v
+
+    /* Hooks called on fill, hit and eviction of line 'id' */
+    virtual unsigned int insertionRRPV(uint64_t id) = 0;
+    virtual void hit(uint64_t id) { }
+    virtual void evicted(uint64_t id) { }
+
+    inline bool occupied(uint64_t set, uint64_t bit) {
+        uint64_t * mask = &rrpv[set * levels];
+        for (unsigned int v = 0; v < levels; v++) {
+            if (mask[v] & bit) return true;
+        }
+        return false;
+    }
+
+    inline void clear(uint64_t set, uint64_t bit) {
+        uint64_t * mask = &rrpv[set * levels];
+        for (unsigned int v = 0; v < levels; v++)
+            mask[v] &= ~bit;
+    }
+
+    inline void move(uint64_t set, uint64_t bit, unsigned int value) {
+        clear(set, bit);
+        rrpv[set * levels + value] |= bit;
+    }
+};
+
+class SRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SRRIP, "memHierarchy", "replacement.srrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "static re-reference interval prediction (SRRIP-HP), inserts lines with a long re-reference interval. Max 64 ways", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits per re-reference prediction value (1-4)", "2"} )
+
+    SRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) { }
+    virtual ~SRRIP() { }
+
+protected:
+    unsigned int insertionRRPV(uint64_t id) { return maxRRPV - 1; }
+};
+
+class BRRIP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(BRRIP, "memHierarchy", "replacement.brrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "bimodal re-reference interval prediction, inserts most lines with a distant re-reference interval. Scan/thrash resistant. Max 64 ways", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits per re-reference prediction value (1-4)", "2"},
+            {"throttle",    "One in 'throttle' insertions uses a long (instead of distant) re-reference interval", "32"},
+            {"seed_a",      "Seed for random number generator", "1"},
+            {"seed_b",      "Seed for random number generator", "1"} )
+
+    BRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity) {
+        throttle = params.find<uint64_t>("throttle", 32);
+        if (throttle == 0) throttle = 1;
+        uint64_t seeda = params.find<uint64_t>("seed_a", 1);
+        uint64_t seedb = params.find<uint64_t>("seed_b", 1);
+        gen = new SST::RNG::MarsagliaRNG(seeda, seedb);
+    }
+
+    virtual ~BRRIP() {
+        delete gen;
+    }
+
+protected:
+    uint64_t throttle;
+    SST::RNG::MarsagliaRNG* gen;
+
+    unsigned int insertionRRPV(uint64_t id) {
+        return (gen->generateNextUInt64() % throttle == 0) ? maxRRPV - 1 : maxRRPV;
+    }
+};
+
+/* Dynamic RRIP: a few leader sets always use SRRIP or BRRIP insertion, the rest follow whichever misses less */
+class DRRIP : public BRRIP {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(DRRIP, "memHierarchy", "replacement.drrip", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "dynamic re-reference interval prediction, set dueling between SRRIP and BRRIP insertion. Max 64 ways", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",   "Bits per re-reference prediction value (1-4)", "2"},
+            {"throttle",    "BRRIP: One in 'throttle' insertions uses a long (instead of distant) re-reference interval", "32"},
+            {"leader_sets", "Number of leader sets dedicated to each of SRRIP and BRRIP", "32"},
+            {"psel_bits",   "Width of the policy selection counter", "10"},
+            {"seed_a",      "Seed for random number generator", "1"},
+            {"seed_b",      "Seed for random number generator", "1"} )
+
+    DRRIP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : BRRIP(id, params, lines, associativity) {
+        uint64_t leaders = params.find<uint64_t>("leader_sets", 32);
+        uint32_t pselBits = params.find<uint32_t>("psel_bits", 10);
+        if (pselBits < 1 || pselBits > 31) pselBits = 10;
+        pselMax = (1 << pselBits) - 1;
+        psel = pselMax / 2;
+        // Spread leaders evenly: set s leads SRRIP if s % stride == 0, BRRIP if s % stride == 1
+        stride = (leaders && sets >= 2 * leaders) ? sets / leaders : 0;
+    }
+
+    virtual ~DRRIP() { }
+
+protected:
+    uint64_t stride;
+    uint32_t psel;
+    uint32_t pselMax;
+
+    enum class Leader { NONE, SRRIP, BRRIP };
+
+    inline Leader leader(uint64_t set) {
+        if (!stride) return Leader::NONE;
+        uint64_t r = set % stride;
+        return r == 0 ? Leader::SRRIP : (r == 1 ? Leader::BRRIP : Leader::NONE);
+    }
+
+    /* Insertions are fills, i.e., misses */
+    unsigned int insertionRRPV(uint64_t id) {
+        switch (leader(id / ways)) {
+            case Leader::SRRIP:
+                if (psel < pselMax) psel++;
+                return maxRRPV - 1;
+            case Leader::BRRIP:
+                if (psel > 0) psel--;
+                return BRRIP::insertionRRPV(id);
+            default:
+                return (psel > pselMax / 2) ? BRRIP::insertionRRPV(id) : maxRRPV - 1;
+        }
+    }
+};
+
+/* ------------------------------------------------------------------------------------------
+ *  Signature-based hit predictor (SHiP) on top of SRRIP
+ *  - Cache arrays do not see the requesting PC so the signature is the memory
+ *    region of the line (SHiP-Mem)
+ *  - Signature history counters (SHCT) learn whether lines from a region are re-referenced
+ *    and lines from regions predicted dead are inserted with a distant re-reference interval
+ * ------------------------------------------------------------------------------------------*/
+class SHiP : public RRIPBase {
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(SHiP, "memHierarchy", "replacement.ship", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "signature-based hit predictor (SHiP-Mem) on top of SRRIP. Max 64 ways", SST::MemHierarchy::ReplacementPolicy);
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"rrpv_bits",       "Bits per re-reference prediction value (1-4)", "2"},
+            {"signature_bits",  "log2 of the number of signature history counter table entries", "14"},
+            {"counter_bits",    "Bits per signature history counter", "3"},
+            {"region_shift",    "Lines in the same 2^region_shift byte region share a signature", "14"} )
+
+    SHiP(ComponentId_t id, Params& params, uint64_t lines, uint64_t associativity) : RRIPBase(id, params, lines, associativity), pendingSig(0) {
+        uint32_t sigBits = params.find<uint32_t>("signature_bits", 14);
+        uint32_t ctrBits = params.find<uint32_t>("counter_bits", 3);
+        regionShift = params.find<uint32_t>("region_shift", 14);
+        if (sigBits < 1 || sigBits > 16 || ctrBits < 1 || ctrBits > 8) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "%s, Invalid param: signature_bits must be 1-16 and counter_bits must be 1-8. You specified %" PRIu32 " and %" PRIu32 ".\n",
+                    getName().c_str(), sigBits, ctrBits);
+        }
+        sigMask = (1 << sigBits) - 1;
+        ctrMax = (1 << ctrBits) - 1;
+        shct.resize(sigMask + 1, (ctrMax + 1) / 2);
+        signature.resize(lines, 0);
+        reused.resize(sets, 0);
+    }
+
+    virtual ~SHiP() { }
+
+    bool usesAddress() { return true; }
+
+    void updateWithAddr(uint64_t id, ReplacementInfo * rInfo, Addr addr) {
+        pendingSig = hashSig(addr);
+        update(id, rInfo);
+    }
+
+protected:
+    uint32_t regionShift;
+    uint32_t sigMask;
+    uint8_t ctrMax;
+    std::vector<uint8_t> shct;      // Signature history counters
+    std::vector<uint16_t> signature; // Per line, signature at fill
+    std::vector<uint64_t> reused;   // Per set, bit per way: line was hit since fill
+    uint16_t pendingSig;            // Signature of the line being updated
+
+    inline uint16_t hashSig(Addr addr) {
+        uint64_t region = addr >> regionShift;
+        return (uint16_t)((region ^ (region >> 16) ^ (region >> 32)) & sigMask);
+    }
+
+    unsigned int insertionRRPV(uint64_t id) {
+        signature[id] = pendingSig;
+        reused[id / ways] &= ~(1ULL << (id % ways));
+        return shct[pendingSig] == 0 ? maxRRPV : maxRRPV - 1;
+    }
+
+    void hit(uint64_t id) {
+        uint64_t set = id / ways;
+        uint64_t bit = 1ULL << (id % ways);
+        if (!(reused[set] & bit)) {
+            reused[set] |= bit;
+            uint8_t &ctr = shct[signature[id]];
+            if (ctr < ctrMax) ctr++;
+        }
+    }
+
+    void evicted(uint64_t id) {
+        if (!(reused[id / ways] & (1ULL << (id % ways)))) {
+            uint8_t &ctr = shct[signature[id]];
+            if (ctr > 0) ctr--;
+        }
+    }
+};
 
 }}
 
@@ -0,0 +1,258 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_ROUTETABLE_H
+#define MEMHIERARCHY_ROUTETABLE_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Address -> destination lookup compiled from a list of address regions
+ *
+ * Regions are added in priority order; find() returns the route of the first
+ * added region that contains the address, same as walking the list and
+ * calling MemRegion::contains() on each one.
+ *
+ *  - Non-interleaved regions are flattened into disjoint segments and found
+ *    with a binary search.
+ *  - Interleaved regions with the same step are grouped. The step is cut into
+ *    slices of 'gcd(step, size, start % step)' bytes; every slice belongs
+ *    entirely to or entirely outside of each region in the group, so
+ *    '(addr % step) / slice' indexes a table listing the regions that own that
+ *    slice. The region bounds are then checked for the (usually one) candidate.
+ *  - Groups that would need more than MaxSlices slices are kept as a plain list.
+ *
+ * This class has no dependencies on sst-core so it can be tested standalone.
+ */
+class AddrRouteTable {
+public:
+    typedef uint64_t Addr;
+    static const int NoRoute = -1;
+    static const size_t MaxSlices = 1 << 16;
+
+    AddrRouteTable() : numRegions_(0) { }
+
+    void clear() {
+        pending_.clear();
+        segments_.clear();
+        groups_.clear();
+        numRegions_ = 0;
+    }
+
+    /* Add a region. 'route' is returned by find() for addresses in the region */
+    void addRegion(Addr start, Addr end, Addr interleaveSize, Addr interleaveStep, int route) {
+        Region r;
+        r.start = start;
+        r.end = end;
+        r.size = interleaveSize;
+        r.step = interleaveStep;
+        r.route = route;
+        r.priority = numRegions_++;
+        pending_.push_back(r);
+    }
+
+    /* Compile the regions added so far. Must be called before find() */
+    void build() {
+        segments_.clear();
+        groups_.clear();
+
+        std::vector<Region> flat;
+        for (std::vector<Region>::iterator it = pending_.begin(); it != pending_.end(); it++) {
+            // Regions whose chunks cover the whole step behave like contiguous regions
+            if (it->size == 0 || it->size >= it->step)
+                flat.push_back(*it);
+            else
+                addToGroup(*it);
+        }
+        buildSegments(flat);
+        for (std::vector<Group>::iterator it = groups_.begin(); it != groups_.end(); it++)
+            buildSlices(*it);
+    }
+
+    int find(Addr addr) const {
+        unsigned int bestPriority = ~0U;
+        int best = NoRoute;
+
+        if (!segments_.empty()) {
+            // Last segment whose start is <= addr
+            std::vector<Segment>::const_iterator it = std::upper_bound(segments_.begin(), segments_.end(), addr,
+                    [](Addr a, const Segment& s) { return a < s.start; });
+            if (it != segments_.begin()) {
+                --it;
+                if (addr <= it->end && it->route != NoRoute) {
+                    bestPriority = it->priority;
+                    best = it->route;
+                }
+            }
+        }
+
+        for (std::vector<Group>::const_iterator g = groups_.begin(); g != groups_.end(); g++) {
+            if (addr < g->start || addr > g->end)
+                continue;
+            const Region* cand;
+            const Region* candEnd;
+            if (g->sliceIndex.empty()) {
+                cand = g->regions.data();
+                candEnd = cand + g->regions.size();
+            } else {
+                Addr slice = g->pow2 ? ((addr & g->stepMask) >> g->sliceShift) : ((addr % g->step) / g->slice);
+                cand = g->sliceRegions.data() + g->sliceIndex[slice];
+                candEnd = g->sliceRegions.data() + g->sliceIndex[slice + 1];
+            }
+            for (; cand != candEnd && cand->priority < bestPriority; cand++) {
+                if (addr < cand->start || addr > cand->end)
+                    continue;
+                if (!g->sliceIndex.empty() || (addr - cand->start) % cand->step < cand->size) {
+                    bestPriority = cand->priority;
+                    best = cand->route;
+                    break;
+                }
+            }
+        }
+        return best;
+    }
+
+private:
+    struct Region {
+        Addr start;
+        Addr end;
+        Addr size;
+        Addr step;
+        int route;
+        unsigned int priority;
+    };
+
+    struct Segment {
+        Addr start;
+        Addr end;
+        int route;
+        unsigned int priority;
+    };
+
+    struct Group {
+        Addr step;
+        Addr start;     // Bounds over all regions in the group
+        Addr end;
+        Addr slice;
+        bool pow2;
+        Addr stepMask;
+        unsigned int sliceShift;
+        std::vector<Region> regions;            // Priority order
+        std::vector<uint32_t> sliceIndex;       // Slice i owns sliceRegions[sliceIndex[i]..sliceIndex[i+1])
+        std::vector<Region> sliceRegions;
+    };
+
+    static bool isPow2(Addr x) { return x && !(x & (x - 1)); }
+
+    static unsigned int log2(Addr x) {
+        unsigned int n = 0;
+        while (x >>= 1) n++;
+        return n;
+    }
+
+    void addToGroup(const Region& r) {
+        for (std::vector<Group>::iterator it = groups_.begin(); it != groups_.end(); it++) {
+            if (it->step == r.step) {
+                it->regions.push_back(r);
+                it->start = std::min(it->start, r.start);
+                it->end = std::max(it->end, r.end);
+                return;
+            }
+        }
+        Group g;
+        g.step = r.step;
+        g.start = r.start;
+        g.end = r.end;
+        g.slice = 0;
+        g.pow2 = false;
+        g.stepMask = 0;
+        g.sliceShift = 0;
+        g.regions.push_back(r);
+        groups_.push_back(g);
+    }
+
+    /* Resolve overlapping non-interleaved regions into disjoint segments, highest priority wins */
+    void buildSegments(std::vector<Region>& flat) {
+        if (flat.empty())
+            return;
+        std::vector<Addr> bounds;
+        for (std::vector<Region>::iterator it = flat.begin(); it != flat.end(); it++) {
+            bounds.push_back(it->start);
+            if (it->end != ~(Addr)0)
+                bounds.push_back(it->end + 1);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        for (size_t i = 0; i < bounds.size(); i++) {
+            Segment s;
+            s.start = bounds[i];
+            s.end = (i + 1 < bounds.size()) ? bounds[i + 1] - 1 : ~(Addr)0;
+            s.route = NoRoute;
+            s.priority = ~0U;
+            for (std::vector<Region>::iterator it = flat.begin(); it != flat.end(); it++) {
+                if (it->start <= s.start && s.end <= it->end && it->priority < s.priority) {
+                    s.route = it->route;
+                    s.priority = it->priority;
+                }
+            }
+            if (!segments_.empty() && segments_.back().route == s.route && segments_.back().priority == s.priority)
+                segments_.back().end = s.end;
+            else
+                segments_.push_back(s);
+        }
+    }
+
+    void buildSlices(Group& g) {
+        Addr slice = g.step;
+        for (std::vector<Region>::iterator it = g.regions.begin(); it != g.regions.end(); it++) {
+            slice = std::gcd(slice, it->size);
+            slice = std::gcd(slice, it->start % g.step);
+        }
+        size_t numSlices = g.step / slice;
+        if (numSlices > MaxSlices)
+            return; // Leave as a list
+
+        g.slice = slice;
+        g.pow2 = isPow2(g.step) && isPow2(slice);
+        g.stepMask = g.step - 1;
+        g.sliceShift = log2(slice);
+
+        g.sliceIndex.resize(numSlices + 1);
+        for (size_t i = 0; i < numSlices; i++) {
+            g.sliceIndex[i] = g.sliceRegions.size();
+            Addr offset = i * slice;
+            for (std::vector<Region>::iterator it = g.regions.begin(); it != g.regions.end(); it++) {
+                Addr phase = it->start % g.step;
+                if ((offset + g.step - phase) % g.step < it->size)
+                    g.sliceRegions.push_back(*it);
+            }
+        }
+        g.sliceIndex[numSlices] = g.sliceRegions.size();
+    }
+
+    std::vector<Region> pending_;
+    std::vector<Segment> segments_;
+    std::vector<Group> groups_;
+    unsigned int numRegions_;
+};
+
+}}
+#endif /* MEMHIERARCHY_ROUTETABLE_H */
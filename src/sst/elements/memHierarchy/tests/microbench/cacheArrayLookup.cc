@@ -0,0 +1,156 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * Microbenchmark: cache array tag lookups per second
+ *
+ * Compares the 'default' CacheArray lookup (walk heap-allocated line objects
+ * and compare getAddr()) against the 'flat' layout (FlatTagArray), with and
+ * without the SIMD compare.
+ *
+ * Usage: ./cacheArrayLookup [size_KiB] [associativity] [lookups] [hit_percent]
+ *   Defaults model an 8MiB, 16-way LLC with 64B lines.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sst/elements/memHierarchy/flatTagArray.h"
+
+using namespace SST::MemHierarchy;
+
+/* Approximates the footprint of a CacheLine: index, addr, state, data vector, timestamps, replacement info */
+class BenchLine {
+public:
+    BenchLine(uint32_t size, unsigned int index) : index_(index), addr_(0), state_(0), timestamp_(0), prefetch_(false), info_(nullptr) {
+        data_.resize(size);
+    }
+    virtual ~BenchLine() { }
+    unsigned int getIndex() { return index_; }
+    uint64_t getAddr() { return addr_; }
+    void setAddr(uint64_t addr) { addr_ = addr; }
+private:
+    const unsigned int index_;
+    uint64_t addr_;
+    int state_;
+    std::vector<uint8_t> data_;
+    uint64_t timestamp_;
+    bool prefetch_;
+    void * info_;
+};
+
+static double runDefault(std::vector<BenchLine*> &lines, unsigned int sets, unsigned int assoc, std::vector<uint64_t> &addrs, uint64_t &hits) {
+    auto start = std::chrono::steady_clock::now();
+    hits = 0;
+    for (size_t n = 0; n < addrs.size(); n++) {
+        uint64_t addr = addrs[n];
+        unsigned int set = (addr >> 6) % sets;
+        unsigned int begin = set * assoc;
+        for (unsigned int i = begin; i < begin + assoc; i++) {
+            if (lines[i]->getAddr() == addr) {
+                hits++;
+                break;
+            }
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+static double runFlat(FlatTagArray &tags, unsigned int sets, std::vector<uint64_t> &addrs, uint64_t &hits) {
+    auto start = std::chrono::steady_clock::now();
+    hits = 0;
+    for (size_t n = 0; n < addrs.size(); n++) {
+        uint64_t addr = addrs[n];
+        if (tags.find((addr >> 6) % sets, addr) != FlatTagArray::NotFound)
+            hits++;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t sizeKiB    = argc > 1 ? strtoull(argv[1], nullptr, 0) : 8192;
+    unsigned int assoc  = argc > 2 ? strtoul(argv[2], nullptr, 0) : 16;
+    uint64_t lookups    = argc > 3 ? strtoull(argv[3], nullptr, 0) : 20000000;
+    unsigned int hitPct = argc > 4 ? strtoul(argv[4], nullptr, 0) : 80;
+    const uint32_t lineSize = 64;
+
+    unsigned int numLines = (sizeKiB * 1024) / lineSize;
+    unsigned int sets = numLines / assoc;
+    if (sets == 0 || assoc == 0) {
+        fprintf(stderr, "Error: cache must have at least one set\n");
+        return 1;
+    }
+
+    std::mt19937_64 rng(1);
+
+    // Fill every way with a distinct line address that maps to its set
+    std::vector<BenchLine*> lines(numLines);
+    for (unsigned int i = 0; i < numLines; i++)
+        lines[i] = new BenchLine(lineSize, i);
+    // Shuffle allocation order so line objects are not laid out in index order, as after a long run
+    std::vector<BenchLine*> shuffled(lines);
+    std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    for (unsigned int i = 0; i < numLines; i++) {
+        lines[i] = shuffled[i];
+    }
+
+    FlatTagArray flat(sets, assoc, false);
+    FlatTagArray flatSIMD(sets, assoc, true);
+    std::vector<uint64_t> resident(numLines);
+    for (unsigned int i = 0; i < numLines; i++) {
+        unsigned int set = i / assoc;
+        unsigned int way = i % assoc;
+        uint64_t addr = (((uint64_t)(way + 1) * sets) + set) * lineSize;
+        lines[i]->setAddr(addr);
+        flat.setTag(i, addr);
+        flatSIMD.setTag(i, addr);
+        resident[i] = addr;
+    }
+
+    std::vector<uint64_t> addrs(lookups);
+    std::uniform_int_distribution<uint64_t> pick(0, numLines - 1);
+    std::uniform_int_distribution<unsigned int> pct(0, 99);
+    for (uint64_t n = 0; n < lookups; n++) {
+        uint64_t addr = resident[pick(rng)];
+        if (pct(rng) >= hitPct)
+            addr += (uint64_t)(assoc + 1) * sets * lineSize; // Same set, never resident
+        addrs[n] = addr;
+    }
+
+    printf("Cache: %" PRIu64 " KiB, %u-way, %u sets, %u lines. Lookups: %" PRIu64 ", target hit rate: %u%%\n",
+            sizeKiB, assoc, sets, numLines, lookups, hitPct);
+    printf("SIMD compare %s\n", flatSIMD.useSIMD() ? "enabled (AVX2)" : "unavailable in this build, flat+simd uses scalar compare");
+
+    uint64_t hits;
+    double t = runDefault(lines, sets, assoc, addrs, hits);
+    printf("  %-12s %10.2f Mlookups/s (hits: %" PRIu64 ")\n", "default", lookups / t / 1e6, hits);
+    t = runFlat(flat, sets, addrs, hits);
+    printf("  %-12s %10.2f Mlookups/s (hits: %" PRIu64 ")\n", "flat", lookups / t / 1e6, hits);
+    t = runFlat(flatSIMD, sets, addrs, hits);
+    printf("  %-12s %10.2f Mlookups/s (hits: %" PRIu64 ")\n", "flat+simd", lookups / t / 1e6, hits);
+
+    for (unsigned int i = 0; i < numLines; i++)
+        delete lines[i];
+    return 0;
+}
@@ -0,0 +1,94 @@
+import sst
+import sys
+from mhlib import componentlist
+
+# Four cores share a small address range so that lines in the L1s are
+# invalidated in place by the other cores' writes and then refetched.
+# The L1 replacement policy is the first model option (default lru).
+#   sst --model-options="plru" testReplacementInvalidate.py
+
+policy = sys.argv[1] if len(sys.argv) > 1 else "lru"
+
+DEBUG_L1 = 0
+DEBUG_L2 = 0
+DEBUG_MEM = 0
+
+cores = 4
+
+comp_bus = sst.Component("bus", "memHierarchy.Bus")
+comp_bus.addParams({
+      "bus_frequency" : "2 Ghz"
+})
+
+for x in range(cores):
+    comp_cpu = sst.Component("core" + str(x), "memHierarchy.standardCPU")
+    comp_cpu.addParams({
+        "memFreq" : 1,
+        "memSize" : "2KiB",
+        "verbose" : 0,
+        "clock" : "2GHz",
+        "rngseed" : 301 + x,
+        "maxOutstanding" : 8,
+        "opCount" : 4000,
+        "reqsPerIssue" : 2,
+        "write_freq" : 40,      # 40% writes
+        "read_freq" : 54,       # 54% reads
+        "flushinv_freq" : 6,    # 6% flush-inv
+    })
+    iface = comp_cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    comp_l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
+    comp_l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2 Ghz",
+        "replacement_policy" : policy,
+        "coherence_protocol" : "MESI",
+        "associativity" : "2",
+        "cache_line_size" : "64",
+        "cache_size" : "1 KB",
+        "L1" : "1",
+        "debug" : DEBUG_L1,
+        "debug_level" : 10
+    })
+
+    link_cpu_l1 = sst.Link("link_cpu_l1_" + str(x))
+    link_cpu_l1.connect( (iface, "port", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+    link_l1_bus = sst.Link("link_l1_bus_" + str(x))
+    link_l1_bus.connect( (comp_l1cache, "low_network_0", "1000ps"), (comp_bus, "high_network_" + str(x), "1000ps") )
+
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams({
+      "access_latency_cycles" : "10",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "cache_size" : "32 KB",
+      "debug" : DEBUG_L2,
+      "debug_level" : 10
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : DEBUG_MEM,
+    "debug_level" : "10",
+    "clock" : "1GHz",
+    "addr_range_end" : 512*1024*1024-1,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+      "access_time" : "50 ns",
+      "mem_size" : "512MiB"
+})
+
+# Enable statistics
+sst.setStatisticLoadLevel(7)
+sst.setStatisticOutput("sst.statOutputConsole")
+for a in componentlist:
+    sst.enableAllStatisticsForComponentType(a)
+
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (comp_bus, "low_network_0", "1000ps"), (comp_l2cache, "high_network_0", "1000ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (comp_l2cache, "low_network_0", "1000ps"), (memctrl, "direct_link", "1000ps") )
@@ -164,6 +164,9 @@ class testcase_memHierarchy_memHA(SSTTestCase):
 
     def test_memHA_RangeCheck(self):
         self.memHA_Template("RangeCheck", testtimeout=60)
+
+    def test_memHA_ReplacementInvalidate(self):
+        self.memHA_Replacement_Template()
 #####
 
     def memHA_Template(self, testcase,
@@ -229,6 +232,39 @@ class testcase_memHierarchy_memHA(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    # L1 lines are invalidated in place by other cores and then refetched.
+    # With two ways, tree-PLRU evicts the same lines as LRU, so its output
+    # must match the LRU run. The other set-bitmask policies must run to
+    # completion on the same traffic.
+    def memHA_Replacement_Template(self, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/testReplacementInvalidate.py".format(test_path)
+
+        outfiles = {}
+        for policy in ["lru", "plru", "srrip", "brrip", "drrip", "ship"]:
+            testDataFileName = "test_memHA_ReplacementInvalidate_{0}".format(policy)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            otherargs = '--model-options="{0}"'.format(policy)
+
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs,
+                         timeout_sec=testtimeout, mpi_out_files=mpioutfiles)
+            outfiles[policy] = outfile
+
+        ignore_lines = ["WARNING: No components are assigned to"]
+        tol_stats = { "outstanding_requests" : [0, 0, 20, 0, 0],
+                      "total_cycles" : [20, 'X', 20, 20, 20],
+                      "MSHR_occupancy" : [0, 0, 20, 0, 0] }
+
+        filesAreTheSame, statDiffs, othDiffs = testing_stat_output_diff(outfiles["plru"], outfiles["lru"], ignore_lines, tol_stats, True)
+        if not filesAreTheSame:
+            diffdata = self._prettyPrintDiffs(statDiffs, othDiffs)
+            log_failure(diffdata)
+        self.assertTrue(filesAreTheSame, "2-way plru output {0} does not match lru output {1}".format(outfiles["plru"], outfiles["lru"]))
+
 ###
     # Remove lines containing any string found in 'remove_strs' from in_file
     # If out_file != None, output is out_file
@@ -0,0 +1,360 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "flow/flow_network.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <set>
+
+#include "interfaces/flowLinkControl.h"
+#include "merlin.h"
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+
+std::map<std::string, FlowNetwork*> FlowNetwork::networks;
+
+// Flows that have not reached a host port after this many routers are
+// caught in a routing loop
+static const int max_flow_hops = 256;
+
+FlowNetwork*
+FlowNetwork::getNetwork(const std::string& name)
+{
+    FlowNetwork*& net = networks[name];
+    if ( net == nullptr ) net = new FlowNetwork(name);
+    net->refs++;
+    return net;
+}
+
+void
+FlowNetwork::releaseNetwork(FlowNetwork* net)
+{
+    if ( --net->refs > 0 ) return;
+    networks.erase(net->name);
+    delete net;
+}
+
+FlowNetwork::~FlowNetwork()
+{
+    // Flows still in flight at the end of simulation
+    std::set<Flow*> flows;
+    for ( FlowLink& link : links ) {
+        flows.insert(link.flows.begin(), link.flows.end());
+    }
+    for ( Flow* flow : flows ) {
+        delete flow->req;
+        delete flow;
+    }
+}
+
+void
+FlowNetwork::addRouter(int rtr, Topology* topo, int num_ports, double link_bw, SimTime_t latency)
+{
+    if ( rtr >= (int)routers.size() ) routers.resize(rtr + 1);
+    RouterInfo& info = routers[rtr];
+    if ( info.topo != nullptr ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow network %s: router id %d used twice\n", name.c_str(), rtr);
+    }
+
+    info.topo = topo;
+    info.num_ports = num_ports;
+    info.link_base = links.size();
+    info.peers.assign(num_ports, std::make_pair(-1,-1));
+    for ( int i = 0; i < num_ports; i++ ) {
+        links.emplace_back(link_bw, latency);
+    }
+}
+
+void
+FlowNetwork::setLinkBW(int rtr, int port, double link_bw)
+{
+    links[routers[rtr].link_base + port].capacity = link_bw;
+}
+
+void
+FlowNetwork::addNeighbor(int rtr, int port, int peer, int peer_port)
+{
+    routers[rtr].peers[port] = std::make_pair(peer, peer_port);
+}
+
+void
+FlowNetwork::addHostPort(int rtr, int port, SimpleNetwork::nid_t id)
+{
+    if ( id >= (SimpleNetwork::nid_t)endpoints.size() ) endpoints.resize(id + 1);
+    EndpointInfo& info = endpoints[id];
+    if ( info.rtr != -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow network %s: endpoint id %" PRI_NID " is on two router ports\n",
+                           name.c_str(), id);
+    }
+
+    // The link into the router has the same latency as the one back
+    // out to the endpoint
+    const FlowLink& out = links[routers[rtr].link_base + port];
+    info.rtr = rtr;
+    info.port = port;
+    info.link = links.size();
+    links.emplace_back(out.capacity, out.latency);
+}
+
+void
+FlowNetwork::addEndpoint(SimpleNetwork::nid_t id, FlowLinkControl* ep, double link_bw)
+{
+    if ( id < 0 || id >= (SimpleNetwork::nid_t)endpoints.size() || endpoints[id].rtr == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow network %s: endpoint %" PRI_NID " is not attached to a flow_router\n",
+                           name.c_str(), id);
+    }
+    endpoints[id].ep = ep;
+    links[endpoints[id].link].capacity = link_bw;
+}
+
+// Walk the request through the topology objects of the routers on its
+// path, the same way hr_router moves a packet from port to port
+void
+FlowNetwork::route(Flow* flow, SimpleNetwork::nid_t src)
+{
+    const EndpointInfo& ep = endpoints[src];
+    flow->path.push_back(ep.link);
+    flow->latency = links[ep.link].latency;
+
+    int rtr = ep.rtr;
+    int port = ep.port;
+    RtrEvent* rtr_ev = new RtrEvent(flow->req, src, flow->vn);
+    rtr_ev->computeSizeInFlits(1);
+    internal_router_event* ev = routers[rtr].topo->process_input(rtr_ev);
+
+    for ( int hops = 0; ; hops++ ) {
+        if ( hops >= max_flow_hops ) {
+            merlin_abort.fatal(CALL_INFO, -1, "flow network %s: flow from %" PRI_NID " to %" PRI_NID " did not reach its destination in %d hops\n",
+                               name.c_str(), src, flow->req->dest, max_flow_hops);
+        }
+
+        const RouterInfo& info = routers[rtr];
+        info.topo->route_packet(port, ev->getVC(), ev);
+        int next_port = ev->getNextPort();
+        int link = info.link_base + next_port;
+        flow->path.push_back(link);
+        flow->latency += links[link].latency;
+
+        if ( info.topo->getPortState(next_port) != Topology::R2R ) break;
+
+        if ( info.peers[next_port].first == -1 ) {
+            merlin_abort.fatal(CALL_INFO, -1, "flow network %s: flow from %" PRI_NID " to %" PRI_NID " routed to unconnected port %d of router %d\n",
+                               name.c_str(), src, flow->req->dest, next_port, rtr);
+        }
+        port = info.peers[next_port].second;
+        rtr = info.peers[next_port].first;
+    }
+
+    // The request belongs to the flow, not the routing event
+    ev->getEncapsulatedEvent()->takeRequest();
+    delete ev;
+}
+
+void
+FlowNetwork::markDirty(Flow* flow)
+{
+    dirty.insert(dirty.end(), flow->path.begin(), flow->path.end());
+    if ( !recompute_pending ) {
+        // Everything that starts or finishes at this time goes into a
+        // single recompute
+        flow->src->sendFlowEvent(0, new FlowEvent(FlowEvent::RECOMPUTE));
+        recompute_pending = true;
+    }
+}
+
+void
+FlowNetwork::startFlow(FlowLinkControl* src, SimpleNetwork::nid_t id, SimpleNetwork::Request* req, int vn, SimTime_t now)
+{
+    SimpleNetwork::nid_t dest = req->dest;
+    if ( dest < 0 || dest >= (SimpleNetwork::nid_t)endpoints.size() || endpoints[dest].ep == nullptr ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow network %s: endpoint %" PRI_NID " sent to unknown endpoint %" PRI_NID "\n",
+                           name.c_str(), id, dest);
+    }
+
+    Flow* flow = new Flow();
+    flow->src = src;
+    flow->dest = endpoints[dest].ep;
+    flow->req = req;
+    flow->vn = vn;
+    flow->remaining = req->size_in_bits;
+    flow->rate = 0;
+    flow->last_update = now;
+    flow->version = 0;
+    flow->pending_events = 0;
+    flow->done = false;
+    flow->mark = 0;
+
+    route(flow, id);
+
+    flow->slot.resize(flow->path.size());
+    for ( size_t i = 0; i < flow->path.size(); i++ ) {
+        std::vector<Flow*>& flows = links[flow->path[i]].flows;
+        flow->slot[i] = flows.size();
+        flows.push_back(flow);
+    }
+
+    markDirty(flow);
+}
+
+void
+FlowNetwork::finishFlow(Flow* flow, uint64_t version, SimTime_t now)
+{
+    flow->pending_events--;
+    if ( flow->done || version != flow->version ) {
+        // Stale event from before the last rate change
+        if ( flow->done && flow->pending_events == 0 ) delete flow;
+        return;
+    }
+
+    for ( size_t i = 0; i < flow->path.size(); i++ ) {
+        int link = flow->path[i];
+        std::vector<Flow*>& flows = links[link].flows;
+        size_t slot = flow->slot[i];
+        size_t last = flows.size() - 1;
+        flows[slot] = flows[last];
+        flows.pop_back();
+        if ( slot == last ) continue;
+
+        // Point the flow that moved at its new slot
+        Flow* moved = flows[slot];
+        for ( size_t j = 0; j < moved->path.size(); j++ ) {
+            if ( moved->path[j] == link && moved->slot[j] == last ) {
+                moved->slot[j] = slot;
+                break;
+            }
+        }
+    }
+
+    flow->done = true;
+    markDirty(flow);
+    flow->src->flowFinished(flow);
+
+    if ( flow->pending_events == 0 ) delete flow;
+}
+
+void
+FlowNetwork::scheduleFinish(Flow* flow)
+{
+    double cycles = 0;
+    if ( flow->remaining > 0 ) {
+        cycles = std::ceil(flow->remaining / flow->rate * cycles_per_second);
+        cycles = std::min(cycles, 1e18);
+    }
+
+    FlowEvent* ev = new FlowEvent(FlowEvent::FINISH);
+    ev->flow = flow;
+    ev->version = ++flow->version;
+    flow->pending_events++;
+    flow->src->sendFlowEvent((SimTime_t)cycles, ev);
+}
+
+// Max-min fair rates by progressive filling: the link with the
+// smallest share per unfixed flow is the bottleneck for all of its
+// unfixed flows, which are fixed at that share and removed from the
+// rest of their links.  Only the flows connected to the links that
+// changed are recomputed.
+void
+FlowNetwork::recompute(SimTime_t now)
+{
+    recompute_pending = false;
+
+    std::vector<int> comp_links;
+    std::vector<Flow*> comp_flows;
+    std::vector<int> stack;
+
+    uint64_t visited = ++mark;
+    for ( int link : dirty ) {
+        if ( links[link].mark == visited ) continue;
+        links[link].mark = visited;
+        stack.push_back(link);
+    }
+    dirty.clear();
+
+    while ( !stack.empty() ) {
+        int link = stack.back();
+        stack.pop_back();
+        comp_links.push_back(link);
+        for ( Flow* flow : links[link].flows ) {
+            if ( flow->mark == visited ) continue;
+            flow->mark = visited;
+            comp_flows.push_back(flow);
+            for ( int next : flow->path ) {
+                if ( links[next].mark == visited ) continue;
+                links[next].mark = visited;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    // Bring the flows up to date at their old rates
+    std::vector<double> old_rate(comp_flows.size());
+    for ( size_t i = 0; i < comp_flows.size(); i++ ) {
+        Flow* flow = comp_flows[i];
+        flow->remaining -= flow->rate * (now - flow->last_update) / cycles_per_second;
+        if ( flow->remaining < 0 ) flow->remaining = 0;
+        flow->last_update = now;
+        old_rate[i] = flow->rate;
+    }
+
+    // A link's share only grows as flows on it are fixed at smaller
+    // shares elsewhere, so a heap entry is a lower bound.  Stale
+    // entries are refreshed when they reach the top.
+    typedef std::pair<double,int> heap_entry_t;
+    std::priority_queue<heap_entry_t, std::vector<heap_entry_t>, std::greater<heap_entry_t> > heap;
+
+    for ( int link : comp_links ) {
+        FlowLink& l = links[link];
+        l.left = l.capacity;
+        l.unfixed = l.flows.size();
+        if ( l.unfixed > 0 ) heap.emplace(l.left / l.unfixed, link);
+    }
+
+    uint64_t fixed = ++mark;
+    while ( !heap.empty() ) {
+        double bound = heap.top().first;
+        int link = heap.top().second;
+        heap.pop();
+
+        FlowLink& l = links[link];
+        if ( l.unfixed == 0 ) continue;
+
+        double share = std::max(l.left, 0.0) / l.unfixed;
+        if ( share > bound ) {
+            heap.emplace(share, link);
+            continue;
+        }
+
+        for ( Flow* flow : l.flows ) {
+            if ( flow->mark == fixed ) continue;
+            flow->mark = fixed;
+            flow->rate = share;
+            for ( int next : flow->path ) {
+                links[next].left -= share;
+                links[next].unfixed--;
+            }
+        }
+    }
+
+    // Finish events stay valid for flows whose rate did not change
+    for ( size_t i = 0; i < comp_flows.size(); i++ ) {
+        Flow* flow = comp_flows[i];
+        if ( flow->rate != old_rate[i] || flow->pending_events == 0 ) scheduleFinish(flow);
+    }
+}
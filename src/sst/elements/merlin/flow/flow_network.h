@@ -0,0 +1,173 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOW_FLOW_NETWORK_H
+#define COMPONENTS_MERLIN_FLOW_FLOW_NETWORK_H
+
+#include <sst/core/event.h>
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include "sst/elements/merlin/router.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+class FlowLinkControl;
+
+// A request in flight through the flow network.  Each request is one
+// flow that holds the same rate on every link of its path.
+struct Flow {
+    FlowLinkControl* src;
+    FlowLinkControl* dest;
+    SST::Interfaces::SimpleNetwork::Request* req;
+    int vn;
+
+    // Links the flow crosses and the flow's index in each link's list
+    std::vector<int> path;
+    std::vector<size_t> slot;
+    // Time from the last bit leaving the source to it reaching the
+    // destination (in units of core timebase)
+    SimTime_t latency;
+
+    // Bits left to send as of last_update and the current rate in
+    // bits/s
+    double remaining;
+    double rate;
+    SimTime_t last_update;
+
+    // Finish events carry the version they were scheduled for.  The
+    // flow is deleted once it is done and no events point at it.
+    uint64_t version;
+    int pending_events;
+    bool done;
+    uint64_t mark;
+};
+
+// Events the flow network schedules on the self link of an endpoint
+class FlowEvent : public Event {
+public:
+    enum Type { RECOMPUTE, FINISH, DELIVER };
+
+    Type type;
+    Flow* flow;
+    uint64_t version;
+    SST::Interfaces::SimpleNetwork::Request* req;
+    SimTime_t start_time;
+
+    FlowEvent(Type type) : Event(), type(type), flow(nullptr), version(0), req(nullptr), start_time(0) {}
+
+    NotSerializable(SST::Merlin::FlowEvent)
+};
+
+// Fluid model of a network of flow_routers.  The routers register
+// their topology objects and wiring during init and endpoints
+// register their injection links.  Paths come from the topology
+// routing functions, and link bandwidth is shared max-min fairly
+// among the flows crossing it.  Rates are only recomputed when a flow
+// starts or finishes, and then only for the flows that share links,
+// directly or transitively, with the ones that changed.
+//
+// All routers and endpoints of a network live in one process, so a
+// network is found by name in a process wide registry.
+class FlowNetwork {
+public:
+    static FlowNetwork* getNetwork(const std::string& name);
+    static void releaseNetwork(FlowNetwork* net);
+
+    // Called by flow_router
+    void addRouter(int rtr, Topology* topo, int num_ports, double link_bw, SimTime_t latency);
+    void setLinkBW(int rtr, int port, double link_bw);
+    void addNeighbor(int rtr, int port, int peer, int peer_port);
+    void addHostPort(int rtr, int port, SST::Interfaces::SimpleNetwork::nid_t id);
+
+    // Called by FlowLinkControl
+    void addEndpoint(SST::Interfaces::SimpleNetwork::nid_t id, FlowLinkControl* ep, double link_bw);
+    void setCoreTimeBase(double seconds) { cycles_per_second = 1.0 / seconds; }
+
+    void startFlow(FlowLinkControl* src, SST::Interfaces::SimpleNetwork::nid_t id,
+                   SST::Interfaces::SimpleNetwork::Request* req, int vn, SimTime_t now);
+    void finishFlow(Flow* flow, uint64_t version, SimTime_t now);
+    void recompute(SimTime_t now);
+
+private:
+    FlowNetwork(const std::string& name) : name(name), refs(0), mark(0), recompute_pending(false), cycles_per_second(1e12) {}
+    ~FlowNetwork();
+
+    static std::map<std::string, FlowNetwork*> networks;
+
+    struct RouterInfo {
+        Topology* topo;
+        int num_ports;
+        int link_base;
+        // (router, port) on the other end of each port, -1 if none
+        std::vector<std::pair<int,int> > peers;
+
+        RouterInfo() : topo(nullptr), num_ports(0), link_base(-1) {}
+    };
+
+    struct EndpointInfo {
+        FlowLinkControl* ep;
+        int rtr;
+        int port;
+        // Link from the endpoint into its router
+        int link;
+
+        EndpointInfo() : ep(nullptr), rtr(-1), port(-1), link(-1) {}
+    };
+
+    struct FlowLink {
+        double capacity;
+        SimTime_t latency;
+        std::vector<Flow*> flows;
+
+        // Scratch state for recompute()
+        uint64_t mark;
+        double left;
+        int unfixed;
+
+        FlowLink(double capacity, SimTime_t latency) :
+            capacity(capacity), latency(latency), mark(0), left(0), unfixed(0) {}
+    };
+
+    std::string name;
+    int refs;
+
+    std::vector<RouterInfo> routers;
+    std::vector<EndpointInfo> endpoints;
+    std::vector<FlowLink> links;
+
+    // Links whose flow set changed since the last recompute
+    std::vector<int> dirty;
+    uint64_t mark;
+    bool recompute_pending;
+
+    double cycles_per_second;
+
+    void route(Flow* flow, SST::Interfaces::SimpleNetwork::nid_t src);
+    void markDirty(Flow* flow);
+    void scheduleFinish(Flow* flow);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOW_FLOW_NETWORK_H
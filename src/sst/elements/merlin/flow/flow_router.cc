@@ -0,0 +1,239 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+#include "flow/flow_router.h"
+
+#include <sst/core/params.h>
+
+#include <string>
+
+#include "merlin.h"
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+
+// Adaptive routing only compares credits, so any value larger than a
+// real buffer will do
+static const int idle_credits = 1 << 20;
+
+flow_router::~flow_router()
+{
+    delete topo;
+    FlowNetwork::releaseNetwork(network);
+}
+
+flow_router::flow_router(ComponentId_t cid, Params& params) :
+    Component(cid),
+    num_vcs(0)
+{
+    // The flow network is shared through process memory
+    if ( getNumRanks().rank > 1 || getNumRanks().thread > 1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router only runs on a single rank and thread\n");
+    }
+
+    id = params.find<int>("id",-1);
+    if ( id == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires id to be specified\n");
+    }
+
+    num_ports = params.find<int>("num_ports",-1);
+    if ( num_ports == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires num_ports to be specified\n");
+    }
+
+    num_vns = params.find<int>("num_vns",2);
+
+    UnitAlgebra link_bw = params.find<UnitAlgebra>("link_bw");
+    if ( !link_bw.hasUnits("B/s") && !link_bw.hasUnits("b/s") ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires link_bw to be specified in either B/s or b/s (SI prefix also allowed)\n");
+    }
+    if ( link_bw.hasUnits("B/s") ) {
+        link_bw *= UnitAlgebra("8b/B");
+    }
+
+    UnitAlgebra link_latency = params.find<UnitAlgebra>("link_latency");
+    if ( !link_latency.hasUnits("s") ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires link_latency to be specified in s (SI prefix also allowed)\n");
+    }
+
+    // Get the topology
+    topo = (Topology*)loadUserSubComponent<SST::Merlin::Topology>
+        ("topology", ComponentInfo::SHARE_NONE, num_ports, id, num_vns);
+
+    if ( !topo ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "flow_router requires topology to be specified in input file\n");
+    }
+
+    std::vector<int> vcs_per_vn(num_vns);
+    topo->getVCsPerVN(vcs_per_vn);
+    for ( int vcs : vcs_per_vn ) num_vcs += vcs;
+
+    output_credits.assign(num_ports * num_vcs, idle_credits);
+    output_queue_lengths.assign(num_ports * num_vcs, 0);
+    topo->setOutputBufferCreditArray(output_credits.data(), num_vcs);
+    topo->setOutputQueueLengthsArray(output_queue_lengths.data(), num_vcs);
+
+    network = FlowNetwork::getNetwork(params.find<std::string>("network_name","network"));
+    network->addRouter(id, topo, num_ports, link_bw.getDoubleValue(),
+                       (link_latency / getCoreTimeBase()).getRoundedValue());
+
+    links.resize(num_ports);
+    port_bw.assign(num_ports, link_bw);
+    for ( int i = 0; i < num_ports; i++ ) {
+        std::string port_name = std::string("port") + std::to_string(i);
+        links[i] = configureLink(port_name, "1GHz", new Event::Handler<flow_router>(this,&flow_router::handle_input));
+        if ( links[i] != nullptr && topo->getPortState(i) == Topology::R2N ) {
+            network->addHostPort(id, i, topo->getEndpointID(i));
+        }
+    }
+}
+
+RtrInitEvent*
+flow_router::checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func)
+{
+    bool good = true;
+    RtrInitEvent* init_ev = nullptr;
+    // Check to make sure the event isn't null and that it is an init event
+    if ( nullptr == ev || static_cast<BaseRtrEvent*>(ev)->getType() != BaseRtrEvent::INITIALIZATION ) good = false;
+
+    if ( good ) {
+        init_ev = static_cast<RtrInitEvent*>(ev);
+
+        // Now check to make sure this is the right protocol event
+        if ( init_ev->command != command ) {
+            good = false;
+        }
+    }
+
+    sst_assert(good, line, file, func, 1, "Error during flow_router protocol initialization.  The most likely cause of this is connecting a flow_router to a merlin.linkcontrol endpoint or an hr_router.\n");
+    return init_ev;
+}
+
+void
+flow_router::sendInitEvent(int port, RtrInitEvent::Commands command, int int_value, const UnitAlgebra& ua_value)
+{
+    RtrInitEvent* ev = new RtrInitEvent();
+    ev->command = command;
+    ev->int_value = int_value;
+    ev->ua_value = ua_value;
+    links[port]->sendUntimedData(ev);
+}
+
+void
+flow_router::init(unsigned int phase)
+{
+    switch ( phase ) {
+    case 0:
+        // Tell endpoints their ID and the neighbors where they are
+        // connected.  Both ends use the lower of the two bandwidths.
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( links[i] == nullptr ) continue;
+            if ( topo->getPortState(i) == Topology::R2N ) {
+                sendInitEvent(i, RtrInitEvent::REPORT_BW, 0, port_bw[i]);
+                sendInitEvent(i, RtrInitEvent::REPORT_ID, topo->getEndpointID(i), port_bw[i]);
+            }
+            else {
+                sendInitEvent(i, RtrInitEvent::REPORT_ID, id, port_bw[i]);
+                sendInitEvent(i, RtrInitEvent::REPORT_PORT, i, port_bw[i]);
+                sendInitEvent(i, RtrInitEvent::REPORT_BW, 0, port_bw[i]);
+            }
+        }
+        break;
+    case 1:
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( links[i] == nullptr ) continue;
+            Event* ev;
+            RtrInitEvent* init_ev;
+            if ( topo->getPortState(i) != Topology::R2N ) {
+                ev = links[i]->recvUntimedData();
+                init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_ID, CALL_INFO);
+                int peer = init_ev->int_value;
+                delete ev;
+
+                ev = links[i]->recvUntimedData();
+                init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_PORT, CALL_INFO);
+                network->addNeighbor(id, i, peer, init_ev->int_value);
+                delete ev;
+            }
+
+            ev = links[i]->recvUntimedData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_BW, CALL_INFO);
+            if ( port_bw[i] > init_ev->ua_value ) port_bw[i] = init_ev->ua_value;
+            network->setLinkBW(id, i, port_bw[i].getDoubleValue());
+            delete ev;
+
+            routeUntimedData(i);
+        }
+        break;
+    default:
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( links[i] != nullptr ) routeUntimedData(i);
+        }
+        break;
+    }
+}
+
+void
+flow_router::complete(unsigned int phase)
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( links[i] != nullptr ) routeUntimedData(i);
+    }
+}
+
+// Forward untimed data the same way hr_router does
+void
+flow_router::routeUntimedData(int port)
+{
+    Event *ev = NULL;
+    while ( (ev = links[port]->recvUntimedData()) != NULL ) {
+        internal_router_event *ire = dynamic_cast<internal_router_event*>(ev);
+        if ( ire == NULL ) {
+            ire = topo->process_UntimedData_input(static_cast<RtrEvent*>(ev));
+        }
+        std::vector<int> outPorts;
+        topo->routeUntimedData(port, ire, outPorts);
+        for ( std::vector<int>::iterator j = outPorts.begin() ; j != outPorts.end() ; ++j ) {
+            if ( links[*j] == nullptr ) continue;
+            /* Little tricky here.  Need to clone both the event, and the
+             * encapsulated event.
+             */
+            switch ( topo->getPortState(*j) ) {
+            case Topology::R2N:
+                links[*j]->sendUntimedData(ire->getEncapsulatedEvent()->clone());
+                break;
+            case Topology::R2R:
+            // Ignore failed links during init
+            case Topology::FAILED: {
+                internal_router_event *new_ire = ire->clone();
+                new_ire->setEncapsulatedEvent(ire->getEncapsulatedEvent()->clone());
+                links[*j]->sendUntimedData(new_ire);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+        delete ire;
+    }
+}
+
+void
+flow_router::handle_input(Event* ev)
+{
+    // Data moves through the FlowNetwork, so nothing is sent on the
+    // links during simulation
+    merlin_abort.fatal(CALL_INFO, -1, "flow_router %d: received an event during simulation\n", id);
+}
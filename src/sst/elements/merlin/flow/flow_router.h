@@ -0,0 +1,102 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOW_FLOW_ROUTER_H
+#define COMPONENTS_MERLIN_FLOW_FLOW_ROUTER_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/flow/flow_network.h"
+
+using namespace SST;
+
+namespace SST {
+namespace Merlin {
+
+// Router for the flow level network model.  It has no buffers or
+// clock.  It loads the same topology objects as hr_router and hands
+// them, along with what it learns about its links during init, to the
+// FlowNetwork shared with the FlowLinkControl endpoints, which moves
+// all the data.  The links only carry untimed data.
+class flow_router : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        flow_router,
+        "merlin",
+        "flow_router",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Router for flow level network models.  Endpoints must use merlin.flowlinkcontrol",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"id",                 "ID of the router."},
+        {"num_ports",          "Number of ports that the router has"},
+        {"num_vns",            "Number of VNs.","2"},
+        {"link_bw",            "Bandwidth of the links specified in either b/s or B/s (can include SI prefix)."},
+        {"link_latency",       "Latency added to a request for each link it crosses leaving this router, including the link in from an endpoint.  Specified in s (can include SI prefix)."},
+        {"network_name",       "Name of the flow network.  Must match network_name of the endpoints' flowlinkcontrol.", "network"}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.internal_router_event" } }
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology object to control routing", "SST::Merlin::Topology" }
+    )
+
+private:
+    int id;
+    int num_ports;
+    int num_vns;
+    int num_vcs;
+
+    Topology* topo;
+    FlowNetwork* network;
+
+    std::vector<Link*> links;
+    std::vector<UnitAlgebra> port_bw;
+
+    // Flows see an empty network, so adaptive routing decisions are
+    // made on zero queue lengths and full credits
+    std::vector<int> output_credits;
+    std::vector<int> output_queue_lengths;
+
+    RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func);
+    void sendInitEvent(int port, RtrInitEvent::Commands command, int int_value, const UnitAlgebra& ua_value);
+    void routeUntimedData(int port);
+    void handle_input(Event* ev);
+
+public:
+    flow_router(ComponentId_t cid, Params& params);
+    ~flow_router();
+
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOW_FLOW_ROUTER_H
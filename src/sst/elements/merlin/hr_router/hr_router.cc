@@ -21,6 +21,7 @@
 #include <sst/core/timeLord.h>
 #include <sst/core/unitAlgebra.h>
 
+#include <fstream>
 #include <sstream>
 #include <string>
 
@@ -238,6 +239,11 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     bool oql_track_port = params.find<bool>("oql_track_port","false");
     bool oql_track_remote = params.find<bool>("oql_track_remote","false");
 
+    credit_window = params.find<int>("credit_window",0);
+    if ( credit_window < 0 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router credit_window must not be negative: %d\n", credit_window);
+    }
+
     params.enableVerify(false);
 
     Params pc_params = params.get_scoped_params("portcontrol");
@@ -246,6 +252,8 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     if (pc_params.contains("network_inspectors")) pc_params.insert("network_inspectors", params.find<std::string>("network_inspectors", ""));
     pc_params.insert("oql_track_port", params.find<std::string>("oql_track_port","false"));
     pc_params.insert("oql_track_remote", params.find<std::string>("oql_track_remote","false"));
+    pc_params.insert("coalesce_credits", credit_window > 0 ? "true" : "false");
+    pc_params.insert("background_packet_size", params.find<std::string>("background_packet_size","64B"));
 
     for ( int i = 0; i < num_ports; i++ ) {
         in_port_busy[i] = 0;
@@ -276,6 +284,12 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
              pc_params,this,id,i,topo);
 
     }
+
+    // Analytical background traffic
+    background_load = params.find<double>("background_load",0.0);
+    background = background_load > 0.0 || params.find<std::string>("background_util_map","") != "";
+    if ( background ) init_background(params);
+
     params.enableVerify(true);
 
     // Get the Xbar arbitration
@@ -284,6 +298,7 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     Params empty_params; // Empty params sent to subcomponents
     arb =
         loadAnonymousSubComponent<XbarArbitration>(xbar_arb, "XbarArb", 0, ComponentInfo::INSERT_STATS, empty_params);
+    arb_tracks_state = arb->tracksPortState();
 
     my_clock_handler = new Clock::Handler<hr_router>(this,&hr_router::clock_handler);
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
@@ -313,6 +328,126 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
 }
 
 
+void
+hr_router::init_background(Params& params)
+{
+    port_link_bw.resize(num_ports);
+    background_rate.assign(num_ports,0.0);
+    background_map.assign(num_ports,-1.0);
+    background_gens.assign(num_ports,nullptr);
+    background_out.assign(num_ports,nullptr);
+
+    for ( int i = 0; i < num_ports; i++ ) {
+        port_link_bw[i] = getLogicalGroupParamUA(params,topo,i,"link_bw").getDoubleValue();
+    }
+
+    if ( background_load > 0.0 ) {
+        if ( background_load > 1.0 ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router background_load must be between 0 and 1: %f\n", background_load);
+        }
+
+        int num_peers = params.find<int>("background_num_peers",-1);
+        if ( num_peers <= 0 ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router requires background_num_peers to be specified when background_load is set\n");
+        }
+
+        background_samples = params.find<int>("background_samples",64);
+        if ( background_samples < 1 ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router background_samples must be at least 1: %d\n", background_samples);
+        }
+
+        // One generator per host port, seeded as if it were the
+        // endpoint on that port
+        std::string pattern = params.find<std::string>("background_pattern","merlin.targetgen.uniform");
+        Params pattern_params = params.get_scoped_params("background_pattern");
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( topo->getPortState(i) != Topology::R2N ) continue;
+            background_gens[i] = loadAnonymousSubComponent<TargetGenerator>
+                (pattern, "background_pattern_gen", i, ComponentInfo::SHARE_NONE, pattern_params,
+                 topo->getEndpointID(i), num_peers);
+        }
+    }
+
+    std::string map_file = params.find<std::string>("background_util_map","");
+    if ( map_file == "" ) return;
+
+    std::ifstream map(map_file);
+    if ( !map.is_open() ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router could not open background_util_map %s\n", map_file.c_str());
+    }
+
+    // Lines are "router port utilization", # starts a comment
+    std::string line;
+    while ( std::getline(map,line) ) {
+        std::istringstream fields(line.substr(0,line.find('#')));
+        int rtr, port;
+        double util;
+        if ( !(fields >> rtr) ) continue;
+        if ( !(fields >> port >> util) ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router found a malformed line in background_util_map %s: %s\n",
+                               map_file.c_str(), line.c_str());
+        }
+        if ( rtr != id ) continue;
+        if ( port < 0 || port >= num_ports || util < 0.0 || util >= 1.0 ) {
+            merlin_abort.fatal(CALL_INFO, -1, "hr_router found a bad entry for router %d in background_util_map %s: %s\n",
+                               id, map_file.c_str(), line.c_str());
+        }
+        background_map[port] = util;
+    }
+}
+
+// Draw background_samples destinations for each local endpoint and
+// route a flow to each, carrying an equal share of the endpoint's
+// background load
+void
+hr_router::start_background_flows()
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        TargetGenerator* gen = background_gens[i];
+        if ( gen == nullptr ) continue;
+
+        int src = topo->getEndpointID(i);
+        double rate = background_load * port_link_bw[i] / background_samples;
+        for ( int j = 0; j < background_samples; j++ ) {
+            SimpleNetwork::Request* req = new SimpleNetwork::Request(gen->getNextValue(), src, 0, true, true);
+            internal_router_event* ev = topo->process_input(new RtrEvent(req, src, 0));
+            route_background_flow(i, ev, rate, 0);
+        }
+
+        // Only needed to draw the flows
+        delete gen;
+        background_gens[i] = nullptr;
+    }
+}
+
+// Flows that have not reached a host port after this many routers are
+// caught in a routing loop
+static const int max_background_hops = 256;
+
+void
+hr_router::route_background_flow(int port, internal_router_event* ev, double rate, int hops)
+{
+    topo->route_packet(port, ev->getVC(), ev);
+    int next_port = ev->getNextPort();
+    background_rate[next_port] += rate;
+
+    if ( topo->getPortState(next_port) != Topology::R2R ) {
+        delete ev;
+        return;
+    }
+
+    if ( hops >= max_background_hops ) {
+        merlin_abort.fatal(CALL_INFO, -1, "hr_router %d: background flow from %d to %d did not reach its destination in %d hops\n",
+                           id, ev->getSrc(), ev->getDest(), max_background_hops);
+    }
+
+    // Flows to the same neighbor go in one event per init phase
+    if ( background_out[next_port] == nullptr ) {
+        background_out[next_port] = new background_flow_event();
+    }
+    background_out[next_port]->add(ev, rate, hops + 1);
+}
+
 void
 hr_router::notifyEvent()
 {
@@ -443,11 +578,36 @@ hr_router::clock_handler(Cycle_t cycle)
         if ( out_port_busy[i] != 0 ) out_port_busy[i]--;
     }
 
+    // Credits are only returned from the moves above, so flush them
+    // once per window and whenever the router is about to go idle so
+    // nothing is held while unclocked.
+    if ( credit_window > 0 && ( cycle % credit_window == 0 || get_vcs_with_data() == 0 ) ) {
+        for ( int i = 0; i < num_ports; i++ ) {
+            ports[i]->flushCredits();
+        }
+    }
+
     return false;
 }
 
 void hr_router::setup()
 {
+    // All background flows have arrived by now, so hand each port its
+    // share of the link.  The model needs the link to have capacity
+    // left over, so saturated ports are capped.
+    if ( background ) {
+        for ( int i = 0; i < num_ports; i++ ) {
+            double util = background_map[i];
+            if ( util < 0.0 ) util = background_rate[i] / port_link_bw[i];
+            if ( util > 0.95 ) {
+                output.output("WARNING: hr_router %d: background utilization of port %d is %.2f, using 0.95\n",
+                              id, i, util);
+                util = 0.95;
+            }
+            ports[i]->setBackgroundUtilization(util);
+        }
+    }
+
     for ( int i = 0; i < num_ports; i++ ) {
     	ports[i]->setup();
     }
@@ -468,6 +628,16 @@ hr_router::init(unsigned int phase)
         ports[i]->init(phase);
         Event *ev = NULL;
         while ( (ev = ports[i]->recvUntimedData()) != NULL ) {
+            background_flow_event* bfe = dynamic_cast<background_flow_event*>(ev);
+            if ( bfe != NULL ) {
+                for ( size_t j = 0; j < bfe->flows.size(); j++ ) {
+                    route_background_flow(i, bfe->flows[j], bfe->rates[j], bfe->hops[j]);
+                }
+                bfe->flows.clear();
+                delete bfe;
+                continue;
+            }
+
             internal_router_event *ire = dynamic_cast<internal_router_event*>(ev);
             if ( ire == NULL ) {
                 ire = topo->process_UntimedData_input(static_cast<RtrEvent*>(ev));
@@ -499,6 +669,18 @@ hr_router::init(unsigned int phase)
     }
 
 
+    // Background flows start once the links are up in phase 1 and
+    // move one router per phase after that
+    if ( background ) {
+        if ( phase == 1 ) start_background_flows();
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( background_out[i] != nullptr ) {
+                ports[i]->sendUntimedData(background_out[i]);
+                background_out[i] = nullptr;
+            }
+        }
+    }
+
     // Always do the above.  A few specific things to do during init
 
     // After phase 1, all the PortControl blocks will have reported
@@ -618,6 +800,7 @@ hr_router::init_vcs()
     // Now that we have the number of VCs we can finish initializing
     // arbitration logic
     arb->setPorts(num_ports,num_vcs);
+    arb->setPortState(vc_heads,xbar_in_credits);
 
 
 }
@@ -30,6 +30,7 @@
 #include <queue>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/target_generator/target_generator.h"
 
 using namespace SST;
 
@@ -65,6 +66,13 @@ public:
         {"network_inspectors", "Comma separated list of network inspectors to put on output ports.", ""},
         {"oql_track_port",     "Set to true to track output queue length for an entire port.  False tracks per VC.", "false"},
         {"oql_track_remote",   "Set to true to track output queue length including remote input queue.  False tracks only local queue.", "false"},
+        {"credit_window",      "Number of crossbar cycles input ports hold returned credits so that credits for all VCs go back in one event.  0 returns credits for each packet as it leaves the input buffer.", "0"},
+        {"background_load",    "Offered load of analytical background traffic from each endpoint, as a fraction of its link bandwidth.  Background packets are not simulated: output ports lose the bandwidth they would use and add the queueing delay they would cause.  0 turns the model off.", "0"},
+        {"background_pattern", "Target generator the background traffic follows.  Parameters for it are scoped with background_pattern.", "merlin.targetgen.uniform"},
+        {"background_num_peers", "Number of endpoints in the network.  Required when background_load is set."},
+        {"background_samples", "Number of background destinations per endpoint routed through the network to estimate the load on each port.", "64"},
+        {"background_packet_size", "Size of background packets in b or B (can include SI prefix).", "64B"},
+        {"background_util_map", "File of \"router port utilization\" lines giving the background utilization of output ports.  Listed ports override the estimate from background_load.", ""},
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
@@ -81,13 +89,14 @@ public:
     )
 
     SST_ELI_DOCUMENT_PORTS(
-        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.internal_router_event", "merlin.topologyevent", "merlin.credit_event" } }
+        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.internal_router_event", "merlin.topologyevent", "merlin.credit_event", "merlin.credit_batch_event" } }
     )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
         {"topology", "Topology object to control routing", "SST::Merlin::Topology" },
         {"XbarArb", "Crossbar arbitration", "SST::Merlin::XbarArbitration" },
-        {"portcontrol", "PortControl blocks", "SST::Merlin::PortInterface" }
+        {"portcontrol", "PortControl blocks", "SST::Merlin::PortInterface" },
+        {"background_pattern_gen", "Target generators for analytical background traffic", "SST::Merlin::TargetGenerator" }
     )
 
 private:
@@ -103,6 +112,24 @@ private:
 
     Topology* topo;
     XbarArbitration* arb;
+    bool arb_tracks_state;
+
+    // Crossbar cycles between flushes of coalesced port credits (0
+    // if credits are not coalesced)
+    int credit_window;
+
+    // Analytical background traffic.  Flows drawn from the background
+    // pattern are routed through the network during init to total the
+    // load (in bits/s) leaving each port; background_map holds
+    // utilizations read from background_util_map (< 0 if not listed).
+    bool background;
+    double background_load;
+    int background_samples;
+    std::vector<double> port_link_bw;
+    std::vector<double> background_rate;
+    std::vector<double> background_map;
+    std::vector<TargetGenerator*> background_gens;
+    std::vector<background_flow_event*> background_out;
 
     PortInterface** ports;
     internal_router_event** vc_heads;
@@ -131,6 +158,9 @@ private:
     static void sigHandler(int signal);
 
     void init_vcs();
+    void init_background(Params& params);
+    void start_background_flows();
+    void route_background_flow(int port, internal_router_event* ev, double rate, int hops);
     Statistic<uint64_t>** xbar_stalls;
 
     Output& output;
@@ -147,6 +177,12 @@ public:
     void finish();
 
     void notifyEvent();
+    void vcHeadChanged(int port, int vc) {
+        if ( arb_tracks_state ) arb->vcHeadChanged(port, vc);
+    }
+    void xbarCreditsChanged(int port, int vc) {
+        if ( arb_tracks_state ) arb->xbarCreditsChanged(port, vc);
+    }
     int const* getOutputBufferCredits() {return xbar_in_credits;}
     int const* getOutputQueueLengths() {return output_queue_lengths;}
 
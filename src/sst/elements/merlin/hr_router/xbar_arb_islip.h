@@ -0,0 +1,378 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_ISLIP_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_ISLIP_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+
+#include <stdint.h>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+namespace Merlin {
+
+/*
+ * iSLIP style arbitration over bitmasks.
+ *
+ * Rather than walk every (port, VC) pair each cycle, the arbiter keeps, for
+ * each output, a bitmask of the inputs with a head event that could move to
+ * it now (the output VC it needs has enough credits). The router reports
+ * every change of a VC head and of the crossbar credits, so the bitmasks are
+ * updated a few times per packet instead of being rebuilt every cycle. Heads
+ * waiting on the same output VC are kept on a list so a credit change only
+ * looks at the events it affects.
+ *
+ * Each cycle free outputs grant to the first eligible free input at or after
+ * their grant pointer, inputs accept the first grant at or after their accept
+ * pointer, and this repeats among the unmatched ports until no more matches
+ * are made, so the match is maximal like the one xbar_arb_lru finds. Pointers
+ * move past the matched port only for matches made in the first round, which
+ * gives inputs and outputs round robin service. Between the VCs of an input
+ * the least recently served one goes first, so no VC is starved.
+ */
+class xbar_arb_islip : public XbarArbitration {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        xbar_arb_islip,
+        "merlin",
+        "xbar_arb_islip",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "iSLIP arbitration unit for hr_router, tracks port state in bitmasks",
+        SST::Merlin::XbarArbitration
+    )
+
+
+private:
+    typedef uint64_t word_t;
+    static const int word_bits = 64;
+
+    int num_ports;
+    int num_vcs;
+    int port_words;     // Words in a bitmask over ports
+    int vc_words;       // Words in a bitmask over VCs
+
+    internal_router_event** vc_heads;
+    int const* xbar_in_credits;
+
+    // Head events, indexed by port * num_vcs + vc
+    std::vector<int> head_target;       // Output port, -1 if the VC is empty
+    std::vector<int> head_target_vc;
+    std::vector<int> head_flits;
+    std::vector<int> wait_next;         // Heads waiting on the same output VC
+    std::vector<int> wait_prev;
+    std::vector<int> wait_list;         // [out_port * num_vcs + vc], first head waiting on it
+
+    std::vector<int> ready_count;       // Head events on each input
+    std::vector<word_t> eligible_vcs;   // [port * vc_words], heads with credits to move
+    std::vector<uint16_t> eligible_count; // [out_port * num_ports + port]
+    std::vector<word_t> requests;       // [out_port * port_words], inputs with an eligible head for out_port
+    std::vector<int> out_requests;      // Eligible heads for each output
+    std::vector<word_t> active_out;     // Outputs with out_requests > 0
+
+    std::vector<int> grant_ptr;
+    std::vector<int> accept_ptr;
+    std::vector<uint64_t> last_served; // Match number each VC last moved on
+    uint64_t matches;
+
+    // Scratch space for arbitrate()
+    std::vector<word_t> free_in;
+    std::vector<word_t> free_out;
+    std::vector<word_t> waiting;        // Free inputs with something to send
+    std::vector<word_t> candidates;
+    std::vector<word_t> grants;         // [port * port_words], outputs granting to port
+    std::vector<int> grant_vc;          // VC granted by each output
+    std::vector<int> granted;           // Inputs with a grant this round
+
+    static inline int findFirst(const word_t* mask, int words) {
+        for ( int w = 0; w < words; w++ ) {
+            if ( mask[w] ) return w * word_bits + __builtin_ctzll(mask[w]);
+        }
+        return -1;
+    }
+
+    // First set bit at or after start, wrapping around to the beginning
+    static inline int findFrom(const word_t* mask, int words, int start) {
+        int w = start / word_bits;
+        word_t bits = mask[w] & (~(word_t)0 << (start % word_bits));
+        if ( bits ) return w * word_bits + __builtin_ctzll(bits);
+        for ( int i = w + 1; i < words; i++ ) {
+            if ( mask[i] ) return i * word_bits + __builtin_ctzll(mask[i]);
+        }
+        return findFirst(mask, w + 1);
+    }
+
+    static inline void setBit(word_t* mask, int bit) { mask[bit / word_bits] |= (word_t)1 << (bit % word_bits); }
+    static inline void clearBit(word_t* mask, int bit) { mask[bit / word_bits] &= ~((word_t)1 << (bit % word_bits)); }
+    static inline bool testBit(const word_t* mask, int bit) { return (mask[bit / word_bits] >> (bit % word_bits)) & 1; }
+
+    void setEligible(int port, int vc, bool eligible) {
+        word_t* vcs = &eligible_vcs[port * vc_words];
+        if ( testBit(vcs, vc) == eligible ) return;
+
+        int target = head_target[port * num_vcs + vc];
+        if ( eligible ) {
+            setBit(vcs, vc);
+            if ( eligible_count[target * num_ports + port]++ == 0 ) setBit(&requests[target * port_words], port);
+            if ( out_requests[target]++ == 0 ) setBit(active_out.data(), target);
+        }
+        else {
+            clearBit(vcs, vc);
+            if ( --eligible_count[target * num_ports + port] == 0 ) clearBit(&requests[target * port_words], port);
+            if ( --out_requests[target] == 0 ) clearBit(active_out.data(), target);
+        }
+    }
+
+    // Least recently served eligible VC on in_port whose head is bound for out_port
+    int pickVC(int in_port, int out_port) {
+        const word_t* vcs = &eligible_vcs[in_port * vc_words];
+        int best = -1;
+        uint64_t best_time = 0;
+        for ( int w = 0; w < vc_words; w++ ) {
+            word_t bits = vcs[w];
+            while ( bits ) {
+                int vc = w * word_bits + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                int index = in_port * num_vcs + vc;
+                if ( head_target[index] == out_port && (best == -1 || last_served[index] < best_time) ) {
+                    best = vc;
+                    best_time = last_served[index];
+                }
+            }
+        }
+        return best;
+    }
+
+public:
+
+    xbar_arb_islip(ComponentId_t cid, Params& params) :
+        XbarArbitration(cid),
+        vc_heads(NULL),
+        xbar_in_credits(NULL)
+    {
+    }
+
+    ~xbar_arb_islip() {
+    }
+
+    void setPorts(int num_ports_s, int num_vcs_s) {
+        num_ports = num_ports_s;
+        num_vcs = num_vcs_s;
+        port_words = (num_ports + word_bits - 1) / word_bits;
+        vc_words = (num_vcs + word_bits - 1) / word_bits;
+
+        int entries = num_ports * num_vcs;
+        head_target.assign(entries, -1);
+        head_target_vc.assign(entries, 0);
+        head_flits.assign(entries, 0);
+        wait_next.assign(entries, -1);
+        wait_prev.assign(entries, -1);
+        wait_list.assign(entries, -1);
+
+        ready_count.assign(num_ports, 0);
+        eligible_vcs.assign(num_ports * vc_words, 0);
+        eligible_count.assign(num_ports * num_ports, 0);
+        requests.assign(num_ports * port_words, 0);
+        out_requests.assign(num_ports, 0);
+        active_out.assign(port_words, 0);
+
+        grant_ptr.assign(num_ports, 0);
+        accept_ptr.assign(num_ports, 0);
+        last_served.assign(entries, 0);
+        matches = 0;
+
+        free_in.assign(port_words, 0);
+        free_out.assign(port_words, 0);
+        waiting.assign(port_words, 0);
+        candidates.assign(port_words, 0);
+        grants.assign(num_ports * port_words, 0);
+        grant_vc.assign(num_ports, -1);
+        granted.reserve(num_ports);
+    }
+
+    bool tracksPortState() { return true; }
+
+    void setPortState(internal_router_event** vc_heads_in, int const* xbar_in_credits_in) {
+        vc_heads = vc_heads_in;
+        xbar_in_credits = xbar_in_credits_in;
+    }
+
+    void vcHeadChanged(int port, int vc) {
+        int index = port * num_vcs + vc;
+
+        // Retire the old head
+        if ( head_target[index] != -1 ) {
+            setEligible(port, vc, false);
+            if ( wait_prev[index] != -1 ) wait_next[wait_prev[index]] = wait_next[index];
+            else wait_list[head_target[index] * num_vcs + head_target_vc[index]] = wait_next[index];
+            if ( wait_next[index] != -1 ) wait_prev[wait_next[index]] = wait_prev[index];
+            head_target[index] = -1;
+            ready_count[port]--;
+        }
+
+        internal_router_event* ev = vc_heads[index];
+        if ( ev == NULL ) return;
+
+        int target = ev->getNextPort();
+        int target_vc = ev->getVC();
+        int out_index = target * num_vcs + target_vc;
+        head_target[index] = target;
+        head_target_vc[index] = target_vc;
+        head_flits[index] = ev->getFlitCount();
+        ready_count[port]++;
+
+        wait_prev[index] = -1;
+        wait_next[index] = wait_list[out_index];
+        if ( wait_list[out_index] != -1 ) wait_prev[wait_list[out_index]] = index;
+        wait_list[out_index] = index;
+
+        setEligible(port, vc, xbar_in_credits[out_index] >= head_flits[index]);
+    }
+
+    void xbarCreditsChanged(int port, int vc) {
+        int out_index = port * num_vcs + vc;
+        int credits = xbar_in_credits[out_index];
+        for ( int index = wait_list[out_index]; index != -1; index = wait_next[index] ) {
+            setEligible(index / num_vcs, index % num_vcs, credits >= head_flits[index]);
+        }
+    }
+
+    // Naming convention is from point of view of the xbar.  So,
+    // in_port_busy is >0 if someone is writing to that xbar port and
+    // out_port_busy is >0 if that xbar port being read.
+    void arbitrate(
+#if VERIFY_DECLOCKING
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, bool clocking
+#else
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc
+#endif
+                   )
+    {
+        for ( int w = 0; w < port_words; w++ ) {
+            free_in[w] = 0;
+            free_out[w] = 0;
+        }
+        for ( int i = 0; i < num_ports; i++ ) {
+            progress_vc[i] = -1;
+            if ( in_port_busy[i] <= 0 && ready_count[i] > 0 ) setBit(free_in.data(), i);
+            if ( out_port_busy[i] <= 0 ) setBit(free_out.data(), i);
+        }
+
+        // Remember who had something to send so stalls can be reported
+        bool any_waiting = false;
+        for ( int w = 0; w < port_words; w++ ) {
+            waiting[w] = free_in[w];
+            any_waiting |= free_in[w] != 0;
+        }
+        if ( !any_waiting ) return;
+
+        for ( int w = 0; w < port_words; w++ ) {
+            free_out[w] &= active_out[w];
+        }
+
+        for ( bool first_round = true; ; first_round = false ) {
+            // Grant: each free output picks a free input that can send to it
+            granted.clear();
+            for ( int w = 0; w < port_words; w++ ) {
+                word_t outs = free_out[w];
+                while ( outs ) {
+                    int out_port = w * word_bits + __builtin_ctzll(outs);
+                    outs &= outs - 1;
+
+                    const word_t* req = &requests[out_port * port_words];
+                    word_t* cand = candidates.data();
+                    bool any = false;
+                    for ( int i = 0; i < port_words; i++ ) {
+                        cand[i] = req[i] & free_in[i];
+                        any |= cand[i] != 0;
+                    }
+                    if ( !any ) {
+                        // Nothing left that can use this output this cycle
+                        clearBit(free_out.data(), out_port);
+                        continue;
+                    }
+
+                    int in_port = findFrom(cand, port_words, grant_ptr[out_port]);
+                    word_t* in_grants = &grants[in_port * port_words];
+                    if ( findFirst(in_grants, port_words) == -1 ) granted.push_back(in_port);
+                    setBit(in_grants, out_port);
+                    grant_vc[out_port] = pickVC(in_port, out_port);
+                }
+            }
+
+            if ( granted.empty() ) break;
+
+            // Accept: each input takes one of its grants
+            for ( int in_port : granted ) {
+                word_t* in_grants = &grants[in_port * port_words];
+                int out_port = findFrom(in_grants, port_words, accept_ptr[in_port]);
+                for ( int w = 0; w < port_words; w++ ) in_grants[w] = 0;
+
+                int vc = grant_vc[out_port];
+                int flits = vc_heads[in_port * num_vcs + vc]->getFlitCount();
+
+                // Tell the router what to move
+                progress_vc[in_port] = vc;
+                last_served[in_port * num_vcs + vc] = ++matches;
+
+                // Need to set the busy values
+                in_port_busy[in_port] = flits;
+                out_port_busy[out_port] = flits;
+
+                clearBit(free_in.data(), in_port);
+                clearBit(free_out.data(), out_port);
+
+                if ( first_round ) {
+                    grant_ptr[out_port] = in_port + 1 == num_ports ? 0 : in_port + 1;
+                    accept_ptr[in_port] = out_port + 1 == num_ports ? 0 : out_port + 1;
+                }
+            }
+        }
+
+        // Inputs that had packets but could not move any of them
+        for ( int w = 0; w < port_words; w++ ) {
+            word_t stalled = free_in[w] & waiting[w];
+            while ( stalled ) {
+                progress_vc[w * word_bits + __builtin_ctzll(stalled)] = -2;
+                stalled &= stalled - 1;
+            }
+        }
+    }
+
+    void reportSkippedCycles(Cycle_t cycles) {
+    }
+
+    void dumpState(std::ostream& stream) {
+        stream << "  Pointers by port (grant, accept):" << std::endl;
+        for ( int i = 0; i < num_ports; i++ ) {
+            stream << i << ": " << grant_ptr[i] << ", " << accept_ptr[i]
+                   << " (" << ready_count[i] << " VCs waiting)" << std::endl;
+        }
+    }
+
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_ISLIP_H
@@ -0,0 +1,345 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "flowLinkControl.h"
+
+#include "merlin.h"
+
+namespace SST {
+using namespace Interfaces;
+
+namespace Merlin {
+
+FlowLinkControl::FlowLinkControl(ComponentId_t cid, Params &params, int vns) :
+    SST::Interfaces::SimpleNetwork(cid),
+    rtr_link(nullptr), flow_timing(nullptr), network(nullptr),
+    req_vns(vns), id(-1), logical_nid(-1), use_nid_map(false), network_initialized(false),
+    receiveFunctor(nullptr), sendFunctor(nullptr)
+{
+    // The flow network is shared through process memory
+    if ( getNumRanks().rank > 1 || getNumRanks().thread > 1 ) {
+        merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: flow networks only run on a single rank and thread\n");
+    }
+
+    // Get the link bandwidth
+    link_bw = params.find<UnitAlgebra>("link_bw");
+    if ( !link_bw.hasUnits("B/s") && !link_bw.hasUnits("b/s") ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: link_bw must be specified in either B/s or b/s (SI prefix also allowed)\n");
+    }
+
+    if ( link_bw.hasUnits("B/s") ) {
+        link_bw *= UnitAlgebra("8b/B");
+    }
+
+    outbuf_size = params.find<UnitAlgebra>("output_buf_size","1kB");
+    if ( !outbuf_size.hasUnits("b") && !outbuf_size.hasUnits("B") ) {
+        merlin_abort.fatal(CALL_INFO,-1,"out_buf_size must be specified in either "
+                           "bits or bytes: %s\n",outbuf_size.toStringBestSI().c_str());
+    }
+    if ( outbuf_size.hasUnits("B") ) outbuf_size *= UnitAlgebra("8b/B");
+
+    // See if we need to set up a nid map
+    bool found = false;
+    int job_id = params.find<int>("job_id",-1,found);
+    use_nid_map = params.find<bool>("use_nid_remap",false);
+    std::string nid_map_name;
+    if ( found ) {
+        if ( use_nid_map ) nid_map_name = std::string("job_") + std::to_string(job_id) + "_nid_map";
+    }
+    else {
+        nid_map_name = params.find<std::string>("nid_map_name",std::string());
+        use_nid_map = !nid_map_name.empty();
+    }
+    if ( use_nid_map ) {
+        int job_size = params.find<int>("job_size",-1);
+        if ( job_size == -1 ) {
+            merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: job_size must be set when using a nid map\n");
+        }
+        logical_nid = params.find<nid_t>("logical_nid",-1);
+        if ( logical_nid == -1 ) {
+            merlin_abort.fatal(CALL_INFO,1,"FlowLinkControl: logical_nid must be set when using a nid map\n");
+        }
+        nid_map.initialize(nid_map_name, job_size * sizeof(nid_t));
+    }
+
+    network = FlowNetwork::getNetwork(params.find<std::string>("network_name","network"));
+    network->setCoreTimeBase(getCoreTimeBase().getDoubleValue());
+
+    // Need to get the right port_name
+    std::string port_name("rtr_port");
+    if ( isAnonymous() ) {
+        port_name = params.find<std::string>("port_name");
+    }
+
+    rtr_link = configureLink(port_name, std::string("1GHz"), new Event::Handler<FlowLinkControl>(this,&FlowLinkControl::handle_input));
+
+    flow_timing = configureSelfLink(port_name + "_flow_timing", getCoreTimeBase().toString(),
+            new Event::Handler<FlowLinkControl>(this,&FlowLinkControl::handle_flow));
+
+    send_queues.resize(req_vns);
+    vn_busy.resize(req_vns, false);
+    send_times.resize(req_vns);
+    output_space.resize(req_vns, outbuf_size.getRoundedValue());
+    input_queues.resize(req_vns);
+
+    // Register statistics
+    packet_latency = registerStatistic<uint64_t>("packet_latency");
+    send_bit_count = registerStatistic<uint64_t>("send_bit_count");
+}
+
+FlowLinkControl::~FlowLinkControl()
+{
+    FlowNetwork::releaseNetwork(network);
+}
+
+void FlowLinkControl::setup()
+{
+    while ( init_events.size() ) {
+        delete init_events.front();
+        init_events.pop_front();
+    }
+}
+
+RtrInitEvent* FlowLinkControl::checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func)
+{
+    bool good = true;
+    RtrInitEvent* init_ev = nullptr;
+    // Check to make sure the event isn't null and that it is an init event
+    if ( nullptr == ev || static_cast<BaseRtrEvent*>(ev)->getType() != BaseRtrEvent::INITIALIZATION ) good = false;
+
+    if ( good ) {
+        init_ev = static_cast<RtrInitEvent*>(ev);
+
+        // Now check to make sure this is the right protocol event
+        if ( init_ev->command != command ) {
+            good = false;
+        }
+    }
+
+    sst_assert(good, line, file, func, 1, "Error during FlowLinkControl protocol initialization.  The most likely cause of this is connecting the endpoint to something other than a merlin.flow_router.\n");
+    return init_ev;
+}
+
+void FlowLinkControl::init(unsigned int phase)
+{
+    Event* ev;
+    RtrInitEvent* init_ev;
+    switch ( phase ) {
+    case 0:
+    {
+        // Negotiate link speed.  We will take the min of the two link speeds
+        init_ev = new RtrInitEvent();
+        init_ev->command = RtrInitEvent::REPORT_BW;
+        init_ev->ua_value = link_bw;
+        rtr_link->sendUntimedData(init_ev);
+    }
+        break;
+    case 1:
+    {
+        ev = rtr_link->recvUntimedData();
+        init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_BW, CALL_INFO);
+        if ( link_bw > init_ev->ua_value ) link_bw = init_ev->ua_value;
+        delete ev;
+
+        ev = rtr_link->recvUntimedData();
+        init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_ID, CALL_INFO);
+        id = init_ev->int_value;
+        if ( logical_nid == -1 ) logical_nid = id;
+        // If we have a nid_map, fill in my mapping
+        if ( use_nid_map ) {
+            nid_map.write(logical_nid,id);
+            nid_map.publish();
+        }
+        delete ev;
+
+        network->addEndpoint(id, this, link_bw.getDoubleValue());
+        network_initialized = true;
+    }
+        break;
+    default:
+        recvInitEvents();
+        break;
+    }
+}
+
+void FlowLinkControl::complete(unsigned int phase)
+{
+    recvInitEvents();
+}
+
+// Events other than the link protocol get passed up to the containing
+// component through the init_events queue
+void FlowLinkControl::recvInitEvents()
+{
+    Event* ev;
+    while ( ( ev = rtr_link->recvUntimedData() ) != nullptr ) {
+        BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+        if ( bev->getType() != BaseRtrEvent::PACKET ) {
+            merlin_abort_full.fatal(CALL_INFO, 1, "Reached state where a non-RtrEvent was not handled.");
+        }
+        init_events.push_back(static_cast<RtrEvent*>(ev));
+    }
+}
+
+void FlowLinkControl::finish(void)
+{
+    // Clean up all the events left in the queues.  This will help
+    // track down real memory leaks as all this events won't be in the
+    // way.
+    for ( int i = 0; i < req_vns; i++ ) {
+        while ( !input_queues[i].empty() ) {
+            delete input_queues[i].front();
+            input_queues[i].pop();
+        }
+        while ( !send_queues[i].empty() ) {
+            delete send_queues[i].front();
+            send_queues[i].pop();
+        }
+    }
+}
+
+
+// Returns true if there is space in the output buffer and false
+// otherwise.
+bool FlowLinkControl::send(SimpleNetwork::Request* req, int vn) {
+    // Check to see if the VN is in range
+    if ( vn >= req_vns ) return false;
+    if ( output_space[vn] < (int64_t)req->size_in_bits ) return false;
+
+    req->vn = vn;
+    // Check to see if we need to do a nid translation
+    if ( use_nid_map ) req->dest = nid_map[req->dest];
+
+    output_space[vn] -= req->size_in_bits;
+    send_times[vn].push(getCurrentSimTimeNano());
+    send_queues[vn].push(req);
+    if ( !vn_busy[vn] ) startFlow(vn);
+    return true;
+}
+
+void FlowLinkControl::startFlow(int vn)
+{
+    SimpleNetwork::Request* req = send_queues[vn].front();
+    send_queues[vn].pop();
+    vn_busy[vn] = true;
+    network->startFlow(this, id, req, vn, getCurrentSimCycle());
+}
+
+// Called when the last bit of a request leaves the bottleneck link
+void FlowLinkControl::flowFinished(Flow* flow)
+{
+    int vn = flow->vn;
+    SimpleNetwork::Request* req = flow->req;
+    flow->req = nullptr;
+
+    FlowEvent* ev = new FlowEvent(FlowEvent::DELIVER);
+    ev->req = req;
+    ev->start_time = send_times[vn].front();
+    send_times[vn].pop();
+    flow->dest->sendFlowEvent(flow->latency, ev);
+
+    send_bit_count->addData(req->size_in_bits);
+    output_space[vn] += req->size_in_bits;
+
+    if ( send_queues[vn].empty() ) vn_busy[vn] = false;
+    else startFlow(vn);
+
+    if ( sendFunctor != nullptr ) {
+        bool keep = (*sendFunctor)(vn);
+        if ( !keep ) sendFunctor = nullptr;
+    }
+}
+
+
+// Returns true if there is space in the output buffer and false
+// otherwise.
+bool FlowLinkControl::spaceToSend(int vn, int bits) {
+    return output_space[vn] >= bits;
+}
+
+
+// Returns nullptr if no event in input_buf[vn]. Otherwise, returns
+// the next event.
+SST::Interfaces::SimpleNetwork::Request* FlowLinkControl::recv(int vn) {
+    if ( input_queues[vn].empty() ) return nullptr;
+
+    SST::Interfaces::SimpleNetwork::Request* ret = input_queues[vn].front();
+    input_queues[vn].pop();
+    if ( use_nid_map ) ret->dest = logical_nid;
+    return ret;
+}
+
+void FlowLinkControl::sendUntimedData(SST::Interfaces::SimpleNetwork::Request* req)
+{
+    if ( use_nid_map && req->dest != SimpleNetwork::INIT_BROADCAST_ADDR ) {
+        req->dest = nid_map[req->dest];
+    }
+    rtr_link->sendUntimedData(new RtrEvent(req,id,0));
+}
+
+SST::Interfaces::SimpleNetwork::Request* FlowLinkControl::recvUntimedData()
+{
+    if ( init_events.size() ) {
+        RtrEvent *ev = init_events.front();
+        init_events.pop_front();
+        SST::Interfaces::SimpleNetwork::Request* ret = ev->takeRequest();
+        delete ev;
+        return ret;
+    } else {
+        return nullptr;
+    }
+}
+
+
+void FlowLinkControl::handle_input(Event* ev)
+{
+    // flow_routers only use the links during init and complete
+    merlin_abort.fatal(CALL_INFO, -1, "FlowLinkControl %" PRI_NID ": received an event from the router during simulation\n", id);
+}
+
+void FlowLinkControl::handle_flow(Event* ev)
+{
+    FlowEvent* fe = static_cast<FlowEvent*>(ev);
+    switch ( fe->type ) {
+    case FlowEvent::RECOMPUTE:
+        network->recompute(getCurrentSimCycle());
+        break;
+    case FlowEvent::FINISH:
+        network->finishFlow(fe->flow, fe->version, getCurrentSimCycle());
+        break;
+    case FlowEvent::DELIVER:
+    {
+        int vn = fe->req->vn;
+        if ( vn >= req_vns ) {
+            merlin_abort.fatal(CALL_INFO, -1, "FlowLinkControl %" PRI_NID ": received a request on VN %d, but only %d VNs are in use\n",
+                               id, vn, req_vns);
+        }
+        packet_latency->addData(getCurrentSimTimeNano() - fe->start_time);
+        input_queues[vn].push(fe->req);
+        if ( receiveFunctor != nullptr ) {
+            bool keep = (*receiveFunctor)(vn);
+            if ( !keep) receiveFunctor = nullptr;
+        }
+    }
+        break;
+    }
+    delete ev;
+}
+
+}
+}
@@ -0,0 +1,170 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOWLINKCONTROL_H
+#define COMPONENTS_MERLIN_FLOWLINKCONTROL_H
+
+#include <sst/core/subcomponent.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <sst/core/interfaces/simpleNetwork.h>
+
+#include <sst/core/statapi/statbase.h>
+#include <sst/core/shared/sharedArray.h>
+
+#include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/flow/flow_network.h"
+
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// SimpleNetwork interface for networks of flow_routers.  Each request
+// is a flow through the shared FlowNetwork model instead of a packet
+// moving hop by hop, so endpoints can trade packet level detail for
+// speed by swapping merlin.linkcontrol for this subcomponent.
+class FlowLinkControl : public SST::Interfaces::SimpleNetwork {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        FlowLinkControl,
+        "merlin",
+        "flowlinkcontrol",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Link Control module that models the network as flows for NICs attached to merlin.flow_router",
+        SST::Interfaces::SimpleNetwork
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"port_name",          "Port name to connect to.  Only used when loaded anonymously",""},
+        {"link_bw",            "Bandwidth of the links specified in either b/s or B/s (can include SI prefix)."},
+        {"output_buf_size",    "Size of output buffers specified in b or B (can include SI prefix).  Sends wait for space until earlier requests finish.", "1kB"},
+        {"network_name",       "Name of the flow network.  Must match network_name of the flow_routers.", "network"},
+        {"job_id",             "ID of the job this enpoint is part of.", "" },
+        {"job_size",           "Number of nodes in the job this endpoint is part of.",""},
+        {"logical_nid",        "My logical NID", "" },
+        {"use_nid_remap",      "If true, will remap logical nids in job to physical ids", "false" },
+        {"nid_map_name",       "Base name of shared region where my NID map will be located.  If empty, no NID map will be used.",""},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "packet_latency",     "Histogram of latencies for received packets", "latency", 1},
+        { "send_bit_count",     "Count number of bits sent on link", "bits", 1},
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"rtr_port", "Port that connects to router", { "merlin.RtrEvent" } },
+    )
+
+
+private:
+
+    typedef std::queue<SST::Interfaces::SimpleNetwork::Request*> request_queue_t;
+
+    // Link to router.  Only used during init and complete, data moves
+    // through the flow network.
+    Link* rtr_link;
+    // Self link the flow network schedules flow events on
+    Link* flow_timing;
+
+    FlowNetwork* network;
+
+    UnitAlgebra link_bw;
+    UnitAlgebra outbuf_size;
+
+    int req_vns;
+    nid_t id;
+    nid_t logical_nid;
+    Shared::SharedArray<nid_t> nid_map;
+    bool use_nid_map;
+    bool network_initialized;
+
+    // Requests waiting behind the flow in progress on each VN.  A VN
+    // sends one request at a time, like the output queues of
+    // LinkControl.
+    std::vector<request_queue_t> send_queues;
+    std::vector<bool> vn_busy;
+    // Times (in ns) the in progress and waiting requests were sent
+    std::vector<std::queue<SimTime_t> > send_times;
+    // Bits of output buffer not yet used on each VN
+    std::vector<int64_t> output_space;
+
+    std::vector<request_queue_t> input_queues;
+
+    // Initialization events received from network
+    std::deque<RtrEvent*> init_events;
+
+    // Functors for notifying the parent when there is more space in
+    // output queue or when a new packet arrives
+    HandlerBase* receiveFunctor;
+    HandlerBase* sendFunctor;
+
+    Statistic<uint64_t>* packet_latency;
+    Statistic<uint64_t>* send_bit_count;
+
+    RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func);
+    void recvInitEvents();
+    void startFlow(int vn);
+    void handle_input(Event* ev);
+    void handle_flow(Event* ev);
+
+public:
+    FlowLinkControl(ComponentId_t cid, Params &params, int vns);
+
+    ~FlowLinkControl();
+
+    void setup();
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void finish();
+
+    bool send(SST::Interfaces::SimpleNetwork::Request* req, int vn);
+    bool spaceToSend(int vn, int bits);
+    SST::Interfaces::SimpleNetwork::Request* recv(int vn);
+    bool requestToReceive( int vn ) { return ! input_queues[vn].empty(); }
+
+    void sendUntimedData(SST::Interfaces::SimpleNetwork::Request* ev);
+    SST::Interfaces::SimpleNetwork::Request* recvUntimedData();
+
+    inline void setNotifyOnReceive(HandlerBase* functor) { receiveFunctor = functor; }
+    inline void setNotifyOnSend(HandlerBase* functor) { sendFunctor = functor; }
+
+    inline bool isNetworkInitialized() const { return network_initialized; }
+    inline nid_t getEndpointID() const {
+        if ( use_nid_map ) {
+            return logical_nid;
+        }
+        else {
+            return id;
+        }
+    }
+    inline const UnitAlgebra& getLinkBW() const { return link_bw; }
+
+    // Used by FlowNetwork
+    void sendFlowEvent(SimTime_t delay, FlowEvent* ev) { flow_timing->send(delay, ev); }
+    void flowFinished(Flow* flow);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOWLINKCONTROL_H
@@ -539,9 +539,19 @@ void LinkControl::handle_input(Event* ev)
     // credit_event* ce = dynamic_cast<credit_event*>(ev);
     // if ( ce != nullptr ) {
     BaseRtrEvent* base_event = static_cast<BaseRtrEvent*>(ev);
-    if ( base_event->getType() == BaseRtrEvent::CREDIT ) {
-    	credit_event* ce = static_cast<credit_event*>(ev);
-        router_credits[ce->vc] += ce->credits;
+    if ( base_event->getType() == BaseRtrEvent::CREDIT ||
+         base_event->getType() == BaseRtrEvent::CREDIT_BATCH ) {
+        if ( base_event->getType() == BaseRtrEvent::CREDIT ) {
+            credit_event* ce = static_cast<credit_event*>(ev);
+            router_credits[ce->vc] += ce->credits;
+        }
+        else {
+            // Router port is coalescing its credit returns
+            credit_batch_event* cbe = static_cast<credit_batch_event*>(ev);
+            for ( size_t i = 0; i < cbe->vcs.size(); i++ ) {
+                router_credits[cbe->vcs[i]] += cbe->credits[i];
+            }
+        }
         delete ev;
 
         // If we're waiting, we need to send a wakeup event to the
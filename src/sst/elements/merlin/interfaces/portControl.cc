@@ -20,6 +20,9 @@
 #include "output_arb_basic.h"
 #include "output_arb_qos_multi.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define TRACK 0
 #define TRACK_ID 131
 #define TRACK_PORT 4
@@ -75,6 +78,7 @@ PortControl::send(internal_router_event* ev, int vc)
 #endif
 
 	xbar_in_credits[vc] -= ev->getFlitCount();
+	parent->xbarCreditsChanged(port_number, vc);
     if ( oql_track_port ) {
         int flits = ev->getFlitCount();
         for ( int i = 0; i < num_vcs; ++i ) {
@@ -128,6 +132,7 @@ PortControl::recv(int vc)
         topo->route_packet(port_number, event->getVC(), event);
 	    vc_heads[vc] = input_buf[vc].front();
 	}
+	parent->vcHeadChanged(port_number, vc);
 
     int vc_return = topo->isHostPort(port_number) ? event->getCreditReturnVC() : vc;
 	// Figure out how many credits to return
@@ -135,9 +140,15 @@ PortControl::recv(int vc)
 
 	// For now, we're just going to send the credits back to the
 	// other side.  The required BW to do this will not be taken
-	// into account.
-	port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
-	port_ret_credits[vc_return] = 0;
+	// into account.  When coalescing, they go back in
+	// flushCredits() instead.
+    if ( coalesce_credits ) {
+        ret_credits_pending = true;
+    }
+    else {
+        port_link->send(1,new credit_event(vc_return,port_ret_credits[vc_return]));
+        port_ret_credits[vc_return] = 0;
+    }
 
 #if TRACK
     if ( rtr_id == TRACK_ID && port_number == TRACK_PORT ) {
@@ -147,6 +158,52 @@ PortControl::recv(int vc)
     return event;
 }
 
+void
+PortControl::flushCredits()
+{
+    if ( !ret_credits_pending ) return;
+    ret_credits_pending = false;
+
+    // A single VC goes back as a plain credit_event
+    int num_pending = 0;
+    int last_vc = -1;
+    for ( int i = 0; i < num_vcs; i++ ) {
+        if ( port_ret_credits[i] != 0 ) {
+            num_pending++;
+            last_vc = i;
+        }
+    }
+
+    if ( num_pending == 1 ) {
+        port_link->send(1,new credit_event(last_vc,port_ret_credits[last_vc]));
+        port_ret_credits[last_vc] = 0;
+        return;
+    }
+
+    credit_batch_event* cbe = new credit_batch_event();
+    for ( int i = 0; i < num_vcs; i++ ) {
+        if ( port_ret_credits[i] != 0 ) {
+            cbe->add(i,port_ret_credits[i]);
+            port_ret_credits[i] = 0;
+        }
+    }
+    port_link->send(1,cbe);
+}
+
+void
+PortControl::setBackgroundUtilization(double util)
+{
+    background_util = util;
+    if ( util <= 0.0 ) return;
+
+    // Background packets form an M/D/1 queue on the link.  A packet
+    // that finds it busy waits S/(2(1-util)) on average.
+    background_wait = background_packet_flits / (2.0 * (1.0 - util));
+    if ( background_rng == nullptr ) {
+        background_rng = new RNG::XORShiftRNG(rtr_id * 1024 + port_number + 1);
+    }
+}
+
 void
 PortControl::reportIncomingEvent(internal_router_event* ev)
 {
@@ -237,6 +294,7 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     output_buf_count(NULL),
     port_ret_credits(NULL),
     port_out_credits(NULL),
+    ret_credits_pending(false),
     idle_start(0),
 	sai_win_start(0),
 	sai_port_disabled(false),
@@ -251,7 +309,11 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     cm_activated(false),
     current_incast(0),
     total_flits_incoming(0),
-    total_incast_flits(0)
+    total_incast_flits(0),
+    background_util(0.0),
+    background_wait(0.0),
+    background_carry(0.0),
+    background_rng(nullptr)
 {
     // Process the parameters
 
@@ -400,6 +462,10 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     cm_incast_threshold = params.find<int>("cm_incast_threshold", 6);
     cm_window_factor = 1.5;
 
+    UnitAlgebra background_packet_size = params.find<UnitAlgebra>("background_packet_size","64B");
+    if ( background_packet_size.hasUnits("B") ) background_packet_size *= UnitAlgebra("8b/B");
+    background_packet_flits = std::ceil((background_packet_size / flit_size).getDoubleValue());
+
     // Register statistics
     std::string port_name("port");
     port_name = port_name + std::to_string(port_number);
@@ -442,6 +508,7 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     // Unless otherwise stated, we will turn on track port if we are a host port
     oql_track_port = params.find<bool>("oql_track_port",host_port);
     oql_track_remote = params.find<bool>("oql_track_remote",false);
+    coalesce_credits = params.find<bool>("coalesce_credits",false);
 
 
 
@@ -549,6 +616,7 @@ PortControl::~PortControl() {
     if ( output_buf_count != NULL ) delete [] output_buf_count;
     if ( port_ret_credits != NULL ) delete [] port_ret_credits;
     if ( port_out_credits != NULL ) delete [] port_out_credits;
+    if ( background_rng != nullptr ) delete background_rng;
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         delete network_inspectors[i];
     }
@@ -901,6 +969,42 @@ PortControl::dumpQueueState(port_queue_t& q, Output& out) {
 	}
 }
 
+// Credits returned by the other side of the link.  Host ports also
+// take them off the output queue lengths when tracking the remote
+// input queue.
+void
+PortControl::add_out_credits(int vc, int credits)
+{
+    port_out_credits[vc] += credits;
+
+    if ( host_port && oql_track_remote ) {
+        if ( oql_track_port ) {
+            for ( int i = 0; i < num_vcs; ++i ) {
+                output_queue_lengths[i] -= credits;
+            }
+        }
+        else {
+            output_queue_lengths[vc] -= credits;
+        }
+    }
+}
+
+void
+PortControl::wake_on_credits()
+{
+    // If we're waiting, we need to send a wakeup event to the
+    // output queues
+    if ( waiting ) {
+        output_timing->send(1,NULL);
+        waiting = false;
+        // If we were stalled waiting for credits and we had
+        // packets, we need to add stall time
+        if ( have_packets) {
+            output_port_stalls->addData(getCurrentSimCycle() - start_block);
+        }
+    }
+}
+
 void
 PortControl::handle_input_n2r(Event* ev)
 {
@@ -912,32 +1016,19 @@ PortControl::handle_input_n2r(Event* ev)
 	case BaseRtrEvent::CREDIT:
     {
 	    credit_event* ce = static_cast<credit_event*>(ev);
-	    port_out_credits[ce->vc] += ce->credits;
-
-        if ( oql_track_remote ) {
-            if ( oql_track_port ) {
-                for ( int i = 0; i < num_vcs; ++i ) {
-                    output_queue_lengths[i] -= ce->credits;
-                }
-            }
-            else {
-                output_queue_lengths[ce->vc] -= ce->credits;
-            }
-        }
-
+        add_out_credits(ce->vc, ce->credits);
         delete ce;
-
-	    // If we're waiting, we need to send a wakeup event to the
-	    // output queues
-	    if ( waiting ) {
-            output_timing->send(1,NULL);
-            waiting = false;
-            // If we were stalled waiting for credits and we had
-            // packets, we need to add stall time
-            if ( have_packets) {
-                output_port_stalls->addData(getCurrentSimCycle() - start_block);
-            }
-	    }
+        wake_on_credits();
+	}
+    break;
+	case BaseRtrEvent::CREDIT_BATCH:
+    {
+	    credit_batch_event* cbe = static_cast<credit_batch_event*>(ev);
+        for ( size_t i = 0; i < cbe->vcs.size(); i++ ) {
+            add_out_credits(cbe->vcs[i], cbe->credits[i]);
+        }
+        delete cbe;
+        wake_on_credits();
 	}
     break;
 	case BaseRtrEvent::PACKET:
@@ -961,6 +1052,7 @@ PortControl::handle_input_n2r(Event* ev)
             topo->route_packet(port_number, rtr_event->getVC(), rtr_event);
             vc_heads[curr_vc] = rtr_event;
             parent->inc_vcs_with_data();
+            parent->vcHeadChanged(port_number, curr_vc);
 	    }
 
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -1007,20 +1099,19 @@ PortControl::handle_input_r2r(Event* ev)
 	case BaseRtrEvent::CREDIT:
 	{
 	    credit_event* ce = static_cast<credit_event*>(ev);
-	    port_out_credits[ce->vc] += ce->credits;
-	    delete ce;
-
-	    // If we're waiting, we need to send a wakeup event to the
-	    // output queues
-	    if ( waiting ) {
-            output_timing->send(1,NULL);
-            waiting = false;
-            // If we were stalled waiting for credits and we had
-            // packets, we need to add stall time
-            if ( have_packets) {
-                output_port_stalls->addData(getCurrentSimCycle() - start_block);
-            }
-	    }
+        add_out_credits(ce->vc, ce->credits);
+        delete ce;
+        wake_on_credits();
+	}
+    break;
+	case BaseRtrEvent::CREDIT_BATCH:
+    {
+	    credit_batch_event* cbe = static_cast<credit_batch_event*>(ev);
+        for ( size_t i = 0; i < cbe->vcs.size(); i++ ) {
+            add_out_credits(cbe->vcs[i], cbe->credits[i]);
+        }
+        delete cbe;
+        wake_on_credits();
 	}
     break;
 	case BaseRtrEvent::PACKET:
@@ -1044,6 +1135,7 @@ PortControl::handle_input_r2r(Event* ev)
             topo->route_packet(port_number, event->getVC(), event);
             vc_heads[curr_vc] = event;
             parent->inc_vcs_with_data();
+            parent->vcHeadChanged(port_number, curr_vc);
 	    }
 
 	    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
@@ -1100,6 +1192,17 @@ PortControl::handle_output(Event* ev) {
     if ( !sai_port_disabled )
         vc_to_send = output_arb->arbitrate(getCurrentSimTime(flit_cycle),output_buf, port_out_credits, host_port, have_packets);
 
+    // If the port was idle, the link may still be busy with
+    // background traffic, in which case the packet waits behind it.
+    if ( vc_to_send != -1 && is_idle && background_util > 0.0 &&
+         background_rng->nextUniform() < background_util ) {
+        double wait = -background_wait * std::log(1.0 - background_rng->nextUniform());
+        idle_time->addData(getCurrentSimCycle() - idle_start);
+        is_idle = false;
+        output_timing->send((SimTime_t)std::max(1.0, std::round(wait)),NULL);
+        return;
+    }
+
     if ( vc_to_send != -1 ) {
         //  We found something to send
         internal_router_event* send_event = output_buf[vc_to_send].front();
@@ -1113,6 +1216,7 @@ PortControl::handle_output(Event* ev) {
 	    // Need to return credits to the output buffer
 	    int size = send_event->getFlitCount();
 	    xbar_in_credits[vc_to_send] += size;
+	    parent->xbarCreditsChanged(port_number, vc_to_send);
         if ( !oql_track_remote ) {
             if ( oql_track_port ) {
                 for ( int i = 0; i < num_vcs; ++i ) {
@@ -1125,7 +1229,16 @@ PortControl::handle_output(Event* ev) {
         }
 
 	    // Send an event to wake up again after this packet is sent.
-	    output_timing->send(size,NULL);
+	    // Background traffic sharing the link stretches the time the
+	    // packet holds it.
+        int busy = size;
+        if ( background_util > 0.0 ) {
+            background_carry += size * background_util / (1.0 - background_util);
+            int extra = (int)background_carry;
+            background_carry -= extra;
+            busy += extra;
+        }
+	    output_timing->send(busy,NULL);
 
 	    // Subtract credits
 	    port_out_credits[vc_to_send] -= size;
@@ -26,6 +26,7 @@
 #include <sst/core/timeConverter.h>
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/shared/sharedArray.h>
+#include <sst/core/rng/xorshift.h>
 
 #include <sst/core/statapi/stataccumulator.h>
 
@@ -74,7 +75,9 @@ public:
         {"enable_congestion_management", "Turn on congestion management","false"},
         {"cm_outstanding_threshold", "Threshold for the amount of data outstanding to a host before congestion management can trigger","2*output_buf_size"},
         {"cm_pktsize_threshold", "Minimum size of a packet to be considered part of a stream with regards to congestion management","128B"},
-        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"}
+        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"},
+        {"coalesce_credits",   "Hold returned credits until the router flushes them, so that credits for all VCs go back in one event","false"},
+        {"background_packet_size", "Size of analytical background packets in b or B (can include SI prefix)","64B"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -186,6 +189,10 @@ private:
     int* port_ret_credits;
     int* port_out_credits;
 
+    // Set when credit returns are held for flushCredits()
+    bool coalesce_credits;
+    bool ret_credits_pending;
+
     // Represents the start of when a port was idle
     // If the buffer was empty we instantiate this to the current time
     SimTime_t idle_start;
@@ -304,6 +311,18 @@ private:
     int congestion_events;
     int congestion_count_at_last_throttle;
 
+    // Analytical background traffic.  The link is shared with
+    // background packets at background_util: foreground packets hold
+    // the link 1/(1-util) times longer and, when they find it busy,
+    // wait for the background packets queued ahead of them.
+    double background_util;
+    int background_packet_flits;
+    // Mean wait in flit cycles for a packet that finds the link busy
+    double background_wait;
+    // Fraction of a flit cycle of stretch carried to the next packet
+    double background_carry;
+    RNG::XORShiftRNG* background_rng;
+
 public:
 
     void recvCtrlEvent(CtrlRtrEvent* ev);
@@ -322,6 +341,9 @@ public:
     }
     virtual void reportIncomingEvent(internal_router_event* ev);
 
+    void flushCredits();
+    void setBackgroundUtilization(double util);
+
     // time_base is a frequency which represents the bandwidth of the link in flits/second.
     PortControl(ComponentId_t cid, Params& params, Router* rif, int rtr_id, int port_number, Topology *topo);
 
@@ -353,6 +375,8 @@ private:
 
     void handle_input_n2r(Event* ev);
     void handle_input_r2r(Event* ev);
+    void add_out_credits(int vc, int credits);
+    void wake_on_credits();
     void handle_output(Event* ev);
     void handle_failed(Event* ev);
     void handleSAIWindow(Event* ev);
@@ -826,7 +826,11 @@ class hr_router(RouterTemplate):
         RouterTemplate.__init__(self)
 
         self._declareParams("params",["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size",
-                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm",
+                                      "credit_window","background_load","background_num_peers","background_samples",
+                                      "background_packet_size","background_util_map"])
+        # TargetGenerator the analytical background traffic follows
+        self._declareClassVariables(["background_pattern"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
         self._declareParams("params",["output_arb", "enable_congestion_management", "cm_outstanding_threshold", "cm_incast_threshold"],"portcontrol.")
@@ -853,6 +857,35 @@ class hr_router(RouterTemplate):
         rtr.addGlobalParamSet("%s_params"%self._instance_name)
         rtr.addParam("num_ports",radix)
         rtr.addParam("id",rtr_id)
+        if self.background_pattern:
+            self.background_pattern.addAsAnonymous(rtr, "background_pattern", "background_pattern.")
+        return rtr
+
+    def getTopologySlotName(self):
+        return "topology"
+
+# Router for flow level models of the network.  Endpoints attached to
+# it need to use FlowLinkControl as their network interface.
+class flow_router(RouterTemplate):
+    _default_linkcontrol = "sst.merlin.interface.FlowLinkControl"
+
+    def __init__(self):
+        RouterTemplate.__init__(self)
+        self._declareParams("params",["link_bw","link_latency","num_vns","network_name"])
+        self._subscribeToPlatformParamSet("router")
+
+    def getDefaultNetworkInterface(self):
+        module_name, class_name = flow_router._default_linkcontrol.rsplit(".", 1)
+        return getattr(import_module(module_name), class_name)()
+
+    def instanceRouter(self, name, radix, rtr_id):
+        if self._check_first_build():
+            sst.addGlobalParams("%s_params"%self._instance_name, self._getGroupParams("params"))
+
+        rtr = sst.Component(name, "merlin.flow_router")
+        rtr.addGlobalParamSet("%s_params"%self._instance_name)
+        rtr.addParam("num_ports",radix)
+        rtr.addParam("id",rtr_id)
         return rtr
 
     def getTopologySlotName(self):
@@ -21,7 +21,7 @@ from sst.merlin.base import *
 class TestJob(Job):
     def __init__(self,job_id,size):
         Job.__init__(self,job_id,size)
-        self._declareParams("main",["num_peers","num_messages","message_size","send_untimed_bcast"])
+        self._declareParams("main",["num_peers","num_messages","message_size","send_untimed_bcast","num_vns"])
         self.num_peers = size
         self._lockVariable("num_peers")
 
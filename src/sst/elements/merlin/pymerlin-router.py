@@ -23,7 +23,11 @@ class hr_router(RouterTemplate):
     def __init__(self):
         RouterTemplate.__init__(self)
         self._declareParams("params",["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size",
-                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm",
+                                      "credit_window","background_load","background_num_peers","background_samples",
+                                      "background_packet_size","background_util_map"])
+        # TargetGenerator the analytical background traffic follows
+        self._declareClassVariables(["background_pattern"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
         self._declareParams("params",["output_arb"],"portcontrol.")
@@ -42,6 +46,8 @@ class hr_router(RouterTemplate):
         rtr.addParams(self._getGroupParams("params"))
         rtr.addParam("num_ports",radix)
         rtr.addParam("id",rtr_id)
+        if self.background_pattern:
+            self.background_pattern.addAsAnonymous(rtr, "background_pattern", "background_pattern.")
         return rtr
     
     def getTopologySlotName(self):
@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -70,12 +71,27 @@ public:
     inline void dec_vcs_with_data() { vcs_with_data--; }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
+    // Called by a port whenever the event at the head of one of its
+    // input VCs changes (including to or from empty) and whenever the
+    // crossbar credits of one of its output VCs change
+    virtual void vcHeadChanged(int port, int vc) {}
+    virtual void xbarCreditsChanged(int port, int vc) {}
+
     virtual int const* getOutputBufferCredits() = 0;
     virtual void sendCtrlEvent(CtrlRtrEvent* ev, int port = -1) = 0;
     virtual void recvCtrlEvent(int port, CtrlRtrEvent* ev) = 0;
 
     virtual void reportIncomingEvent(internal_router_event* ev) = 0;
 
+    // Ports that coalesce credit returns hold them until the router
+    // calls flushCredits(), which sends everything pending in a
+    // single event.
+    virtual void flushCredits() {}
+
+    // Fraction of the output link used by analytical background
+    // traffic (see the hr_router background_* parameters).
+    virtual void setBackgroundUtilization(double util) {}
+
 };
 
 #define MERLIN_ENABLE_TRACE
@@ -84,7 +100,7 @@ public:
 class BaseRtrEvent : public Event {
 
 public:
-    enum RtrEventType {CREDIT, PACKET, INTERNAL, INITIALIZATION, CTRL};
+    enum RtrEventType {CREDIT, PACKET, INTERNAL, INITIALIZATION, CTRL, CREDIT_BATCH};
 
     inline RtrEventType getType() const { return type; }
 
@@ -372,6 +388,39 @@ private:
 
 };
 
+// Credits for several VCs returned in one event.  Sent by ports that
+// coalesce their credit returns (see PortInterface::flushCredits()).
+class credit_batch_event : public BaseRtrEvent {
+public:
+    std::vector<int> vcs;
+    std::vector<int> credits;
+
+    credit_batch_event() :
+	BaseRtrEvent(BaseRtrEvent::CREDIT_BATCH)
+    {}
+
+    void add(int vc, int num_credits) {
+        vcs.push_back(vc);
+        credits.push_back(num_credits);
+    }
+
+    virtual void print(const std::string& header, Output &out) const  override {
+        out.output("%s credit_batch_event for %zu VCs to be delivered at %" PRIu64 " with priority %d\n",
+                header.c_str(), vcs.size(), getDeliveryTime(), getPriority());
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        BaseRtrEvent::serialize_order(ser);
+        ser & vcs;
+        ser & credits;
+    }
+
+private:
+
+    ImplementSerializable(SST::Merlin::credit_batch_event)
+
+};
+
 class RtrInitEvent : public BaseRtrEvent {
 public:
 
@@ -480,6 +529,46 @@ private:
     ImplementSerializable(SST::Merlin::internal_router_event)
 };
 
+// Analytical background traffic flows, routed through the network
+// during init so each router can total the background load leaving
+// its ports.  Each flow is a routed packet, the rate it carries in
+// bits/s and the number of router hops it has taken.
+class background_flow_event : public BaseRtrEvent {
+public:
+    std::vector<internal_router_event*> flows;
+    std::vector<double> rates;
+    std::vector<int> hops;
+
+    background_flow_event() :
+        BaseRtrEvent(BaseRtrEvent::INITIALIZATION)
+    {}
+
+    ~background_flow_event() {
+        for ( auto flow : flows ) delete flow;
+    }
+
+    void add(internal_router_event* flow, double rate, int num_hops) {
+        flows.push_back(flow);
+        rates.push_back(rate);
+        hops.push_back(num_hops);
+    }
+
+    virtual void print(const std::string& header, Output &out) const  override {
+        out.output("%s background_flow_event with %zu flows to be delivered at %" PRIu64 " with priority %d\n",
+                header.c_str(), flows.size(), getDeliveryTime(), getPriority());
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        BaseRtrEvent::serialize_order(ser);
+        ser & flows;
+        ser & rates;
+        ser & hops;
+    }
+
+private:
+    ImplementSerializable(SST::Merlin::background_flow_event)
+};
+
 class Topology : public SubComponent {
 public:
 
@@ -648,6 +737,16 @@ public:
     virtual void arbitrate(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc) = 0;
 #endif
     virtual void setPorts(int num_ports, int num_vcs) = 0;
+
+    // Arbiters that keep their own record of the input VCs and output
+    // credits return true from tracksPortState().  The router then
+    // passes them its VC head and credit arrays (indexed port * num_vcs
+    // + vc) after setPorts() and reports every change to either.
+    virtual bool tracksPortState() { return false; }
+    virtual void setPortState(internal_router_event** vc_heads, int const* xbar_in_credits) {}
+    virtual void vcHeadChanged(int port, int vc) {}
+    virtual void xbarCreditsChanged(int port, int vc) {}
+
     virtual bool isOkayToPauseClock() { return true; }
     virtual void reportSkippedCycles(Cycle_t cycles) {};
     virtual void dumpState(std::ostream& stream) {};
@@ -58,13 +58,18 @@ nic::nic(ComponentId_t cid, Params& params) :
 
     send_untimed_bcast = params.find<bool>("send_untimed_bcast","false");
 
+    num_vns = params.find<int>("num_vns",1);
+    if ( num_vns < 1 ) {
+        merlin_abort.fatal(CALL_INFO,1,"Error: test_nic num_vns must be at least 1\n");
+    }
+
     UnitAlgebra message_size = params.find<std::string>("message_size","64b");
     if ( message_size.hasUnits("B") ) message_size  *= UnitAlgebra("8b/B");
     msg_size = message_size.getRoundedValue();
 
     // First see if it is defined in the python
     link_control = loadUserSubComponent<SST::Interfaces::SimpleNetwork>
-        ("networkIF", ComponentInfo::SHARE_NONE, 1 /* vns */);
+        ("networkIF", ComponentInfo::SHARE_NONE, num_vns);
 
     if ( !link_control ) {
         merlin_abort.fatal(CALL_INFO,1,"Error: no LinkControl object loaded into test_nic\n");
@@ -324,7 +329,6 @@ nic::clock_handler(Cycle_t cycle)
 {
     // For run phase of simulation, only use my group (my group
     // defaults to everyone if nothing is specified)
-    static const int send_vc = 0;
     expected_recv_count = num_peers * num_msg;
 
     if ( !done && (packets_recd >= expected_recv_count) ) {
@@ -336,6 +340,8 @@ nic::clock_handler(Cycle_t cycle)
 
     // Send packets
     if ( packets_sent < expected_recv_count ) {
+        // Packets take turns on the VNs
+        int send_vc = packets_sent % num_vns;
         if ( link_control->spaceToSend(send_vc,msg_size) ) {
             last_target++;
             last_target %= num_peers;
@@ -366,9 +372,11 @@ nic::clock_handler(Cycle_t cycle)
         }
     }
 
-    // Receive packets
-    if ( link_control->requestToReceive(send_vc) ) {
-        SimpleNetwork::Request* req = link_control->recv(0);
+    // Receive packets, at most one per cycle
+    int recv_vn = 0;
+    while ( recv_vn < num_vns && !link_control->requestToReceive(recv_vn) ) recv_vn++;
+    if ( recv_vn < num_vns ) {
+        SimpleNetwork::Request* req = link_control->recv(recv_vn);
         MyRtrEvent* ev = dynamic_cast<MyRtrEvent*>(req->takePayload());
         if ( ev == NULL ) {
             output.fatal(CALL_INFO, -1, "Error: Received event of wrong type!\n");
@@ -49,6 +49,7 @@ public:
         {"num_messages", "Total number of messages to send to each endpoint."},
         {"message_size", "Size of each message to be sent specified in either b or B (can include SI prefix)."},
         {"send_untimed_broadcast",   "Controls whether data is sent in init and complete.","false"},
+        {"num_vns",      "Number of VNs to send on.  Packets take turns on the VNs.","1"},
     )
 
     SST_ELI_DOCUMENT_PORTS(
@@ -83,6 +84,7 @@ private:
     int init_broadcast_count;
 
     bool send_untimed_bcast;
+    int num_vns;
 
     SST::Interfaces::SimpleNetwork* link_control;
 
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Foreground latency under hr_router's analytical background traffic.  The
+# first model option picks the background:
+#
+#   none         no background
+#   load         background_load of uniform random traffic (background_pattern)
+#   map <file>   per port utilizations from a background_util_map file
+#
+#   sst --model-options="map dragon_72_background_util.map" dragon_72_background_test.py
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.targetgen import *
+from sst.merlin.topology import *
+
+import sys
+
+if __name__ == "__main__":
+
+    mode = sys.argv[1] if len(sys.argv) > 1 else "none"
+
+    ### Setup the topology
+    topo = topoDragonFly()
+    topo.hosts_per_router = 2
+    topo.routers_per_group = 4
+    topo.intergroup_links = 1
+    topo.num_groups = 9
+    topo.algorithm = "minimal"
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "4GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    if mode == "load":
+        router.background_load = 0.5
+        router.background_num_peers = topo.getNumNodes()
+        router.background_pattern = UniformTarget()
+    elif mode == "map":
+        router.background_util_map = sys.argv[2]
+    elif mode != "none":
+        print("unknown background mode %s, expected none, load or map"%mode)
+        sys.exit(1)
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = OfferedLoadJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.offered_load = 0.2
+    ep.link_bw = "4GB/s"
+    ep.message_size = "64B"
+    ep.warmup_time = "200ns"
+    ep.collect_time = "2us"
+    ep.drain_time = "1us"
+    ep.pattern = UniformTarget()
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+    system.build()
@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# All to all traffic with coalesced credit returns.  Every endpoint sends on
+# both VNs and packets are larger than a flit, so credits for several VCs are
+# pending at each flush and go back to routers (PortControl) and endpoints
+# (LinkControl) as credit_batch_events.  The buffers only hold a few packets,
+# so lost credits stall the run.
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoDragonFly()
+    topo.hosts_per_router = 2
+    topo.routers_per_group = 4
+    topo.intergroup_links = 1
+    topo.num_groups = 9
+    topo.algorithm = ["minimal","ugal"]
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "4GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "256B"
+    router.output_buf_size = "256B"
+    router.num_vns = 2
+    router.xbar_arb = "merlin.xbar_arb_lru"
+    router.credit_window = 4
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "256B"
+    networkif.output_buf_size = "256B"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.num_vns = 2
+    ep.message_size = "64B"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+    system.build()
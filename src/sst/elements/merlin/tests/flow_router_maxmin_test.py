@@ -0,0 +1,83 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Max-min fair rates in the flow level model.  Two flow_routers joined by
+# one link, three hosts on each:
+#
+#   hosts 0 1 2 -- rtr 0 ==== rtr 1 -- hosts 3 4 5
+#
+# Streams 0->3, 1->3 and 2->4 share the router to router link and get a
+# third of the link bandwidth each.  Stream 5->4 shares only the link into
+# host 4 with 2->4, so it gets the remaining two thirds.
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+
+class Pt2ptJob(Job):
+    def __init__(self,job_id,size):
+        Job.__init__(self,job_id,size)
+        self._declareParams("main",["packet_size","packets_to_send","src","dest"])
+
+    def getName(self):
+        return "pt2pt Job"
+
+    def build(self, nID, extraKeys):
+        nic = sst.Component("pt2ptNic_%d"%nID, "merlin.pt2pt_test")
+        self._applyStatisticsSettings(nic)
+        nic.addParams(self._getGroupParams("main"))
+        nic.addParams(extraKeys)
+        id = self._nid_map[nID]
+
+        #  Add the network interface
+        networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
+
+        return (networkif, port_name)
+
+
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoMesh()
+    topo.shape = "2"
+    topo.width = "1"
+    topo.local_ports = 3
+    topo.link_latency = "20ns"
+
+    # Set up the routers
+    router = flow_router()
+    router.link_bw = "4GB/s"
+    router.link_latency = "20ns"
+    router.num_vns = 1
+
+    topo.router = router
+
+    ### set up the endpoint
+    networkif = FlowLinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.output_buf_size = "8kB"
+
+    ep = Pt2ptJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.packet_size = "4kB"
+    ep.packets_to_send = 100
+    ep.src = [0, 1, 2, 5]
+    ep.dest = [3, 3, 4, 4]
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+    system.build()
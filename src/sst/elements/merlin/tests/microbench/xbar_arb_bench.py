@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Crossbar arbiter benchmark: simulated router cycles per second of run loop time
+#
+# Run with python to time each arbiter on the same network:
+#
+#   python3 xbar_arb_bench.py [--groups N] [--hosts N] [--routers N] [--global N]
+#                             [--load F] [--time T] [--arbs a,b,...]
+#
+# The defaults build a 33 group dragonfly of 63 port routers (1056 routers)
+# under uniform random traffic. The same file is the SST model, so a single
+# configuration can also be run directly with
+#
+#   sst --model-options="--arb merlin.xbar_arb_islip" xbar_arb_bench.py
+
+import argparse
+import re
+import subprocess
+import sys
+
+parser = argparse.ArgumentParser(description="Compare hr_router crossbar arbiters")
+parser.add_argument("--arb", default="merlin.xbar_arb_lru", help="Arbiter for a single SST run")
+parser.add_argument("--arbs", default="merlin.xbar_arb_lru,merlin.xbar_arb_islip", help="Arbiters to compare")
+parser.add_argument("--groups", type=int, default=33)
+parser.add_argument("--routers", type=int, default=32, help="Routers per group")
+parser.add_argument("--hosts", type=int, default=16, help="Hosts per router")
+parser.add_argument("--global", dest="global_links", type=int, default=16, help="Global links per router")
+parser.add_argument("--load", type=float, default=0.6, help="Offered load")
+parser.add_argument("--time", default="2us", help="Time to collect over")
+parser.add_argument("--xbar_bw", default="5GB/s")
+parser.add_argument("--flit_size", default="8B")
+args = parser.parse_args()
+
+try:
+    import sst
+    under_sst = True
+except ImportError:
+    under_sst = False
+
+
+def build():
+    from sst.merlin.base import System, hr_router
+    from sst.merlin.endpoint import OfferedLoadJob
+    from sst.merlin.interface import LinkControl
+    from sst.merlin.targetgen import UniformTarget
+    from sst.merlin.topology import topoDragonFly
+
+    topo = topoDragonFly()
+    topo.hosts_per_router = args.hosts
+    topo.routers_per_group = args.routers
+    topo.intergroup_links = args.global_links
+    topo.num_groups = args.groups
+    topo.algorithm = "ugal"
+    topo.link_latency = "20ns"
+
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = args.flit_size
+    router.xbar_bw = args.xbar_bw
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = args.arb
+    topo.router = router
+
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = OfferedLoadJob(0, topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.offered_load = args.load
+    ep.link_bw = "4GB/s"
+    ep.message_size = "64B"
+    ep.warmup_time = "200ns"
+    ep.collect_time = args.time
+    ep.drain_time = "1us"
+    ep.pattern = UniformTarget()
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep, "linear")
+    system.build()
+
+
+def to_ns(value, unit):
+    scale = {"fs": 1e-6, "ps": 1e-3, "ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    return float(value) * scale[unit]
+
+
+def run(arb):
+    options = " ".join(["--arb", arb, "--groups", str(args.groups), "--routers", str(args.routers),
+                        "--hosts", str(args.hosts), "--global", str(args.global_links),
+                        "--load", str(args.load), "--time", args.time,
+                        "--xbar_bw", args.xbar_bw, "--flit_size", args.flit_size])
+    result = subprocess.run(["sst", "--print-timing-info", "--model-options=" + options, __file__],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        sys.stdout.write(result.stdout)
+        sys.exit("sst failed for %s" % arb)
+
+    # Only the run loop is timed.  Building the graph and init take the
+    # same time for every arbiter and dwarf a short run.
+    match = re.search(r"Run (?:loop|stage) [Tt]ime:\s*([0-9.eE+-]+)\s*seconds", result.stdout)
+    if match is None:
+        sys.exit("could not find the run loop time in the output for %s" % arb)
+    wall = float(match.group(1))
+
+    match = re.search(r"simulated time:\s*([0-9.eE+-]+)\s*(fs|ps|ns|us|ms|s)\b", result.stdout)
+    if match is None:
+        sys.exit("could not find the simulated time in the output for %s" % arb)
+    return wall, to_ns(match.group(1), match.group(2))
+
+
+if under_sst:
+    build()
+else:
+    # Router clock is the crossbar bandwidth in flits per second
+    units = {"B/s": 1, "KB/s": 1e3, "MB/s": 1e6, "GB/s": 1e9, "TB/s": 1e12}
+    bw = re.match(r"([0-9.]+)\s*([KMGT]?B/s)", args.xbar_bw)
+    flit = re.match(r"([0-9.]+)\s*B", args.flit_size)
+    clock_ghz = float(bw.group(1)) * units[bw.group(2)] / float(flit.group(1)) / 1e9
+
+    num_routers = args.groups * args.routers
+    radix = args.hosts + args.routers - 1 + args.global_links
+    print("Dragonfly: %d routers, %d ports each, load %.2f" % (num_routers, radix, args.load))
+    print("%-28s %10s %12s %18s" % ("arbiter", "run (s)", "sim (ns)", "router cycles/s"))
+
+    baseline = None
+    for arb in args.arbs.split(","):
+        wall, sim_ns = run(arb)
+        rate = sim_ns * clock_ghz * num_routers / wall
+        if baseline is None:
+            baseline = rate
+        print("%-28s %10.2f %12.0f %18.3e  (%.2fx)" % (arb, wall, sim_ns, rate, rate / baseline))
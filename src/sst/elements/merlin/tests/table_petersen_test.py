@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# All to all traffic over the merlin.table topology built from
+# table_petersen.edges. Generate the route table first, then pass it in:
+#
+#   sst-merlin-tablegen -p 4 table_petersen.edges table_petersen.rt
+#   sst --model-options="table_petersen.rt" table_petersen_test.py
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+import sys
+
+if __name__ == "__main__":
+
+    if len(sys.argv) < 2:
+        print("usage: sst --model-options=\"<route table>\" table_petersen_test.py")
+        sys.exit(1)
+
+    ### Setup the topology
+    topo = topoTable()
+    topo.file = sys.argv[1]
+    topo.algorithm = "ugal"
+    topo.link_latency = "20ns"
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "4GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+
+    topo.router = router
+
+    ### Set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    # Untimed broadcasts follow the table's broadcast trees
+    ep = TestJob(0, topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.send_untimed_bcast = True
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep, "linear")
+    system.build()
@@ -2,6 +2,8 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import os
+import re
 
 try:
     from sympy.polys.domains import ZZ
@@ -71,6 +73,29 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_polarstar_504(self):
         self.merlin_test_template("polarstar_504_test")
 
+    def test_merlin_dragon_72_islip(self):
+        self.merlin_delivery_test_template("dragon_72_islip_test", 72)
+
+    def test_merlin_torus_64_islip(self):
+        self.merlin_delivery_test_template("torus_64_islip_test", 64)
+
+    def test_merlin_dragon_72_credit_window(self):
+        self.merlin_delivery_test_template("dragon_72_credit_window_test", 72)
+
+    def test_merlin_dragon_72_background(self):
+        self.merlin_background_test_template("dragon_72_background_test")
+
+    def test_merlin_flow_router_maxmin(self):
+        # 4GB/s links: the three streams crossing the router to router
+        # link get a third each, 5->4 gets the rest of the link into 4
+        link_bw = 32.0e9
+        self.merlin_flow_test_template("flow_router_maxmin_test",
+                                       {(0, 3): link_bw / 3, (1, 3): link_bw / 3,
+                                        (2, 4): link_bw / 3, (5, 4): 2 * link_bw / 3})
+
+    def test_merlin_table_petersen(self):
+        self.merlin_table_test_template("table_petersen", 4)
+
 
 #####
 
@@ -108,3 +133,146 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+
+    def merlin_table_test_template(self, testcase, hosts_per_router):
+        # Builds the route table for tests/<testcase>.edges with
+        # sst-merlin-tablegen, checks the generator's summary against the
+        # reference and then runs all to all traffic over it.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        tablegen = "{0}/sst-merlin-tablegen".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(tablegen), "sst-merlin-tablegen not found in {0}".format(elem_bin_dir))
+
+        edgefile = "{0}/{1}.edges".format(test_path, testcase)
+        tablefile = "{0}/{1}.rt".format(tmpdir, testcase)
+        genfile = "{0}/{1}_tablegen.out".format(outdir, testDataFileName)
+        genref = "{0}/refFiles/{1}_tablegen.out".format(test_path, testDataFileName)
+
+        cmd = "{0} -p {1} {2} {3}".format(tablegen, hosts_per_router, edgefile, tablefile)
+        rtn = OSCommand(cmd).run()
+        self.assertTrue(rtn.result() == 0, "sst-merlin-tablegen failed for {0}:\n{1}".format(edgefile, rtn.output()))
+        with open(genfile, "w") as f:
+            f.write(rtn.output())
+
+        cmp_result = testing_compare_diff(testcase, genfile, genref)
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testcase)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Route table summary {0} does not match Reference File {1}".format(genfile, genref))
+
+        sdlfile = "{0}/{1}_test.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options=\"{0}\"'.format(tablefile)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        with open(genref) as f:
+            routers = int(re.search(r"Routers:\s+(\d+)", f.read()).group(1))
+        nodes = routers * hosts_per_router
+
+        self._checkTestJobDelivery(testcase, outfile, nodes)
+
+
+    def merlin_delivery_test_template(self, testcase, nodes):
+        # Runs a TestJob model and checks that all of its traffic arrives.
+        # Used where packet timing depends on arbitration details that a
+        # sorted diff would pin down.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        self._checkTestJobDelivery(testcase, outfile, nodes)
+
+
+    def _checkTestJobDelivery(self, testcase, outfile, nodes, num_messages=10):
+        with open(outfile) as f:
+            output = f.read()
+        self.assertTrue(re.search(r"didn't receive", output) is None, "{0} lost init or broadcast messages".format(testcase))
+        received = set(int(n) for n in re.findall(r"NIC (\d+) received all packets \(total of {0}\)".format(nodes * num_messages), output))
+        self.assertEqual(received, set(range(nodes)), "{0}: not every NIC received its packets".format(testcase))
+        finished = re.findall(r"Finished sending packets", output)
+        self.assertEqual(len(finished), nodes, "{0}: not every NIC finished sending".format(testcase))
+        self.assertTrue("Simulation is complete" in output, "{0} did not complete".format(testcase))
+
+
+    def merlin_background_test_template(self, testcase):
+        # Runs an OfferedLoadJob without background traffic, with a
+        # background_load following a background_pattern and with a
+        # background_util_map, and checks that both backgrounds slow the
+        # foreground packets down.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        mapfile = "{0}/dragon_72_background_util.map".format(test_path)
+
+        latency = {}
+        for mode, options in [("none", "none"), ("load", "load"), ("map", "map {0}".format(mapfile))]:
+            testDataFileName="test_merlin_{0}_{1}".format(testcase, mode)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            otherargs = '--model-options=\"{0}\"'.format(options)
+
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+            latency[mode] = self._readOfferedLoadLatency(outfile)
+            log_debug("{0}: {1} background average latency {2} ns".format(testcase, mode, latency[mode]))
+
+        self.assertTrue(latency["load"] > latency["none"],
+                        "background_load did not increase latency: {0} ns vs {1} ns".format(latency["load"], latency["none"]))
+        self.assertTrue(latency["map"] > latency["none"],
+                        "background_util_map did not increase latency: {0} ns vs {1} ns".format(latency["map"], latency["none"]))
+
+
+    def _readOfferedLoadLatency(self, outfile):
+        # Average latency from the summary table offered_load prints
+        scale = {"fs": 1e-6, "ps": 1e-3, "ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+        with open(outfile) as f:
+            match = re.search(r"^\s*[0-9.]+\s+([0-9.eE+-]+)\s*(fs|ps|ns|us|ms|s)\b", f.read(), re.MULTILINE)
+        self.assertTrue(match is not None, "No average latency found in {0}".format(outfile))
+        return float(match.group(1)) * scale[match.group(2)]
+
+
+    def merlin_flow_test_template(self, testcase, expected_bw, tolerance=0.05):
+        # Runs a pt2pt_test model and checks the bandwidth each stream
+        # reports against its max-min fair share, in bits per second
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        scale = {"": 1.0, "k": 1e3, "K": 1e3, "M": 1e6, "G": 1e9, "T": 1e12}
+        with open(outfile) as f:
+            output = f.read()
+        measured = {}
+        for src, dest, value, prefix in re.findall(r"For src = (\d+) and dest = (\d+):.*?Bandwidth: ([0-9.eE+-]+) ?([kKMGT]?)b/s", output, re.DOTALL):
+            measured[(int(src), int(dest))] = float(value) * scale[prefix]
+
+        self.assertEqual(set(measured.keys()), set(expected_bw.keys()),
+                         "{0}: streams reported {1}, expected {2}".format(testcase, sorted(measured.keys()), sorted(expected_bw.keys())))
+        for stream, bw in expected_bw.items():
+            self.assertTrue(abs(measured[stream] - bw) <= tolerance * bw,
+                            "{0}: stream {1} got {2:.4g} b/s, expected {3:.4g} b/s".format(testcase, stream, measured[stream], bw))
@@ -0,0 +1,120 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# Portions are copyright of other developers:
+# See the file CONTRIBUTORS.TXT in the top level directory
+# of the distribution for more information.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+from sst.merlin.base import *
+
+import struct
+
+
+class topoTable(Topology):
+
+    # Layout of the route table header and link records, see table_format.h
+    _header_format = "<IHHIIIHHHHIQQ"
+    _link_format = "<IHH"
+    _magic = 0x4254524d
+    _no_peer = 0xffffffff
+
+    def __init__(self):
+        Topology.__init__(self)
+        self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints",
+                                     "_routers","_hosts_per_router","_network_ports","_links"])
+        self._declareParams("main",["file","algorithm","adaptive_threshold"])
+        self._setCallbackOnWrite("file",self._file_callback)
+        self._subscribeToPlatformParamSet("topology")
+
+    def _file_callback(self,variable_name,value):
+        self._lockVariable(variable_name)
+
+        with open(value, "rb") as f:
+            header_size = struct.calcsize(self._header_format)
+            fields = struct.unpack(self._header_format, f.read(header_size))
+            (magic, version, reserved, routers, hosts_per_router, network_ports,
+             min_slots, nonmin_slots, diameter, max_hops, record_bytes, links_offset, tables_offset) = fields
+            if magic != self._magic:
+                print("topoTable: %s is not a route table (generate one with sst-merlin-tablegen)."%value)
+                exit(1)
+
+            link_size = struct.calcsize(self._link_format)
+            f.seek(links_offset)
+            data = f.read(routers * network_ports * link_size)
+            if len(data) != routers * network_ports * link_size:
+                print("topoTable: %s is truncated."%value)
+                exit(1)
+
+        self._routers = routers
+        self._hosts_per_router = hosts_per_router
+        self._network_ports = network_ports
+        self._links = [struct.unpack_from(self._link_format, data, i * link_size)[0:2]
+                       for i in range(routers * network_ports)]
+
+    def getName(self):
+        return "Table"
+
+    def getNumNodes(self):
+        if self._routers is None:
+            print("topoTable: calling getNumNodes before file was set.")
+            exit(1)
+        return self._routers * self._hosts_per_router
+
+    def getRouterNameForId(self,rtr_id):
+        return "rtr_%d"%rtr_id
+
+    def findRouterById(self,rtr_id):
+        return sst.findComponentByName(self.getRouterNameForId(rtr_id))
+
+    def _build_impl(self, endpoint):
+        if self._routers is None:
+            print("topoTable: file must be set before building the network.")
+            exit(1)
+
+        if self.host_link_latency is None:
+            self.host_link_latency = self.link_latency
+
+        hosts = self._hosts_per_router
+        radix = hosts + self._network_ports
+
+        links = dict()
+        def getLink(end1, end2):
+            # Sort the (router, port) pairs so both ends get the same link
+            name = "link_%d_%d_%d_%d"%(min(end1,end2) + max(end1,end2))
+            if name not in links:
+                links[name] = sst.Link(name)
+            return links[name]
+
+        for r in range(self._routers):
+            rtr = self._instanceRouter(radix,r)
+
+            topology = rtr.setSubComponent(self.router.getTopologySlotName(),"merlin.table")
+            self._applyStatisticsSettings(topology)
+            topology.addParams(self._getGroupParams("main"))
+
+            # Hosts are on the first ports
+            for n in range(hosts):
+                nodeID = hosts * r + n
+                (ep, port_name) = endpoint.build(nodeID, {})
+                if ep:
+                    nicLink = sst.Link("nic_%d_%d"%(r, n))
+                    if self.bundleEndpoints:
+                       nicLink.setNoCut()
+                    nicLink.connect( (ep, port_name, self.host_link_latency), (rtr, "port%d"%n, self.host_link_latency) )
+
+            for i in range(self._network_ports):
+                (peer, peer_port) = self._links[r * self._network_ports + i]
+                if peer == self._no_peer:
+                    continue
+                rtr.addLink(getLink((r,i),(peer,peer_port)), "port%d"%(hosts + i), self.link_latency)
@@ -0,0 +1,290 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "table.h"
+#include "table_format.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+
+using namespace SST::Merlin;
+
+
+topo_table::topo_table(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns) :
+    Topology(cid),
+    router_id(rtr_id),
+    num_vns(num_vns),
+    output_queue_lengths(NULL)
+{
+    std::string file = params.find<std::string>("file", "");
+    if ( file == "" ) {
+        output.fatal(CALL_INFO, -1, "table topology: the file parameter must name a route table\n");
+    }
+
+    std::string algo = params.find<std::string>("algorithm", "minimal");
+    if ( algo == "minimal" ) {
+        algorithm = MINIMAL;
+    }
+    else if ( algo == "ugal" ) {
+        algorithm = UGAL;
+    }
+    else {
+        output.fatal(CALL_INFO, -1, "table topology: unknown routing algorithm specified: %s\n", algo.c_str());
+    }
+    adaptive_threshold = params.find<int>("adaptive_threshold", 0);
+
+    loadTable(file, num_ports);
+}
+
+topo_table::~topo_table()
+{
+}
+
+void
+topo_table::loadTable(const std::string& file, int num_ports)
+{
+    FILE* fp = fopen(file.c_str(), "rb");
+    if ( fp == NULL ) {
+        output.fatal(CALL_INFO, -1, "table topology: unable to open route table %s\n", file.c_str());
+    }
+    RouteTable::FileHeader header;
+    if ( fread(&header, sizeof(header), 1, fp) != 1 || header.magic != RouteTable::FileMagic ) {
+        output.fatal(CALL_INFO, -1, "table topology: %s is not a route table\n", file.c_str());
+    }
+    if ( header.version != RouteTable::FileVersion ) {
+        output.fatal(CALL_INFO, -1, "table topology: %s has version %" PRIu16 ", expected %" PRIu16 "\n",
+                     file.c_str(), header.version, RouteTable::FileVersion);
+    }
+
+    num_routers = header.routers;
+    hosts_per_router = header.hosts_per_router;
+    network_ports = header.network_ports;
+    min_slots = header.min_slots;
+    nonmin_slots = header.nonmin_slots;
+    diameter = header.diameter;
+
+    if ( router_id < 0 || router_id >= num_routers ) {
+        output.fatal(CALL_INFO, -1, "table topology: router id %d is outside the %d routers in %s\n",
+                     router_id, num_routers, file.c_str());
+    }
+    if ( num_ports < hosts_per_router + network_ports ) {
+        output.fatal(CALL_INFO, -1, "Number of ports should be at least %d for this configuration\n",
+                     hosts_per_router + network_ports);
+    }
+
+    // Minimal routes are at most diameter hops, ugal routes at most max_hops
+    num_vcs = std::max(1, algorithm == UGAL ? std::max(diameter, (int) header.max_hops) : diameter);
+    total_vcs = num_vcs * num_vns;
+
+    const RouteTable::RecordLayout layout(network_ports, min_slots, nonmin_slots);
+    if ( layout.bytes != header.record_bytes ) {
+        output.fatal(CALL_INFO, -1, "table topology: %s has %" PRIu32 " byte records, expected %zu\n",
+                     file.c_str(), header.record_bytes, layout.bytes);
+    }
+    bcast_bytes = layout.bcast_bytes;
+
+    // Which of our network ports are in use
+    std::vector<RouteTable::LinkRecord> links(network_ports);
+    if ( fseeko(fp, header.links_offset + (off_t) router_id * network_ports * sizeof(RouteTable::LinkRecord), SEEK_SET) != 0 ||
+         (network_ports > 0 && fread(links.data(), sizeof(RouteTable::LinkRecord), network_ports, fp) != (size_t) network_ports) ) {
+        output.fatal(CALL_INFO, -1, "table topology: %s is truncated (links of router %d)\n", file.c_str(), router_id);
+    }
+    connected.resize(network_ports);
+    for ( int i = 0; i < network_ports; ++i ) {
+        connected[i] = links[i].peer_router != RouteTable::NO_PEER;
+    }
+
+    // Our row of the route table
+    std::vector<uint8_t> row((size_t) num_routers * layout.bytes);
+    if ( fseeko(fp, header.tables_offset + (off_t) router_id * row.size(), SEEK_SET) != 0 ||
+         fread(row.data(), 1, row.size(), fp) != row.size() ) {
+        output.fatal(CALL_INFO, -1, "table topology: %s is truncated (routes of router %d)\n", file.c_str(), router_id);
+    }
+    fclose(fp);
+
+    distance.resize(num_routers);
+    min_count.resize(num_routers);
+    nonmin_count.resize(num_routers);
+    min_ports.resize((size_t) num_routers * min_slots);
+    nonmin_ports.resize((size_t) num_routers * nonmin_slots);
+    nonmin_hops.resize((size_t) num_routers * nonmin_slots);
+    bcast_ports.resize((size_t) num_routers * bcast_bytes);
+
+    for ( int d = 0; d < num_routers; ++d ) {
+        const uint8_t* rec = &row[(size_t) d * layout.bytes];
+        distance[d] = rec[0];
+        min_count[d] = rec[1];
+        nonmin_count[d] = rec[2];
+
+        if ( min_count[d] > min_slots || nonmin_count[d] > nonmin_slots ||
+             (d != router_id && (distance[d] == 0 || min_count[d] == 0)) ) {
+            output.fatal(CALL_INFO, -1, "table topology: %s has a corrupt route from router %d to router %d\n",
+                         file.c_str(), router_id, d);
+        }
+
+        memcpy(&min_ports[(size_t) d * min_slots], rec + layout.min_port, 2 * min_slots);
+        memcpy(&nonmin_ports[(size_t) d * nonmin_slots], rec + layout.nonmin_port, 2 * nonmin_slots);
+        memcpy(&nonmin_hops[(size_t) d * nonmin_slots], rec + layout.nonmin_hops, nonmin_slots);
+        memcpy(&bcast_ports[(size_t) d * bcast_bytes], rec + layout.bcast_ports, bcast_bytes);
+
+        for ( int i = 0; i < min_count[d]; ++i ) {
+            if ( min_ports[(size_t) d * min_slots + i] >= network_ports ) {
+                output.fatal(CALL_INFO, -1, "table topology: %s routes router %d to router %d through port %" PRIu16 ", only %d network ports\n",
+                             file.c_str(), router_id, d, min_ports[(size_t) d * min_slots + i], network_ports);
+            }
+        }
+        for ( int i = 0; i < nonmin_count[d]; ++i ) {
+            if ( nonmin_ports[(size_t) d * nonmin_slots + i] >= network_ports ) {
+                output.fatal(CALL_INFO, -1, "table topology: %s routes router %d to router %d through port %" PRIu16 ", only %d network ports\n",
+                             file.c_str(), router_id, d, nonmin_ports[(size_t) d * nonmin_slots + i], network_ports);
+            }
+        }
+    }
+}
+
+void
+topo_table::setOutputQueueLengthsArray(int const* array, int vcs)
+{
+    output_queue_lengths = array;
+    total_vcs = vcs;
+}
+
+// Returns the candidate network port with the shortest output queue on vc
+int
+topo_table::leastLoaded(const uint16_t* ports, int count, int vc, int& queue) const
+{
+    int best = ports[0];
+    if ( output_queue_lengths == NULL ) {
+        queue = 0;
+        return best;
+    }
+
+    queue = output_queue_lengths[(hosts_per_router + best) * total_vcs + vc];
+    for ( int i = 1; i < count; ++i ) {
+        int q = output_queue_lengths[(hosts_per_router + ports[i]) * total_vcs + vc];
+        if ( q < queue ) {
+            queue = q;
+            best = ports[i];
+        }
+    }
+    return best;
+}
+
+void
+topo_table::route_packet(int port, int vc, internal_router_event* ev)
+{
+    topo_table_event* tt_ev = static_cast<topo_table_event*>(ev);
+    int dest = tt_ev->getDest();
+    int dest_router = dest / hosts_per_router;
+    int start_vc = tt_ev->getVN() * num_vcs;
+
+    if ( dest_router == router_id ) {
+        tt_ev->setNextPort(dest % hosts_per_router);
+        tt_ev->setVC(start_vc);
+        return;
+    }
+
+    int next_vc = start_vc + tt_ev->hops;
+
+    int min_queue;
+    int out_port = leastLoaded(&min_ports[(size_t) dest_router * min_slots], min_count[dest_router], next_vc, min_queue);
+
+    // UGAL: a non-minimal first hop if the best one is cheaper than the best minimal one
+    if ( algorithm == UGAL && tt_ev->hops == 0 && nonmin_count[dest_router] > 0 && min_queue > 0 ) {
+        const size_t base = (size_t) dest_router * nonmin_slots;
+        int nonmin_queue;
+        int nonmin_port = leastLoaded(&nonmin_ports[base], nonmin_count[dest_router], next_vc, nonmin_queue);
+        int hops = 0;
+        for ( int i = 0; i < nonmin_count[dest_router]; ++i ) {
+            if ( nonmin_ports[base + i] == nonmin_port ) {
+                hops = nonmin_hops[base + i];
+                break;
+            }
+        }
+
+        if ( min_queue * distance[dest_router] > nonmin_queue * hops + adaptive_threshold ) {
+            out_port = nonmin_port;
+        }
+    }
+
+    tt_ev->setNextPort(hosts_per_router + out_port);
+    tt_ev->setVC(next_vc);
+    tt_ev->hops++;
+}
+
+internal_router_event*
+topo_table::process_input(RtrEvent* ev)
+{
+    topo_table_event* tt_ev = new topo_table_event();
+    tt_ev->setEncapsulatedEvent(ev);
+    tt_ev->setVC(tt_ev->getVN() * num_vcs);
+    return tt_ev;
+}
+
+void
+topo_table::routeUntimedData(int port, internal_router_event* ev, std::vector<int> &outPorts)
+{
+    if ( ev->getDest() == UNTIMED_BROADCAST_ADDR ) {
+        // Deliver to our hosts and pass it down the broadcast tree of the
+        // router it was injected at
+        for ( int i = 0; i < hosts_per_router; ++i ) {
+            if ( i != port ) outPorts.push_back(i);
+        }
+
+        int src_router = ev->getSrc() / hosts_per_router;
+        const uint8_t* mask = &bcast_ports[(size_t) src_router * bcast_bytes];
+        for ( int i = 0; i < network_ports; ++i ) {
+            if ( mask[i / 8] & (1 << (i % 8)) ) {
+                outPorts.push_back(hosts_per_router + i);
+            }
+        }
+    }
+    else {
+        route_packet(port, 0, ev);
+        outPorts.push_back(ev->getNextPort());
+    }
+}
+
+internal_router_event*
+topo_table::process_UntimedData_input(RtrEvent* ev)
+{
+    topo_table_event* tt_ev = new topo_table_event();
+    tt_ev->setEncapsulatedEvent(ev);
+    return tt_ev;
+}
+
+std::pair<int,int>
+topo_table::getDeliveryPortForEndpointID(int ep_id)
+{
+    return std::make_pair(ep_id / hosts_per_router, ep_id % hosts_per_router);
+}
+
+Topology::PortState
+topo_table::getPortState(int port) const
+{
+    if ( port < hosts_per_router ) return R2N;
+    if ( port < hosts_per_router + network_ports && connected[port - hosts_per_router] ) return R2R;
+    return UNCONNECTED;
+}
+
+int
+topo_table::getEndpointID(int port)
+{
+    if ( port < hosts_per_router ) return router_id * hosts_per_router + port;
+    return -1;
+}
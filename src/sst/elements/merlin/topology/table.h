@@ -0,0 +1,155 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_TABLE_H
+#define COMPONENTS_MERLIN_TOPOLOGY_TABLE_H
+
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/params.h>
+
+#include <stdint.h>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+namespace Merlin {
+
+class topo_table_event : public internal_router_event {
+public:
+    // Router to router hops taken so far, also selects the VC for the next hop
+    int hops;
+
+    topo_table_event() : internal_router_event(), hops(0) {}
+    virtual ~topo_table_event() {}
+
+    virtual internal_router_event* clone(void) override
+    {
+        return new topo_table_event(*this);
+    }
+
+    void serialize_order(SST::Core::Serialization::serializer &ser)  override {
+        internal_router_event::serialize_order(ser);
+        ser & hops;
+    }
+
+private:
+    ImplementSerializable(SST::Merlin::topo_table_event)
+};
+
+
+/*
+ * Topology read from a route table file (see table_format.h), so arbitrary
+ * router graphs can be simulated without a topology specific routing
+ * function. Each router loads its own row of the table: for every
+ * destination router the minimal next hops, a set of non-minimal next hops
+ * and the ports on which to forward broadcasts. Routing a packet is a lookup
+ * and a comparison of the output queue lengths of the candidate ports.
+ *
+ * Deadlock freedom comes from the VC assignment: a packet moves to the next
+ * VC on every router to router hop, so the number of VCs per VN is the
+ * longest route the algorithm can take.
+ */
+class topo_table: public Topology {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        topo_table,
+        "merlin",
+        "table",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Arbitrary topology routed from precomputed tables (generated with sst-merlin-tablegen)",
+        SST::Merlin::Topology
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"file",               "Route table file written by sst-merlin-tablegen."},
+        {"algorithm",          "Routing algorithm to use: minimal (adaptive among the minimal next hops) or ugal "
+                               "(may also take a non-minimal first hop when the minimal ports are congested).", "minimal"},
+        {"adaptive_threshold", "ugal: bias, in flits times hops, in favor of the minimal route.", "0"}
+    )
+
+    enum RouteAlgo {
+        MINIMAL,
+        UGAL
+    };
+
+private:
+    int router_id;
+    int num_routers;
+    int hosts_per_router;
+    int network_ports;
+    int diameter;
+
+    int num_vns;
+    int num_vcs;                        // Per VN
+    int total_vcs;                      // Per port in output_queue_lengths
+    RouteAlgo algorithm;
+    int adaptive_threshold;
+
+    int const* output_queue_lengths;
+
+    int min_slots;
+    int nonmin_slots;
+    int bcast_bytes;
+
+    // This router's row of the table, indexed by destination router
+    std::vector<uint8_t> distance;
+    std::vector<uint8_t> min_count;
+    std::vector<uint8_t> nonmin_count;
+    std::vector<uint16_t> min_ports;    // [dest * min_slots + i]
+    std::vector<uint16_t> nonmin_ports; // [dest * nonmin_slots + i]
+    std::vector<uint8_t> nonmin_hops;   // [dest * nonmin_slots + i]
+    std::vector<uint8_t> bcast_ports;   // [dest * bcast_bytes + i]
+
+    std::vector<bool> connected;        // Network ports with a router on the other end
+
+public:
+    topo_table(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
+    ~topo_table();
+
+    virtual void route_packet(int port, int vc, internal_router_event* ev);
+    virtual internal_router_event* process_input(RtrEvent* ev);
+
+    virtual void routeUntimedData(int port, internal_router_event* ev, std::vector<int> &outPorts);
+    virtual internal_router_event* process_UntimedData_input(RtrEvent* ev);
+
+    virtual std::pair<int,int> getDeliveryPortForEndpointID(int ep_id);
+
+    virtual PortState getPortState(int port) const;
+    virtual int getEndpointID(int port);
+
+    virtual void setOutputQueueLengthsArray(int const* array, int vcs);
+
+    virtual void getVCsPerVN(std::vector<int>& vcs_per_vn) {
+        for ( int i = 0; i < num_vns; ++i ) {
+            vcs_per_vn[i] = num_vcs;
+        }
+    }
+
+private:
+    void loadTable(const std::string& file, int num_ports);
+    int leastLoaded(const uint16_t* ports, int count, int vc, int& queue) const;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_TABLE_H
@@ -0,0 +1,110 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_TOPOLOGY_TABLE_FORMAT_H
+#define COMPONENTS_MERLIN_TOPOLOGY_TABLE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * On-disk layout of the route tables read by the "merlin.table" topology and
+ * written by sst-merlin-tablegen. All values are little endian.
+ *
+ *   FileHeader
+ *   LinkRecord[routers][network_ports]        at links_offset
+ *   route record[routers][routers]            at tables_offset
+ *
+ * The link records give, for every router port that connects to another
+ * router, the router and port on the far end (peer_router is NO_PEER for an
+ * unused port). Router ports are numbered hosts first, so network port i is
+ * router port hosts_per_router + i.
+ *
+ * Route record (router r, destination router d), record_bytes long:
+ *
+ *   uint8_t  distance                      router hops from r to d
+ *   uint8_t  min_count                     used entries in min_port
+ *   uint8_t  nonmin_count                  used entries in nonmin_port
+ *   uint8_t  reserved
+ *   uint16_t min_port[min_slots]           network ports one hop closer to d
+ *   uint16_t nonmin_port[nonmin_slots]     other network ports, shortest detour first
+ *   uint8_t  nonmin_hops[nonmin_slots]     total hops to d when leaving on nonmin_port
+ *   uint8_t  bcast_ports[bcast_bytes]      bitmask of network ports to forward a
+ *                                          broadcast that started at router d
+ *
+ * A router only needs its own rows, so each one reads routers * record_bytes
+ * bytes starting at tables_offset + r * routers * record_bytes.
+ */
+
+namespace SST {
+namespace Merlin {
+namespace RouteTable {
+
+static const uint32_t FileMagic = 0x4254524d;   // "MRTB"
+static const uint16_t FileVersion = 1;
+static const uint32_t NO_PEER = 0xffffffff;
+static const uint16_t NO_PORT = 0xffff;
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t routers;
+    uint32_t hosts_per_router;
+    uint32_t network_ports;     // Router to router ports on each router
+    uint16_t min_slots;
+    uint16_t nonmin_slots;
+    uint16_t diameter;
+    uint16_t max_hops;          // Longest route that starts with a non-minimal hop
+    uint32_t record_bytes;
+    uint64_t links_offset;
+    uint64_t tables_offset;
+};
+static_assert(sizeof(FileHeader) == 48, "RouteTable::FileHeader must be 48 bytes");
+
+struct LinkRecord {
+    uint32_t peer_router;
+    uint16_t peer_port;         // Network port index on peer_router
+    uint16_t reserved;
+};
+static_assert(sizeof(LinkRecord) == 8, "RouteTable::LinkRecord must be 8 bytes");
+
+/* Offsets of the fields of a route record */
+struct RecordLayout {
+    size_t min_port;
+    size_t nonmin_port;
+    size_t nonmin_hops;
+    size_t bcast_ports;
+    size_t bcast_bytes;
+    size_t bytes;
+
+    RecordLayout(uint32_t network_ports, uint16_t min_slots, uint16_t nonmin_slots) {
+        min_port = 4;
+        nonmin_port = min_port + 2 * min_slots;
+        nonmin_hops = nonmin_port + 2 * nonmin_slots;
+        bcast_ports = nonmin_hops + nonmin_slots;
+        bcast_bytes = (network_ports + 7) / 8;
+        bytes = (bcast_ports + bcast_bytes + 3) & ~((size_t) 3);
+    }
+};
+
+}
+}
+}
+
+#endif // COMPONENTS_MERLIN_TOPOLOGY_TABLE_FORMAT_H
@@ -0,0 +1,359 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Builds the route table file used by the merlin.table topology from a list
+// of router to router links.
+
+#include <sst_config.h>
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "table_format.h"
+
+using namespace SST::Merlin;
+
+static void printUsage() {
+    printf("sst-merlin-tablegen [options] <edge list> <route table>\n");
+    printf("\n");
+    printf("The edge list has one router to router link per line, given as the two router\n");
+    printf("ids separated by whitespace. Repeating a pair adds parallel links. Text after a\n");
+    printf("'#' is ignored. Network ports are numbered in the order the links are listed.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("  -p <hosts>    Endpoints attached to each router (default 1)\n");
+    printf("  -n <routers>  Number of routers, default: highest router id in the edge list + 1\n");
+    printf("  -m <slots>    Minimal next hops kept per destination (default 4)\n");
+    printf("  -k <slots>    Non-minimal next hops kept per destination (default 4)\n");
+    printf("  -x <hops>     Longest detour, in extra hops, a non-minimal next hop may add (default 2)\n");
+    printf("\n");
+}
+
+struct Port {
+    uint32_t peer;
+    uint16_t peer_port;
+};
+
+// Router graph in compressed adjacency form, ports of router r are
+// ports[first[r]] .. ports[first[r+1]-1]
+struct Graph {
+    uint32_t routers;
+    uint32_t network_ports;
+    std::vector<uint32_t> first;
+    std::vector<Port> ports;
+
+    uint32_t degree(uint32_t r) const { return first[r+1] - first[r]; }
+    const Port& port(uint32_t r, uint32_t i) const { return ports[first[r] + i]; }
+};
+
+static bool readEdges(const std::string& path, uint32_t routers, Graph& graph) {
+    FILE* input = fopen(path.c_str(), "rt");
+    if ( NULL == input ) {
+        fprintf(stderr, "Error: unable to open %s\n", path.c_str());
+        return false;
+    }
+
+    std::vector<std::pair<uint32_t,uint32_t> > edges;
+    uint32_t highest = 0;
+    char line[1024];
+    int line_no = 0;
+    while ( fgets(line, sizeof(line), input) != NULL ) {
+        line_no++;
+        char* comment = strchr(line, '#');
+        if ( comment ) *comment = '\0';
+
+        unsigned long a, b;
+        char extra;
+        int fields = sscanf(line, " %lu %lu %c", &a, &b, &extra);
+        if ( fields <= 0 ) continue;
+        if ( fields != 2 ) {
+            fprintf(stderr, "Error: %s:%d: expected two router ids\n", path.c_str(), line_no);
+            fclose(input);
+            return false;
+        }
+        if ( a == b ) {
+            fprintf(stderr, "Error: %s:%d: router %lu is linked to itself\n", path.c_str(), line_no, a);
+            fclose(input);
+            return false;
+        }
+        edges.push_back(std::make_pair((uint32_t) a, (uint32_t) b));
+        highest = std::max(highest, (uint32_t) std::max(a, b));
+    }
+    fclose(input);
+
+    if ( routers == 0 ) routers = edges.empty() ? 1 : highest + 1;
+    if ( !edges.empty() && highest >= routers ) {
+        fprintf(stderr, "Error: edge list names router %" PRIu32 " but there are only %" PRIu32 " routers\n", highest, routers);
+        return false;
+    }
+
+    std::vector<uint32_t> degree(routers, 0);
+    for ( auto& e : edges ) {
+        degree[e.first]++;
+        degree[e.second]++;
+    }
+
+    graph.routers = routers;
+    graph.network_ports = 0;
+    graph.first.assign(routers + 1, 0);
+    for ( uint32_t r = 0; r < routers; ++r ) {
+        graph.first[r+1] = graph.first[r] + degree[r];
+        graph.network_ports = std::max(graph.network_ports, degree[r]);
+    }
+    if ( graph.network_ports >= RouteTable::NO_PORT ) {
+        fprintf(stderr, "Error: a router has %" PRIu32 " links, at most %d are supported\n", graph.network_ports, RouteTable::NO_PORT - 1);
+        return false;
+    }
+
+    graph.ports.resize(graph.first[routers]);
+    std::vector<uint32_t> used(routers, 0);
+    for ( auto& e : edges ) {
+        uint32_t pa = used[e.first]++;
+        uint32_t pb = used[e.second]++;
+        graph.ports[graph.first[e.first] + pa] = { e.second, (uint16_t) pb };
+        graph.ports[graph.first[e.second] + pb] = { e.first, (uint16_t) pa };
+    }
+    return true;
+}
+
+// Distances, in router hops, from every router to dest
+static void bfs(const Graph& graph, uint32_t dest, std::vector<uint32_t>& dist, std::vector<uint32_t>& queue) {
+    std::fill(dist.begin(), dist.end(), UINT32_MAX);
+    size_t head = 0, tail = 0;
+    dist[dest] = 0;
+    queue[tail++] = dest;
+    while ( head < tail ) {
+        uint32_t r = queue[head++];
+        for ( uint32_t i = 0; i < graph.degree(r); ++i ) {
+            uint32_t n = graph.port(r, i).peer;
+            if ( dist[n] == UINT32_MAX ) {
+                dist[n] = dist[r] + 1;
+                queue[tail++] = n;
+            }
+        }
+    }
+}
+
+// Network ports of r one hop closer to dest. The candidates are rotated by
+// dest so that destinations reached through the same set of neighbors do not
+// all favor the same port.
+static uint32_t minimalPorts(const Graph& graph, uint32_t r, uint32_t dest, const std::vector<uint32_t>& dist,
+                             uint32_t slots, uint16_t* out) {
+    uint16_t candidates[RouteTable::NO_PORT];
+    uint32_t count = 0;
+    for ( uint32_t i = 0; i < graph.degree(r); ++i ) {
+        if ( dist[graph.port(r, i).peer] + 1 == dist[r] ) candidates[count++] = i;
+    }
+    if ( count == 0 ) return 0;
+
+    uint32_t used = std::min(count, slots);
+    for ( uint32_t i = 0; i < used; ++i ) {
+        out[i] = candidates[(dest + i) % count];
+    }
+    return used;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t hosts_per_router = 1;
+    uint32_t routers = 0;
+    uint32_t min_slots = 4;
+    uint32_t nonmin_slots = 4;
+    uint32_t max_extra = 2;
+
+    int opt;
+    while ( (opt = getopt(argc, argv, "p:n:m:k:x:h")) != -1 ) {
+        switch ( opt ) {
+        case 'p': hosts_per_router = strtoul(optarg, NULL, 0); break;
+        case 'n': routers = strtoul(optarg, NULL, 0); break;
+        case 'm': min_slots = strtoul(optarg, NULL, 0); break;
+        case 'k': nonmin_slots = strtoul(optarg, NULL, 0); break;
+        case 'x': max_extra = strtoul(optarg, NULL, 0); break;
+        case 'h':
+            printUsage();
+            return 0;
+        default:
+            printUsage();
+            return -1;
+        }
+    }
+
+    if ( argc - optind != 2 ) {
+        printUsage();
+        return -1;
+    }
+    if ( hosts_per_router == 0 || min_slots == 0 || min_slots > 255 || nonmin_slots > 255 ) {
+        fprintf(stderr, "Error: need at least one host per router and between 1 and 255 minimal slots, at most 255 non-minimal slots\n");
+        return -1;
+    }
+
+    Graph graph;
+    if ( !readEdges(argv[optind], routers, graph) ) {
+        return -1;
+    }
+    routers = graph.routers;
+
+    RouteTable::FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RouteTable::FileMagic;
+    header.version = RouteTable::FileVersion;
+    header.routers = routers;
+    header.hosts_per_router = hosts_per_router;
+    header.network_ports = graph.network_ports;
+    header.min_slots = min_slots;
+    header.nonmin_slots = nonmin_slots;
+
+    const RouteTable::RecordLayout layout(graph.network_ports, min_slots, nonmin_slots);
+    header.record_bytes = layout.bytes;
+    header.links_offset = sizeof(header);
+    header.tables_offset = header.links_offset + (uint64_t) routers * graph.network_ports * sizeof(RouteTable::LinkRecord);
+    const uint64_t file_size = header.tables_offset + (uint64_t) routers * routers * layout.bytes;
+
+    // The tables are written one destination at a time, which touches every
+    // router's row, so map the file rather than hold it all in memory
+    const char* out_path = argv[optind + 1];
+    int fd = open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if ( fd < 0 || ftruncate(fd, file_size) != 0 ) {
+        fprintf(stderr, "Error: unable to create %s (%" PRIu64 " bytes)\n", out_path, file_size);
+        return -1;
+    }
+    uint8_t* file = (uint8_t*) mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if ( file == MAP_FAILED ) {
+        fprintf(stderr, "Error: unable to map %s\n", out_path);
+        return -1;
+    }
+
+    RouteTable::LinkRecord* links = (RouteTable::LinkRecord*) (file + header.links_offset);
+    for ( uint32_t r = 0; r < routers; ++r ) {
+        for ( uint32_t i = 0; i < graph.network_ports; ++i ) {
+            RouteTable::LinkRecord& link = links[(uint64_t) r * graph.network_ports + i];
+            link.peer_router = i < graph.degree(r) ? graph.port(r, i).peer : RouteTable::NO_PEER;
+            link.peer_port = i < graph.degree(r) ? graph.port(r, i).peer_port : RouteTable::NO_PORT;
+            link.reserved = 0;
+        }
+    }
+
+    std::vector<uint32_t> dist(routers);
+    std::vector<uint32_t> queue(routers);
+    std::vector<uint16_t> parent_port(routers);
+    std::vector<std::pair<uint32_t,uint16_t> > detours;
+    uint32_t diameter = 0;
+    uint32_t max_hops = 0;
+    uint64_t total_dist = 0;
+    uint64_t total_min = 0;
+    uint64_t total_nonmin = 0;
+
+    for ( uint32_t d = 0; d < routers; ++d ) {
+        bfs(graph, d, dist, queue);
+
+        // Broadcasts from d follow the tree formed by each router's first minimal port toward d
+        for ( uint32_t r = 0; r < routers; ++r ) {
+            if ( dist[r] == UINT32_MAX ) {
+                fprintf(stderr, "Error: router %" PRIu32 " cannot reach router %" PRIu32 ", the graph is not connected\n", r, d);
+                return -1;
+            }
+            if ( dist[r] > 254 ) {
+                fprintf(stderr, "Error: routers %" PRIu32 " and %" PRIu32 " are %" PRIu32 " hops apart, at most 254 are supported\n", r, d, dist[r]);
+                return -1;
+            }
+            diameter = std::max(diameter, dist[r]);
+            total_dist += dist[r];
+            parent_port[r] = RouteTable::NO_PORT;
+            minimalPorts(graph, r, d, dist, 1, &parent_port[r]);
+        }
+
+        for ( uint32_t r = 0; r < routers; ++r ) {
+            uint8_t* rec = file + header.tables_offset + ((uint64_t) r * routers + d) * layout.bytes;
+            uint16_t* min_port = (uint16_t*) (rec + layout.min_port);
+            uint16_t* nonmin_port = (uint16_t*) (rec + layout.nonmin_port);
+            uint8_t* nonmin_hops = rec + layout.nonmin_hops;
+            uint8_t* bcast = rec + layout.bcast_ports;
+
+            uint32_t min_count = minimalPorts(graph, r, d, dist, min_slots, min_port);
+            for ( uint32_t i = min_count; i < min_slots; ++i ) min_port[i] = RouteTable::NO_PORT;
+
+            // Non-minimal next hops: the shortest route through each other
+            // neighbor, shortest first, as long as it is within max_extra hops
+            // of the minimal route
+            detours.clear();
+            if ( r != d ) {
+                for ( uint32_t i = 0; i < graph.degree(r); ++i ) {
+                    uint32_t hops = 1 + dist[graph.port(r, i).peer];
+                    if ( hops > dist[r] && hops <= dist[r] + max_extra ) {
+                        detours.push_back(std::make_pair(hops, (uint16_t) i));
+                    }
+                }
+                uint32_t deg = graph.degree(r);
+                std::sort(detours.begin(), detours.end(),
+                          [d, deg](const std::pair<uint32_t,uint16_t>& a, const std::pair<uint32_t,uint16_t>& b) {
+                              if ( a.first != b.first ) return a.first < b.first;
+                              return (a.second + d) % deg < (b.second + d) % deg;
+                          });
+            }
+            uint32_t nonmin_count = std::min((uint32_t) detours.size(), nonmin_slots);
+            for ( uint32_t i = 0; i < nonmin_slots; ++i ) {
+                nonmin_port[i] = i < nonmin_count ? detours[i].second : RouteTable::NO_PORT;
+                nonmin_hops[i] = i < nonmin_count ? detours[i].first : 0;
+                if ( i < nonmin_count ) max_hops = std::max(max_hops, detours[i].first);
+            }
+
+            memset(bcast, 0, layout.bcast_bytes);
+            for ( uint32_t i = 0; i < graph.degree(r); ++i ) {
+                const Port& p = graph.port(r, i);
+                if ( parent_port[p.peer] == p.peer_port ) bcast[i / 8] |= 1 << (i % 8);
+            }
+
+            rec[0] = dist[r];
+            rec[1] = min_count;
+            rec[2] = nonmin_count;
+            rec[3] = 0;
+
+            total_min += min_count;
+            total_nonmin += nonmin_count;
+        }
+    }
+
+    if ( max_hops > 255 ) {
+        fprintf(stderr, "Error: non-minimal routes of %" PRIu32 " hops, at most 255 are supported\n", max_hops);
+        return -1;
+    }
+    header.diameter = diameter;
+    header.max_hops = max_hops;
+    memcpy(file, &header, sizeof(header));
+
+    munmap(file, file_size);
+    close(fd);
+
+    const double pairs = (double) routers * routers;
+    printf("Routers:              %" PRIu32 " (%" PRIu32 " hosts each)\n", routers, hosts_per_router);
+    printf("Links:                %zu\n", graph.ports.size() / 2);
+    printf("Network ports:        %" PRIu32 "\n", graph.network_ports);
+    printf("Diameter:             %" PRIu32 "\n", diameter);
+    printf("Average distance:     %.3f\n", routers > 1 ? total_dist / (pairs - routers) : 0.0);
+    printf("Minimal next hops:    %.2f per destination\n", total_min / pairs);
+    printf("Non-minimal hops:     %.2f per destination\n", total_nonmin / pairs);
+    printf("VCs per VN:           %" PRIu32 " minimal, %" PRIu32 " ugal\n",
+           std::max(diameter, (uint32_t) 1), std::max(std::max(diameter, max_hops), (uint32_t) 1));
+    printf("Table size:           %" PRIu64 " bytes (%zu bytes per route)\n", file_size, layout.bytes);
+    return 0;
+}
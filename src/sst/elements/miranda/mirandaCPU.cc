@@ -71,6 +71,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
         stdMemHandlers = new StdMemHandler(this, out);
 
 	maxOpLookup = params.find<uint64_t>("max_reorder_lookups", 16);
+	scoreboard = new MirandaScoreboard(maxOpLookup);
 
 	out->verbose(CALL_INFO, 1, 0, "Loaded memory interface successfully.\n");
 
@@ -168,6 +169,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 }
 
 RequestGenCPU::~RequestGenCPU() {
+	delete scoreboard;
 	delete out;
 }
 
@@ -216,7 +218,7 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 	out->verbose(CALL_INFO, 2, 0, "Recv event for processing from interface\n");
 
         Interfaces::StandardMem::Request::id_t reqID = ev->getID();
-	std::map<Interfaces::StandardMem::Request::id_t, CPURequest*>::iterator reqFind = requestsInFlight.find(reqID);
+	auto reqFind = requestsInFlight.find(reqID);
 
 	if(reqFind == requestsInFlight.end()) {
 		out->fatal(CALL_INFO, -1, "Unable to find request %" PRIu64 " in request map.\n", reqID);
@@ -241,10 +243,8 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 			out->verbose(CALL_INFO, 4, 0, "-> Entry has all parts satisfied, removing ID=%" PRIu64 ", total processing time: %" PRIu64 "ns\n",
 				cpuReq->getOriginalReqID(), (getCurrentSimTimeNano() - cpuReq->getIssueTime()));
 
-			// Notify every pending request that there may be a satisfied dependency
-			for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
-			}
+			// Wake any pending requests which are waiting on this one
+			scoreboard->complete(cpuReq->getOriginalReqID());
 
 			delete cpuReq;
 		}
@@ -391,7 +391,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     statCycles->addData(1);
 
     if (reqGen->isFinished()) {
-        if ( (pendingRequests.size() == 0) &&
+        if ( scoreboard->empty() &&
                 (0 == requestsPending[READ]) &&
                 (0 == requestsPending[WRITE]) &&
                 (0 == requestsPending[CUSTOM]) ) {
@@ -437,104 +437,109 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
-    for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
+    for(uint32_t i = scoreboard->size(); i < maxOpLookup; ++i) {
         if( reqGen->isFinished()) {
             break;
     	} else {
             reqGen->generate(&pendingRequests);
     	}
     }
+    scoreboard->insert(&pendingRequests);
 
-    for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-        if(reqsIssuedThisCycle == reqMaxPerCycle) {
-            statMaxIssuePerCycle->addData(1);
-            break;
-    	}
-
-	// Only a certain number of lookups are allowed, if we exceed this then we
-        // must exit the issue loop
-    	if(i == maxOpLookup) {
-            out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
-            statCyclesHitReorderLimit->addData(1);
-            break;
-    	}
+    // Requests are considered oldest first. Issue stops at the first request outside the
+    // reorder window, at the first fence, or at the first load/store for which all slots are
+    // occupied, so find the oldest of those and only look at ready requests ahead of it.
+    MirandaScoreboard::Entry* const windowEnd = scoreboard->windowEnd();
+    MirandaScoreboard::Entry* stopAt = windowEnd;
 
-	GeneratorRequest* nxtRq = pendingRequests.at(i);
-        ReqOperation op = nxtRq->getOperation();
+    stopAt = MirandaScoreboard::older(stopAt, scoreboard->firstOf(REQ_FENCE));
+    if( requestsPending[READ] >= maxRequestsPending[READ] ) {
+        stopAt = MirandaScoreboard::older(stopAt, scoreboard->firstOf(READ));
+    }
+    if( requestsPending[WRITE] >= maxRequestsPending[WRITE] ) {
+        stopAt = MirandaScoreboard::older(stopAt, scoreboard->firstOf(WRITE));
+    }
 
-	if(op == REQ_FENCE) {
-            if(0 == requestsInFlight.size()) {
-		out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
+    bool hitIssueLimit = false;
+    if( (0 == reqMaxPerCycle) && !scoreboard->empty() ) {
+        statMaxIssuePerCycle->addData(1);
+        hitIssueLimit = true;
+    }
 
-                // Keep record we will delete fence at i
-    		delReqs.push_back(i);
+    while( !hitIssueLimit ) {
+        MirandaScoreboard::Entry* nxt = NULL;
 
-                // Delete the fence
-    		delete nxtRq;
-            } else {
-                out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
+        for(const ReqOperation op : { READ, WRITE, CUSTOM }) {
+            if( op == CUSTOM && requestsPending[CUSTOM] >= maxRequestsPending[CUSTOM] ) {
+                continue;
             }
 
-            statCyclesHitFence->addData(1);
+            MirandaScoreboard::Entry* candidate = scoreboard->peekReady(op);
+            if( NULL != candidate && (NULL == stopAt || candidate->seq < stopAt->seq) &&
+                    (NULL == nxt || candidate->seq < nxt->seq) ) {
+                nxt = candidate;
+            }
+        }
 
-            // Fence operations do now allow anything else to complete in this cycle
+        if( NULL == nxt ) {
             break;
-        } else if (op == CUSTOM) {
-            if (requestsPending[CUSTOM] < maxRequestsPending[CUSTOM]) {
-                out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
+        }
 
-		if(nxtRq->canIssue()) {
-                    issued = true;
-                    reqsIssuedThisCycle++;
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
-                            nxtRq->getRequestID(), reqsIssuedThisCycle);
+        scoreboard->popReady(nxt->op);
 
-    		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
+        issued = true;
+        reqsIssuedThisCycle++;
+        out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
+                nxt->req->getRequestID(), reqsIssuedThisCycle);
 
-                    issueCustomRequest(static_cast<CustomOpRequest*>(nxtRq));
+        if( nxt->op == CUSTOM ) {
+            issueCustomRequest(static_cast<CustomOpRequest*>(nxt->req));
+        } else {
+            issueRequest(static_cast<MemoryOpRequest*>(nxt->req));
 
-                    delete nxtRq;
-                }
+            // Once the slots fill up nothing is issued past the next request of the same type
+            if( requestsPending[nxt->op] >= maxRequestsPending[nxt->op] ) {
+                stopAt = MirandaScoreboard::older(stopAt, nxt->opNext);
             }
-        } else if (op == READ || op == WRITE) {
-            if( requestsPending[op] < maxRequestsPending[op] ) {
-                auto memOpReq = static_cast<MemoryOpRequest*>(nxtRq);
-                out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
-
-
-		if(nxtRq->canIssue()) {
-                    issued = true;
-                    reqsIssuedThisCycle++;
+        }
 
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " encountered, cleared to be issued, %" PRIu32 " issued this cycle.\n",
-                            nxtRq->getRequestID(), reqsIssuedThisCycle);
+        const bool moreRequests = (NULL != nxt->next);
+        scoreboard->remove(nxt);
+        delete nxt->req;
 
-    		    // Keep record we will delete at index i
-                    delReqs.push_back(i);
+        if( reqsIssuedThisCycle == reqMaxPerCycle ) {
+            if( moreRequests ) {
+                statMaxIssuePerCycle->addData(1);
+            }
+            hitIssueLimit = true;
+        }
+    }
 
-                    issueRequest(memOpReq);
+    if( !hitIssueLimit && NULL != stopAt ) {
+        if( stopAt == windowEnd ) {
+            out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
+            statCyclesHitReorderLimit->addData(1);
+        } else if( stopAt->op == REQ_FENCE ) {
+            if(0 == requestsInFlight.size()) {
+                out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
 
-                    delete nxtRq;
-		} else {
-                    out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " in queue, has dependencies which are not satisfied, wait.\n",
-                            nxtRq->getRequestID());
-                }
-    	    } else {
-                out->verbose(CALL_INFO, 4, 0, "All load/store/custom slots occupied, no more issues will be attempted.\n");
-    	        break;
+                GeneratorRequest* fence = stopAt->req;
+                scoreboard->remove(stopAt);
+                scoreboard->complete(fence->getRequestID());
+                delete fence;
+            } else {
+                out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
             }
-	} else {
-            out->fatal(CALL_INFO, -1, "Error, invalid operation \n");
+
+            statCyclesHitFence->addData(1);
+        } else {
+            out->verbose(CALL_INFO, 4, 0, "All load/store/custom slots occupied, no more issues will be attempted.\n");
         }
     }
 
-    pendingRequests.erase(delReqs);
-
     if(issued) {
 	statCyclesWithIssue->addData(1);
     } else {
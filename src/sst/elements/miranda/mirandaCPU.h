@@ -23,6 +23,9 @@
 #include "mirandaGenerator.h"
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
+#include "mirandaScoreboard.h"
+
+#include <unordered_map>
 
 using namespace SST;
 using namespace SST::Interfaces;
@@ -141,13 +144,14 @@ private:
     TimeConverter* timeConverter;
     Clock::HandlerBase* clockHandler;
     RequestGenerator* reqGen;
-    std::map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
+    std::unordered_map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
     StandardMem* cache_link;
     Link* srcLink;
     MirandaReqEvent* srcReqEvent;
     StdMemHandler* stdMemHandlers;
 
-    MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+    MirandaRequestQueue<GeneratorRequest*> pendingRequests;     // Filled by the generator, drained into the scoreboard each cycle
+    MirandaScoreboard* scoreboard;
     MirandaMemoryManager* memMgr;
 
     uint32_t maxRequestsPending[OPCOUNT];
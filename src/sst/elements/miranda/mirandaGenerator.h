@@ -70,6 +70,10 @@ public:
 		return dependsOn.empty();
 	}
 
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
+	}
+
 	uint64_t getIssueTime() const {
 		return issueTime;
 	}
@@ -124,6 +128,10 @@ public:
 		return maxCapacity;
 	}
 
+	void clear() {
+		curSize = 0;
+	}
+
        	QueueType at(const uint32_t index) {
                	return theQ[index];
        	}
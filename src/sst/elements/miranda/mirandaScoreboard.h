@@ -0,0 +1,290 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_SCOREBOARD
+#define _H_SST_MIRANDA_SCOREBOARD
+
+#include <stdint.h>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "mirandaGenerator.h"
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Tracks the requests a generator has produced but the CPU has not yet issued.
+ *
+ * Pending requests are kept in generation order on a list (and on one list per
+ * operation type) so the first entries form the reorder window. Each request
+ * counts the producers it still waits on; producers hold an intrusive list of
+ * their waiters and wake them when they complete, at which point a waiter with
+ * nothing left to wait on moves to the ready queue for its operation. Ready
+ * queues are ordered by age, so the CPU only has to look at ready requests
+ * and a handful of window boundaries rather than scan the whole window.
+ */
+class MirandaScoreboard {
+public:
+	struct Entry;
+
+	/* One edge of the dependency graph, on the producer's waiter list */
+	struct WaitLink {
+		Entry* waiter;
+		WaitLink* next;
+	};
+
+	struct Entry {
+		GeneratorRequest* req;
+		uint64_t seq;                   // Position in generation order
+		ReqOperation op;
+		uint32_t waiting;               // Producers not yet completed
+		WaitLink* waiters;
+		bool pending;                   // Not yet issued
+		bool inWindow;
+		Entry* prev;
+		Entry* next;
+		Entry* opPrev;
+		Entry* opNext;
+	};
+
+	MirandaScoreboard(const uint32_t windowSize) :
+		windowSize(windowSize), windowCount(0), pendingCount(0), nextSeq(0),
+		head(nullptr), tail(nullptr), windowEndEntry(nullptr), freeLinks(nullptr) {
+		for(int i = 0; i < OPCOUNT; ++i) {
+			opHead[i] = opTail[i] = nullptr;
+		}
+	}
+
+	~MirandaScoreboard() {
+		for(auto it = producers.begin(); it != producers.end(); ++it) {
+			releaseLinks(it->second);
+			delete it->second;
+		}
+		for(auto it = freeEntries.begin(); it != freeEntries.end(); ++it) {
+			delete *it;
+		}
+		for(auto it = linkChunks.begin(); it != linkChunks.end(); ++it) {
+			delete[] *it;
+		}
+	}
+
+	/* Move everything the generator pushed onto q into the scoreboard and empty q */
+	void insert(MirandaRequestQueue<GeneratorRequest*>* q) {
+		const uint32_t count = q->size();
+		const uint64_t firstSeq = nextSeq;
+
+		// Register every new request first so dependencies resolve regardless of push order
+		for(uint32_t i = 0; i < count; ++i) {
+			append(q->at(i));
+		}
+
+		for(Entry* e = tail; e != nullptr && e->seq >= firstSeq; e = e->prev) {
+			// Fences retire without regard to their dependencies
+			if(e->op != REQ_FENCE) {
+				const std::vector<uint64_t>& deps = e->req->getDependencies();
+				for(auto dep = deps.begin(); dep != deps.end(); ++dep) {
+					auto producer = producers.find(*dep);
+					if(producer != producers.end() && producer->second != e) {
+						WaitLink* link = allocLink();
+						link->waiter = e;
+						link->next = producer->second->waiters;
+						producer->second->waiters = link;
+						e->waiting++;
+					}
+				}
+			}
+		}
+
+		for(Entry* e = tail; e != nullptr && e->seq >= firstSeq; e = e->prev) {
+			if(0 == e->waiting && e->op != REQ_FENCE) {
+				ready[e->op].push(e);
+			}
+		}
+
+		q->clear();
+	}
+
+	uint32_t size() const { return pendingCount; }
+	bool empty() const { return 0 == pendingCount; }
+
+	/* Oldest pending request */
+	Entry* front() const { return head; }
+
+	/* First pending request beyond the reorder window, nullptr if the window holds them all */
+	Entry* windowEnd() const { return windowEndEntry; }
+
+	/* Oldest pending request of an operation type */
+	Entry* firstOf(const ReqOperation op) const { return opHead[op]; }
+
+	/* Oldest request of an operation type with all dependencies satisfied */
+	Entry* peekReady(const ReqOperation op) const {
+		return ready[op].empty() ? nullptr : ready[op].top();
+	}
+
+	void popReady(const ReqOperation op) {
+		ready[op].pop();
+	}
+
+	/* Whichever of two pending requests was generated first, nullptr counts as youngest */
+	static Entry* older(Entry* a, Entry* b) {
+		if(a == nullptr) return b;
+		if(b == nullptr) return a;
+		return a->seq <= b->seq ? a : b;
+	}
+
+	/*
+	 * Take an issued or retired request out of the pending order. The entry
+	 * stays registered as a producer until complete() is called for it.
+	 */
+	void remove(Entry* e) {
+		if(e->inWindow) {
+			windowCount--;
+			if(windowEndEntry != nullptr) {
+				windowEndEntry->inWindow = true;
+				windowCount++;
+				windowEndEntry = windowEndEntry->next;
+			}
+		} else if(e == windowEndEntry) {
+			windowEndEntry = e->next;
+		}
+
+		if(e->prev) e->prev->next = e->next; else head = e->next;
+		if(e->next) e->next->prev = e->prev; else tail = e->prev;
+		if(e->opPrev) e->opPrev->opNext = e->opNext; else opHead[e->op] = e->opNext;
+		if(e->opNext) e->opNext->opPrev = e->opPrev; else opTail[e->op] = e->opPrev;
+
+		e->pending = false;
+		e->inWindow = false;
+		pendingCount--;
+	}
+
+	/* Request reqID has completed, wake anything waiting on it */
+	void complete(const uint64_t reqID) {
+		auto producer = producers.find(reqID);
+		if(producer == producers.end()) {
+			return;
+		}
+
+		Entry* e = producer->second;
+		producers.erase(producer);
+
+		for(WaitLink* link = e->waiters; link != nullptr; link = link->next) {
+			Entry* waiter = link->waiter;
+			if(0 == --waiter->waiting && waiter->pending) {
+				ready[waiter->op].push(waiter);
+			}
+		}
+
+		releaseLinks(e);
+		freeEntries.push_back(e);
+	}
+
+private:
+	struct OlderFirst {
+		bool operator()(const Entry* a, const Entry* b) const {
+			return a->seq > b->seq;
+		}
+	};
+
+	void append(GeneratorRequest* req) {
+		Entry* e;
+		if(freeEntries.empty()) {
+			e = new Entry();
+		} else {
+			e = freeEntries.back();
+			freeEntries.pop_back();
+		}
+
+		e->req = req;
+		e->seq = nextSeq++;
+		e->op = req->getOperation();
+		e->waiting = 0;
+		e->waiters = nullptr;
+		e->pending = true;
+
+		e->prev = tail;
+		e->next = nullptr;
+		if(tail) tail->next = e; else head = e;
+		tail = e;
+
+		e->opPrev = opTail[e->op];
+		e->opNext = nullptr;
+		if(opTail[e->op]) opTail[e->op]->opNext = e; else opHead[e->op] = e;
+		opTail[e->op] = e;
+
+		if(windowCount < windowSize) {
+			e->inWindow = true;
+			windowCount++;
+		} else {
+			e->inWindow = false;
+			if(windowEndEntry == nullptr) {
+				windowEndEntry = e;
+			}
+		}
+
+		pendingCount++;
+		producers[req->getRequestID()] = e;
+	}
+
+	WaitLink* allocLink() {
+		if(freeLinks == nullptr) {
+			WaitLink* chunk = new WaitLink[256];
+			linkChunks.push_back(chunk);
+			for(int i = 0; i < 256; ++i) {
+				chunk[i].next = freeLinks;
+				freeLinks = &chunk[i];
+			}
+		}
+
+		WaitLink* link = freeLinks;
+		freeLinks = link->next;
+		return link;
+	}
+
+	void releaseLinks(Entry* e) {
+		while(e->waiters != nullptr) {
+			WaitLink* link = e->waiters;
+			e->waiters = link->next;
+			link->next = freeLinks;
+			freeLinks = link;
+		}
+	}
+
+	const uint32_t windowSize;
+	uint32_t windowCount;
+	uint32_t pendingCount;
+	uint64_t nextSeq;
+
+	Entry* head;
+	Entry* tail;
+	Entry* windowEndEntry;
+	Entry* opHead[OPCOUNT];
+	Entry* opTail[OPCOUNT];
+
+	std::priority_queue<Entry*, std::vector<Entry*>, OlderFirst> ready[OPCOUNT];
+	std::unordered_map<uint64_t, Entry*> producers;     // Requests that have not completed, by request ID
+
+	std::vector<Entry*> freeEntries;
+	WaitLink* freeLinks;
+	std::vector<WaitLink*> linkChunks;
+};
+
+}
+}
+
+#endif
@@ -112,6 +112,10 @@ uint64_t MemoryManagerOpal::translateAddress(uint64_t virtAddr) {
     return temp_translator->translateAddress(virtAddr);
 }
 
+uint64_t MemoryManagerOpal::translateAddressForCore(uint64_t virtAddr, uint32_t core) {
+    return temp_translator->translateAddressForCore(virtAddr, core);
+}
+
 void MemoryManagerOpal::printStats() {
     temp_translator->printStats();
 }
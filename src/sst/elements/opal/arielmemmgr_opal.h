@@ -67,6 +67,7 @@ class MemoryManagerOpal : public ArielComponent::ArielMemoryManager {
         uint32_t getDefaultPool();
 
         uint64_t translateAddress(uint64_t virtAddr);
+        uint64_t translateAddressForCore(uint64_t virtAddr, uint32_t core);
         void printStats();
 
         /* Call through to Opal */
@@ -106,7 +106,7 @@ void OpalMemNIC::processInitMemRtrEvent(MemHierarchy::MemNICBase::InitMemRtrEven
 }
 
 
-std::string OpalMemNIC::findTargetDestination(MemHierarchy::Addr addr) {
+const std::string& OpalMemNIC::findTargetDestination(MemHierarchy::Addr addr) {
     for (std::set<MemHierarchy::MemLinkBase::EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
         if (it->region.contains(addr)) return it->name;
     }
@@ -126,5 +126,5 @@ std::string OpalMemNIC::findTargetDestination(MemHierarchy::Addr addr) {
         error << it->name << " " << it->region.toString() << endl;
     }
     dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-    return "";
+    return noTargetDestination();
 }
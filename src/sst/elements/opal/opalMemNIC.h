@@ -92,7 +92,7 @@ public:
     void finish() { link_control->finish(); }
     void setup() { link_control->setup(); MemLinkBase::setup(); }
 
-    virtual std::string findTargetDestination(MemHierarchy::Addr addr);
+    virtual const std::string& findTargetDestination(MemHierarchy::Addr addr);
 
 protected:
     virtual MemHierarchy::MemNICBase::InitMemRtrEvent* createInitMemRtrEvent();
@@ -0,0 +1,110 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosdeltareader.h"
+
+using namespace SST::Prospero;
+
+
+ProsperoDeltaTraceReader::ProsperoDeltaTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	const uint64_t startCycle = params.find<uint64_t>("start_cycle", 0);
+
+	if (!trace.open(traceFile)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in delta reader: %s\n",
+			getName().c_str(), traceFile.c_str(), trace.error().c_str());
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Opened delta trace %s, %s\n", traceFile.c_str(),
+		trace.hasIndex() ? "indexed" : "no index, trace was not closed cleanly");
+
+	entries.assign(trace.maxBlockRecords(), ProsperoTraceEntry(0, 0, 0, READ));
+	entryCount = 0;
+	nextEntry = 0;
+
+	if (startCycle > 0) {
+		if (!trace.seekCycle(startCycle)) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: unable to seek to cycle %" PRIu64 " in %s\n",
+				getName().c_str(), startCycle, traceFile.c_str());
+		}
+
+		// The block found may start before the requested cycle
+		while (loadBlock()) {
+			while (nextEntry < entryCount && entries[nextEntry].getIssueAtCycle() < startCycle) {
+				nextEntry++;
+			}
+			if (nextEntry < entryCount) {
+				break;
+			}
+		}
+
+		output->verbose(CALL_INFO, 1, 0, "Started trace at record %" PRIu64 " for cycle %" PRIu64 "\n",
+			trace.firstRecordOfBlock() + nextEntry, startCycle);
+	}
+}
+
+ProsperoDeltaTraceReader::~ProsperoDeltaTraceReader() {
+	trace.close();
+}
+
+bool ProsperoDeltaTraceReader::loadBlock() {
+	entryCount = 0;
+	nextEntry = 0;
+
+	if (!trace.readBlock()) {
+		if (!trace.error().empty()) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: error reading delta trace: %s\n",
+				getName().c_str(), trace.error().c_str());
+		}
+		return false;
+	}
+
+	const uint32_t records = trace.block().records;
+	if (records > entries.size()) {
+		entries.resize(records, ProsperoTraceEntry(0, 0, 0, READ));
+	}
+
+	ProsperoTraceEntry* target = entries.data();
+	const bool decoded = trace.decode([target](uint32_t i, uint64_t cycle, uint64_t address, uint32_t length, bool write) {
+		target[i] = ProsperoTraceEntry(cycle, address, length, write ? WRITE : READ);
+	});
+
+	if (!decoded) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: corrupt block at record %" PRIu64 " in delta trace\n",
+			getName().c_str(), trace.firstRecordOfBlock());
+	}
+
+	entryCount = records;
+	return true;
+}
+
+/*
+ * The returned entry lives in the reader's block array and stays valid until
+ * the next call; the component releases it before asking for another.
+ */
+ProsperoTraceEntry* ProsperoDeltaTraceReader::readNextEntry() {
+	while (nextEntry == entryCount) {
+		if (!loadBlock()) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
+	}
+
+	return &entries[nextEntry++];
+}
@@ -0,0 +1,66 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_DELTA_READER
+#define _H_SST_PROSPERO_DELTA_READER
+
+#include "prosreader.h"
+#include "prosdeltatrace.h"
+
+#include <vector>
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Reader for the block delta trace format (see prosdeltatrace.h). Each block
+ * is decoded in one pass into a reusable array of entries.
+ */
+class ProsperoDeltaTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoDeltaTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoDeltaTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+    void releaseEntry(const ProsperoTraceEntry*) {}
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoDeltaTraceReader,
+        "prospero",
+        "ProsperoDeltaTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Block delta trace reader",
+        SST::Prospero::ProsperoTraceReader
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "file", "Sets the file for the trace reader to use", "" },
+        { "start_cycle", "Skip records issued before this cycle, using the block index to seek", "0" }
+    )
+
+private:
+    bool loadBlock();
+
+    DeltaTrace::Reader trace;
+    std::vector<ProsperoTraceEntry> entries;
+    size_t entryCount;
+    size_t nextEntry;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,538 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_DELTA_TRACE
+#define _H_SST_PROSPERO_DELTA_TRACE
+
+/*
+ * Block-oriented delta trace format shared by the Ariel trace generator, the
+ * Prospero reader and the conversion tool. Header only and independent of
+ * SST core so that all three can use it; include sst_config.h first so that
+ * HAVE_LIBZ enables deflate compressed blocks.
+ *
+ * Layout (all integers little endian):
+ *
+ *   FileHeader
+ *   { BlockHeader, payload } ...
+ *   IndexEntry ...                one per block
+ *   Trailer
+ *
+ * A block payload holds four columns, one after the other:
+ *   cycles     delta from the previous record's cycle
+ *   addresses  delta from the previous record's address
+ *   operations one bit per record, set for writes
+ *   lengths    delta from the previous record's length
+ * The first record's deltas are relative to firstCycle, firstAddress and 0.
+ * Deltas are zigzag encoded and stored as varints whose byte counts (0-8)
+ * are kept apart from the value bytes: a column is one 4-bit count per
+ * record, two to a byte, followed by the little endian value bytes. Unlike
+ * continuation-bit varints, where each value's length is only known after
+ * reading it, the next value's position is one add away, which is what lets
+ * a block decode at memory speed. The payload is optionally deflated as a
+ * whole.
+ *
+ * The index and trailer are written when the trace is closed; a trace whose
+ * writer did not finish can still be read front to back, only without
+ * seeking.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace SST {
+namespace Prospero {
+namespace DeltaTrace {
+
+static const uint32_t FileMagic  = 0x44535250;  // "PRSD"
+static const uint32_t BlockMagic = 0x4b4c4244;  // "DBLK"
+static const uint32_t IndexMagic = 0x58444e49;  // "INDX"
+static const uint32_t Version    = 1;
+
+static const uint32_t DefaultBlockRecords = 65536;
+
+enum Codec : uint32_t {
+    CODEC_NONE    = 0,
+    CODEC_DEFLATE = 1
+};
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t blockRecords;      // Most records in any block
+    uint32_t reserved;
+};
+
+struct BlockHeader {
+    uint32_t magic;
+    uint32_t records;
+    uint32_t codec;
+    uint32_t storedBytes;       // Payload size in the file
+    uint32_t cycleBytes;        // Column sizes before compression
+    uint32_t addressBytes;
+    uint32_t lengthBytes;
+    uint32_t reserved;
+    uint64_t firstCycle;
+    uint64_t firstAddress;
+};
+
+struct IndexEntry {
+    uint64_t offset;            // File offset of the block header
+    uint64_t firstRecord;
+    uint64_t firstCycle;
+};
+
+struct Trailer {
+    uint64_t indexOffset;
+    uint64_t blocks;
+    uint64_t records;
+    uint32_t magic;
+    uint32_t version;
+};
+
+static_assert(sizeof(FileHeader) == 16, "DeltaTrace::FileHeader must be packed");
+static_assert(sizeof(BlockHeader) == 48, "DeltaTrace::BlockHeader must be packed");
+static_assert(sizeof(IndexEntry) == 24, "DeltaTrace::IndexEntry must be packed");
+static_assert(sizeof(Trailer) == 32, "DeltaTrace::Trailer must be packed");
+
+inline uint64_t zigzag(int64_t v) { return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return (int64_t) (v >> 1) ^ -(int64_t) (v & 1); }
+
+inline size_t columnBytesBound(size_t count) { return (count + 1) / 2 + count * sizeof(uint64_t); }
+
+/*
+ * Encode 'count' values as zigzag deltas starting from 'base'. Writes up to 8
+ * bytes past the returned end, so 'p' needs that much slack.
+ */
+template<class T>
+uint8_t* encodeColumn(uint8_t* p, const T* values, size_t count, uint64_t base) {
+    uint8_t* counts = p;
+    uint8_t* data = p + (count + 1) / 2;
+    memset(counts, 0, (count + 1) / 2);
+
+    uint64_t prev = base;
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t delta = zigzag((int64_t) ((uint64_t) values[i] - prev));
+        const uint32_t bytes = delta ? (uint32_t) (64 - __builtin_clzll(delta) + 7) / 8 : 0;
+        memcpy(data, &delta, sizeof(delta));
+        data += bytes;
+        counts[i >> 1] |= (uint8_t) (bytes << ((i & 1) * 4));
+        prev = (uint64_t) values[i];
+    }
+    return data;
+}
+
+/*
+ * Decode a column written by encodeColumn. Reads up to 8 bytes past the
+ * column, which the caller must keep readable. Returns false if the column
+ * is corrupt.
+ */
+inline bool decodeColumn(const uint8_t* p, size_t bytes, uint32_t count, uint64_t base, uint64_t* out) {
+    static const uint64_t masks[9] = { 0, 0xffULL, 0xffffULL, 0xffffffULL, 0xffffffffULL, 0xffffffffffULL,
+        0xffffffffffffULL, 0xffffffffffffffULL, ~0ULL };
+
+    const uint8_t* counts = p;
+    const uint8_t* data = p + (count + 1) / 2;
+    const uint8_t* end = p + bytes;
+    if (data > end) {
+        return false;
+    }
+
+    uint64_t value = base;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t n = (counts[i >> 1] >> ((i & 1) * 4)) & 0xf;
+        if (n > 8 || data + n > end) {
+            return false;
+        }
+        uint64_t delta;
+        memcpy(&delta, data, sizeof(delta));
+        data += n;
+        value += (uint64_t) unzigzag(delta & masks[n]);
+        out[i] = value;
+    }
+    return data == end;
+}
+
+/*
+ * Writes a trace, buffering one block of records at a time.
+ * Methods return false on I/O errors; error() describes the failure.
+ */
+class Writer {
+public:
+    Writer() : file(NULL), blockRecords(DefaultBlockRecords), level(0), records(0) {}
+    ~Writer() { close(); }
+
+    /* 'level' is the deflate level, 0 stores blocks uncompressed */
+    bool open(const std::string& path, uint32_t recordsPerBlock = DefaultBlockRecords, int compressionLevel = 0) {
+        blockRecords = std::max(recordsPerBlock, (uint32_t) 1);
+#ifdef HAVE_LIBZ
+        level = std::min(std::max(compressionLevel, 0), 9);
+#else
+        level = 0;
+        (void) compressionLevel;
+#endif
+        file = fopen(path.c_str(), "wb");
+        if (NULL == file) {
+            errorText = "unable to open " + path + " for writing";
+            return false;
+        }
+        setvbuf(file, NULL, _IOFBF, 1024 * 1024);
+
+        cycles.reserve(blockRecords);
+        addresses.reserve(blockRecords);
+        lengths.reserve(blockRecords);
+        writes.reserve(blockRecords);
+
+        const FileHeader header = { FileMagic, Version, blockRecords, 0 };
+        return put(&header, sizeof(header));
+    }
+
+    bool append(uint64_t cycle, uint64_t address, uint32_t length, bool write) {
+        cycles.push_back(cycle);
+        addresses.push_back(address);
+        lengths.push_back(length);
+        writes.push_back(write ? 1 : 0);
+        return cycles.size() < blockRecords || flushBlock();
+    }
+
+    /* Write any buffered records, the index and the trailer */
+    bool close() {
+        if (NULL == file) {
+            return true;
+        }
+
+        bool ok = flushBlock();
+        const uint64_t indexOffset = (uint64_t) ftello(file);
+        ok = ok && (index.empty() || put(index.data(), index.size() * sizeof(IndexEntry)));
+        const Trailer trailer = { indexOffset, (uint64_t) index.size(), records, IndexMagic, Version };
+        ok = ok && put(&trailer, sizeof(trailer));
+
+        if (0 != fclose(file) && ok) {
+            errorText = "error closing trace";
+            ok = false;
+        }
+        file = NULL;
+        return ok;
+    }
+
+    uint64_t recordCount() const { return records; }
+    const std::string& error() const { return errorText; }
+
+private:
+    bool put(const void* data, size_t len) {
+        if (len != fwrite(data, 1, len, file)) {
+            errorText = "error writing trace";
+            return false;
+        }
+        return true;
+    }
+
+    bool flushBlock() {
+        const size_t count = cycles.size();
+        if (0 == count) {
+            return true;
+        }
+
+        // Worst case of 8 bytes per value, plus slack for encodeColumn and decodeColumn
+        raw.resize(3 * columnBytesBound(count) + (count + 7) / 8 + sizeof(uint64_t));
+        uint8_t* p = raw.data();
+
+        BlockHeader header;
+        memset(&header, 0, sizeof(header));
+        header.magic = BlockMagic;
+        header.records = (uint32_t) count;
+        header.firstCycle = cycles[0];
+        header.firstAddress = addresses[0];
+
+        uint8_t* columnStart = p;
+        p = encodeColumn(p, cycles.data(), count, header.firstCycle);
+        header.cycleBytes = (uint32_t) (p - columnStart);
+
+        columnStart = p;
+        p = encodeColumn(p, addresses.data(), count, header.firstAddress);
+        header.addressBytes = (uint32_t) (p - columnStart);
+
+        memset(p, 0, (count + 7) / 8);
+        for (size_t i = 0; i < count; ++i) {
+            p[i >> 3] |= (uint8_t) (writes[i] << (i & 7));
+        }
+        p += (count + 7) / 8;
+
+        columnStart = p;
+        p = encodeColumn(p, lengths.data(), count, 0);
+        header.lengthBytes = (uint32_t) (p - columnStart);
+
+        const uint8_t* payload = raw.data();
+        size_t payloadBytes = p - raw.data();
+        header.codec = CODEC_NONE;
+
+#ifdef HAVE_LIBZ
+        if (level > 0) {
+            uLongf packedBytes = compressBound(payloadBytes);
+            packed.resize(packedBytes);
+            if (Z_OK == compress2(packed.data(), &packedBytes, raw.data(), payloadBytes, level) && packedBytes < payloadBytes) {
+                payload = packed.data();
+                payloadBytes = packedBytes;
+                header.codec = CODEC_DEFLATE;
+            }
+        }
+#endif
+        header.storedBytes = (uint32_t) payloadBytes;
+
+        const IndexEntry entry = { (uint64_t) ftello(file), records, header.firstCycle };
+        index.push_back(entry);
+        records += count;
+
+        cycles.clear();
+        addresses.clear();
+        lengths.clear();
+        writes.clear();
+
+        return put(&header, sizeof(header)) && put(payload, payloadBytes);
+    }
+
+    FILE* file;
+    uint32_t blockRecords;
+    int level;
+    uint64_t records;
+
+    std::vector<uint64_t> cycles;
+    std::vector<uint64_t> addresses;
+    std::vector<uint32_t> lengths;
+    std::vector<uint8_t> writes;
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> packed;
+    std::vector<IndexEntry> index;
+    std::string errorText;
+};
+
+/*
+ * Reads a trace block by block. readBlock() loads the next block and
+ * decode() passes each of its records to a callback, so callers decode
+ * straight into their own storage.
+ */
+class Reader {
+public:
+    Reader() : file(NULL), blockRecords(0), dataEnd(0), totalRecords(0), nextRecord(0) {
+        memset(&current, 0, sizeof(current));
+    }
+    ~Reader() { close(); }
+
+    bool open(const std::string& path) {
+        file = fopen(path.c_str(), "rb");
+        if (NULL == file) {
+            errorText = "unable to open " + path;
+            return false;
+        }
+        setvbuf(file, NULL, _IOFBF, 1024 * 1024);
+
+        FileHeader header;
+        if (1 != fread(&header, sizeof(header), 1, file) || header.magic != FileMagic) {
+            errorText = path + " is not a delta trace";
+            return false;
+        }
+        if (header.version != Version) {
+            errorText = path + " has an unsupported delta trace version";
+            return false;
+        }
+        blockRecords = header.blockRecords;
+
+        // Without a valid trailer the trace is read front to back until the data runs out
+        Trailer trailer;
+        dataEnd = UINT64_MAX;
+        if (0 == fseeko(file, -(off_t) sizeof(trailer), SEEK_END) &&
+                1 == fread(&trailer, sizeof(trailer), 1, file) &&
+                trailer.magic == IndexMagic && trailer.version == Version) {
+            index.resize(trailer.blocks);
+            if (0 == fseeko(file, (off_t) trailer.indexOffset, SEEK_SET) &&
+                    (index.empty() || 1 == fread(index.data(), index.size() * sizeof(IndexEntry), 1, file))) {
+                dataEnd = trailer.indexOffset;
+                totalRecords = trailer.records;
+            } else {
+                index.clear();
+            }
+        }
+
+        return 0 == fseeko(file, (off_t) sizeof(FileHeader), SEEK_SET);
+    }
+
+    void close() {
+        if (NULL != file) {
+            fclose(file);
+            file = NULL;
+        }
+    }
+
+    /* Load the next block, returns false at the end of the trace or on a corrupt block */
+    bool readBlock() {
+        if ((uint64_t) ftello(file) >= dataEnd) {
+            return false;
+        }
+
+        nextRecord += current.records;
+        current.records = 0;
+
+        BlockHeader header;
+        if (1 != fread(&header, sizeof(header), 1, file)) {
+            return false;
+        }
+        if (header.magic != BlockMagic) {
+            errorText = "corrupt block header";
+            return false;
+        }
+
+        // decodeColumn reads up to 8 bytes past the last column
+        stored.resize(header.storedBytes + sizeof(uint64_t));
+        if (header.storedBytes > 0 && 1 != fread(stored.data(), header.storedBytes, 1, file)) {
+            errorText = "truncated block";
+            return false;
+        }
+
+        const size_t rawBytes = (size_t) header.cycleBytes + header.addressBytes +
+            (header.records + 7) / 8 + header.lengthBytes;
+
+        if (header.codec == CODEC_NONE) {
+            if (rawBytes != header.storedBytes) {
+                errorText = "corrupt block sizes";
+                return false;
+            }
+            raw.swap(stored);
+#ifdef HAVE_LIBZ
+        } else if (header.codec == CODEC_DEFLATE) {
+            raw.resize(rawBytes + sizeof(uint64_t));
+            uLongf rawLength = rawBytes;
+            if (Z_OK != uncompress(raw.data(), &rawLength, stored.data(), header.storedBytes) || rawLength != rawBytes) {
+                errorText = "corrupt compressed block";
+                return false;
+            }
+#endif
+        } else {
+            errorText = "block uses an unsupported codec";
+            return false;
+        }
+
+        current = header;
+        return true;
+    }
+
+    /*
+     * Call sink(i, cycle, address, length, isWrite) for every record of the
+     * loaded block. Returns false if the block does not decode.
+     */
+    template<class Sink>
+    bool decode(Sink sink) {
+        const uint32_t count = current.records;
+        const uint8_t* cycleColumn = raw.data();
+        const uint8_t* addressColumn = cycleColumn + current.cycleBytes;
+        const uint8_t* ops = addressColumn + current.addressBytes;
+        const uint8_t* lengthColumn = ops + (count + 7) / 8;
+
+        // One column at a time keeps each loop tight and its branches predictable
+        cycles.resize(count);
+        addresses.resize(count);
+        lengths.resize(count);
+        if (!decodeColumn(cycleColumn, current.cycleBytes, count, current.firstCycle, cycles.data()) ||
+                !decodeColumn(addressColumn, current.addressBytes, count, current.firstAddress, addresses.data()) ||
+                !decodeColumn(lengthColumn, current.lengthBytes, count, 0, lengths.data())) {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            sink(i, cycles[i], addresses[i], (uint32_t) lengths[i], 0 != ((ops[i >> 3] >> (i & 7)) & 1));
+        }
+        return true;
+    }
+
+    /*
+     * Position the reader so that the next readBlock() loads the block
+     * holding the first record issued at or after 'cycle'. Uses the index if
+     * there is one, otherwise skips blocks by their headers. Assumes cycles
+     * do not decrease through the trace.
+     */
+    bool seekCycle(uint64_t cycle) {
+        if (!index.empty()) {
+            // Last block starting at or before the cycle, records before it are all earlier
+            size_t block = std::upper_bound(index.begin(), index.end(), cycle,
+                [](uint64_t c, const IndexEntry& e) { return c < e.firstCycle; }) - index.begin();
+            block = block > 0 ? block - 1 : 0;
+            current.records = 0;
+            nextRecord = index[block].firstRecord;
+            return 0 == fseeko(file, (off_t) index[block].offset, SEEK_SET);
+        }
+
+        if (0 != fseeko(file, (off_t) sizeof(FileHeader), SEEK_SET)) {
+            return false;
+        }
+        current.records = 0;
+        nextRecord = 0;
+
+        BlockHeader header;
+        off_t previous = (off_t) sizeof(FileHeader);
+        uint64_t previousRecord = 0;
+        while (true) {
+            const off_t offset = ftello(file);
+            if (1 != fread(&header, sizeof(header), 1, file) || header.magic != BlockMagic || header.firstCycle > cycle) {
+                break;
+            }
+            previous = offset;
+            previousRecord = nextRecord;
+            nextRecord += header.records;
+            if (0 != fseeko(file, header.storedBytes, SEEK_CUR)) {
+                break;
+            }
+        }
+        nextRecord = previousRecord;
+        return 0 == fseeko(file, previous, SEEK_SET);
+    }
+
+    const BlockHeader& block() const { return current; }
+    uint32_t maxBlockRecords() const { return blockRecords; }
+    bool hasIndex() const { return !index.empty(); }
+    uint64_t blockCount() const { return index.size(); }
+    uint64_t recordCount() const { return totalRecords; }
+    uint64_t firstRecordOfBlock() const { return nextRecord; }
+    const std::string& error() const { return errorText; }
+
+private:
+    FILE* file;
+    uint32_t blockRecords;
+    uint64_t dataEnd;
+    uint64_t totalRecords;
+    uint64_t nextRecord;            // Index of the first record of the loaded block
+    BlockHeader current;
+    std::vector<uint8_t> stored;
+    std::vector<uint8_t> raw;
+    std::vector<uint64_t> cycles;   // Decoded columns of the loaded block
+    std::vector<uint64_t> addresses;
+    std::vector<uint64_t> lengths;
+    std::vector<IndexEntry> index;
+    std::string errorText;
+};
+
+}
+}
+}
+
+#endif
@@ -48,10 +48,10 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -65,6 +65,9 @@ public:
 
 	~ProsperoTraceReader() { };
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+	// Called once the component is done with an entry. Readers that hand out
+	// entries from their own storage override this so nothing is freed.
+	virtual void releaseEntry(const ProsperoTraceEntry* entry) { delete entry; }
 	void setOutput(Output* out) { output = out; }
 
 protected:
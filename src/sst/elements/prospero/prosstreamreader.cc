@@ -0,0 +1,389 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosstreamreader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Prospero;
+
+// Consumed parts of a mapped trace are given back to the kernel in chunks of this size
+#define PROSPERO_MAP_RELEASE_CHUNK (64 * 1024 * 1024)
+
+ProsperoStreamingTraceReader::ProsperoStreamingTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	std::string mode = params.find<std::string>("mode", "auto");
+	blockSize = params.find<size_t>("block_size", 4194304);
+	batchSize = params.find<size_t>("batch_size", 1024);
+	background = params.find<bool>("background", true);
+	const bool hugePages = params.find<bool>("huge_pages", true);
+
+	if (mode != "auto" && mode != "mmap" && mode != "stream") {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unknown mode '%s', expected auto, mmap or stream.\n",
+			getName().c_str(), mode.c_str());
+	}
+
+	if (0 == batchSize) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: batch_size must be at least 1.\n", getName().c_str());
+	}
+
+	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+	// Blocks hold whole records so that none is split across two blocks
+	blockSize = std::max(blockSize - (blockSize % recordLength), (size_t) recordLength);
+
+	entries.assign(batchSize, ProsperoTraceEntry(0, 0, 0, READ));
+	entryCount = 0;
+	nextEntry = 0;
+
+	mapped = false;
+	mapBase = NULL;
+	mapLength = 0;
+	mapOffset = 0;
+	mapReleased = 0;
+	streamInput = NULL;
+	currentBlock = 0;
+	blockOffset = 0;
+	stopFiller = false;
+	blockWaits = 0;
+
+	// gzip streams start with 0x1f 0x8b
+	FILE* probe = fopen(traceFile.c_str(), "rb");
+	if (NULL == probe) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in streaming reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+	unsigned char magic[2] = { 0, 0 };
+	const bool compressed = (2 == fread(magic, 1, 2, probe)) && magic[0] == 0x1f && magic[1] == 0x8b;
+	fclose(probe);
+
+#ifndef HAVE_LIBZ
+	if (compressed) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file %s is compressed but Prospero was built without libz.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+#endif
+
+	if (mode == "mmap" && compressed) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file %s is compressed and cannot be read with mode=mmap.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	if (mode == "mmap" || (mode == "auto" && !compressed)) {
+		mapped = openMapped(traceFile);
+
+		if (!mapped && mode == "mmap") {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: unable to map trace file %s: %s\n",
+				getName().c_str(), traceFile.c_str(), strerror(errno));
+		}
+	}
+
+	if (mapped) {
+#ifdef MADV_HUGEPAGE
+		if (hugePages && mapLength > 0) {
+			// Advisory only, most file systems cannot back file mappings with huge pages
+			madvise(mapBase, mapLength, MADV_HUGEPAGE);
+		}
+#endif
+		output->verbose(CALL_INFO, 1, 0, "Mapped trace file %s (%zu bytes)\n", traceFile.c_str(), mapLength);
+	} else {
+		openStream(traceFile);
+		output->verbose(CALL_INFO, 1, 0, "Streaming trace file %s (%s) in %zu byte blocks%s\n", traceFile.c_str(),
+			compressed ? "compressed" : "uncompressed", blockSize, background ? " on a background thread" : "");
+	}
+}
+
+ProsperoStreamingTraceReader::~ProsperoStreamingTraceReader() {
+	if (filler.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(blockLock);
+			stopFiller = true;
+		}
+		blockReady.notify_all();
+		filler.join();
+	}
+
+	if (NULL != streamInput) {
+#ifdef HAVE_LIBZ
+		gzclose(streamInput);
+#else
+		fclose(streamInput);
+#endif
+	}
+
+	if (NULL != mapBase) {
+		munmap(mapBase, mapLength);
+	}
+
+	if (!mapped) {
+		output->verbose(CALL_INFO, 1, 0, "Streaming reader waited for the next block %" PRIu64 " times\n", blockWaits);
+	}
+}
+
+bool ProsperoStreamingTraceReader::openMapped(const std::string& traceFile) {
+	int fd = open(traceFile.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0) {
+		close(fd);
+		return false;
+	}
+
+	mapLength = (size_t) fileStat.st_size;
+	if (mapLength > 0) {
+		void* base = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == base) {
+			close(fd);
+			mapLength = 0;
+			return false;
+		}
+		mapBase = (char*) base;
+		madvise(mapBase, mapLength, MADV_SEQUENTIAL);
+	}
+
+	// The mapping keeps the file referenced
+	close(fd);
+	return true;
+}
+
+void ProsperoStreamingTraceReader::openStream(const std::string& traceFile) {
+#ifdef HAVE_LIBZ
+	// zlib passes uncompressed files through unchanged
+	streamInput = gzopen(traceFile.c_str(), "rb");
+	if (Z_NULL == streamInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: attempted to open: %s but zlib returns error condition.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+#if ZLIB_VERNUM >= 0x1240
+	gzbuffer(streamInput, 1024 * 1024);
+#endif
+#else
+	streamInput = fopen(traceFile.c_str(), "rb");
+	if (NULL == streamInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in streaming reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+#endif
+
+	for (int i = 0; i < 2; ++i) {
+		blocks[i].data.resize(blockSize);
+		blocks[i].bytes = 0;
+		blocks[i].full = false;
+		blocks[i].error = false;
+	}
+
+	if (background) {
+		filler = std::thread(&ProsperoStreamingTraceReader::fillThread, this);
+
+		std::unique_lock<std::mutex> lock(blockLock);
+		blockReady.wait(lock, [this] { return blocks[0].full; });
+	} else {
+		fillBlock(blocks[0]);
+		blocks[0].full = true;
+	}
+
+	if (blocks[0].error) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: error reading trace file: %s\n", getName().c_str(), traceFile.c_str());
+	}
+}
+
+size_t ProsperoStreamingTraceReader::readBlock(char* target, size_t len, bool& error) {
+	size_t total = 0;
+
+	while (total < len) {
+#ifdef HAVE_LIBZ
+		const int bytesRead = gzread(streamInput, target + total, (unsigned int) (len - total));
+		if (bytesRead < 0) {
+			error = true;
+			break;
+		}
+#else
+		const size_t bytesRead = fread(target + total, 1, len - total, streamInput);
+		if (ferror(streamInput)) {
+			error = true;
+		}
+#endif
+		if (0 == bytesRead) {
+			break;
+		}
+		total += (size_t) bytesRead;
+	}
+
+	return total;
+}
+
+void ProsperoStreamingTraceReader::fillBlock(Block& block) {
+	block.error = false;
+	block.bytes = readBlock(block.data.data(), blockSize, block.error);
+}
+
+/*
+ * Runs on the reader thread: fill the two blocks alternately, each as soon as
+ * the simulation hands it back. A short block marks the end of the trace.
+ */
+void ProsperoStreamingTraceReader::fillThread() {
+	uint32_t index = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(blockLock);
+			blockReady.wait(lock, [this, index] { return stopFiller || !blocks[index].full; });
+			if (stopFiller) {
+				return;
+			}
+		}
+
+		// The simulation does not touch a block until it is marked full
+		fillBlock(blocks[index]);
+		const bool last = blocks[index].bytes < blockSize;
+
+		{
+			std::lock_guard<std::mutex> lock(blockLock);
+			blocks[index].full = true;
+		}
+		blockReady.notify_all();
+
+		if (last) {
+			return;
+		}
+		index ^= 1;
+	}
+}
+
+/* Move on to the next stream block, returns false at the end of the trace */
+bool ProsperoStreamingTraceReader::nextBlock() {
+	Block& current = blocks[currentBlock];
+
+	if (current.bytes < blockSize) {
+		if (current.bytes % recordLength != 0) {
+			output->verbose(CALL_INFO, 2, 0, "Trace ends with a partial record, ignoring %zu bytes.\n",
+				(size_t) (current.bytes % recordLength));
+		}
+		return false;
+	}
+
+	if (background) {
+		{
+			std::lock_guard<std::mutex> lock(blockLock);
+			current.full = false;
+		}
+		blockReady.notify_all();
+
+		currentBlock ^= 1;
+		std::unique_lock<std::mutex> lock(blockLock);
+		if (!blocks[currentBlock].full) {
+			blockWaits++;
+			blockReady.wait(lock, [this] { return blocks[currentBlock].full; });
+		}
+	} else {
+		fillBlock(current);
+	}
+
+	if (blocks[currentBlock].error) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: error reading trace file.\n", getName().c_str());
+	}
+
+	blockOffset = 0;
+	return true;
+}
+
+/* Decode the next batch of records into the entry array, returns false at the end of the trace */
+bool ProsperoStreamingTraceReader::refill() {
+	if (mapped) {
+		const size_t available = (mapLength - mapOffset) / recordLength;
+		if (0 == available) {
+			return false;
+		}
+
+		const size_t count = std::min(available, batchSize);
+		decode(mapBase + mapOffset, count);
+		mapOffset += count * recordLength;
+
+		if (mapOffset - mapReleased >= PROSPERO_MAP_RELEASE_CHUNK) {
+			const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+			const size_t releaseTo = mapOffset - (mapOffset % pageSize);
+			madvise(mapBase + mapReleased, releaseTo - mapReleased, MADV_DONTNEED);
+			mapReleased = releaseTo;
+		}
+		return true;
+	}
+
+	while (true) {
+		const Block& current = blocks[currentBlock];
+		const size_t available = (current.bytes - blockOffset) / recordLength;
+
+		if (available > 0) {
+			const size_t count = std::min(available, batchSize);
+			decode(current.data.data() + blockOffset, count);
+			blockOffset += count * recordLength;
+			return true;
+		}
+
+		if (!nextBlock()) {
+			return false;
+		}
+	}
+}
+
+void ProsperoStreamingTraceReader::decode(const char* records, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		const char* record = records + (i * recordLength);
+
+		uint64_t reqCycles;
+		char reqType;
+		uint64_t reqAddress;
+		uint32_t reqLength;
+
+		memcpy(&reqCycles,  record, sizeof(uint64_t));
+		memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+		memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+		entries[i] = ProsperoTraceEntry(reqCycles, reqAddress, reqLength,
+			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+	}
+
+	entryCount = count;
+	nextEntry = 0;
+}
+
+/*
+ * The returned entry lives in the reader's batch array and stays valid until
+ * the next call; the component releases it before asking for another.
+ */
+ProsperoTraceEntry* ProsperoStreamingTraceReader::readNextEntry() {
+	if (nextEntry == entryCount) {
+		if (!refill()) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
+	}
+
+	return &entries[nextEntry++];
+}
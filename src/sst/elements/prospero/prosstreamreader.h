@@ -0,0 +1,126 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_STREAM_READER
+#define _H_SST_PROSPERO_STREAM_READER
+
+#include "prosreader.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include "zlib.h"
+#endif
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Reader for the binary trace format (plain or gzip compressed) built for
+ * very large traces.
+ *
+ * Records are decoded in batches into a reusable array of entries, so
+ * readNextEntry() only allocates when a batch is refilled and never per
+ * record. Uncompressed traces are mapped into memory and decoded in place;
+ * pages already consumed are dropped from the mapping as the trace advances.
+ * Compressed traces (or any trace when mode is "stream") are read in large
+ * blocks by a background thread into two buffers, so the simulation only
+ * waits on I/O if it consumes a block faster than the next one is inflated.
+ */
+class ProsperoStreamingTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoStreamingTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoStreamingTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+    void releaseEntry(const ProsperoTraceEntry*) {}
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoStreamingTraceReader,
+        "prospero",
+        "ProsperoStreamingTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Memory mapped / block streaming binary trace reader with background decompression",
+        SST::Prospero::ProsperoTraceReader
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "file", "Sets the file for the trace reader to use, plain or gzip compressed binary", "" },
+        { "mode", "How to read the file: 'mmap' maps it into memory, 'stream' reads it in blocks, 'auto' maps uncompressed traces and streams compressed ones", "auto" },
+        { "block_size", "Size in bytes of each of the two stream buffers", "4194304" },
+        { "batch_size", "Number of records decoded at a time", "1024" },
+        { "background", "Read and inflate stream blocks on a separate thread", "true" },
+        { "huge_pages", "Ask the kernel to back the mapping with huge pages where it supports it", "true" }
+    )
+
+private:
+    /* One of the two stream buffers, filled by the reader thread and drained by readNextEntry */
+    struct Block {
+        std::vector<char> data;
+        size_t bytes;
+        bool full;
+        bool error;
+    };
+
+    bool openMapped(const std::string& traceFile);
+    void openStream(const std::string& traceFile);
+    size_t readBlock(char* target, size_t len, bool& error);
+    void fillBlock(Block& block);
+    void fillThread();
+    bool nextBlock();
+    bool refill();
+    void decode(const char* records, size_t count);
+
+    uint32_t recordLength;
+    std::vector<ProsperoTraceEntry> entries;
+    size_t entryCount;
+    size_t nextEntry;
+    size_t batchSize;
+
+    // Memory mapped input
+    bool mapped;
+    char* mapBase;
+    size_t mapLength;
+    size_t mapOffset;
+    size_t mapReleased;             // Bytes at the start of the mapping already given back
+
+    // Streamed input
+#ifdef HAVE_LIBZ
+    gzFile streamInput;
+#else
+    FILE* streamInput;
+#endif
+    bool background;
+    size_t blockSize;
+    Block blocks[2];
+    uint32_t currentBlock;
+    size_t blockOffset;
+
+    std::thread filler;
+    std::mutex blockLock;
+    std::condition_variable blockReady;
+    bool stopFiller;
+
+    uint64_t blockWaits;            // Times readNextEntry found the next block not yet filled
+};
+
+}
+}
+
+#endif
@@ -8,6 +8,7 @@ traceFile = "File Error"
 traceDir = "Dir Error"
 memSize = "4096"
 useTimingDram="no"
+readerMode=""
 
 def main():
     global Tracetype
@@ -15,9 +16,10 @@ def main():
     global traceDir
     global memSize
     global useTimingDram
+    global readerMode
 
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir=","Reader="])
     except getopt.GetopError as err:
         print(str(err))
         sys.exit(2)
@@ -43,6 +45,9 @@ def main():
                 useTimingDram = 'yes'
         elif o in ("--TraceDir"):
             traceDir=a
+        elif o in ("--Reader"):
+            # Read the trace with the streaming reader in this mode (mmap or stream)
+            readerMode=a
         else:
             print("no match for o", o)
             assert False, "Unknown Options !"
@@ -61,6 +66,11 @@ comp_cpu.addParams({
        "reader" : "prospero.Prospero" + Tracetype + "TraceReader",
        "readerParams.file" : traceDir + "/" + traceFile
 })
+if readerMode != "":
+    comp_cpu.addParams({
+       "reader" : "prospero.ProsperoStreamingTraceReader",
+       "readerParams.mode" : readerMode
+    })
 comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
 comp_l1cache.addParams({
       "access_latency_cycles" : "1",
@@ -4,6 +4,8 @@ from sst_unittest import *
 from sst_unittest_support import *
 import os
 import glob
+import random
+import re
 
 USE_PIN_TRACES = True
 USE_TAR_TRACES = False
@@ -65,9 +67,37 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_binary_withtimingdram_using_PIN_traces(self):
         self.prospero_test_template("binary", WITH_TIMINGDRAM, USE_PIN_TRACES)
 
+    def test_prospero_binary_using_TAR_traces_mmap_reader(self):
+        self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES, reader="mmap")
+
+    def test_prospero_binary_using_TAR_traces_stream_reader(self):
+        self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES, reader="stream")
+
+    def test_prospero_binary_withtimingdram_using_TAR_traces_mmap_reader(self):
+        self.prospero_test_template("binary", WITH_TIMINGDRAM, USE_TAR_TRACES, reader="mmap")
+
+    def test_prospero_binary_withtimingdram_using_TAR_traces_stream_reader(self):
+        self.prospero_test_template("binary", WITH_TIMINGDRAM, USE_TAR_TRACES, reader="stream")
+
+    # Compressed traces cannot be mapped, so they are only read in stream mode
+    @unittest.skipIf(libz_missing, "test_prospero_compressed_using_TAR_traces_stream_reader test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_compressed_using_TAR_traces_stream_reader(self):
+        self.prospero_test_template("compressed", NO_TIMINGDRAM, USE_TAR_TRACES, reader="stream")
+
+    @unittest.skipIf(libz_missing, "test_prospero_compressed_withtimingdram_using_TAR_traces_stream_reader test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_compressed_withtimingdram_using_TAR_traces_stream_reader(self):
+        self.prospero_test_template("compressed", WITH_TIMINGDRAM, USE_TAR_TRACES, reader="stream")
+
+    def test_prospero_delta_round_trip(self):
+        self.prospero_delta_round_trip_template(0)
+
+    @unittest.skipIf(libz_missing, "test_prospero_delta_deflated_round_trip test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_delta_deflated_round_trip(self):
+        self.prospero_delta_round_trip_template(1)
+
 #####
 
-    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240):
+    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240, reader=""):
         pass
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -88,18 +118,25 @@ class testcase_prospero(SSTTestCase):
         trace_files_list = glob.glob(wildcard_filepath)
         self.assertTrue(len(trace_files_list) > 0, "Prospero - No Trace files found in dir {0}".format(prospero_trace_dir))
 
+        # The streaming reader must produce the same results as the reader for the trace type
+        readerarg = ""
+        if reader != "":
+            readerarg = " --Reader={0}".format(reader)
+
         # Set the various file paths
         if with_timingdram:
             testDataFileName = ("test_prospero_with_timingdram_{0}".format(trace_name))
-            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=yes --TraceDir={1}\"'.format(trace_name, prospero_trace_dir)
+            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=yes --TraceDir={1}{2}\"'.format(trace_name, prospero_trace_dir, readerarg)
         else:
             testDataFileName = ("test_prospero_wo_timingdram_{0}".format(trace_name))
-            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=no --TraceDir={1}\"'.format(trace_name, prospero_trace_dir)
+            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=no --TraceDir={1}{2}\"'.format(trace_name, prospero_trace_dir, readerarg)
 
         if use_pin_traces:
             tracetype = "pin"
         else:
             tracetype = "tar"
+        if reader != "":
+            tracetype = "{0}_{1}_reader".format(tracetype, reader)
 
         sdlfile = "{0}/array/trace-common.py".format(test_path)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
@@ -156,6 +193,77 @@ class testcase_prospero(SSTTestCase):
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
 
+    def prospero_delta_round_trip_template(self, level):
+        # Convert a text trace to the block delta format and back, and check
+        # that every record survives. Small blocks put records on block edges,
+        # and the trace mixes runs with jumps that need all 8 value bytes.
+        tmpdir = self.get_test_output_tmp_dir()
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        convert = "{0}/sst-prospero-convert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(convert), "Prospero - sst-prospero-convert not found in {0}".format(elem_bin_dir))
+
+        name = "delta_round_trip_z{0}".format(level)
+        textfile = "{0}/{1}.trace".format(tmpdir, name)
+        deltafile = "{0}/{1}.trace.pdt".format(tmpdir, name)
+        backfile = "{0}/{1}.back.trace".format(tmpdir, name)
+
+        records = self._write_delta_test_trace(textfile)
+
+        cmd = "{0} -f text -o delta -b 7 -z {1} {2} {3}".format(convert, level, textfile, deltafile)
+        rtn = OSCommand(cmd).run()
+        self.assertTrue(rtn.result() == 0, "Prospero - text to delta conversion failed:\n{0}".format(rtn.output()))
+
+        cmd = "{0} -f delta -o text {1} {2}".format(convert, deltafile, backfile)
+        rtn = OSCommand(cmd).run()
+        self.assertTrue(rtn.result() == 0, "Prospero - delta to text conversion failed:\n{0}".format(rtn.output()))
+
+        with open(textfile) as f:
+            original = f.read().splitlines()
+        with open(backfile) as f:
+            converted = f.read().splitlines()
+        self.assertEqual(len(original), records)
+        self.assertEqual(len(converted), records, "Prospero - delta trace returned {0} of {1} records".format(len(converted), records))
+        for i, (want, got) in enumerate(zip(original, converted)):
+            self.assertEqual(want, got, "Prospero - record {0} changed in the delta round trip".format(i))
+
+        cmd = "{0} -i {1}".format(convert, deltafile)
+        rtn = OSCommand(cmd).run()
+        self.assertTrue(rtn.result() == 0, "Prospero - delta trace summary failed:\n{0}".format(rtn.output()))
+        self.assertTrue(re.search(r"Index:\s+yes", rtn.output()) is not None, "Prospero - delta trace has no index")
+        self.assertTrue(re.search(r"Records:\s+{0}\b".format(records), rtn.output()) is not None,
+                        "Prospero - delta trace summary does not report {0} records".format(records))
+
+
+    def _write_delta_test_trace(self, textfile):
+        rng = random.Random(511)
+        lines = []
+        cycle = 0
+        address = 0x10000
+        for i in range(500):
+            pick = rng.randrange(8)
+            if pick < 5:
+                address += 64                       # sequential run
+            elif pick == 5:
+                address -= rng.randrange(1, 1 << 20)  # backwards
+            elif pick == 6:
+                address = rng.randrange(1 << 48)    # far jump
+            else:
+                address = 0                         # repeat of the base
+            address &= (1 << 64) - 1
+            cycle += rng.randrange(0, 1000)
+            op = "W" if rng.randrange(3) == 0 else "R"
+            length = rng.choice([1, 4, 8, 64])
+            lines.append("{0} {1} {2} {3}".format(cycle, op, address, length))
+        # Deltas that only fit in 8 bytes, and a zero delta after them
+        top = (1 << 64) - 1
+        lines.append("{0} R {1} 8".format(cycle, top))
+        lines.append("{0} W {1} 8".format(top, 1 << 63))
+        lines.append("{0} W {1} 8".format(top, 1 << 63))
+        lines.append("{0} R 0 4294967295".format(top))
+        with open(textfile, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        return len(lines)
+
 #######################
 
     def _setup_prospero_test_dirs(self):
@@ -0,0 +1,383 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Converts Prospero traces between the text, binary, compressed binary and
+// block delta formats, and summarizes delta traces.
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../prosdeltatrace.h"
+
+using namespace SST::Prospero;
+
+typedef std::function<bool(uint64_t, uint64_t, uint32_t, bool)> RecordSink;
+
+static const size_t BinaryRecordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+void printUsage() {
+	printf("sst-prospero-convert [options] <input> <output>\n");
+	printf("sst-prospero-convert -i <delta trace>\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -f <format>   Input <format> = {text, binary, compressed, delta}, default: detect binary, compressed or delta\n");
+	printf("  -o <format>   Output <format> = {text, binary, compressed, delta}, default: delta\n");
+	printf("  -b <records>  Records per block in delta output (default %" PRIu32 ")\n", DeltaTrace::DefaultBlockRecords);
+	printf("  -z <level>    Deflate level for delta output blocks, 0 to store uncompressed (default 1)\n");
+	printf("  -i            Print a summary of a delta trace and time decoding it\n");
+	printf("\n");
+}
+
+static std::string detectFormat(const std::string& path) {
+	FILE* probe = fopen(path.c_str(), "rb");
+	if (NULL == probe) {
+		return "";
+	}
+
+	unsigned char magic[4] = { 0, 0, 0, 0 };
+	const size_t got = fread(magic, 1, sizeof(magic), probe);
+	fclose(probe);
+
+	uint32_t word = 0;
+	memcpy(&word, magic, sizeof(word));
+	if (got == sizeof(magic) && word == DeltaTrace::FileMagic) {
+		return "delta";
+	}
+	if (got >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+		return "compressed";
+	}
+	return "binary";
+}
+
+static bool readText(const std::string& path, const RecordSink& sink) {
+	FILE* input = fopen(path.c_str(), "rt");
+	if (NULL == input) {
+		fprintf(stderr, "Error: unable to open %s\n", path.c_str());
+		return false;
+	}
+
+	uint64_t cycles, address;
+	uint32_t length;
+	char type;
+	bool ok = true;
+	while (ok && 4 == fscanf(input, "%" SCNu64 " %c %" SCNu64 " %" SCNu32, &cycles, &type, &address, &length)) {
+		ok = sink(cycles, address, length, type == 'W' || type == 'w');
+	}
+
+	fclose(input);
+	return ok;
+}
+
+static bool readBinary(const std::string& path, const RecordSink& sink) {
+#ifdef HAVE_LIBZ
+	// zlib also reads uncompressed files
+	gzFile input = gzopen(path.c_str(), "rb");
+	if (Z_NULL == input) {
+#else
+	FILE* input = fopen(path.c_str(), "rb");
+	if (NULL == input) {
+#endif
+		fprintf(stderr, "Error: unable to open %s\n", path.c_str());
+		return false;
+	}
+
+	std::vector<char> buffer(BinaryRecordLength * 65536);
+	size_t pending = 0;
+	bool ok = true;
+
+	while (ok) {
+#ifdef HAVE_LIBZ
+		const int got = gzread(input, buffer.data() + pending, (unsigned int) (buffer.size() - pending));
+		if (got < 0) {
+			fprintf(stderr, "Error: unable to read %s\n", path.c_str());
+			ok = false;
+			break;
+		}
+#else
+		const size_t got = fread(buffer.data() + pending, 1, buffer.size() - pending, input);
+#endif
+		if (0 == got) {
+			break;
+		}
+		pending += (size_t) got;
+
+		const size_t records = pending / BinaryRecordLength;
+		for (size_t i = 0; ok && i < records; ++i) {
+			const char* record = buffer.data() + i * BinaryRecordLength;
+			uint64_t cycles, address;
+			uint32_t length;
+			char type;
+			memcpy(&cycles,  record, sizeof(uint64_t));
+			memcpy(&type,    record + sizeof(uint64_t), sizeof(char));
+			memcpy(&address, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+			memcpy(&length,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+			ok = sink(cycles, address, length, !(type == 'R' || type == 'r'));
+		}
+
+		const size_t used = records * BinaryRecordLength;
+		memmove(buffer.data(), buffer.data() + used, pending - used);
+		pending -= used;
+	}
+
+	if (ok && pending > 0) {
+		fprintf(stderr, "Warning: ignoring %zu bytes of partial record at the end of %s\n", pending, path.c_str());
+	}
+
+#ifdef HAVE_LIBZ
+	gzclose(input);
+#else
+	fclose(input);
+#endif
+	return ok;
+}
+
+static bool readDelta(const std::string& path, const RecordSink& sink) {
+	DeltaTrace::Reader reader;
+	if (!reader.open(path)) {
+		fprintf(stderr, "Error: %s\n", reader.error().c_str());
+		return false;
+	}
+
+	bool ok = true;
+	while (ok && reader.readBlock()) {
+		const bool decoded = reader.decode([&ok, &sink](uint32_t, uint64_t cycles, uint64_t address, uint32_t length, bool write) {
+			ok = ok && sink(cycles, address, length, write);
+		});
+		if (!decoded) {
+			fprintf(stderr, "Error: corrupt block at record %" PRIu64 " in %s\n", reader.firstRecordOfBlock(), path.c_str());
+			return false;
+		}
+	}
+
+	if (!reader.error().empty()) {
+		fprintf(stderr, "Error: %s in %s\n", reader.error().c_str(), path.c_str());
+		return false;
+	}
+	return ok;
+}
+
+static int summarize(const std::string& path) {
+	DeltaTrace::Reader reader;
+	if (!reader.open(path)) {
+		fprintf(stderr, "Error: %s\n", reader.error().c_str());
+		return -1;
+	}
+
+	struct stat fileStat;
+	const uint64_t fileBytes = (0 == stat(path.c_str(), &fileStat)) ? (uint64_t) fileStat.st_size : 0;
+
+	uint64_t records = 0;
+	uint64_t blocks = 0;
+	uint64_t compressedBlocks = 0;
+	uint64_t checksum = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	while (reader.readBlock()) {
+		blocks++;
+		compressedBlocks += (reader.block().codec != DeltaTrace::CODEC_NONE) ? 1 : 0;
+		const bool decoded = reader.decode([&checksum](uint32_t, uint64_t cycles, uint64_t address, uint32_t length, bool write) {
+			checksum += cycles ^ address ^ length ^ (uint64_t) write;
+		});
+		if (!decoded) {
+			fprintf(stderr, "Error: corrupt block at record %" PRIu64 "\n", reader.firstRecordOfBlock());
+			return -1;
+		}
+		records += reader.block().records;
+	}
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (!reader.error().empty()) {
+		fprintf(stderr, "Error: %s\n", reader.error().c_str());
+		return -1;
+	}
+
+	printf("Trace:              %s\n", path.c_str());
+	printf("Index:              %s\n", reader.hasIndex() ? "yes" : "no (trace was not closed)");
+	printf("Blocks:             %" PRIu64 " (%" PRIu64 " deflated)\n", blocks, compressedBlocks);
+	printf("Records:            %" PRIu64 "\n", records);
+	printf("File size:          %" PRIu64 " bytes\n", fileBytes);
+	if (records > 0) {
+		printf("Bytes per record:   %.3f (binary format: %zu)\n", (double) fileBytes / records, BinaryRecordLength);
+	}
+	if (seconds > 0) {
+		printf("Decode rate:        %.1f M records/s, %.1f MB/s of binary format\n",
+			records / seconds / 1.0e6, records * BinaryRecordLength / seconds / 1.0e6);
+	}
+	printf("Checksum:           %016" PRIx64 "\n", checksum);
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	std::string inputFormat;
+	std::string outputFormat = "delta";
+	uint32_t blockRecords = DeltaTrace::DefaultBlockRecords;
+	int level = 1;
+	bool info = false;
+	std::vector<std::string> files;
+
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+			printUsage();
+			exit(0);
+		} else if (std::strcmp(argv[i], "-i") == 0) {
+			info = true;
+		} else if (i + 1 < argc && std::strcmp(argv[i], "-f") == 0) {
+			inputFormat = argv[++i];
+		} else if (i + 1 < argc && std::strcmp(argv[i], "-o") == 0) {
+			outputFormat = argv[++i];
+		} else if (i + 1 < argc && std::strcmp(argv[i], "-b") == 0) {
+			blockRecords = (uint32_t) strtoul(argv[++i], NULL, 0);
+		} else if (i + 1 < argc && std::strcmp(argv[i], "-z") == 0) {
+			level = atoi(argv[++i]);
+		} else {
+			files.push_back(argv[i]);
+		}
+	}
+
+	if (info) {
+		if (files.size() != 1) {
+			printUsage();
+			exit(-1);
+		}
+		return summarize(files[0]);
+	}
+
+	if (files.size() != 2 || 0 == blockRecords) {
+		printUsage();
+		exit(-1);
+	}
+
+	if (inputFormat.empty()) {
+		inputFormat = detectFormat(files[0]);
+	}
+
+#ifndef HAVE_LIBZ
+	if (inputFormat == "compressed" || outputFormat == "compressed") {
+		fprintf(stderr, "Error: compressed traces require libz\n");
+		exit(-1);
+	}
+#endif
+
+	// Set up the output
+	DeltaTrace::Writer deltaOutput;
+	FILE* plainOutput = NULL;
+#ifdef HAVE_LIBZ
+	gzFile gzOutput = Z_NULL;
+#endif
+	char record[BinaryRecordLength];
+	RecordSink sink;
+
+	if (outputFormat == "delta") {
+		if (!deltaOutput.open(files[1], blockRecords, level)) {
+			fprintf(stderr, "Error: %s\n", deltaOutput.error().c_str());
+			exit(-1);
+		}
+		sink = [&deltaOutput](uint64_t cycles, uint64_t address, uint32_t length, bool write) {
+			return deltaOutput.append(cycles, address, length, write);
+		};
+	} else if (outputFormat == "text") {
+		plainOutput = fopen(files[1].c_str(), "wt");
+		sink = [&plainOutput](uint64_t cycles, uint64_t address, uint32_t length, bool write) {
+			return 0 < fprintf(plainOutput, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "\n", cycles, write ? 'W' : 'R', address, length);
+		};
+	} else if (outputFormat == "binary" || outputFormat == "compressed") {
+		const bool compressed = outputFormat == "compressed";
+		if (compressed) {
+#ifdef HAVE_LIBZ
+			gzOutput = gzopen(files[1].c_str(), "wb");
+#endif
+		} else {
+			plainOutput = fopen(files[1].c_str(), "wb");
+		}
+		sink = [&, compressed](uint64_t cycles, uint64_t address, uint32_t length, bool write) {
+			const char type = write ? 'W' : 'R';
+			memcpy(record, &cycles, sizeof(uint64_t));
+			memcpy(record + sizeof(uint64_t), &type, sizeof(char));
+			memcpy(record + sizeof(uint64_t) + sizeof(char), &address, sizeof(uint64_t));
+			memcpy(record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &length, sizeof(uint32_t));
+#ifdef HAVE_LIBZ
+			if (compressed) {
+				return (int) BinaryRecordLength == gzwrite(gzOutput, record, BinaryRecordLength);
+			}
+#endif
+			return BinaryRecordLength == fwrite(record, 1, BinaryRecordLength, plainOutput);
+		};
+	} else {
+		fprintf(stderr, "Error: unknown output format %s\n", outputFormat.c_str());
+		exit(-1);
+	}
+
+	bool outputOpen = outputFormat == "delta" || NULL != plainOutput;
+#ifdef HAVE_LIBZ
+	outputOpen = outputOpen || Z_NULL != gzOutput;
+#endif
+	if (!outputOpen) {
+		fprintf(stderr, "Error: unable to open %s for writing\n", files[1].c_str());
+		exit(-1);
+	}
+
+	// Convert
+	uint64_t records = 0;
+	RecordSink counted = [&records, &sink](uint64_t cycles, uint64_t address, uint32_t length, bool write) {
+		records++;
+		return sink(cycles, address, length, write);
+	};
+
+	bool ok;
+	if (inputFormat == "text") {
+		ok = readText(files[0], counted);
+	} else if (inputFormat == "binary" || inputFormat == "compressed") {
+		ok = readBinary(files[0], counted);
+	} else if (inputFormat == "delta") {
+		ok = readDelta(files[0], counted);
+	} else {
+		fprintf(stderr, "Error: unknown or unreadable input %s\n", files[0].c_str());
+		exit(-1);
+	}
+
+	if (outputFormat == "delta") {
+		if (!deltaOutput.close()) {
+			fprintf(stderr, "Error: %s\n", deltaOutput.error().c_str());
+			ok = false;
+		}
+	}
+	if (NULL != plainOutput && 0 != fclose(plainOutput)) {
+		ok = false;
+	}
+#ifdef HAVE_LIBZ
+	if (Z_NULL != gzOutput && Z_OK != gzclose(gzOutput)) {
+		ok = false;
+	}
+#endif
+
+	if (!ok) {
+		fprintf(stderr, "Error: conversion of %s failed after %" PRIu64 " records\n", files[0].c_str(), records);
+		exit(-1);
+	}
+
+	printf("Converted %" PRIu64 " records from %s (%s) to %s (%s)\n", records,
+		files[0].c_str(), inputFormat.c_str(), files[1].c_str(), outputFormat.c_str());
+	return 0;
+}